@@ -31,12 +31,25 @@
 
 
 #include "3dface.h"
+#include "arena.h"
+#include "pool.h"
+#include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_3dface_new are handed out by.
+ */
+static DxfPool dxf_3dface_pool = DXF_POOL_INITIALIZER (sizeof (Dxf3dface));
 
 
 /*!
  * \brief Allocate memory for a \c Dxf3dface.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_3dface_free.
  */
 Dxf3dface *
 dxf_3dface_new ()
@@ -46,31 +59,91 @@ dxf_3dface_new ()
                 __FILE__, __LINE__);
 #endif
         Dxf3dface *dxf_3dface = NULL;
-        size_t size;
 
-        size = sizeof (Dxf3dface);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_3dface = malloc (size)) == NULL)
+        if ((dxf_3dface = dxf_pool_alloc (&dxf_3dface_pool)) == NULL)
         {
                 fprintf (stderr, "ERROR in dxf_3dface_new () could not allocate memory for a Dxf3dface struct.\n");
-                dxf_3dface = NULL;
         }
-        else
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_3dface_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_3dface);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c Dxf3dface from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_3dface_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+Dxf3dface *
+dxf_3dface_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_3dface_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        Dxf3dface *dxf_3dface = NULL;
+
+        if (arena == NULL)
+        {
+                dxf_3dface = dxf_3dface_new ();
+        }
+        else if ((dxf_3dface = dxf_arena_alloc (arena, sizeof (Dxf3dface))) == NULL)
         {
-                memset (dxf_3dface, 0, size);
+                fprintf (stderr, "ERROR in dxf_3dface_new_arena () could not allocate memory for a Dxf3dface struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_3dface_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_3dface_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_3dface);
 }
 
 
+/*!
+ * \brief Release a \c Dxf3dface allocated by \c dxf_3dface_new to its pool.
+ *
+ * The struct has no strings of its own, the layer and linetype are
+ * interned (see \c dxf_arena_intern).\n
+ * Not for a \c Dxf3dface allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_3dface_free
+(
+        Dxf3dface *dxf_3dface
+                /*!< DXF 3dface entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_3dface_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        dxf_pool_release (&dxf_3dface_pool, dxf_3dface);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_3dface_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in a \c 3DFACE entity.
  * 
+ * The layer and linetype are interned in the names shared by the
+ * entities without an arena (see \c dxf_intern_shared), they stay
+ * valid until \c dxf_intern_shared_free.
+ *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
  */
@@ -85,15 +158,45 @@ dxf_3dface_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_3dface_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        dxf_3dface = dxf_3dface_new ();
+        dxf_3dface = dxf_3dface_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_3dface_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_3dface);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in a \c 3DFACE entity.
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_3dface_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+Dxf3dface *
+dxf_3dface_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_3dface_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        Dxf3dface *dxf_3dface = NULL;
+        dxf_3dface = dxf_3dface_new_arena (arena);
         if (dxf_3dface == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_3dface_init () could not allocate memory for a Dxf3dface struct.\n");
+              fprintf (stderr, "ERROR in dxf_3dface_init_arena () could not allocate memory for a Dxf3dface struct.\n");
               return (NULL);
         }
         dxf_3dface->common.id_code = 0;
-        dxf_3dface->common.linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dxf_3dface->common.layer = strdup (DXF_DEFAULT_LAYER);
+        dxf_3dface->common.linetype = dxf_arena_intern (arena, DXF_DEFAULT_LINETYPE);
+        dxf_3dface->common.layer = dxf_arena_intern (arena, DXF_DEFAULT_LAYER);
         dxf_3dface->x0 = 0.0;
         dxf_3dface->y0 = 0.0;
         dxf_3dface->z0 = 0.0;
@@ -112,13 +215,36 @@ dxf_3dface_init
         dxf_3dface->flag = 0;
         dxf_3dface->common.acad_version_number = 0;
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_3dface_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_3dface_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_3dface);
 }
 
 
+/*!
+ * \brief Schema of the \c 3DFACE entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_3dface_schema[DXF_SCHEMA_SIZE] =
+{
+        DXF_SCHEMA_ENTITY_COMMON (Dxf3dface),
+        [10] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, Dxf3dface, x0),
+        [11] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, Dxf3dface, x1),
+        [12] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, Dxf3dface, x2),
+        [13] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, Dxf3dface, x3),
+        [20] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, Dxf3dface, y0),
+        [21] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, Dxf3dface, y1),
+        [22] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, Dxf3dface, y2),
+        [23] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, Dxf3dface, y3),
+        [30] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, Dxf3dface, z0),
+        [31] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, Dxf3dface, z1),
+        [32] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, Dxf3dface, z2),
+        [33] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, Dxf3dface, z3),
+        [38] = DXF_SCHEMA_FIELD (DXF_FIELD_ELEVATION, Dxf3dface, z0),
+        [70] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, Dxf3dface, flag)
+};
+
+
 /*!
  * \brief Read data from a DXF file into an \c 3DFACE entity.
  *
@@ -126,6 +252,7 @@ dxf_3dface_init
  * Now follows some data for the \c 3DFACE, to be terminated with a "  0"
  * string announcing the following entity, or the end of the \c ENTITY
  * section marker \c ENDSEC. \n
+ * The group codes are decoded through \c dxf_3dface_schema.
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred while reading from the input file.
@@ -133,12 +260,8 @@ dxf_3dface_init
 int
 dxf_3dface_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         Dxf3dface *dxf_3dface,
                 /*!< DXF 3dface entity. */
         int acad_version_number
@@ -149,196 +272,19 @@ dxf_3dface_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_3dface_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
         if (!dxf_3dface)
         {
                 dxf_3dface = dxf_3dface_new ();
         }
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_3dface_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (0);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (*line_number)++;
-                        fscanf (fp, "%x\n", &dxf_3dface->common.id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_3dface->common.linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_3dface->common.layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the first point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_3dface->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the first point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_3dface->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of first the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_3dface->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the second point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_3dface->x1);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the second point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_3dface->y1);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the second point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_3dface->z1);
-                }
-                else if (strcmp (temp_string, "12") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the third point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_3dface->x2);
-                }
-                else if (strcmp (temp_string, "22") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the third point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_3dface->y2);
-                }
-                else if (strcmp (temp_string, "32") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the third point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_3dface->z2);
-                }
-                else if (strcmp (temp_string, "13") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_3dface->x3);
-                }
-                else if (strcmp (temp_string, "23") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the fourth point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_3dface->y3);
-                }
-                else if (strcmp (temp_string, "33") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the fourth point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_3dface->z3);
-                }
-                else if ((acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (dxf_3dface->z0 = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_3dface->z0);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_3dface->common.thickness);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_3dface->common.color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_3dface->common.paperspace);
-                }
-                else if ((acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * value of edge visibility flag. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_3dface->flag);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning in dxf_3dface_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_3dface_schema, dxf_3dface, NULL,
+                "3DFACE", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_3dface_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -351,8 +297,8 @@ dxf_3dface_read
 int
 dxf_3dface_write_lowlevel
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< group code = 5. */
         char *linetype,
@@ -429,41 +375,41 @@ dxf_3dface_write_lowlevel
                         dxf_entity_name);
                 layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
-        fprintf (fp, " 11\n%f\n", x1);
-        fprintf (fp, " 21\n%f\n", y1);
-        fprintf (fp, " 31\n%f\n", z1);
-        fprintf (fp, " 12\n%f\n", x2);
-        fprintf (fp, " 22\n%f\n", y2);
-        fprintf (fp, " 32\n%f\n", z2);
-        fprintf (fp, " 13\n%f\n", x3);
-        fprintf (fp, " 23\n%f\n", y3);
-        fprintf (fp, " 33\n%f\n", z3);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
+        dxf_write_group_double (fp, 11, x1);
+        dxf_write_group_double (fp, 21, y1);
+        dxf_write_group_double (fp, 31, z1);
+        dxf_write_group_double (fp, 12, x2);
+        dxf_write_group_double (fp, 22, y2);
+        dxf_write_group_double (fp, 32, z2);
+        dxf_write_group_double (fp, 13, x3);
+        dxf_write_group_double (fp, 23, y3);
+        dxf_write_group_double (fp, 33, z3);
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
         if (paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp, " 70\n%d\n", flag);
+        dxf_write_group_int (fp, 70, flag);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_3dface_write_lowlevel () function.\n",
                 __FILE__, __LINE__);
@@ -481,8 +427,8 @@ dxf_3dface_write_lowlevel
 int
 dxf_3dface_write
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         Dxf3dface dxf_3dface
                 /*!< DXF 3D face entity. */
 )
@@ -501,39 +447,39 @@ dxf_3dface_write
                         dxf_entity_name);
                 dxf_3dface.common.layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (dxf_3dface.common.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_3dface.common.id_code);
+                dxf_write_group_hex (fp, 5, dxf_3dface.common.id_code);
         }
         if (strcmp (dxf_3dface.common.linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", dxf_3dface.common.linetype);
+                dxf_write_group_string (fp, 6, dxf_3dface.common.linetype);
         }
-        fprintf (fp, "  8\n%s\n", dxf_3dface.common.layer);
-        fprintf (fp, " 10\n%f\n", dxf_3dface.x0);
-        fprintf (fp, " 20\n%f\n", dxf_3dface.y0);
-        fprintf (fp, " 30\n%f\n", dxf_3dface.z0);
-        fprintf (fp, " 11\n%f\n", dxf_3dface.x1);
-        fprintf (fp, " 21\n%f\n", dxf_3dface.y1);
-        fprintf (fp, " 31\n%f\n", dxf_3dface.z1);
-        fprintf (fp, " 12\n%f\n", dxf_3dface.x2);
-        fprintf (fp, " 22\n%f\n", dxf_3dface.y2);
-        fprintf (fp, " 32\n%f\n", dxf_3dface.z2);
-        fprintf (fp, " 13\n%f\n", dxf_3dface.x3);
-        fprintf (fp, " 23\n%f\n", dxf_3dface.y3);
-        fprintf (fp, " 33\n%f\n", dxf_3dface.z3);
+        dxf_write_group_string (fp, 8, dxf_3dface.common.layer);
+        dxf_write_group_double (fp, 10, dxf_3dface.x0);
+        dxf_write_group_double (fp, 20, dxf_3dface.y0);
+        dxf_write_group_double (fp, 30, dxf_3dface.z0);
+        dxf_write_group_double (fp, 11, dxf_3dface.x1);
+        dxf_write_group_double (fp, 21, dxf_3dface.y1);
+        dxf_write_group_double (fp, 31, dxf_3dface.z1);
+        dxf_write_group_double (fp, 12, dxf_3dface.x2);
+        dxf_write_group_double (fp, 22, dxf_3dface.y2);
+        dxf_write_group_double (fp, 32, dxf_3dface.z2);
+        dxf_write_group_double (fp, 13, dxf_3dface.x3);
+        dxf_write_group_double (fp, 23, dxf_3dface.y3);
+        dxf_write_group_double (fp, 33, dxf_3dface.z3);
         if (dxf_3dface.common.thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", dxf_3dface.common.thickness);
+                dxf_write_group_double (fp, 39, dxf_3dface.common.thickness);
         }
         if (dxf_3dface.common.color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", dxf_3dface.common.color);
+                dxf_write_group_int (fp, 62, dxf_3dface.common.color);
         }
         if (dxf_3dface.common.paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_3dface_write () function.\n",
@@ -543,4 +489,89 @@ dxf_3dface_write
 }
 
 
+/*!
+ * \brief Write DXF output to fp for a batch of 3D face entities, for
+ * example the triangles of a mesh.
+ *
+ * The corners are given as arrays with \c 3 * \c count doubles for the
+ * X, Y and Z of corner 0 of the faces (X, Y and Z of the first face,
+ * then of the second face, ...), corner 1 and corner 2.\n
+ * \c corner3 can be \c NULL for triangles, the fourth corner is then
+ * the same as the third corner.\n
+ * All faces are written with the same layer and color.\n
+ * When \c handle is not \c NULL the faces get the handles \c *handle,
+ * \c *handle + 1, ..., and \c *handle is set to the next free handle.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occured.
+ */
+int
+dxf_3dface_write_batch
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        size_t count,
+                /*!< number of faces. */
+        const double *corner0,
+                /*!< first corners. */
+        const double *corner1,
+                /*!< second corners. */
+        const double *corner2,
+                /*!< third corners. */
+        const double *corner3,
+                /*!< fourth corners, or \c NULL for triangles. */
+        const char *layer,
+                /*!< layer of all entities. */
+        int color,
+                /*!< color of all entities. */
+        int *handle
+                /*!< next free handle, or \c NULL to write the entities
+                 * without a handle. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_3dface_write_batch () function.\n",
+                __FILE__, __LINE__);
+#endif
+        const double *corners[4];
+        size_t i;
+        int j;
+
+        if (!layer || (strcmp (layer, "") == 0))
+        {
+                fprintf (stderr, "Warning in dxf_3dface_write_batch () empty layer string for the 3DFACE entities.\n");
+                fprintf (stderr, "    3DFACE entities are relocated to layer 0\n");
+                layer = DXF_DEFAULT_LAYER;
+        }
+        for (i = 0; i < count; i++)
+        {
+                corners[0] = corner0 + 3 * i;
+                corners[1] = corner1 + 3 * i;
+                corners[2] = corner2 + 3 * i;
+                corners[3] = corner3 ? corner3 + 3 * i : corners[2];
+                dxf_write_group_string (fp, 0, "3DFACE");
+                if (handle)
+                {
+                        dxf_write_group_hex (fp, 5, (*handle)++);
+                }
+                dxf_write_group_string (fp, 8, layer);
+                for (j = 0; j < 4; j++)
+                {
+                        dxf_write_group_double (fp, 10 + j, corners[j][0]);
+                        dxf_write_group_double (fp, 20 + j, corners[j][1]);
+                        dxf_write_group_double (fp, 30 + j, corners[j][2]);
+                }
+                if (color != DXF_COLOR_BYLAYER)
+                {
+                        dxf_write_group_int (fp, 62, color);
+                }
+        }
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_3dface_write_batch () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (fp->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
 /* EOF */
@@ -96,23 +96,36 @@ dxf_3dface
 Dxf3dface *
 dxf_3dface_new ();
 Dxf3dface *
+dxf_3dface_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_3dface_free
+(
+        Dxf3dface *dxf_3dface
+);
+Dxf3dface *
 dxf_3dface_init
 (
         Dxf3dface *dxf_3dface
 );
+Dxf3dface *
+dxf_3dface_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_3dface_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         Dxf3dface *dxf_3dface,
         int acad_version_number
 );
 int
 dxf_3dface_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *linetype,
         char *layer,
@@ -136,9 +149,22 @@ dxf_3dface_write_lowlevel
 int
 dxf_3dface_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         Dxf3dface dxf_3dface
 );
+int
+dxf_3dface_write_batch
+(
+        DxfWriter *fp,
+        size_t count,
+        const double *corner0,
+        const double *corner1,
+        const double *corner2,
+        const double *corner3,
+        const char *layer,
+        int color,
+        int *handle
+);
 
 
 #endif /* _3DFACE_H */
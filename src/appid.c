@@ -37,12 +37,25 @@
 
 
 #include "appid.h"
+#include "arena.h"
+#include "pool.h"
+#include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_appid_new are handed out by.
+ */
+static DxfPool dxf_appid_pool = DXF_POOL_INITIALIZER (sizeof (DxfAppid));
 
 
 /*!
  * \brief Allocate memory for a \c DxfAppid.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_appid_free.
  */
 DxfAppid *
 dxf_appid_new ()
@@ -52,28 +65,88 @@ dxf_appid_new ()
                 __FILE__, __LINE__);
 #endif
         DxfAppid *dxf_appid = NULL;
-        size_t size;
 
-        size = sizeof (DxfAppid);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_appid = malloc (size)) == NULL)
+        if ((dxf_appid = dxf_pool_alloc (&dxf_appid_pool)) == NULL)
         {
                 fprintf (stderr, "ERROR in dxf_appid_new () could not allocate memory for a DxfAppid struct.\n");
-                dxf_appid = NULL;
         }
-        else
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_appid_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_appid);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfAppid from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_appid_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfAppid *
+dxf_appid_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_appid_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfAppid *dxf_appid = NULL;
+
+        if (arena == NULL)
+        {
+                dxf_appid = dxf_appid_new ();
+        }
+        else if ((dxf_appid = dxf_arena_alloc (arena, sizeof (DxfAppid))) == NULL)
         {
-                memset (dxf_appid, 0, size);
+                fprintf (stderr, "ERROR in dxf_appid_new_arena () could not allocate memory for a DxfAppid struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_appid_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_appid_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_appid);
 }
 
 
+/*!
+ * \brief Release a \c DxfAppid allocated by \c dxf_appid_new to its pool.
+ *
+ * \c application_name, allocated with \c malloc by \c dxf_appid_init or
+ * \c dxf_appid_read, is freed as well.\n
+ * Not for a \c DxfAppid allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_appid_free
+(
+        DxfAppid *dxf_appid
+                /*!< DXF appid entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_appid_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        if (dxf_appid)
+        {
+                free (dxf_appid->application_name);
+        }
+        dxf_pool_release (&dxf_appid_pool, dxf_appid);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_appid_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in a \c APPID
  * entity.
@@ -92,23 +165,65 @@ dxf_appid_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_appid_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        dxf_appid = dxf_appid_new ();
+        dxf_appid = dxf_appid_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_appid_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_appid);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in a \c APPID
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_appid_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfAppid *
+dxf_appid_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_appid_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfAppid *dxf_appid = NULL;
+        dxf_appid = dxf_appid_new_arena (arena);
         if (dxf_appid == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_appid_init () could not allocate memory for a DxfAppid struct.\n");
+              fprintf (stderr, "ERROR in dxf_appid_init_arena () could not allocate memory for a DxfAppid struct.\n");
               return (NULL);
         }
         dxf_appid->id_code = 0;
-        dxf_appid->application_name = strdup ("");
+        dxf_appid->application_name = dxf_arena_strdup (arena, "");
         dxf_appid->standard_flag = 0;
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_appid_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_appid_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_appid);
 }
 
 
+/*!
+ * \brief Schema of the \c APPID entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_appid_schema[DXF_SCHEMA_SIZE] =
+{
+        [2] = DXF_SCHEMA_FIELD (DXF_FIELD_STRING, DxfAppid, application_name),
+        [5] = DXF_SCHEMA_FIELD (DXF_FIELD_HEX, DxfAppid, id_code),
+        [70] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfAppid, standard_flag),
+        [999] = DXF_SCHEMA_TYPE (DXF_FIELD_COMMENT)
+};
+
+
 /*!
  * \brief Read data from a DXF file into an \c APPID entity.
  *
@@ -116,7 +231,8 @@ dxf_appid_init
  * Now follows some data for the \c ARC, to be terminated with a "  0"
  * string announcing the following entity, or the end of the \c ENTITY
  * section marker \c ENDSEC. \n
- * While parsing the DXF file store data in \c dxf_appid. \n
+ * While parsing the DXF file store data in \c dxf_appid, the group
+ * codes are decoded through \c dxf_appid_schema. \n
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -124,12 +240,8 @@ dxf_appid_init
 int
 dxf_appid_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         DxfAppid *dxf_appid,
                 /*!< DXF appid entity. */
         int acad_version_number
@@ -140,62 +252,19 @@ dxf_appid_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_appid_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
         if (!dxf_appid)
         {
                 dxf_appid = dxf_appid_new ();
         }
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_appid_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (EXIT_FAILURE);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (*line_number)++;
-                        fscanf (fp, "%x\n", &dxf_appid->id_code);
-                }
-                else if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_appid->application_name);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * standard flag value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_appid->standard_flag);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning: in dxf_appid_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_appid_schema, dxf_appid, NULL,
+                "APPID", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_appid_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -205,8 +274,8 @@ dxf_appid_read
 static int
 dxf_appid_write_lowlevel
 (
-        FILE *fp,
-                /*!< File pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int acad_version_number,
                 /*!< AutoCAD version number. */
         int id_code,
@@ -245,13 +314,13 @@ dxf_appid_write_lowlevel
                 fprintf (stderr, "    %s entity is relocated to default layer.\n",
                         dxf_entity_name);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
-        fprintf (fp, "  2\n%s\n", application_name);
-        fprintf (fp, " 70\n%d\n", standard_flag);
+        dxf_write_group_string (fp, 2, application_name);
+        dxf_write_group_int (fp, 70, standard_flag);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_appid_write_lowlevel () function.\n",
                 __FILE__, __LINE__);
@@ -266,8 +335,8 @@ dxf_appid_write_lowlevel
 int
 dxf_appid_write
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfAppid dxf_appid
                 /*!< DXF appid entity. */
 )
@@ -285,13 +354,13 @@ dxf_appid_write
                         dxf_entity_name);
                 return (EXIT_FAILURE);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (dxf_appid.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_appid.id_code);
+                dxf_write_group_hex (fp, 5, dxf_appid.id_code);
         }
-        fprintf (fp, "  2\n%s\n", dxf_appid.application_name);
-        fprintf (fp, " 70\n%d\n", dxf_appid.standard_flag);
+        dxf_write_group_string (fp, 2, dxf_appid.application_name);
+        dxf_write_group_int (fp, 70, dxf_appid.standard_flag);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_appid_write () function.\n",
                 __FILE__, __LINE__);
@@ -79,32 +79,36 @@ dxf_appid
 DxfAppid *
 dxf_appid_new ();
 DxfAppid *
+dxf_appid_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_appid_free
+(
+        DxfAppid *dxf_appid
+);
+DxfAppid *
 dxf_appid_init
 (
         DxfAppid *dxf_appid
 );
+DxfAppid *
+dxf_appid_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_appid_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfAppid *dxf_appid,
         int acad_version_number
 );
-static int
-dxf_appid_write_lowlevel
-(
-        FILE *fp,
-        int acad_version_number,
-        int id_code,
-        char *application_name,
-        int standard_flag
-);
 int
 dxf_appid_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfAppid dxf_appid
 );
 
@@ -31,12 +31,25 @@
 
 
 #include "arc.h"
+#include "arena.h"
+#include "pool.h"
+#include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_arc_new are handed out by.
+ */
+static DxfPool dxf_arc_pool = DXF_POOL_INITIALIZER (sizeof (DxfArc));
 
 
 /*!
  * \brief Allocate memory for a \c DxfArc.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_arc_free.
  */
 DxfArc *
 dxf_arc_new ()
@@ -46,31 +59,91 @@ dxf_arc_new ()
                 __FILE__, __LINE__);
 #endif
         DxfArc *dxf_arc = NULL;
-        size_t size;
 
-        size = sizeof (DxfArc);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_arc = malloc (size)) == NULL)
+        if ((dxf_arc = dxf_pool_alloc (&dxf_arc_pool)) == NULL)
         {
                 fprintf (stderr, "ERROR in dxf_arc_new () could not allocate memory for a DxfArc struct.\n");
-                dxf_arc = NULL;
         }
-        else
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_arc_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_arc);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfArc from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_arc_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfArc *
+dxf_arc_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_arc_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfArc *dxf_arc = NULL;
+
+        if (arena == NULL)
+        {
+                dxf_arc = dxf_arc_new ();
+        }
+        else if ((dxf_arc = dxf_arena_alloc (arena, sizeof (DxfArc))) == NULL)
         {
-                memset (dxf_arc, 0, size);
+                fprintf (stderr, "ERROR in dxf_arc_new_arena () could not allocate memory for a DxfArc struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_arc_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_arc_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_arc);
 }
 
 
+/*!
+ * \brief Release a \c DxfArc allocated by \c dxf_arc_new to its pool.
+ *
+ * The struct has no strings of its own, the layer and linetype are
+ * interned (see \c dxf_arena_intern).\n
+ * Not for a \c DxfArc allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_arc_free
+(
+        DxfArc *dxf_arc
+                /*!< DXF arc entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_arc_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        dxf_pool_release (&dxf_arc_pool, dxf_arc);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_arc_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in a \c ARC entity.
  * 
+ * The layer and linetype are interned in the names shared by the
+ * entities without an arena (see \c dxf_intern_shared), they stay
+ * valid until \c dxf_intern_shared_free.
+ *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
  */
@@ -85,15 +158,45 @@ dxf_arc_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_arc_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        dxf_arc = dxf_arc_new ();
+        dxf_arc = dxf_arc_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_arc_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_arc);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in a \c ARC entity.
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_arc_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfArc *
+dxf_arc_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_arc_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfArc *dxf_arc = NULL;
+        dxf_arc = dxf_arc_new_arena (arena);
         if (dxf_arc == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_arc_init () could not allocate memory for a DxfArc struct.\n");
+              fprintf (stderr, "ERROR in dxf_arc_init_arena () could not allocate memory for a DxfArc struct.\n");
               return (NULL);
         }
         dxf_arc->common.id_code = 0;
-        dxf_arc->common.linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dxf_arc->common.layer = strdup (DXF_DEFAULT_LAYER);
+        dxf_arc->common.linetype = dxf_arena_intern (arena, DXF_DEFAULT_LINETYPE);
+        dxf_arc->common.layer = dxf_arena_intern (arena, DXF_DEFAULT_LAYER);
         dxf_arc->x0 = 0.0;
         dxf_arc->y0 = 0.0;
         dxf_arc->z0 = 0.0;
@@ -108,13 +211,32 @@ dxf_arc_init
         dxf_arc->common.paperspace = DXF_MODELSPACE;
         dxf_arc->common.acad_version_number = 0;
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_arc_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_arc_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_arc);
 }
 
 
+/*!
+ * \brief Schema of the \c ARC entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_arc_schema[DXF_SCHEMA_SIZE] =
+{
+        DXF_SCHEMA_ENTITY_COMMON (DxfArc),
+        [10] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfArc, x0),
+        [20] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfArc, y0),
+        [30] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfArc, z0),
+        [38] = DXF_SCHEMA_FIELD (DXF_FIELD_ELEVATION, DxfArc, z0),
+        [40] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfArc, radius),
+        [50] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfArc, start_angle),
+        [51] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfArc, end_angle),
+        [210] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfArc, extr_x0),
+        [220] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfArc, extr_y0),
+        [230] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfArc, extr_z0)
+};
+
+
 /*!
  * \brief Read data from a DXF file into an \c ARC entity.
  *
@@ -122,7 +244,8 @@ dxf_arc_init
  * Now follows some data for the \c ARC, to be terminated with a "  0"
  * string announcing the following entity, or the end of the \c ENTITY
  * section marker \c ENDSEC. \n
- * While parsing the DXF file store data in \c dxf_arc. \n
+ * While parsing the DXF file store data in \c dxf_arc, the group
+ * codes are decoded through \c dxf_arc_schema. \n
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -130,12 +253,8 @@ dxf_arc_init
 int
 dxf_arc_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         DxfArc *dxf_arc,
                 /*!< DXF arc entity. */
         int acad_version_number
@@ -146,168 +265,19 @@ dxf_arc_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_arc_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
         if (!dxf_arc)
         {
                 dxf_arc = dxf_arc_new ();
         }
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_arc_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (EXIT_FAILURE);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (*line_number)++;
-                        fscanf (fp, "%x\n", &dxf_arc->common.id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_arc->common.linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_arc->common.layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_arc->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_arc->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_arc->z0);
-                }
-                else if ((acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (dxf_arc->z0 = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_arc->z0);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_arc->common.thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * radius. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_arc->radius);
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing the
-                         * start angle. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_arc->start_angle);
-                }
-                else if (strcmp (temp_string, "51") == 0)
-                {
-                        /* Now follows a string containing the
-                         * end angle. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_arc->end_angle);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_arc->common.color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_arc->common.paperspace);
-                }
-                else if ((acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_arc->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_arc->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_arc->extr_z0);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning: in dxf_arc_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_arc_schema, dxf_arc, NULL,
+                "ARC", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_arc_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -320,8 +290,8 @@ dxf_arc_read
 int
 dxf_arc_write_lowlevel
 (
-        FILE *fp,
-                /*!< File pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< Identification number for the entity.\n
                  * this is to be an unique (sequential) number in the DXF
@@ -441,47 +411,47 @@ dxf_arc_write_lowlevel
                         dxf_entity_name);
                 layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (acad_version_number >= AutoCAD_14)
         {
-                fprintf (fp, "100\nAcDbCircle\n");
+                dxf_write_group_string (fp, 100, "AcDbCircle");
         }
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
         if (acad_version_number >= AutoCAD_12)
         {
-                fprintf (fp, "210\n%f\n", extr_x0);
-                fprintf (fp, "220\n%f\n", extr_y0);
-                fprintf (fp, "230\n%f\n", extr_z0);
+                dxf_write_group_double (fp, 210, extr_x0);
+                dxf_write_group_double (fp, 220, extr_y0);
+                dxf_write_group_double (fp, 230, extr_z0);
         }
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
-        fprintf (fp, " 40\n%f\n", radius);
+        dxf_write_group_double (fp, 40, radius);
         if (acad_version_number >= AutoCAD_14)
         {
-                fprintf (fp, "100\nAcDbArc\n");
+                dxf_write_group_string (fp, 100, "AcDbArc");
         }
-        fprintf (fp, " 50\n%f\n", start_angle);
-        fprintf (fp, " 51\n%f\n", end_angle);
+        dxf_write_group_double (fp, 50, start_angle);
+        dxf_write_group_double (fp, 51, end_angle);
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
         if (paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_arc_write_lowlevel () function.\n",
@@ -500,8 +470,8 @@ dxf_arc_write_lowlevel
 int
 dxf_arc_write
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfArc dxf_arc
                 /*!< DXF arc entity. */
 )
@@ -573,43 +543,43 @@ dxf_arc_write
                         dxf_entity_name);
                 dxf_arc.common.layer = DXF_DEFAULT_LAYER;
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (dxf_arc.common.acad_version_number >= AutoCAD_14)
         {
-                fprintf (fp, "100\nAcDbArc\n");
+                dxf_write_group_string (fp, 100, "AcDbArc");
         }
         if (dxf_arc.common.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_arc.common.id_code);
+                dxf_write_group_hex (fp, 5, dxf_arc.common.id_code);
         }
         if (strcmp (dxf_arc.common.linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", dxf_arc.common.linetype);
+                dxf_write_group_string (fp, 6, dxf_arc.common.linetype);
         }
-        fprintf (fp, "  8\n%s\n", dxf_arc.common.layer);
-        fprintf (fp, " 10\n%f\n", dxf_arc.x0);
-        fprintf (fp, " 20\n%f\n", dxf_arc.y0);
-        fprintf (fp, " 30\n%f\n", dxf_arc.z0);
+        dxf_write_group_string (fp, 8, dxf_arc.common.layer);
+        dxf_write_group_double (fp, 10, dxf_arc.x0);
+        dxf_write_group_double (fp, 20, dxf_arc.y0);
+        dxf_write_group_double (fp, 30, dxf_arc.z0);
         if (dxf_arc.common.acad_version_number >= AutoCAD_12)
         {
-                fprintf (fp, "210\n%f\n", dxf_arc.extr_x0);
-                fprintf (fp, "220\n%f\n", dxf_arc.extr_y0);
-                fprintf (fp, "230\n%f\n", dxf_arc.extr_z0);
+                dxf_write_group_double (fp, 210, dxf_arc.extr_x0);
+                dxf_write_group_double (fp, 220, dxf_arc.extr_y0);
+                dxf_write_group_double (fp, 230, dxf_arc.extr_z0);
         }
         if (dxf_arc.common.thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", dxf_arc.common.thickness);
+                dxf_write_group_double (fp, 39, dxf_arc.common.thickness);
         }
-        fprintf (fp, " 40\n%f\n", dxf_arc.radius);
-        fprintf (fp, " 50\n%f\n", dxf_arc.start_angle);
-        fprintf (fp, " 51\n%f\n", dxf_arc.end_angle);
+        dxf_write_group_double (fp, 40, dxf_arc.radius);
+        dxf_write_group_double (fp, 50, dxf_arc.start_angle);
+        dxf_write_group_double (fp, 51, dxf_arc.end_angle);
         if (dxf_arc.common.color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", dxf_arc.common.color);
+                dxf_write_group_int (fp, 62, dxf_arc.common.color);
         }
         if (dxf_arc.common.paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_arc_write () function.\n",
@@ -619,4 +589,97 @@ dxf_arc_write
 }
 
 
+/*!
+ * \brief Write DXF output to fp for a batch of arc entities, given as
+ * arrays of centers, radii and angles.
+ *
+ * All arcs are written with the same layer and color, with the default
+ * linetype, no thickness and the default extrusion direction.\n
+ * \c z0 can be \c NULL for arcs in the XY-plane.\n
+ * When \c handle is not \c NULL the arcs get the handles \c *handle,
+ * \c *handle + 1, ..., and \c *handle is set to the next free handle.\n
+ * Arcs with a radius of 0.0, identical angles or angles outside of 0 to
+ * 360 degrees are skipped, as by \c dxf_arc_write.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an arc was
+ * skipped or an error occured.
+ */
+int
+dxf_arc_write_batch
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        size_t count,
+                /*!< number of arcs. */
+        const double *x0,
+                /*!< X-values of the centers. */
+        const double *y0,
+                /*!< Y-values of the centers. */
+        const double *z0,
+                /*!< Z-values of the centers, or \c NULL. */
+        const double *radius,
+                /*!< radii. */
+        const double *start_angle,
+                /*!< start angles, in degrees. */
+        const double *end_angle,
+                /*!< end angles, in degrees. */
+        const char *layer,
+                /*!< layer of all entities. */
+        int color,
+                /*!< color of all entities. */
+        int *handle
+                /*!< next free handle, or \c NULL to write the entities
+                 * without a handle. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_arc_write_batch () function.\n",
+                __FILE__, __LINE__);
+#endif
+        int ret = EXIT_SUCCESS;
+        size_t i;
+
+        if (!layer || (strcmp (layer, "") == 0))
+        {
+                fprintf (stderr, "Warning in dxf_arc_write_batch () empty layer string for the ARC entities.\n");
+                fprintf (stderr, "    ARC entities are relocated to layer 0\n");
+                layer = DXF_DEFAULT_LAYER;
+        }
+        for (i = 0; i < count; i++)
+        {
+                if ((radius[i] == 0.0)
+                        || (start_angle[i] == end_angle[i])
+                        || (start_angle[i] < 0.0) || (start_angle[i] > 360.0)
+                        || (end_angle[i] < 0.0) || (end_angle[i] > 360.0))
+                {
+                        fprintf (stderr, "Error in dxf_arc_write_batch () invalid radius or angles for ARC entity %lu, skipping it.\n",
+                                (unsigned long) i);
+                        ret = EXIT_FAILURE;
+                        continue;
+                }
+                dxf_write_group_string (fp, 0, "ARC");
+                if (handle)
+                {
+                        dxf_write_group_hex (fp, 5, (*handle)++);
+                }
+                dxf_write_group_string (fp, 8, layer);
+                dxf_write_group_double (fp, 10, x0[i]);
+                dxf_write_group_double (fp, 20, y0[i]);
+                dxf_write_group_double (fp, 30, z0 ? z0[i] : 0.0);
+                dxf_write_group_double (fp, 40, radius[i]);
+                dxf_write_group_double (fp, 50, start_angle[i]);
+                dxf_write_group_double (fp, 51, end_angle[i]);
+                if (color != DXF_COLOR_BYLAYER)
+                {
+                        dxf_write_group_int (fp, 62, color);
+                }
+        }
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_arc_write_batch () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (fp->failed ? EXIT_FAILURE : ret);
+}
+
+
 /* EOF*/
@@ -83,23 +83,36 @@ dxf_arc
 DxfArc *
 dxf_arc_new ();
 DxfArc *
+dxf_arc_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_arc_free
+(
+        DxfArc *dxf_arc
+);
+DxfArc *
 dxf_arc_init
 (
         DxfArc *dxf_arc
 );
+DxfArc *
+dxf_arc_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_arc_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfArc *dxf_arc,
         int acad_version_number
 );
 int
 dxf_arc_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *linetype,
         char *layer,
@@ -120,8 +133,23 @@ dxf_arc_write_lowlevel
 int
 dxf_arc_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfArc dxf_arc);
+int
+dxf_arc_write_batch
+(
+        DxfWriter *fp,
+        size_t count,
+        const double *x0,
+        const double *y0,
+        const double *z0,
+        const double *radius,
+        const double *start_angle,
+        const double *end_angle,
+        const char *layer,
+        int color,
+        int *handle
+);
 
 
 #endif /* _ARC_H */
@@ -0,0 +1,373 @@
+/*!
+ * \file arena.c
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Functions for an arena for the entities and strings of a document.
+ *
+ * Memory is handed out from large chunks by moving a pointer, nothing is
+ * freed on its own: all entities, strings and vertices of a document are
+ * freed together by freeing the chunks.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#include "arena.h"
+#include "intern.h"
+
+
+/*!
+ * \brief Alignment of the memory handed out by an arena.
+ */
+#define DXF_ARENA_ALIGNMENT 16
+
+/*!
+ * \brief Size of the header of a chunk, the bytes of the chunk start
+ * aligned after the header.
+ */
+#define DXF_ARENA_HEADER \
+        ((sizeof (DxfArenaChunk) + DXF_ARENA_ALIGNMENT - 1) & ~((size_t) DXF_ARENA_ALIGNMENT - 1))
+
+
+/*!
+ * \brief Allocates an arena.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the arena
+ * when succesful.
+ */
+DxfArena *
+dxf_arena_new
+(
+        size_t chunk_size
+                /*!< size of a chunk, 0 for \c DXF_ARENA_CHUNK_SIZE. */
+)
+{
+        DxfArena *arena;
+
+        arena = malloc (sizeof (DxfArena));
+        if (!arena)
+        {
+                fprintf (stderr, "Error in dxf_arena_new () could not allocate memory for a DxfArena struct.\n");
+                return (NULL);
+        }
+        arena->chunks = NULL;
+        arena->chunk_size = (chunk_size > 0) ? chunk_size : DXF_ARENA_CHUNK_SIZE;
+        arena->allocated = 0;
+        arena->names = NULL;
+        arena->shared_names = FALSE;
+        return (arena);
+}
+
+
+/*!
+ * \brief Hands out \c size bytes of memory, filled with zeros.
+ *
+ * A request larger than a quarter of a chunk gets a chunk of its own, so
+ * the free space of the current chunk is not wasted.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the memory
+ * when succesful.
+ */
+void *
+dxf_arena_alloc
+(
+        DxfArena *arena,
+                /*!< the arena. */
+        size_t size
+                /*!< number of bytes. */
+)
+{
+        DxfArenaChunk *chunk = arena->chunks;
+        size_t chunk_size;
+        char *memory;
+
+        size = (size + DXF_ARENA_ALIGNMENT - 1) & ~((size_t) DXF_ARENA_ALIGNMENT - 1);
+        if (!chunk || (chunk->size - chunk->used < size))
+        {
+                chunk_size = (size > arena->chunk_size / 4) ? size : arena->chunk_size;
+                chunk = malloc (DXF_ARENA_HEADER + chunk_size);
+                if (!chunk)
+                {
+                        fprintf (stderr, "Error in dxf_arena_alloc () could not allocate memory for a chunk.\n");
+                        return (NULL);
+                }
+                chunk->size = chunk_size;
+                chunk->used = 0;
+                arena->allocated += DXF_ARENA_HEADER + chunk_size;
+                if (arena->chunks && (chunk_size == size))
+                {
+                        /* Keep handing out from the current chunk. */
+                        chunk->next = arena->chunks->next;
+                        arena->chunks->next = chunk;
+                }
+                else
+                {
+                        chunk->next = arena->chunks;
+                        arena->chunks = chunk;
+                }
+        }
+        memory = (char *) chunk + DXF_ARENA_HEADER + chunk->used;
+        chunk->used += size;
+        memset (memory, 0, size);
+        return (memory);
+}
+
+
+/*!
+ * \brief Copies \c length characters of a string into an arena.
+ *
+ * Without an arena the copy is allocated with \c malloc.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the string,
+ * terminated with a '\\0', when succesful.
+ */
+char *
+dxf_arena_strndup
+(
+        DxfArena *arena,
+                /*!< the arena, or \c NULL. */
+        const char *string,
+                /*!< the string. */
+        size_t length
+                /*!< number of characters to copy. */
+)
+{
+        char *copy;
+
+        copy = arena ? dxf_arena_alloc (arena, length + 1) : malloc (length + 1);
+        if (!copy)
+                return (NULL);
+        memcpy (copy, string, length);
+        copy[length] = '\0';
+        return (copy);
+}
+
+
+/*!
+ * \brief Copies a string into an arena, like \c strdup.
+ *
+ * Without an arena the copy is allocated with \c strdup.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the string
+ * when succesful.
+ */
+char *
+dxf_arena_strdup
+(
+        DxfArena *arena,
+                /*!< the arena, or \c NULL. */
+        const char *string
+                /*!< the string. */
+)
+{
+        if (!arena)
+                return (strdup (string));
+        return (dxf_arena_strndup (arena, string, strlen (string)));
+}
+
+
+/*!
+ * \brief Gives the table of names interned for the entities in an arena,
+ * the table is created by the first call.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the table
+ * when succesful.
+ */
+DxfIntern *
+dxf_arena_names
+(
+        DxfArena *arena
+                /*!< the arena. */
+)
+{
+        if (!arena->names)
+                arena->names = dxf_intern_new ();
+        return (arena->names);
+}
+
+
+/*!
+ * \brief Interns \c length characters of a string in the names of an
+ * arena (see \c dxf_intern_string).
+ *
+ * Used for the names of layers, linetypes, text styles and blocks: the
+ * entities in an arena with the same name share one string, and two
+ * names are the same when their pointers are the same.\n
+ * Without an arena the string is interned in the names shared by all
+ * entities without an arena (see \c dxf_intern_shared), it must not be
+ * freed either and stays valid until \c dxf_intern_shared_free.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the string
+ * when succesful.
+ */
+char *
+dxf_arena_internn
+(
+        DxfArena *arena,
+                /*!< the arena, or \c NULL. */
+        const char *string,
+                /*!< the string. */
+        size_t length
+                /*!< number of characters to intern. */
+)
+{
+        DxfIntern *names;
+
+        names = arena ? dxf_arena_names (arena) : dxf_intern_shared ();
+        if (!names)
+                return (NULL);
+        return (dxf_intern_string (names, string, length));
+}
+
+
+/*!
+ * \brief Interns a string in the names of an arena (see
+ * \c dxf_arena_internn).
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the string
+ * when succesful.
+ */
+char *
+dxf_arena_intern
+(
+        DxfArena *arena,
+                /*!< the arena, or \c NULL. */
+        const char *string
+                /*!< the string. */
+)
+{
+        return (dxf_arena_internn (arena, string, strlen (string)));
+}
+
+
+/*!
+ * \brief Lets \c other intern its names in the names of \c arena.
+ *
+ * Called before the arenas are handed to other threads, so the names
+ * interned by all threads are the same pointers.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * was allocated.
+ */
+int
+dxf_arena_share_names
+(
+        DxfArena *arena,
+                /*!< the arena owning the names. */
+        DxfArena *other
+                /*!< the arena sharing the names. */
+)
+{
+        if (!dxf_arena_names (arena))
+                return (EXIT_FAILURE);
+        other->names = arena->names;
+        other->shared_names = TRUE;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Moves the chunks of \c other into \c arena and frees \c other.
+ *
+ * Used to collect the arenas filled by several threads into the arena
+ * of the document. The names of \c other stay valid when it shares the
+ * names of another arena (see \c dxf_arena_share_names), or when
+ * \c arena has no names yet and takes over the table of \c other.\n
+ * Two tables cannot be merged without renumbering the names, and the
+ * bits and indices of a \c DxfViewport or a \c DxfEntityHeaders refer
+ * to the table they were made with: when both arenas have names of their
+ * own nothing is moved. Indices into one table never refer to another
+ * one after an adoption.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when both
+ * arenas have names of their own, \c other is then left as it was.
+ */
+int
+dxf_arena_adopt
+(
+        DxfArena *arena,
+                /*!< the arena receiving the chunks. */
+        DxfArena *other
+                /*!< the arena giving the chunks. */
+)
+{
+        DxfArenaChunk *last;
+
+        if (!other)
+                return (EXIT_SUCCESS);
+        if (other->names && !other->shared_names && arena->names
+                && (arena->names != other->names))
+        {
+                fprintf (stderr, "Error in dxf_arena_adopt () both arenas have names of their own.\n");
+                return (EXIT_FAILURE);
+        }
+        if (other->chunks)
+        {
+                /* The chunks of other go behind the current chunk. */
+                for (last = other->chunks; last->next; last = last->next)
+                        ;
+                if (arena->chunks)
+                {
+                        last->next = arena->chunks->next;
+                        arena->chunks->next = other->chunks;
+                }
+                else
+                        arena->chunks = other->chunks;
+                arena->allocated += other->allocated;
+        }
+        if (other->names && !other->shared_names)
+                arena->names = other->names;
+        free (other);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Frees an arena with all memory handed out by it.
+ */
+void
+dxf_arena_free
+(
+        DxfArena *arena
+                /*!< the arena. */
+)
+{
+        DxfArenaChunk *chunk;
+
+        if (!arena)
+                return;
+        while (arena->chunks)
+        {
+                chunk = arena->chunks;
+                arena->chunks = chunk->next;
+                free (chunk);
+        }
+        if (!arena->shared_names)
+                dxf_intern_free (arena->names);
+        free (arena);
+}
+
+
+/* EOF */
@@ -0,0 +1,104 @@
+/*!
+ * \file arena.h
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Definition of an arena for the entities and strings of a document.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifndef ARENA_H
+#define ARENA_H
+
+
+#include "global.h"
+
+
+DxfArena *
+dxf_arena_new
+(
+        size_t chunk_size
+);
+void *
+dxf_arena_alloc
+(
+        DxfArena *arena,
+        size_t size
+);
+char *
+dxf_arena_strndup
+(
+        DxfArena *arena,
+        const char *string,
+        size_t length
+);
+char *
+dxf_arena_strdup
+(
+        DxfArena *arena,
+        const char *string
+);
+DxfIntern *
+dxf_arena_names
+(
+        DxfArena *arena
+);
+char *
+dxf_arena_internn
+(
+        DxfArena *arena,
+        const char *string,
+        size_t length
+);
+char *
+dxf_arena_intern
+(
+        DxfArena *arena,
+        const char *string
+);
+int
+dxf_arena_share_names
+(
+        DxfArena *arena,
+        DxfArena *other
+);
+int
+dxf_arena_adopt
+(
+        DxfArena *arena,
+        DxfArena *other
+);
+void
+dxf_arena_free
+(
+        DxfArena *arena
+);
+
+
+#endif /* ARENA_H */
+
+
+/* EOF */
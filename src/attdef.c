@@ -31,12 +31,25 @@
 
 
 #include "attdef.h"
+#include "arena.h"
+#include "pool.h"
+#include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_attdef_new are handed out by.
+ */
+static DxfPool dxf_attdef_pool = DXF_POOL_INITIALIZER (sizeof (DxfAttdef));
 
 
 /*!
  * \brief Allocate memory for a \c DxfAttdef.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_attdef_free.
  */
 DxfAttdef *
 dxf_attdef_new ()
@@ -46,31 +59,100 @@ dxf_attdef_new ()
                 __FILE__, __LINE__);
 #endif
         DxfAttdef *dxf_attdef = NULL;
-        size_t size;
 
-        size = sizeof (DxfAttdef);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_attdef = malloc (size)) == NULL)
+        if ((dxf_attdef = dxf_pool_alloc (&dxf_attdef_pool)) == NULL)
         {
                 fprintf (stderr, "ERROR in dxf_attdef_new () could not allocate memory for a DxfAttdef struct.\n");
-                dxf_attdef = NULL;
         }
-        else
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_attdef_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_attdef);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfAttdef from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_attdef_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfAttdef *
+dxf_attdef_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_attdef_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfAttdef *dxf_attdef = NULL;
+
+        if (arena == NULL)
+        {
+                dxf_attdef = dxf_attdef_new ();
+        }
+        else if ((dxf_attdef = dxf_arena_alloc (arena, sizeof (DxfAttdef))) == NULL)
         {
-                memset (dxf_attdef, 0, size);
+                fprintf (stderr, "ERROR in dxf_attdef_new_arena () could not allocate memory for a DxfAttdef struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_attdef_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_attdef_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_attdef);
 }
 
 
+/*!
+ * \brief Release a \c DxfAttdef allocated by \c dxf_attdef_new to its pool.
+ *
+ * \c default_value, \c tag_value and \c prompt_value, allocated with
+ * \c malloc by \c dxf_attdef_init or \c dxf_attdef_read, are freed as
+ * well; the text style, layer and linetype are interned and are not
+ * (see \c dxf_arena_intern).\n
+ * Not for a \c DxfAttdef allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_attdef_free
+(
+        DxfAttdef *dxf_attdef
+                /*!< DXF attdef entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_attdef_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        if (dxf_attdef)
+        {
+                free (dxf_attdef->default_value);
+                free (dxf_attdef->tag_value);
+                free (dxf_attdef->prompt_value);
+        }
+        dxf_pool_release (&dxf_attdef_pool, dxf_attdef);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_attdef_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in a \c ATTDEF entity.
  * 
+ * The layer, linetype and text style are interned in the names
+ * shared by the entities without an arena (see
+ * \c dxf_intern_shared), they stay valid until
+ * \c dxf_intern_shared_free.
+ *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
  */
@@ -85,19 +167,49 @@ dxf_attdef_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_attdef_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        dxf_attdef = dxf_attdef_new ();
+        dxf_attdef = dxf_attdef_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_attdef_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_attdef);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in a \c ATTDEF entity.
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_attdef_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfAttdef *
+dxf_attdef_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_attdef_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfAttdef *dxf_attdef = NULL;
+        dxf_attdef = dxf_attdef_new_arena (arena);
         if (dxf_attdef == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_attdef_init () could not allocate memory for a DxfAttdef struct.\n");
+              fprintf (stderr, "ERROR in dxf_attdef_init_arena () could not allocate memory for a DxfAttdef struct.\n");
               return (NULL);
         }
-        dxf_attdef->default_value = strdup ("");
-        dxf_attdef->tag_value = strdup ("");
-        dxf_attdef->prompt_value = strdup ("");
+        dxf_attdef->default_value = dxf_arena_strdup (arena, "");
+        dxf_attdef->tag_value = dxf_arena_strdup (arena, "");
+        dxf_attdef->prompt_value = dxf_arena_strdup (arena, "");
         dxf_attdef->common.id_code = 0;
-        dxf_attdef->common.linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dxf_attdef->text_style = strdup (DXF_DEFAULT_TEXTSTYLE);
-        dxf_attdef->common.layer = strdup (DXF_DEFAULT_LAYER);
+        dxf_attdef->common.linetype = dxf_arena_intern (arena, DXF_DEFAULT_LINETYPE);
+        dxf_attdef->text_style = dxf_arena_intern (arena, DXF_DEFAULT_TEXTSTYLE);
+        dxf_attdef->common.layer = dxf_arena_intern (arena, DXF_DEFAULT_LAYER);
         dxf_attdef->x0 = 0.0;
         dxf_attdef->y0 = 0.0;
         dxf_attdef->z0 = 0.0;
@@ -121,13 +233,45 @@ dxf_attdef_init
         dxf_attdef->extr_z0 = 0.0;
         dxf_attdef->common.acad_version_number = 0;
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_attdef_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_attdef_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_attdef);
 }
 
 
+/*!
+ * \brief Schema of the \c ATTDEF entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_attdef_schema[DXF_SCHEMA_SIZE] =
+{
+        DXF_SCHEMA_ENTITY_COMMON (DxfAttdef),
+        [1] = DXF_SCHEMA_FIELD (DXF_FIELD_STRING, DxfAttdef, default_value),
+        [2] = DXF_SCHEMA_FIELD (DXF_FIELD_STRING, DxfAttdef, tag_value),
+        [3] = DXF_SCHEMA_FIELD (DXF_FIELD_STRING, DxfAttdef, prompt_value),
+        [7] = DXF_SCHEMA_FIELD (DXF_FIELD_NAME, DxfAttdef, text_style),
+        [10] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfAttdef, x0),
+        [11] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfAttdef, x1),
+        [20] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfAttdef, y0),
+        [21] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfAttdef, y1),
+        [30] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfAttdef, z0),
+        [31] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfAttdef, z1),
+        [38] = DXF_SCHEMA_FIELD (DXF_FIELD_ELEVATION, DxfAttdef, z0),
+        [40] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfAttdef, height),
+        [41] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfAttdef, rel_x_scale),
+        [50] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfAttdef, rot_angle),
+        [51] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfAttdef, obl_angle),
+        [70] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfAttdef, attr_flags),
+        [71] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfAttdef, text_flags),
+        [72] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfAttdef, hor_align),
+        [73] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfAttdef, field_length),
+        [74] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfAttdef, vert_align),
+        [210] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfAttdef, extr_x0),
+        [220] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfAttdef, extr_y0),
+        [230] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfAttdef, extr_z0)
+};
+
+
 /*!
  * \brief Read data from a DXF file into an \c ATTDEF entity.
  *
@@ -135,7 +279,8 @@ dxf_attdef_init
  * Now follows some data for the \c ATTDEF, to be terminated with a "  0"
  * string announcing the following entity, or the end of the \c ENTITY
  * section marker \c ENDSEC. \n
- * While parsing the DXF file store data in \c dxf_attdef. \n
+ * While parsing the DXF file store data in \c dxf_attdef, the group
+ * codes are decoded through \c dxf_attdef_schema. \n
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -143,12 +288,8 @@ dxf_attdef_init
 int
 dxf_attdef_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         DxfAttdef *dxf_attdef,
                 /*!< DXF attdef entity. */
         int acad_version_number
@@ -159,257 +300,19 @@ dxf_attdef_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_attdef_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
         if (!dxf_attdef)
         {
                 dxf_attdef = dxf_attdef_new ();
         }
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_attdef_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (EXIT_FAILURE);
-                }
-                if (strcmp (temp_string, "1") == 0)
-                {
-                        /* Now follows a string containing the attribute
-                         * default value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_attdef->default_value);
-                }
-                else if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a tag value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_attdef->tag_value);
-                }
-                else if (strcmp (temp_string, "3") == 0)
-                {
-                        /* Now follows a string containing a prompt
-                         * value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_attdef->prompt_value);
-                }
-                else if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (*line_number)++;
-                        fscanf (fp, "%x\n", &dxf_attdef->common.id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_attdef->common.linetype);
-                }
-                else if (strcmp (temp_string, "7") == 0)
-                {
-                        /* Now follows a string containing a text style. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_attdef->text_style);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_attdef->common.layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_attdef->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_attdef->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_attdef->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the align point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_attdef->x1);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the align point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_attdef->y1);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the align point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_attdef->z1);
-                }
-                else if ((acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (dxf_attdef->z0 = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_attdef->z0);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_attdef->common.thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * height. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_attdef->height);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * relative X-scale. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_attdef->rel_x_scale);
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing the
-                         * rotation angle. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_attdef->rot_angle);
-                }
-                else if (strcmp (temp_string, "51") == 0)
-                {
-                        /* Now follows a string containing the
-                         * end angle. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_attdef->obl_angle);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_attdef->common.color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_attdef->common.paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * attribute flags value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_attdef->attr_flags);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the
-                         * text flags value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_attdef->text_flags);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing the
-                         * horizontal alignment value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_attdef->hor_align);
-                }
-                else if (strcmp (temp_string, "73") == 0)
-                {
-                        /* Now follows a string containing the
-                         * field length value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_attdef->field_length);
-                }
-                else if (strcmp (temp_string, "74") == 0)
-                {
-                        /* Now follows a string containing the
-                         * vertical alignment value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_attdef->vert_align);
-                }
-                else if ((acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_attdef->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_attdef->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_attdef->extr_z0);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning: in dxf_attdef_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_attdef_schema, dxf_attdef, NULL,
+                "ATTDEF", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_attdef_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -419,8 +322,8 @@ dxf_attdef_read
 int
 dxf_attdef_write_lowlevel
 (
-        FILE *fp,
-                /*!< File pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< Identification number for the entity.\n
                  * this is to be an unique (sequential) number in the DXF
@@ -595,26 +498,26 @@ dxf_attdef_write_lowlevel
                         dxf_entity_name);
                 rel_x_scale = 1.0;
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
-        fprintf (fp, "  1\n%s\n", default_value);
-        fprintf (fp, "  2\n%s\n", tag_value);
-        fprintf (fp, "  3\n%s\n", prompt_value);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
+        dxf_write_group_string (fp, 1, default_value);
+        dxf_write_group_string (fp, 2, tag_value);
+        dxf_write_group_string (fp, 3, prompt_value);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, "BYLAYER") != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
         if (strcmp (text_style, "STANDARD") != 0)
         {
-                fprintf (fp, "  7\n%s\n", text_style);
+                dxf_write_group_string (fp, 7, text_style);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
         if ((hor_align != 0) || (vert_align != 0))
         {
                 if ((x0 == x1) && (y0 == y1) && (z0 == z1))
@@ -628,58 +531,58 @@ dxf_attdef_write_lowlevel
                 }
                 else
                 {
-                        fprintf (fp, " 11\n%f\n", x1);
-                        fprintf (fp, " 21\n%f\n", y1);
-                        fprintf (fp, " 31\n%f\n", z1);
+                        dxf_write_group_double (fp, 11, x1);
+                        dxf_write_group_double (fp, 21, y1);
+                        dxf_write_group_double (fp, 31, z1);
                 }
         }
         if (acad_version_number >= AutoCAD_12)
         {
-                fprintf (fp, "210\n%f\n", extr_x0);
-                fprintf (fp, "220\n%f\n", extr_y0);
-                fprintf (fp, "230\n%f\n", extr_z0);
+                dxf_write_group_double (fp, 210, extr_x0);
+                dxf_write_group_double (fp, 220, extr_y0);
+                dxf_write_group_double (fp, 230, extr_z0);
         }
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
-        fprintf (fp, " 40\n%f\n", height);
+        dxf_write_group_double (fp, 40, height);
         if (rel_x_scale != 1.0)
         {
-                fprintf (fp, " 41\n%f\n", rel_x_scale);
+                dxf_write_group_double (fp, 41, rel_x_scale);
         }
         if (rot_angle != 0.0)
         {
-                fprintf (fp, " 50\n%f\n", rot_angle);
+                dxf_write_group_double (fp, 50, rot_angle);
         }
         if (obl_angle != 0.0)
         {
-                fprintf (fp, " 51\n%f\n", obl_angle);
+                dxf_write_group_double (fp, 51, obl_angle);
         }
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
         if (paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp, " 70\n%d\n", attr_flags);
+        dxf_write_group_int (fp, 70, attr_flags);
         if (text_flags != 0)
         {
-                fprintf (fp, " 71\n%d\n", text_flags);
+                dxf_write_group_int (fp, 71, text_flags);
         }
         if (hor_align != 0)
         {
-                fprintf (fp, " 72\n%d\n", hor_align);
+                dxf_write_group_int (fp, 72, hor_align);
         }
         if (field_length != 0)
         {
-                fprintf (fp, " 73\n%d\n", field_length);
+                dxf_write_group_int (fp, 73, field_length);
         }
         if (vert_align != 0)
         {
-                fprintf (fp, " 74\n%d\n", vert_align);
+                dxf_write_group_int (fp, 74, vert_align);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_attdef_write_lowlevel () function.\n",
@@ -695,8 +598,8 @@ dxf_attdef_write_lowlevel
 int
 dxf_attdef_write
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfAttdef dxf_attdef
                 /*!< attribute definition entity. */
 )
@@ -744,26 +647,26 @@ dxf_attdef_write
                         dxf_entity_name);
                 dxf_attdef.rel_x_scale = 1.0;
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
-        fprintf (fp, "  1\n%s\n", dxf_attdef.default_value);
-        fprintf (fp, "  2\n%s\n", dxf_attdef.tag_value);
-        fprintf (fp, "  3\n%s\n", dxf_attdef.prompt_value);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
+        dxf_write_group_string (fp, 1, dxf_attdef.default_value);
+        dxf_write_group_string (fp, 2, dxf_attdef.tag_value);
+        dxf_write_group_string (fp, 3, dxf_attdef.prompt_value);
         if (dxf_attdef.common.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_attdef.common.id_code);
+                dxf_write_group_hex (fp, 5, dxf_attdef.common.id_code);
         }
         if (strcmp (dxf_attdef.common.linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", dxf_attdef.common.linetype);
+                dxf_write_group_string (fp, 6, dxf_attdef.common.linetype);
         }
         if (strcmp (dxf_attdef.text_style, "STANDARD") != 0)
         {
-                fprintf (fp, "  7\n%s\n", dxf_attdef.text_style);
+                dxf_write_group_string (fp, 7, dxf_attdef.text_style);
         }
-        fprintf (fp, "  8\n%s\n", dxf_attdef.common.layer);
-        fprintf (fp, " 10\n%f\n", dxf_attdef.x0);
-        fprintf (fp, " 20\n%f\n", dxf_attdef.y0);
-        fprintf (fp, " 30\n%f\n", dxf_attdef.z0);
+        dxf_write_group_string (fp, 8, dxf_attdef.common.layer);
+        dxf_write_group_double (fp, 10, dxf_attdef.x0);
+        dxf_write_group_double (fp, 20, dxf_attdef.y0);
+        dxf_write_group_double (fp, 30, dxf_attdef.z0);
         if ((dxf_attdef.hor_align != 0) || (dxf_attdef.vert_align != 0))
         {
                 if ((dxf_attdef.x0 == dxf_attdef.x1) && (dxf_attdef.y0 == dxf_attdef.y1) && (dxf_attdef.z0 == dxf_attdef.z1))
@@ -777,58 +680,58 @@ dxf_attdef_write
                 }
                 else
                 {
-                        fprintf (fp, " 11\n%f\n", dxf_attdef.x1);
-                        fprintf (fp, " 21\n%f\n", dxf_attdef.y1);
-                        fprintf (fp, " 31\n%f\n", dxf_attdef.z1);
+                        dxf_write_group_double (fp, 11, dxf_attdef.x1);
+                        dxf_write_group_double (fp, 21, dxf_attdef.y1);
+                        dxf_write_group_double (fp, 31, dxf_attdef.z1);
                 }
         }
         if (dxf_attdef.common.acad_version_number >= AutoCAD_12)
         {
-                fprintf (fp, "210\n%f\n", dxf_attdef.extr_x0);
-                fprintf (fp, "220\n%f\n", dxf_attdef.extr_y0);
-                fprintf (fp, "230\n%f\n", dxf_attdef.extr_z0);
+                dxf_write_group_double (fp, 210, dxf_attdef.extr_x0);
+                dxf_write_group_double (fp, 220, dxf_attdef.extr_y0);
+                dxf_write_group_double (fp, 230, dxf_attdef.extr_z0);
         }
         if (dxf_attdef.common.thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", dxf_attdef.common.thickness);
+                dxf_write_group_double (fp, 39, dxf_attdef.common.thickness);
         }
-        fprintf (fp, " 40\n%f\n", dxf_attdef.height);
+        dxf_write_group_double (fp, 40, dxf_attdef.height);
         if (dxf_attdef.rel_x_scale != 1.0)
         {
-                fprintf (fp, " 41\n%f\n", dxf_attdef.rel_x_scale);
+                dxf_write_group_double (fp, 41, dxf_attdef.rel_x_scale);
         }
         if (dxf_attdef.rot_angle != 0.0)
         {
-                fprintf (fp, " 50\n%f\n", dxf_attdef.rot_angle);
+                dxf_write_group_double (fp, 50, dxf_attdef.rot_angle);
         }
         if (dxf_attdef.obl_angle != 0.0)
         {
-                fprintf (fp, " 51\n%f\n", dxf_attdef.obl_angle);
+                dxf_write_group_double (fp, 51, dxf_attdef.obl_angle);
         }
         if (dxf_attdef.common.color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", dxf_attdef.common.color);
+                dxf_write_group_int (fp, 62, dxf_attdef.common.color);
         }
         if (dxf_attdef.common.paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp, " 70\n%d\n", dxf_attdef.attr_flags);
+        dxf_write_group_int (fp, 70, dxf_attdef.attr_flags);
         if (dxf_attdef.text_flags != 0)
         {
-                fprintf (fp, " 71\n%d\n", dxf_attdef.text_flags);
+                dxf_write_group_int (fp, 71, dxf_attdef.text_flags);
         }
         if (dxf_attdef.hor_align != 0)
         {
-                fprintf (fp, " 72\n%d\n", dxf_attdef.hor_align);
+                dxf_write_group_int (fp, 72, dxf_attdef.hor_align);
         }
         if (dxf_attdef.field_length != 0)
         {
-                fprintf (fp, " 73\n%d\n", dxf_attdef.field_length);
+                dxf_write_group_int (fp, 73, dxf_attdef.field_length);
         }
         if (dxf_attdef.vert_align != 0)
         {
-                fprintf (fp, " 74\n%d\n", dxf_attdef.vert_align);
+                dxf_write_group_int (fp, 74, dxf_attdef.vert_align);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_attdef_write () function.\n",
@@ -150,23 +150,36 @@ dxf_attdef
 DxfAttdef *
 dxf_attdef_new ();
 DxfAttdef *
+dxf_attdef_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_attdef_free
+(
+        DxfAttdef *dxf_attdef
+);
+DxfAttdef *
 dxf_attdef_init
 (
         DxfAttdef *dxf_attdef
 );
+DxfAttdef *
+dxf_attdef_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_attdef_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfAttdef *dxf_attdef,
         int acad_version_number
 );
 int
 dxf_attdef_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *default_value,
         char *tag_value,
@@ -201,7 +214,7 @@ dxf_attdef_write_lowlevel
 int
 dxf_attdef_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfAttdef dxf_attdef
 );
 
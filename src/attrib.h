@@ -134,23 +134,36 @@ dxf_attrib
 DxfAttrib *
 dxf_attrib_new ();
 DxfAttrib *
+dxf_attrib_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_attrib_free
+(
+        DxfAttrib *dxf_attrib
+);
+DxfAttrib *
 dxf_attrib_init
 (
         DxfAttrib *dxf_attrib
 );
+DxfAttrib *
+dxf_attrib_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_attrib_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfAttrib *dxf_attrib,
         int acad_version_number
 );
 int
 dxf_attrib_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *value,
         char *tag_value,
@@ -179,7 +192,7 @@ dxf_attrib_write_lowlevel
 int
 dxf_attrib_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfAttrib dxf_attrib
 );
 
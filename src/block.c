@@ -31,13 +31,25 @@
 
 
 #include "block.h"
+#include "arena.h"
+#include "pool.h"
 #include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_block_new are handed out by.
+ */
+static DxfPool dxf_block_pool = DXF_POOL_INITIALIZER (sizeof (DxfBlock));
 
 
 /*!
  * \brief Allocate memory for a \c DxfBlock.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_block_free.
  */
 DxfBlock *
 dxf_block_new ()
@@ -47,31 +59,97 @@ dxf_block_new ()
                 __FILE__, __LINE__);
 #endif
         DxfBlock *dxf_block = NULL;
-        size_t size;
 
-        size = sizeof (DxfBlock);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_block = malloc (size)) == NULL)
+        if ((dxf_block = dxf_pool_alloc (&dxf_block_pool)) == NULL)
         {
                 fprintf (stderr, "ERROR in dxf_block_new () could not allocate memory for a DxfBlock struct.\n");
-                dxf_block = NULL;
         }
-        else
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_block_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_block);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfBlock from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_block_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfBlock *
+dxf_block_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_block_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfBlock *dxf_block = NULL;
+
+        if (arena == NULL)
         {
-                memset (dxf_block, 0, size);
+                dxf_block = dxf_block_new ();
+        }
+        else if ((dxf_block = dxf_arena_alloc (arena, sizeof (DxfBlock))) == NULL)
+        {
+                fprintf (stderr, "ERROR in dxf_block_new_arena () could not allocate memory for a DxfBlock struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_block_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_block_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_block);
 }
 
 
+/*!
+ * \brief Release a \c DxfBlock allocated by \c dxf_block_new to its pool.
+ *
+ * \c xref_name, allocated with \c malloc by \c dxf_block_init or
+ * \c dxf_block_read, is freed as well; the block name, layer and
+ * linetype are interned and are not (see \c dxf_arena_intern).\n
+ * Not for a \c DxfBlock allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_block_free
+(
+        DxfBlock *dxf_block
+                /*!< DXF block entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_block_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        if (dxf_block)
+        {
+                free (dxf_block->xref_name);
+        }
+        dxf_pool_release (&dxf_block_pool, dxf_block);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_block_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in a \c BLOCK entity.
  * 
+ * The layer, linetype and block name are interned in the names
+ * shared by the entities without an arena (see
+ * \c dxf_intern_shared), they stay valid until
+ * \c dxf_intern_shared_free.
+ *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
  */
@@ -86,17 +164,47 @@ dxf_block_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_block_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        dxf_block = dxf_block_new ();
+        dxf_block = dxf_block_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_block_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_block);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in a \c BLOCK entity.
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_block_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfBlock *
+dxf_block_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_block_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfBlock *dxf_block = NULL;
+        dxf_block = dxf_block_new_arena (arena);
         if (dxf_block == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_block_init () could not allocate memory for a DxfBlock struct.\n");
+              fprintf (stderr, "ERROR in dxf_block_init_arena () could not allocate memory for a DxfBlock struct.\n");
               return (NULL);
         }
-        dxf_block->xref_name = strdup ("");
-        dxf_block->block_name = strdup ("");
+        dxf_block->xref_name = dxf_arena_strdup (arena, "");
+        dxf_block->block_name = dxf_arena_intern (arena, "");
         dxf_block->common.id_code = 0;
-        dxf_block->common.linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dxf_block->common.layer = strdup (DXF_DEFAULT_LAYER);
+        dxf_block->common.linetype = dxf_arena_intern (arena, DXF_DEFAULT_LINETYPE);
+        dxf_block->common.layer = dxf_arena_intern (arena, DXF_DEFAULT_LAYER);
         dxf_block->x0 = 0.0;
         dxf_block->y0 = 0.0;
         dxf_block->z0 = 0.0;
@@ -106,13 +214,33 @@ dxf_block_init
         dxf_block->common.acad_version_number = 0;
         dxf_block->block_type = 0; /* 0 = invalid type */
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_block_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_block_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_block);
 }
 
 
+/*!
+ * \brief Schema of the \c BLOCK entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_block_schema[DXF_SCHEMA_SIZE] =
+{
+        DXF_SCHEMA_ENTITY_COMMON (DxfBlock),
+        [1] = DXF_SCHEMA_FIELD (DXF_FIELD_STRING, DxfBlock, xref_name),
+        [2] = DXF_SCHEMA_FIELD (DXF_FIELD_NAME, DxfBlock, block_name),
+        [3] = DXF_SCHEMA_FIELD (DXF_FIELD_NAME, DxfBlock, block_name),
+        [10] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfBlock, x0),
+        [20] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfBlock, y0),
+        [30] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfBlock, z0),
+        [38] = DXF_SCHEMA_FIELD (DXF_FIELD_ELEVATION, DxfBlock, z0),
+        [70] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfBlock, block_type),
+        [210] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfBlock, extr_x0),
+        [220] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfBlock, extr_y0),
+        [230] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfBlock, extr_z0)
+};
+
+
 /*!
  * \brief Read data from a DXF file into an \c BLOCK entity.
  *
@@ -120,7 +248,8 @@ dxf_block_init
  * Now follows some data for the \c BLOCK, to be terminated with a "  0"
  * string announcing the following entity, or the end of the \c ENTITY
  * section marker \c ENDSEC. \n
- * While parsing the DXF file store data in \c dxf_block. \n
+ * While parsing the DXF file store data in \c dxf_block, the group
+ * codes are decoded through \c dxf_block_schema. \n
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -140,146 +269,19 @@ dxf_block_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_block_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char temp_string[DXF_MAX_STRING_LENGTH];
+        int ret;
 
         if (!dxf_block)
         {
                 dxf_block = dxf_block_new ();
         }
-        dxf_read_line (temp_string, fp);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (strcmp (temp_string, "1") == 0)
-                {
-                        /* Now follows a string containing a external
-                         * reference name. */
-                        dxf_read_scanf (fp, "%s\n", dxf_block->xref_name);
-                }
-                if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a block name. */
-                        dxf_read_scanf (fp, "%s\n", dxf_block->block_name);
-                }
-                if (strcmp (temp_string, "3") == 0)
-                {
-                        /* Now follows a string containing a block name. */
-                        dxf_read_scanf (fp, "%s\n", dxf_block->block_name);
-                }
-                else if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        dxf_read_scanf (fp, "%x\n", &dxf_block->common.id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        dxf_read_scanf (fp, "%s\n", dxf_block->common.linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        dxf_read_scanf (fp, "%s\n", dxf_block->common.layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        dxf_read_scanf (fp, "%lf\n", &dxf_block->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        dxf_read_scanf (fp, "%lf\n", &dxf_block->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        dxf_read_scanf (fp, "%lf\n", &dxf_block->z0);
-                }
-                else if ((acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (dxf_block->z0 = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        dxf_read_scanf (fp, "%lf\n", &dxf_block->z0);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        dxf_read_scanf (fp, "%lf\n", &dxf_block->common.thickness);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        dxf_read_scanf (fp, "%d\n", &dxf_block->common.color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        dxf_read_scanf (fp, "%d\n", &dxf_block->common.paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the block
-                         * type value. */
-                        dxf_read_scanf (fp, "%d\n", &dxf_block->block_type);
-                }
-                else if ((acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        dxf_read_scanf (fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        dxf_read_scanf (fp, "%lf\n", &dxf_block->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        dxf_read_scanf (fp, "%lf\n", &dxf_block->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        dxf_read_scanf (fp, "%lf\n", &dxf_block->extr_z0);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        dxf_read_scanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning: in dxf_block_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                fp->filename, fp->line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_block_schema, dxf_block, NULL,
+                "BLOCK", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_block_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -289,8 +291,8 @@ dxf_block_read
 int
 dxf_block_write_lowlevel
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< group code = 5. */
         char *xref_name,
@@ -357,38 +359,38 @@ dxf_block_write_lowlevel
                 fprintf (stderr, "    %s entity is relocated to layer 0.\n", dxf_entity_name);
                 layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if ((block_type && 4) || (block_type && 32))
         {
-                fprintf (fp, "  1\n%s\n", xref_name);
+                dxf_write_group_string (fp, 1, xref_name);
         }
-        fprintf (fp, "  2\n%s\n", block_name);
-        fprintf (fp, "  3\n%s\n", block_name);
+        dxf_write_group_string (fp, 2, block_name);
+        dxf_write_group_string (fp, 3, block_name);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
         if (paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp, " 70\n%d\n", block_type);
+        dxf_write_group_int (fp, 70, block_type);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_block () function.\n", __FILE__, __LINE__);
 #endif
@@ -402,8 +404,8 @@ dxf_block_write_lowlevel
 int
 dxf_block_write
 (
-        FILE *fp,
-                /*!< file pointer to output device */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device) */
         DxfBlock dxf_block
                 /*!< block entity */
 )
@@ -437,42 +439,42 @@ dxf_block_write
                         dxf_entity_name);
                 dxf_block.common.layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if ((dxf_block.block_type && 4) || (dxf_block.block_type && 32))
         {
-                fprintf (fp, "  1\n%s\n", dxf_block.xref_name);
+                dxf_write_group_string (fp, 1, dxf_block.xref_name);
         }
         if ((dxf_block.block_type && 4) || (dxf_block.block_type && 32))
         {
-                fprintf (fp, "  1\n%s\n", dxf_block.xref_name);
+                dxf_write_group_string (fp, 1, dxf_block.xref_name);
         }
-        fprintf (fp, "  2\n%s\n", dxf_block.block_name);
-        fprintf (fp, "  3\n%s\n", dxf_block.block_name);
+        dxf_write_group_string (fp, 2, dxf_block.block_name);
+        dxf_write_group_string (fp, 3, dxf_block.block_name);
         if (dxf_block.common.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_block.common.id_code);
+                dxf_write_group_hex (fp, 5, dxf_block.common.id_code);
         }
         if (strcmp (dxf_block.common.linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", dxf_block.common.linetype);
+                dxf_write_group_string (fp, 6, dxf_block.common.linetype);
         }
-        fprintf (fp, "  8\n%s\n", dxf_block.common.layer);
-        fprintf (fp, " 10\n%f\n", dxf_block.x0);
-        fprintf (fp, " 20\n%f\n", dxf_block.y0);
-        fprintf (fp, " 30\n%f\n", dxf_block.z0);
+        dxf_write_group_string (fp, 8, dxf_block.common.layer);
+        dxf_write_group_double (fp, 10, dxf_block.x0);
+        dxf_write_group_double (fp, 20, dxf_block.y0);
+        dxf_write_group_double (fp, 30, dxf_block.z0);
         if (dxf_block.common.thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", dxf_block.common.thickness);
+                dxf_write_group_double (fp, 39, dxf_block.common.thickness);
         }
         if (dxf_block.common.color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", dxf_block.common.color);
+                dxf_write_group_int (fp, 62, dxf_block.common.color);
         }
         if (dxf_block.common.paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp, " 70\n%d\n", dxf_block.block_type);
+        dxf_write_group_int (fp, 70, dxf_block.block_type);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_block2 () function.\n",
                 __FILE__, __LINE__);
@@ -488,12 +490,12 @@ dxf_block_write
  * Contains no other group codes than "0".
  */
 int
-dxf_block_write_endblk (FILE *fp)
+dxf_block_write_endblk (DxfWriter *fp)
 {
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_write_endblk () function.\n", __FILE__, __LINE__);
 #endif
-        fprintf (fp, "  0\nENDBLK\n");
+        dxf_write_group_string (fp, 0, "ENDBLK");
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_endblk () function.\n", __FILE__, __LINE__);
 #endif
@@ -107,10 +107,25 @@ dxf_block
 DxfBlock *
 dxf_block_new ();
 DxfBlock *
+dxf_block_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_block_free
+(
+        DxfBlock *dxf_block
+);
+DxfBlock *
 dxf_block_init
 (
         DxfBlock *dxf_block
 );
+DxfBlock *
+dxf_block_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_block_read
 (
@@ -121,7 +136,7 @@ dxf_block_read
 int
 dxf_block_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *xref_name,
         char *block_name,
@@ -136,13 +151,13 @@ dxf_block_write_lowlevel
         int block_type
 );
 int
-dxf_blocks_write
+dxf_block_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfBlock dxf_block
 );
 int
-dxf_block_write_endblk (FILE *fp);
+dxf_block_write_endblk (DxfWriter *fp);
 int
 dxf_block_write_table
 (
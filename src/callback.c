@@ -0,0 +1,468 @@
+/*!
+ * \file callback.c
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Functions for a DXF entity callback reader.
+ *
+ * The callback reader calls a handler for every entity of a registered
+ * type, other entities are skipped without decoding their groups.\n
+ * Each registered type has one struct which is reused for all entities
+ * of that type, and the strings of an entity are borrowed from the
+ * \c DxfFile (see \c dxf_read_string), so no memory is allocated per
+ * entity.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#include <stddef.h>
+#include "callback.h"
+#include "util.h"
+#include "3dface.h"
+#include "appid.h"
+#include "arc.h"
+#include "attdef.h"
+#include "attrib.h"
+#include "block.h"
+#include "circle.h"
+#include "ellipse.h"
+#include "insert.h"
+#include "line.h"
+#include "lwpolyline.h"
+#include "point.h"
+#include "polyline.h"
+#include "shape.h"
+#include "solid.h"
+#include "text.h"
+#include "vertex.h"
+#include "viewport.h"
+
+
+/*!
+ * \brief Defines the init, free and read functions of \c DxfCallbackType for
+ * the entity module \c module with the struct \c structure.
+ */
+#define DXF_CALLBACK_TYPE(module, structure) \
+static void * \
+dxf_callback_init_##module (DxfArena *arena, size_t *size) \
+{ \
+        *size = sizeof (structure); \
+        return (dxf_##module##_init_arena (arena)); \
+} \
+static void \
+dxf_callback_free_##module (void *entity) \
+{ \
+        dxf_##module##_free ((structure *) entity); \
+} \
+static int \
+dxf_callback_read_##module (DxfFile *fp, void *entity, int acad_version_number) \
+{ \
+        return (dxf_##module##_read (fp, (structure *) entity, acad_version_number)); \
+}
+
+
+/*!
+ * \brief Defines the write function of \c DxfCallbackType for the entity
+ * module \c module with the struct \c structure.
+ */
+#define DXF_CALLBACK_WRITE(module, structure) \
+static int \
+dxf_callback_write_##module (DxfWriter *fp, void *entity, int acad_version_number) \
+{ \
+        (void) acad_version_number; \
+        return (dxf_##module##_write (fp, *(structure *) entity)); \
+}
+
+/*!
+ * \brief Defines the write function of \c DxfCallbackType for the entity
+ * module \c module with the struct \c structure, of which the output
+ * depends on the AutoCAD version.
+ */
+#define DXF_CALLBACK_WRITE_VERSION(module, structure) \
+static int \
+dxf_callback_write_##module (DxfWriter *fp, void *entity, int acad_version_number) \
+{ \
+        return (dxf_##module##_write (fp, *(structure *) entity, acad_version_number)); \
+}
+
+DXF_CALLBACK_TYPE (appid, DxfAppid)
+DXF_CALLBACK_WRITE (appid, DxfAppid)
+DXF_CALLBACK_TYPE (arc, DxfArc)
+DXF_CALLBACK_WRITE (arc, DxfArc)
+DXF_CALLBACK_TYPE (attdef, DxfAttdef)
+DXF_CALLBACK_WRITE (attdef, DxfAttdef)
+DXF_CALLBACK_TYPE (attrib, DxfAttrib)
+DXF_CALLBACK_WRITE (attrib, DxfAttrib)
+DXF_CALLBACK_TYPE (block, DxfBlock)
+DXF_CALLBACK_WRITE (block, DxfBlock)
+DXF_CALLBACK_TYPE (circle, DxfCircle)
+DXF_CALLBACK_WRITE_VERSION (circle, DxfCircle)
+DXF_CALLBACK_TYPE (ellipse, DxfEllipse)
+DXF_CALLBACK_WRITE_VERSION (ellipse, DxfEllipse)
+DXF_CALLBACK_TYPE (3dface, Dxf3dface)
+DXF_CALLBACK_WRITE (3dface, Dxf3dface)
+DXF_CALLBACK_TYPE (insert, DxfInsert)
+DXF_CALLBACK_WRITE (insert, DxfInsert)
+DXF_CALLBACK_TYPE (line, DxfLine)
+DXF_CALLBACK_WRITE (line, DxfLine)
+DXF_CALLBACK_TYPE (lwpolyline, DxfLWPolyline)
+DXF_CALLBACK_WRITE_VERSION (lwpolyline, DxfLWPolyline)
+DXF_CALLBACK_TYPE (point, DxfPoint)
+DXF_CALLBACK_WRITE (point, DxfPoint)
+DXF_CALLBACK_TYPE (polyline, DxfPolyline)
+DXF_CALLBACK_WRITE (polyline, DxfPolyline)
+DXF_CALLBACK_TYPE (shape, DxfShape)
+DXF_CALLBACK_WRITE (shape, DxfShape)
+DXF_CALLBACK_TYPE (solid, DxfSolid)
+DXF_CALLBACK_WRITE (solid, DxfSolid)
+DXF_CALLBACK_TYPE (text, DxfText)
+DXF_CALLBACK_WRITE (text, DxfText)
+DXF_CALLBACK_TYPE (vertex, DxfVertex)
+DXF_CALLBACK_WRITE (vertex, DxfVertex)
+DXF_CALLBACK_TYPE (viewport, DxfViewport)
+DXF_CALLBACK_WRITE (viewport, DxfViewport)
+
+
+/*!
+ * \brief Entity types known by the callback reader.
+ */
+static const DxfCallbackType dxf_callback_types[] =
+{
+        {APPID, "APPID", dxf_callback_init_appid, dxf_callback_free_appid,
+                dxf_callback_read_appid, dxf_callback_write_appid,
+                offsetof (DxfAppid, id_code)},
+        {ARC, "ARC", dxf_callback_init_arc, dxf_callback_free_arc,
+                dxf_callback_read_arc, dxf_callback_write_arc,
+                offsetof (DxfArc, common.id_code)},
+        {ATTDEF, "ATTDEF", dxf_callback_init_attdef, dxf_callback_free_attdef,
+                dxf_callback_read_attdef, dxf_callback_write_attdef,
+                offsetof (DxfAttdef, common.id_code)},
+        {ATTRIB, "ATTRIB", dxf_callback_init_attrib, dxf_callback_free_attrib,
+                dxf_callback_read_attrib, dxf_callback_write_attrib,
+                offsetof (DxfAttrib, common.id_code)},
+        {BLOCK, "BLOCK", dxf_callback_init_block, dxf_callback_free_block,
+                dxf_callback_read_block, dxf_callback_write_block,
+                offsetof (DxfBlock, common.id_code)},
+        {CIRCLE, "CIRCLE", dxf_callback_init_circle, dxf_callback_free_circle,
+                dxf_callback_read_circle, dxf_callback_write_circle,
+                offsetof (DxfCircle, common.id_code)},
+        {ELLIPSE, "ELLIPSE", dxf_callback_init_ellipse, dxf_callback_free_ellipse,
+                dxf_callback_read_ellipse, dxf_callback_write_ellipse,
+                offsetof (DxfEllipse, common.id_code)},
+        {FACE3D, "3DFACE", dxf_callback_init_3dface, dxf_callback_free_3dface,
+                dxf_callback_read_3dface, dxf_callback_write_3dface,
+                offsetof (Dxf3dface, common.id_code)},
+        {INSERT, "INSERT", dxf_callback_init_insert, dxf_callback_free_insert,
+                dxf_callback_read_insert, dxf_callback_write_insert,
+                offsetof (DxfInsert, common.id_code)},
+        {LINE, "LINE", dxf_callback_init_line, dxf_callback_free_line,
+                dxf_callback_read_line, dxf_callback_write_line,
+                offsetof (DxfLine, common.id_code)},
+        {LWPOLYLINE, "LWPOLYLINE", dxf_callback_init_lwpolyline, dxf_callback_free_lwpolyline,
+                dxf_callback_read_lwpolyline, dxf_callback_write_lwpolyline,
+                offsetof (DxfLWPolyline, common.id_code)},
+        {POINT, "POINT", dxf_callback_init_point, dxf_callback_free_point,
+                dxf_callback_read_point, dxf_callback_write_point,
+                offsetof (DxfPoint, common.id_code)},
+        {POLYLINE, "POLYLINE", dxf_callback_init_polyline, dxf_callback_free_polyline,
+                dxf_callback_read_polyline, dxf_callback_write_polyline,
+                offsetof (DxfPolyline, common.id_code)},
+        {SHAPE, "SHAPE", dxf_callback_init_shape, dxf_callback_free_shape,
+                dxf_callback_read_shape, dxf_callback_write_shape,
+                offsetof (DxfShape, common.id_code)},
+        {SOLID, "SOLID", dxf_callback_init_solid, dxf_callback_free_solid,
+                dxf_callback_read_solid, dxf_callback_write_solid,
+                offsetof (DxfSolid, common.id_code)},
+        {TEXT, "TEXT", dxf_callback_init_text, dxf_callback_free_text,
+                dxf_callback_read_text, dxf_callback_write_text,
+                offsetof (DxfText, common.id_code)},
+        {VERTEX, "VERTEX", dxf_callback_init_vertex, dxf_callback_free_vertex,
+                dxf_callback_read_vertex, dxf_callback_write_vertex,
+                offsetof (DxfVertex, common.id_code)},
+        {VIEWPORT, "VIEWPORT", dxf_callback_init_viewport, dxf_callback_free_viewport,
+                dxf_callback_read_viewport, dxf_callback_write_viewport,
+                offsetof (DxfViewport, common.id_code)}
+};
+
+
+/*!
+ * \brief Number of entries in \c dxf_callback_types.
+ */
+#define DXF_CALLBACK_TYPES (sizeof (dxf_callback_types) / sizeof (dxf_callback_types[0]))
+
+
+/*!
+ * \brief Looks up an entity type in \c dxf_callback_types.
+ *
+ * \return the entry, or \c NULL when the type is not known.
+ */
+const DxfCallbackType *
+dxf_callback_type_by_type
+(
+        DxfEntityType type
+                /*!< the entity type. */
+)
+{
+        size_t i;
+
+        for (i = 0; i < DXF_CALLBACK_TYPES; i++)
+        {
+                if (dxf_callback_types[i].type == type)
+                        return (&dxf_callback_types[i]);
+        }
+        return (NULL);
+}
+
+
+/*!
+ * \brief Looks up the entity type named by a "  0" group in
+ * \c dxf_callback_types.
+ *
+ * \return the entry, or \c NULL when the type is not known.
+ */
+const DxfCallbackType *
+dxf_callback_type_by_name
+(
+        const DxfGroup *group
+                /*!< the "  0" group starting an entity. */
+)
+{
+        size_t i;
+
+        for (i = 0; i < DXF_CALLBACK_TYPES; i++)
+        {
+                if (dxf_group_is (group, 0, dxf_callback_types[i].name))
+                        return (&dxf_callback_types[i]);
+        }
+        return (NULL);
+}
+
+
+/*!
+ * \brief Opens a DXF file for reading with \c dxf_callback_reader_run.
+ *
+ * \return \c NULL when the file could not be opened or no memory was
+ * allocated, a pointer to the callback reader when succesful.
+ */
+DxfCallbackReader *
+dxf_callback_reader_open
+(
+        const char *filename
+                /*!< filename of input file (or device). */
+)
+{
+        DxfFile *fp;
+
+        fp = dxf_read_init (filename);
+        if (!fp)
+                return (NULL);
+        return (dxf_callback_reader_open_file (fp));
+}
+
+
+/*!
+ * \brief Opens a callback reader on a DxfFile which is open already,
+ * for example one from \c dxf_read_memory.
+ *
+ * The callback reader takes \c fp over, it is closed by
+ * \c dxf_callback_reader_close (or here when an error occurs).
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * callback reader when succesful.
+ */
+DxfCallbackReader *
+dxf_callback_reader_open_file
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_callback_reader_open_file () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfCallbackReader *callback_reader;
+
+        callback_reader = malloc (sizeof (DxfCallbackReader));
+        if (!callback_reader)
+        {
+                fprintf (stderr, "Error in dxf_callback_reader_open_file () could not allocate memory for a DxfCallbackReader struct.\n");
+                dxf_read_close (fp);
+                return (NULL);
+        }
+        memset (callback_reader, 0, sizeof (DxfCallbackReader));
+        callback_reader->reader = dxf_reader_open_file (fp);
+        if (!callback_reader->reader)
+        {
+                free (callback_reader);
+                return (NULL);
+        }
+        callback_reader->reader->fp->borrow_strings = TRUE;
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_callback_reader_open_file () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (callback_reader);
+}
+
+
+/*!
+ * \brief Registers the handler for the entities of type \c type.
+ *
+ * A previous handler for \c type is replaced, a \c NULL handler skips
+ * the entities of \c type.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when entities of
+ * \c type can not be read or no memory was allocated.
+ */
+int
+dxf_callback_reader_register
+(
+        DxfCallbackReader *callback_reader,
+                /*!< DXF callback reader. */
+        DxfEntityType type,
+                /*!< the entity type. */
+        DxfEntityCallback callback,
+                /*!< the handler. */
+        void *user_data
+                /*!< data passed to the handler. */
+)
+{
+        const DxfCallbackType *callback_type;
+
+        callback_type = dxf_callback_type_by_type (type);
+        if (!callback_type)
+        {
+                fprintf (stderr, "Error in dxf_callback_reader_register () entities of type %d can not be read.\n",
+                        type);
+                return (EXIT_FAILURE);
+        }
+        if (callback && !callback_reader->defaults[type])
+        {
+                callback_reader->defaults[type] = callback_type->init (NULL, &callback_reader->sizes[type]);
+                callback_reader->entities[type] = malloc (callback_reader->sizes[type]);
+                if (!callback_reader->defaults[type] || !callback_reader->entities[type])
+                {
+                        fprintf (stderr, "Error in dxf_callback_reader_register () could not allocate memory for a %s entity.\n",
+                                callback_type->name);
+                        return (EXIT_FAILURE);
+                }
+        }
+        callback_reader->callbacks[type] = callback;
+        callback_reader->user_data[type] = user_data;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Reads the DXF file and calls the registered handlers.
+ *
+ * \return \c EXIT_SUCCESS when the whole file was read, the value
+ * returned by a handler which stopped the reader, or \c EXIT_FAILURE
+ * when an error occurred.
+ */
+int
+dxf_callback_reader_run
+(
+        DxfCallbackReader *callback_reader
+                /*!< DXF callback reader. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_callback_reader_run () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfReader *reader = callback_reader->reader;
+        DxfFile *fp = reader->fp;
+        DxfReaderEvent event;
+        const DxfCallbackType *callback_type;
+        DxfEntityType type;
+        void *entity;
+        int ret;
+
+        while (dxf_reader_next (reader, &event) > DXF_EVENT_EOF)
+        {
+                if (event.type != DXF_EVENT_ENTITY_BEGIN)
+                        continue;
+                callback_type = dxf_callback_type_by_name (&event.group);
+                if (!callback_type || !callback_reader->callbacks[callback_type->type])
+                        continue;
+                type = callback_type->type;
+                entity = callback_reader->entities[type];
+                memcpy (entity, callback_reader->defaults[type], callback_reader->sizes[type]);
+                dxf_read_reset_strings (fp);
+                if (callback_type->read (fp, entity, reader->acad_version_number) != EXIT_SUCCESS)
+                        return (EXIT_FAILURE);
+                ret = callback_reader->callbacks[type] (type, entity, callback_reader->user_data[type]);
+                if (ret != EXIT_SUCCESS)
+                        return (ret);
+        }
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_callback_reader_run () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return ((event.type == DXF_EVENT_EOF) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+
+/*!
+ * \brief Closes a DXF callback reader and the file it reads from.
+ *
+ * The struct initialized for each type is freed with its \c dxf_X_free,
+ * strings included, the struct the entities were read into is freed
+ * with \c free, and the strings it borrowed are freed with the file.
+ */
+void
+dxf_callback_reader_close
+(
+        DxfCallbackReader *callback_reader
+                /*!< DXF callback reader. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_callback_reader_close () function.\n",
+                __FILE__, __LINE__);
+#endif
+        int i;
+
+        if (callback_reader)
+        {
+                for (i = 0; i < DXF_MAX_ENTITY_TYPES; i++)
+                {
+                        if (callback_reader->defaults[i])
+                                dxf_callback_type_by_type (i)->free (callback_reader->defaults[i]);
+                        free (callback_reader->entities[i]);
+                }
+                dxf_reader_close (callback_reader->reader);
+                free (callback_reader);
+        }
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_callback_reader_close () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
+/* EOF */
@@ -0,0 +1,156 @@
+/*!
+ * \file callback.h
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Definition of a DXF entity callback reader.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifndef CALLBACK_H
+#define CALLBACK_H
+
+
+#include "global.h"
+#include "entity.h"
+#include "reader.h"
+
+
+/*!
+ * \brief Handler for the entities of one type, registered with
+ * \c dxf_callback_reader_register.
+ *
+ * \c entity points to the struct of the type (for example a
+ * \c DxfLine for \c LINE), which is reused for the next entity of the
+ * same type: the entity and its strings are only valid during the call.
+ *
+ * \return \c EXIT_SUCCESS to continue reading, any other value stops
+ * \c dxf_callback_reader_run.
+ */
+typedef int (*DxfEntityCallback)
+(
+        DxfEntityType type,
+        void *entity,
+        void *user_data
+);
+
+
+/*!
+ * \brief DXF definition of an entity type known by the callback reader.
+ *
+ * See \c dxf_callback_type_by_name.
+ */
+typedef struct
+dxf_callback_type
+{
+        DxfEntityType type;
+                /*!< the entity type. */
+        const char *name;
+                /*!< name of the entity in a DXF file. */
+        void *(*init) (DxfArena *arena, size_t *size);
+                /*!< allocates and initializes a struct of the type, from
+                 * \c arena when not \c NULL. */
+        void (*free) (void *entity);
+                /*!< releases a struct allocated by \c init without an
+                 * arena, with the strings it owns. */
+        int (*read) (DxfFile *fp, void *entity, int acad_version_number);
+                /*!< reads the groups of an entity into the struct. */
+        int (*write) (DxfWriter *fp, void *entity, int acad_version_number);
+                /*!< writes the groups of an entity from the struct,
+                 * \c NULL when the type can not be written. */
+        size_t id_code;
+                /*!< offset of the id-code (handle) in the struct. */
+} DxfCallbackType, * DxfCallbackTypePtr;
+
+
+/*!
+ * \brief DXF definition of a callback reader.
+ */
+typedef struct
+dxf_callback_reader
+{
+        DxfReader *reader;
+                /*!< pull reader the events are read from. */
+        DxfEntityCallback callbacks[DXF_MAX_ENTITY_TYPES];
+                /*!< registered handlers, \c NULL for types which are
+                 * skipped. */
+        void *user_data[DXF_MAX_ENTITY_TYPES];
+                /*!< data passed to the handlers. */
+        void *entities[DXF_MAX_ENTITY_TYPES];
+                /*!< reused struct for the entities of each registered
+                 * type. */
+        void *defaults[DXF_MAX_ENTITY_TYPES];
+                /*!< initialized struct, copied into \c entities before
+                 * an entity is read. */
+        size_t sizes[DXF_MAX_ENTITY_TYPES];
+                /*!< size of the struct of each registered type. */
+} DxfCallbackReader, * DxfCallbackReaderPtr;
+
+
+const DxfCallbackType *
+dxf_callback_type_by_type
+(
+        DxfEntityType type
+);
+const DxfCallbackType *
+dxf_callback_type_by_name
+(
+        const DxfGroup *group
+);
+DxfCallbackReader *
+dxf_callback_reader_open
+(
+        const char *filename
+);
+DxfCallbackReader *
+dxf_callback_reader_open_file
+(
+        DxfFile *fp
+);
+int
+dxf_callback_reader_register
+(
+        DxfCallbackReader *callback_reader,
+        DxfEntityType type,
+        DxfEntityCallback callback,
+        void *user_data
+);
+int
+dxf_callback_reader_run
+(
+        DxfCallbackReader *callback_reader
+);
+void
+dxf_callback_reader_close
+(
+        DxfCallbackReader *callback_reader
+);
+
+
+#endif /* CALLBACK_H */
+
+
+/* EOF */
@@ -31,12 +31,25 @@
 
 
 #include "circle.h"
+#include "arena.h"
+#include "pool.h"
+#include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_circle_new are handed out by.
+ */
+static DxfPool dxf_circle_pool = DXF_POOL_INITIALIZER (sizeof (DxfCircle));
 
 
 /*!
  * \brief Allocate memory for a \c DxfCircle.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_circle_free.
  */
 DxfCircle *
 dxf_circle_new ()
@@ -46,31 +59,91 @@ dxf_circle_new ()
                 __FILE__, __LINE__);
 #endif
         DxfCircle *dxf_circle = NULL;
-        size_t size;
 
-        size = sizeof (DxfCircle);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_circle = malloc (size)) == NULL)
+        if ((dxf_circle = dxf_pool_alloc (&dxf_circle_pool)) == NULL)
         {
                 fprintf (stderr, "ERROR in dxf_circle_new () could not allocate memory for a DxfCircle struct.\n");
-                dxf_circle = NULL;
         }
-        else
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_circle_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_circle);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfCircle from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_circle_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfCircle *
+dxf_circle_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_circle_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfCircle *dxf_circle = NULL;
+
+        if (arena == NULL)
+        {
+                dxf_circle = dxf_circle_new ();
+        }
+        else if ((dxf_circle = dxf_arena_alloc (arena, sizeof (DxfCircle))) == NULL)
         {
-                memset (dxf_circle, 0, size);
+                fprintf (stderr, "ERROR in dxf_circle_new_arena () could not allocate memory for a DxfCircle struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_circle_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_circle_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_circle);
 }
 
 
+/*!
+ * \brief Release a \c DxfCircle allocated by \c dxf_circle_new to its pool.
+ *
+ * The struct has no strings of its own, the layer and linetype are
+ * interned (see \c dxf_arena_intern).\n
+ * Not for a \c DxfCircle allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_circle_free
+(
+        DxfCircle *dxf_circle
+                /*!< DXF circle entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_circle_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        dxf_pool_release (&dxf_circle_pool, dxf_circle);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_circle_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in a \c CIRCLE entity.
  * 
+ * The layer and linetype are interned in the names shared by the
+ * entities without an arena (see \c dxf_intern_shared), they stay
+ * valid until \c dxf_intern_shared_free.
+ *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
  */
@@ -85,15 +158,45 @@ dxf_circle_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_circle_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        dxf_circle = dxf_circle_new ();
+        dxf_circle = dxf_circle_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_circle_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_circle);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in a \c CIRCLE entity.
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_circle_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfCircle *
+dxf_circle_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_circle_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfCircle *dxf_circle = NULL;
+        dxf_circle = dxf_circle_new_arena (arena);
         if (dxf_circle == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_circle_init () could not allocate memory for a DxfCircle struct.\n");
+              fprintf (stderr, "ERROR in dxf_circle_init_arena () could not allocate memory for a DxfCircle struct.\n");
               return (NULL);
         }
         dxf_circle->common.id_code = 0;
-        dxf_circle->common.linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dxf_circle->common.layer = strdup (DXF_DEFAULT_LAYER);
+        dxf_circle->common.linetype = dxf_arena_intern (arena, DXF_DEFAULT_LINETYPE);
+        dxf_circle->common.layer = dxf_arena_intern (arena, DXF_DEFAULT_LAYER);
         dxf_circle->x0 = 0.0;
         dxf_circle->y0 = 0.0;
         dxf_circle->z0 = 0.0;
@@ -106,13 +209,30 @@ dxf_circle_init
         dxf_circle->common.paperspace = DXF_MODELSPACE;
         dxf_circle->common.acad_version_number = 0;
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_circle_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_circle_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_circle);
 }
 
 
+/*!
+ * \brief Schema of the \c CIRCLE entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_circle_schema[DXF_SCHEMA_SIZE] =
+{
+        DXF_SCHEMA_ENTITY_COMMON (DxfCircle),
+        [10] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfCircle, x0),
+        [20] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfCircle, y0),
+        [30] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfCircle, z0),
+        [38] = DXF_SCHEMA_FIELD (DXF_FIELD_ELEVATION, DxfCircle, z0),
+        [40] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfCircle, radius),
+        [210] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfCircle, extr_x0),
+        [220] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfCircle, extr_y0),
+        [230] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfCircle, extr_z0)
+};
+
+
 /*!
  * \brief Read data from a DXF file into an \c CIRCLE entity.
  *
@@ -120,7 +240,8 @@ dxf_circle_init
  * Now follows some data for the \c CIRCLE, to be terminated with a "  0"
  * string announcing the following entity, or the end of the \c ENTITY
  * section marker \c ENDSEC. \n
- * While parsing the DXF file store data in \c dxf_circle. \n
+ * While parsing the DXF file store data in \c dxf_circle, the group
+ * codes are decoded through \c dxf_circle_schema. \n
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -128,12 +249,8 @@ dxf_circle_init
 int
 dxf_circle_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         DxfCircle *dxf_circle,
                 /*!< DXF circle entity. */
         int acad_version_number
@@ -144,150 +261,15 @@ dxf_circle_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_circle_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_circle_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (0);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (*line_number)++;
-                        fscanf (fp, "%x\n", &dxf_circle->common.id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_circle->common.linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_circle->common.layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_circle->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_circle->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_circle->z0);
-                }
-                else if ((acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (dxf_circle->z0 = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_circle->z0);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_circle->common.thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * radius. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_circle->radius);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_circle->common.color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_circle->common.paperspace);
-                }
-                else if ((acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_circle->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_circle->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_circle->extr_z0);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning: in dxf_circle_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_circle_schema, dxf_circle, NULL,
+                "CIRCLE", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_circle_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -297,8 +279,8 @@ dxf_circle_read
 int
 dxf_circle_write_lowlevel
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< group code = 5. */
         char *linetype,
@@ -349,31 +331,31 @@ dxf_circle_write_lowlevel
                         dxf_entity_name);
                 layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
-        fprintf (fp, " 40\n%f\n", radius);
+        dxf_write_group_double (fp, 40, radius);
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
         if (paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_circle_write_lowlevel () function.\n",
@@ -388,8 +370,8 @@ dxf_circle_write_lowlevel
 int
 dxf_circle_write
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfCircle dxf_circle,
                 /*!< DXF circle entity. */
         int acad_version_number
@@ -418,31 +400,31 @@ dxf_circle_write
                         dxf_entity_name );
                 dxf_circle.common.layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (dxf_circle.common.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_circle.common.id_code);
+                dxf_write_group_hex (fp, 5, dxf_circle.common.id_code);
         }
         if (strcmp (dxf_circle.common.linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", dxf_circle.common.linetype);
+                dxf_write_group_string (fp, 6, dxf_circle.common.linetype);
         }
-        fprintf (fp, "  8\n%s\n", dxf_circle.common.layer);
-        fprintf (fp, " 10\n%f\n", dxf_circle.x0);
-        fprintf (fp, " 20\n%f\n", dxf_circle.y0);
-        fprintf (fp, " 30\n%f\n", dxf_circle.z0);
+        dxf_write_group_string (fp, 8, dxf_circle.common.layer);
+        dxf_write_group_double (fp, 10, dxf_circle.x0);
+        dxf_write_group_double (fp, 20, dxf_circle.y0);
+        dxf_write_group_double (fp, 30, dxf_circle.z0);
         if (dxf_circle.common.thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", dxf_circle.common.thickness);
+                dxf_write_group_double (fp, 39, dxf_circle.common.thickness);
         }
-        fprintf (fp, " 40\n%f\n", dxf_circle.radius);
+        dxf_write_group_double (fp, 40, dxf_circle.radius);
         if (dxf_circle.common.color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", dxf_circle.common.color);
+                dxf_write_group_int (fp, 62, dxf_circle.common.color);
         }
         if (dxf_circle.common.paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_circle_write () function.\n",
@@ -451,4 +433,88 @@ dxf_circle_write
         return (EXIT_SUCCESS);
 }
 
+/*!
+ * \brief Write DXF output to fp for a batch of circle entities, given as
+ * arrays of centers and radii.
+ *
+ * All circles are written with the same layer and color, with the
+ * default linetype and no thickness.\n
+ * \c z0 can be \c NULL for circles in the XY-plane.\n
+ * When \c handle is not \c NULL the circles get the handles
+ * \c *handle, \c *handle + 1, ..., and \c *handle is set to the next
+ * free handle.\n
+ * Circles with a radius of 0.0 are skipped, as by \c dxf_circle_write.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when a circle
+ * was skipped or an error occured.
+ */
+int
+dxf_circle_write_batch
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        size_t count,
+                /*!< number of circles. */
+        const double *x0,
+                /*!< X-values of the centers. */
+        const double *y0,
+                /*!< Y-values of the centers. */
+        const double *z0,
+                /*!< Z-values of the centers, or \c NULL. */
+        const double *radius,
+                /*!< radii. */
+        const char *layer,
+                /*!< layer of all entities. */
+        int color,
+                /*!< color of all entities. */
+        int *handle
+                /*!< next free handle, or \c NULL to write the entities
+                 * without a handle. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_circle_write_batch () function.\n",
+                __FILE__, __LINE__);
+#endif
+        int ret = EXIT_SUCCESS;
+        size_t i;
+
+        if (!layer || (strcmp (layer, "") == 0))
+        {
+                fprintf (stderr, "Warning in dxf_circle_write_batch () empty layer string for the CIRCLE entities.\n");
+                fprintf (stderr, "    CIRCLE entities are relocated to layer 0\n");
+                layer = DXF_DEFAULT_LAYER;
+        }
+        for (i = 0; i < count; i++)
+        {
+                if (radius[i] == 0.0)
+                {
+                        fprintf (stderr, "Error in dxf_circle_write_batch () radius value equals 0.0 for CIRCLE entity %lu, skipping it.\n",
+                                (unsigned long) i);
+                        ret = EXIT_FAILURE;
+                        continue;
+                }
+                dxf_write_group_string (fp, 0, "CIRCLE");
+                if (handle)
+                {
+                        dxf_write_group_hex (fp, 5, (*handle)++);
+                }
+                dxf_write_group_string (fp, 8, layer);
+                dxf_write_group_double (fp, 10, x0[i]);
+                dxf_write_group_double (fp, 20, y0[i]);
+                dxf_write_group_double (fp, 30, z0 ? z0[i] : 0.0);
+                dxf_write_group_double (fp, 40, radius[i]);
+                if (color != DXF_COLOR_BYLAYER)
+                {
+                        dxf_write_group_int (fp, 62, color);
+                }
+        }
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_circle_write_batch () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (fp->failed ? EXIT_FAILURE : ret);
+}
+
+
 /* EOF */
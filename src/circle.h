@@ -71,23 +71,36 @@ dxf_circle
 DxfCircle *
 dxf_circle_new ();
 DxfCircle *
+dxf_circle_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_circle_free
+(
+        DxfCircle *dxf_circle
+);
+DxfCircle *
 dxf_circle_init
 (
         DxfCircle *dxf_circle
 );
+DxfCircle *
+dxf_circle_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_circle_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfCircle *dxf_circle,
         int acad_version_number
 );
 int
 dxf_circle_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *linetype,
         char *layer,
@@ -103,10 +116,23 @@ dxf_circle_write_lowlevel
 int
 dxf_circle_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfCircle dxf_circle,
         int acad_version_number
 );
+int
+dxf_circle_write_batch
+(
+        DxfWriter *fp,
+        size_t count,
+        const double *x0,
+        const double *y0,
+        const double *z0,
+        const double *radius,
+        const char *layer,
+        int color,
+        int *handle
+);
 
 
 /* EOF */
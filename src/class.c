@@ -39,7 +39,10 @@
 
 
 #include "global.h"
+#include "util.h"
+#include "schema.h"
 #include "class.h"
+#include "writer.h"
 
 
 /*!
@@ -115,6 +118,21 @@ dxf_class_init
 }
 
 
+/*!
+ * \brief Schema of the \c CLASS entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_class_schema[DXF_SCHEMA_SIZE] =
+{
+        [1] = DXF_SCHEMA_FIELD (DXF_FIELD_STRING, DxfClass, record_name),
+        [2] = DXF_SCHEMA_FIELD (DXF_FIELD_STRING, DxfClass, class_name),
+        [3] = DXF_SCHEMA_FIELD (DXF_FIELD_STRING, DxfClass, app_name),
+        [90] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfClass, proxy_cap_flag),
+        [280] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfClass, was_a_proxy_flag),
+        [281] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfClass, is_an_entity_flag),
+        [999] = DXF_SCHEMA_TYPE (DXF_FIELD_COMMENT)
+};
+
+
 /*!
  * \brief Read data from a DXF file into an \c CLASS entity.
  *
@@ -122,7 +140,8 @@ dxf_class_init
  * Now follows some data for the \c CLASS, to be terminated with a "  0"
  * string announcing the following entity, or the end of the \c ENTITY
  * section marker \c ENDCLASS. \n
- * While parsing the DXF file store data in \c dxf_class. \n
+ * While parsing the DXF file store data in \c dxf_class, the group
+ * codes are decoded through \c dxf_class_schema. \n
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -130,12 +149,8 @@ dxf_class_init
 int
 dxf_class_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         DxfClass *dxf_class,
                 /*!< DXF class entity. */
         int acad_version_number
@@ -146,95 +161,19 @@ dxf_class_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_class_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
         if (!dxf_class)
         {
                 dxf_class = dxf_class_new ();
         }
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_class_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (EXIT_FAILURE);
-                }
-                if (strcmp (temp_string, "0") == 0)
-                {
-                        /* Now follows a string containing a record type
-                         * number. */
-                        /*! \bug \c record_type has group code 0 which
-                         * will cause a parsing error and \c record_type
-                         * and other \c class variables  will not be
-                         * read. See the while condition above.
-                         */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", &dxf_class->record_type);
-                }
-                else if (strcmp (temp_string, "1") == 0)
-                {
-                        /* Now follows a string containing a record
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_class->record_name);
-                }
-                else if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a class name.
-                         */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_class->class_name);
-                }
-                else if (strcmp (temp_string, "3") == 0)
-                {
-                        /* Now follows a string containing the
-                         * application name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", &dxf_class->app_name);
-                }
-                else if (strcmp (temp_string, "90") == 0)
-                {
-                        /* Now follows a string containing the
-                         * proxy cap flag value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_class->proxy_cap_flag);
-                }
-                else if (strcmp (temp_string, "280") == 0)
-                {
-                        /* Now follows a string containing the
-                         * was a proxy flag value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_class->was_a_proxy_flag);
-                }
-                else if (strcmp (temp_string, "281") == 0)
-                {
-                        /* Now follows a string containing the
-                         * is an entity flag value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_class->is_an_entity_flag);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning: in dxf_class_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_class_schema, dxf_class, NULL,
+                "CLASS", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_class_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -248,8 +187,8 @@ dxf_class_read
 int
 dxf_class_write_lowlevel
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         char *record_name,
                 /*!< group code = 1.\n
                  * Class DXF record name.\n
@@ -298,13 +237,13 @@ dxf_class_write_lowlevel
                 __FILE__, __LINE__);
 #endif
         char *dxf_entity_name = strdup ("CLASS");
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
-        fprintf (fp, "  1\n%s\n", record_name);
-        fprintf (fp, "  2\n%s\n", class_name);
-        fprintf (fp, "  3\n%s\n", app_name);
-        fprintf (fp, " 90\n%d\n", proxy_cap_flag);
-        fprintf (fp, "280\n%d\n", was_a_proxy_flag);
-        fprintf (fp, "281\n%d\n", is_an_entity_flag);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
+        dxf_write_group_string (fp, 1, record_name);
+        dxf_write_group_string (fp, 2, class_name);
+        dxf_write_group_string (fp, 3, app_name);
+        dxf_write_group_int (fp, 90, proxy_cap_flag);
+        dxf_write_group_int (fp, 280, was_a_proxy_flag);
+        dxf_write_group_int (fp, 281, is_an_entity_flag);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_class_write_lowlevel () function.\n",
                 __FILE__, __LINE__);
@@ -319,8 +258,8 @@ dxf_class_write_lowlevel
 int
 dxf_class_write
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfClass dxf_class
                 /*!< DXF class section. */
 )
@@ -330,13 +269,13 @@ dxf_class_write
                 __FILE__, __LINE__);
 #endif
         char *dxf_entity_name = strdup ("CLASS");
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
-        fprintf (fp, "  1\n%s\n", dxf_class.record_name);
-        fprintf (fp, "  2\n%s\n", dxf_class.class_name);
-        fprintf (fp, "  3\n%s\n", dxf_class.app_name);
-        fprintf (fp, " 90\n%d\n", dxf_class.proxy_cap_flag);
-        fprintf (fp, "280\n%d\n", dxf_class.was_a_proxy_flag);
-        fprintf (fp, "281\n%d\n", dxf_class.is_an_entity_flag);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
+        dxf_write_group_string (fp, 1, dxf_class.record_name);
+        dxf_write_group_string (fp, 2, dxf_class.class_name);
+        dxf_write_group_string (fp, 3, dxf_class.app_name);
+        dxf_write_group_int (fp, 90, dxf_class.proxy_cap_flag);
+        dxf_write_group_int (fp, 280, dxf_class.was_a_proxy_flag);
+        dxf_write_group_int (fp, 281, dxf_class.is_an_entity_flag);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_class_write () function.\n",
                 __FILE__, __LINE__);
@@ -351,13 +290,13 @@ dxf_class_write
 int
 dxf_class_write_endclass
 (
-        FILE *fp
+        DxfWriter *fp
 )
 {
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_class_write_endclass () function.\n", __FILE__, __LINE__);
 #endif
-        fprintf (fp, "  0\nENDSEC\n");
+        dxf_write_group_string (fp, 0, "ENDSEC");
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_class_write_endclass () function.\n", __FILE__, __LINE__);
 #endif
@@ -141,16 +141,14 @@ dxf_class_init
 int
 dxf_class_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfClass *dxf_class,
         int acad_version_number
 );
 int
 dxf_class_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         char *record_name,
         char *class_name,
         char *app_name,
@@ -161,13 +159,13 @@ dxf_class_write_lowlevel
 int
 dxf_class_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfClass dxf_class
 );
 int
 dxf_class_write_endclass
 (
-        FILE *fp
+        DxfWriter *fp
 );
 
 
@@ -30,6 +30,7 @@
  */
 
 #include "global.h"
+#include "writer.h"
 
 /*!
  * \brief Write DXF output to fp for a comment.
@@ -43,8 +44,8 @@
 int
 dxf_write_comment
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         char *comment_string
                 /*!< comment string to be writen to fp. */
 )
@@ -52,7 +53,7 @@ dxf_write_comment
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_write_comment () function.\n", __FILE__, __LINE__);
 #endif
-        fprintf (fp, "999\n%s\n", comment_string);
+        dxf_write_group_string (fp, 999, comment_string);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_comment () function.\n", __FILE__, __LINE__);
 #endif
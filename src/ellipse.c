@@ -31,12 +31,25 @@
 
 
 #include "ellipse.h"
+#include "arena.h"
+#include "pool.h"
+#include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_ellipse_new are handed out by.
+ */
+static DxfPool dxf_ellipse_pool = DXF_POOL_INITIALIZER (sizeof (DxfEllipse));
 
 
 /*!
  * \brief Allocate memory for a \c DxfEllipse.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_ellipse_free.
  *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
@@ -49,31 +62,91 @@ dxf_ellipse_new ()
                 __FILE__, __LINE__);
 #endif
         DxfEllipse *dxf_ellipse = NULL;
-        size_t size;
 
-        size = sizeof (DxfEllipse);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_ellipse = malloc (size)) == NULL)
+        if ((dxf_ellipse = dxf_pool_alloc (&dxf_ellipse_pool)) == NULL)
         {
                 fprintf (stderr, "ERROR in dxf_ellipse_new () could not allocate memory for a DxfEllipse struct.\n");
-                dxf_ellipse = NULL;
         }
-        else
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_ellipse_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_ellipse);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfEllipse from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_ellipse_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfEllipse *
+dxf_ellipse_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_ellipse_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfEllipse *dxf_ellipse = NULL;
+
+        if (arena == NULL)
         {
-                memset (dxf_ellipse, 0, size);
+                dxf_ellipse = dxf_ellipse_new ();
+        }
+        else if ((dxf_ellipse = dxf_arena_alloc (arena, sizeof (DxfEllipse))) == NULL)
+        {
+                fprintf (stderr, "ERROR in dxf_ellipse_new_arena () could not allocate memory for a DxfEllipse struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_ellipse_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_ellipse_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_ellipse);
 }
 
 
+/*!
+ * \brief Release a \c DxfEllipse allocated by \c dxf_ellipse_new to its pool.
+ *
+ * The struct has no strings of its own, the layer and linetype are
+ * interned (see \c dxf_arena_intern).\n
+ * Not for a \c DxfEllipse allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_ellipse_free
+(
+        DxfEllipse *dxf_ellipse
+                /*!< DXF ellipse entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_ellipse_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        dxf_pool_release (&dxf_ellipse_pool, dxf_ellipse);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_ellipse_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in an \c ELLIPSE entity.
  * 
+ * The layer and linetype are interned in the names shared by the
+ * entities without an arena (see \c dxf_intern_shared), they stay
+ * valid until \c dxf_intern_shared_free.
+ *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
  */
@@ -88,15 +161,45 @@ dxf_ellipse_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_ellipse_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        dxf_ellipse = dxf_ellipse_new ();
+        dxf_ellipse = dxf_ellipse_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_ellipse_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_ellipse);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in an \c ELLIPSE entity.
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_ellipse_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfEllipse *
+dxf_ellipse_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_ellipse_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfEllipse *dxf_ellipse = NULL;
+        dxf_ellipse = dxf_ellipse_new_arena (arena);
         if (dxf_ellipse == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_ellipse_init () could not allocate memory for a DxfEllipse struct.\n");
+              fprintf (stderr, "ERROR in dxf_ellipse_init_arena () could not allocate memory for a DxfEllipse struct.\n");
               return (NULL);
         }
         dxf_ellipse->common.id_code = 0;
-        dxf_ellipse->common.linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dxf_ellipse->common.layer = strdup (DXF_DEFAULT_LAYER);
+        dxf_ellipse->common.linetype = dxf_arena_intern (arena, DXF_DEFAULT_LINETYPE);
+        dxf_ellipse->common.layer = dxf_arena_intern (arena, DXF_DEFAULT_LAYER);
         dxf_ellipse->x0 = 0.0;
         dxf_ellipse->y0 = 0.0;
         dxf_ellipse->z0 = 0.0;
@@ -114,13 +217,35 @@ dxf_ellipse_init
         dxf_ellipse->common.paperspace = DXF_MODELSPACE;
         dxf_ellipse->common.acad_version_number = 0;
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_ellipse_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_ellipse_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_ellipse);
 }
 
 
+/*!
+ * \brief Schema of the \c ELLIPSE entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_ellipse_schema[DXF_SCHEMA_SIZE] =
+{
+        DXF_SCHEMA_ENTITY_COMMON (DxfEllipse),
+        [10] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfEllipse, x0),
+        [11] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfEllipse, x1),
+        [20] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfEllipse, y0),
+        [21] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfEllipse, y1),
+        [30] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfEllipse, z0),
+        [31] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfEllipse, z1),
+        [38] = DXF_SCHEMA_FIELD (DXF_FIELD_ELEVATION, DxfEllipse, z0),
+        [40] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfEllipse, ratio),
+        [41] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfEllipse, start_angle),
+        [42] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfEllipse, end_angle),
+        [210] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfEllipse, extr_x0),
+        [220] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfEllipse, extr_y0),
+        [230] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfEllipse, extr_z0)
+};
+
+
 /*!
  * \brief Read data from a DXF file into an \c ELLIPSE entity.
  *
@@ -128,7 +253,8 @@ dxf_ellipse_init
  * Now follows some data for the \c ELLIPSE, to be terminated with a
  * "  0" string announcing the following entity, or the end of the
  * \c ENTITY section marker \c ENDSEC. \n
- * While parsing the DXF file store data in \c dxf_ellipse. \n
+ * While parsing the DXF file store data in \c dxf_ellipse, the group
+ * codes are decoded through \c dxf_ellipse_schema. \n
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -136,12 +262,8 @@ dxf_ellipse_init
 int
 dxf_ellipse_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         DxfEllipse *dxf_ellipse,
                 /*!< DXF ellipse entity. */
         int acad_version_number
@@ -152,185 +274,15 @@ dxf_ellipse_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_ellipse_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_ellipse_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (0);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (*line_number)++;
-                        fscanf (fp, "%x\n", &dxf_ellipse->common.id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_ellipse->common.linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_ellipse->common.layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_ellipse->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_ellipse->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_ellipse->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_ellipse->x1);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_ellipse->y1);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_ellipse->z1);
-                }
-                else if ((acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (dxf_ellipse->z0 = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_ellipse->z0);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_ellipse->common.thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * radius. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_ellipse->ratio);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * start angle. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_ellipse->start_angle);
-                }
-                else if (strcmp (temp_string, "42") == 0)
-                {
-                        /* Now follows a string containing the
-                         * end angle. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_ellipse->end_angle);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_ellipse->common.color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_ellipse->common.paperspace);
-                }
-                else if ((acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_ellipse->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_ellipse->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_ellipse->extr_z0);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning: in dxf_ellipse_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_ellipse_schema, dxf_ellipse, NULL,
+                "ELLIPSE", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_ellipse_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -345,8 +297,8 @@ dxf_ellipse_read
 int
 dxf_ellipse_write_lowlevel
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< group code = 5. */
         char *linetype,
@@ -430,39 +382,39 @@ dxf_ellipse_write_lowlevel
                         dxf_entity_name);
                 layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
-        fprintf (fp, " 11\n%f\n", x1);
-        fprintf (fp, " 21\n%f\n", y1);
-        fprintf (fp, " 31\n%f\n", z1);
-        fprintf (fp, " 210\n%f\n", extr_x0);
-        fprintf (fp, " 220\n%f\n", extr_y0);
-        fprintf (fp, " 230\n%f\n", extr_z0);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
+        dxf_write_group_double (fp, 11, x1);
+        dxf_write_group_double (fp, 21, y1);
+        dxf_write_group_double (fp, 31, z1);
+        dxf_write_group_double (fp, 210, extr_x0);
+        dxf_write_group_double (fp, 220, extr_y0);
+        dxf_write_group_double (fp, 230, extr_z0);
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
-        fprintf (fp, " 40\n%f\n", ratio);
-        fprintf (fp, " 41\n%f\n", start_angle);
-        fprintf (fp, " 42\n%f\n", end_angle);
+        dxf_write_group_double (fp, 40, ratio);
+        dxf_write_group_double (fp, 41, start_angle);
+        dxf_write_group_double (fp, 42, end_angle);
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
         if (paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_ellipse_write_lowlevel () function.\n",
@@ -483,8 +435,8 @@ dxf_ellipse_write_lowlevel
 int
 dxf_ellipse_write
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfEllipse dxf_ellipse,
                 /*!< DXF ellipse entity */
         int acad_version_number
@@ -517,39 +469,39 @@ dxf_ellipse_write
                         dxf_entity_name);
                 dxf_ellipse.common.layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (dxf_ellipse.common.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_ellipse.common.id_code);
+                dxf_write_group_hex (fp, 5, dxf_ellipse.common.id_code);
         }
         if (strcmp (dxf_ellipse.common.linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", dxf_ellipse.common.linetype);
+                dxf_write_group_string (fp, 6, dxf_ellipse.common.linetype);
         }
-        fprintf (fp, "  8\n%s\n", dxf_ellipse.common.layer);
-        fprintf (fp, " 10\n%f\n", dxf_ellipse.x0);
-        fprintf (fp, " 20\n%f\n", dxf_ellipse.y0);
-        fprintf (fp, " 30\n%f\n", dxf_ellipse.z0);
-        fprintf (fp, " 11\n%f\n", dxf_ellipse.x1);
-        fprintf (fp, " 21\n%f\n", dxf_ellipse.y1);
-        fprintf (fp, " 31\n%f\n", dxf_ellipse.z1);
-        fprintf (fp, " 210\n%f\n", dxf_ellipse.extr_x0);
-        fprintf (fp, " 220\n%f\n", dxf_ellipse.extr_y0);
-        fprintf (fp, " 230\n%f\n", dxf_ellipse.extr_z0);
+        dxf_write_group_string (fp, 8, dxf_ellipse.common.layer);
+        dxf_write_group_double (fp, 10, dxf_ellipse.x0);
+        dxf_write_group_double (fp, 20, dxf_ellipse.y0);
+        dxf_write_group_double (fp, 30, dxf_ellipse.z0);
+        dxf_write_group_double (fp, 11, dxf_ellipse.x1);
+        dxf_write_group_double (fp, 21, dxf_ellipse.y1);
+        dxf_write_group_double (fp, 31, dxf_ellipse.z1);
+        dxf_write_group_double (fp, 210, dxf_ellipse.extr_x0);
+        dxf_write_group_double (fp, 220, dxf_ellipse.extr_y0);
+        dxf_write_group_double (fp, 230, dxf_ellipse.extr_z0);
         if (dxf_ellipse.common.thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", dxf_ellipse.common.thickness);
+                dxf_write_group_double (fp, 39, dxf_ellipse.common.thickness);
         }
-        fprintf (fp, " 40\n%f\n", dxf_ellipse.ratio);
-        fprintf (fp, " 41\n%f\n", dxf_ellipse.start_angle);
-        fprintf (fp, " 42\n%f\n", dxf_ellipse.end_angle);
+        dxf_write_group_double (fp, 40, dxf_ellipse.ratio);
+        dxf_write_group_double (fp, 41, dxf_ellipse.start_angle);
+        dxf_write_group_double (fp, 42, dxf_ellipse.end_angle);
         if (dxf_ellipse.common.color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", dxf_ellipse.common.color);
+                dxf_write_group_int (fp, 62, dxf_ellipse.common.color);
         }
         if (dxf_ellipse.common.paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_ellipse_write () function.\n",
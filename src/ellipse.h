@@ -87,23 +87,36 @@ dxf_ellipse
 DxfEllipse *
 dxf_ellipse_new ();
 DxfEllipse *
+dxf_ellipse_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_ellipse_free
+(
+        DxfEllipse *dxf_ellipse
+);
+DxfEllipse *
 dxf_ellipse_init
 (
         DxfEllipse *dxf_ellipse
 );
+DxfEllipse *
+dxf_ellipse_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_ellipse_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfEllipse *dxf_ellipse,
         int acad_version_number
 );
 int
 dxf_ellipse_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *linetype,
         char *layer,
@@ -127,7 +140,7 @@ dxf_ellipse_write_lowlevel
 int
 dxf_ellipse_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfEllipse dxf_ellipse,
         int acad_version_number
 );
@@ -30,6 +30,7 @@
  */
 
 #include "global.h"
+#include "writer.h"
 
 /*!
  * \brief Write DXF output to a file for an end of tables marker.
@@ -37,14 +38,14 @@
 int
 dxf_write_endtab
 (
-        FILE *fp
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp
+                /*!< DXF file handle of output file (or device). */
 )
 {
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_write_endtab () function.\n", __FILE__, __LINE__);
 #endif
-        fprintf (fp, "  0\nENDTAB\n");
+        dxf_write_group_string (fp, 0, "ENDTAB");
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_endtab () function.\n", __FILE__, __LINE__);
 #endif
@@ -30,7 +30,8 @@
  */
 
 
-#include "global.h"
+#include "entity.h"
+#include "intern.h"
 
 
 /*!
@@ -126,4 +127,235 @@ dxf_write_entities
 }
 
 
+/*!
+ * \brief Allocates an empty table of compact entity headers.
+ *
+ * The layer and linetype names are numbered in \c names, which may be
+ * shared with an arena (see \c dxf_arena_intern), or in a table of names
+ * of its own when \c names is \c NULL.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the table
+ * when succesful.
+ */
+DxfEntityHeaders *
+dxf_entity_headers_new
+(
+        DxfIntern *names
+                /*!< table of names, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_entity_headers_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfEntityHeaders *headers;
+
+        headers = malloc (sizeof (DxfEntityHeaders));
+        if (!headers)
+        {
+                fprintf (stderr, "Error in dxf_entity_headers_new () could not allocate memory for a DxfEntityHeaders struct.\n");
+                return (NULL);
+        }
+        memset (headers, 0, sizeof (DxfEntityHeaders));
+        headers->shared_names = (names != NULL);
+        headers->names = names ? names : dxf_intern_new ();
+        if (!headers->names)
+        {
+                free (headers);
+                return (NULL);
+        }
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_entity_headers_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (headers);
+}
+
+
+/*!
+ * \brief Adds the common properties of an entity to a table of compact
+ * entity headers.
+ *
+ * The handle is taken from the id-code of \c common, see
+ * \c dxf_entity_headers_add_handle for handles of more than 32 bits.
+ *
+ * \return \c -1 when no memory was allocated, the number of the header
+ * in the table when succesful.
+ */
+long
+dxf_entity_headers_add
+(
+        DxfEntityHeaders *headers,
+                /*!< the table. */
+        const DxfEntity *common
+                /*!< common properties of the entity. */
+)
+{
+        return (dxf_entity_headers_add_handle (headers, common,
+                (uint32_t) common->id_code));
+}
+
+
+/*!
+ * \brief Adds the common properties of an entity with a 64 bit handle to
+ * a table of compact entity headers.
+ *
+ * The table keeps one AutoCAD version number for all of its entities,
+ * the one of the first entity added (the entities of a document share
+ * it).
+ *
+ * \return \c -1 when no memory was allocated, the number of the header
+ * in the table when succesful.
+ */
+long
+dxf_entity_headers_add_handle
+(
+        DxfEntityHeaders *headers,
+                /*!< the table. */
+        const DxfEntity *common,
+                /*!< common properties of the entity. */
+        uint64_t handle
+                /*!< handle of the entity, in place of the id-code of
+                 * \c common. */
+)
+{
+        DxfEntityHeader *header;
+        DxfEntityHeader *grown;
+        double *thicknesses;
+        long layer;
+        long linetype;
+        size_t size;
+
+        if (headers->count == headers->size)
+        {
+                size = headers->size ? 2 * headers->size : 1024;
+                grown = realloc (headers->headers, size * sizeof (DxfEntityHeader));
+                if (!grown)
+                {
+                        fprintf (stderr, "Error in dxf_entity_headers_add () could not allocate memory for the headers.\n");
+                        return (-1);
+                }
+                headers->headers = grown;
+                headers->size = size;
+        }
+        if ((common->thickness != 0.0)
+                && (headers->thickness_count == headers->thickness_size))
+        {
+                size = headers->thickness_size ? 2 * headers->thickness_size : 64;
+                thicknesses = realloc (headers->thicknesses, size * sizeof (double));
+                if (!thicknesses)
+                {
+                        fprintf (stderr, "Error in dxf_entity_headers_add () could not allocate memory for the thicknesses.\n");
+                        return (-1);
+                }
+                headers->thicknesses = thicknesses;
+                headers->thickness_size = size;
+        }
+        layer = dxf_intern_index (headers->names,
+                common->layer ? common->layer : DXF_DEFAULT_LAYER,
+                strlen (common->layer ? common->layer : DXF_DEFAULT_LAYER));
+        linetype = dxf_intern_index (headers->names,
+                common->linetype ? common->linetype : DXF_DEFAULT_LINETYPE,
+                strlen (common->linetype ? common->linetype : DXF_DEFAULT_LINETYPE));
+        if ((layer < 0) || (linetype < 0))
+                return (-1);
+        header = &headers->headers[headers->count];
+        header->handle = handle;
+        header->layer = (uint32_t) layer;
+        header->linetype = (uint32_t) linetype;
+        header->flags = (uint32_t) common->color & DXF_ENTITY_COLOR;
+        if (common->paperspace == DXF_PAPERSPACE)
+                header->flags |= DXF_ENTITY_PAPERSPACE;
+        if (common->color == DXF_COLOR_BYLAYER)
+                header->flags |= DXF_ENTITY_COLOR_BYLAYER;
+        else if (common->color == DXF_COLOR_BYBLOCK)
+                header->flags |= DXF_ENTITY_COLOR_BYBLOCK;
+        else if (common->color < 0)
+                header->flags |= DXF_ENTITY_COLOR_OFF;
+        header->thickness = 0;
+        if (common->thickness != 0.0)
+        {
+                headers->thicknesses[headers->thickness_count++] = common->thickness;
+                header->thickness = (uint32_t) headers->thickness_count;
+        }
+        if (headers->count == 0)
+                headers->acad_version_number = common->acad_version_number;
+        return ((long) headers->count++);
+}
+
+
+/*!
+ * \brief Copies a compact entity header of a table into the common
+ * properties of an entity.
+ *
+ * The layer and linetype of \c common point to the names of the table,
+ * they must not be freed.\n
+ * The id-code of \c common gets the lower 32 bits of the handle.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the table
+ * has no header with number \c index.
+ */
+int
+dxf_entity_headers_get
+(
+        DxfEntityHeaders *headers,
+                /*!< the table. */
+        size_t index,
+                /*!< number of the header. */
+        DxfEntity *common
+                /*!< common properties of the entity. */
+)
+{
+        const DxfEntityHeader *header;
+
+        if (index >= headers->count)
+                return (EXIT_FAILURE);
+        header = &headers->headers[index];
+        common->id_code = (int) header->handle;
+        common->layer = dxf_intern_name (headers->names, header->layer);
+        common->linetype = dxf_intern_name (headers->names, header->linetype);
+        common->thickness = header->thickness
+                ? headers->thicknesses[header->thickness - 1] : 0.0;
+        /* The color is a 16 bit signed number. */
+        common->color = (int) (header->flags & DXF_ENTITY_COLOR);
+        if (common->color > 0x7fff)
+                common->color -= 0x10000;
+        common->paperspace = (header->flags & DXF_ENTITY_PAPERSPACE)
+                ? DXF_PAPERSPACE : DXF_MODELSPACE;
+        common->acad_version_number = headers->acad_version_number;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Frees a table of compact entity headers.
+ *
+ * A table of names passed to \c dxf_entity_headers_new is not freed.
+ */
+void
+dxf_entity_headers_free
+(
+        DxfEntityHeaders *headers
+                /*!< the table. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_entity_headers_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        if (headers != NULL)
+        {
+                if (!headers->shared_names)
+                        dxf_intern_free (headers->names);
+                free (headers->thicknesses);
+                free (headers->headers);
+                free (headers);
+        }
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_entity_headers_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /* EOF */
@@ -34,17 +34,18 @@
 #define ENTITY_H
 
 
+#include <stdint.h>
+#include "global.h"
+
+
 /*!
  * \brief DXF definition of common properties of an AutoCAD entity.
+ *
+ * The members are ordered by size, so the struct has no padding.
  */
 typedef struct
 dxf_entity
 {
-        int id_code;
-                /*!< Identification number for the entity.\n
-                 * This is to be an unique (sequential) number in the DXF
-                 * file.\n
-                 * Group code = 5. */
         char *linetype;
                 /*!< The linetype of the entity.\n
                  * Defaults to \c BYLAYER if ommitted in the DXF file.\n
@@ -57,6 +58,11 @@ dxf_entity
                 /*!< Thickness of the arc in the local Z-direction.\n
                  * Defaults to 0.0 if ommitted in the DXF file.\n
                  * Group code = 39. */
+        int id_code;
+                /*!< Identification number for the entity.\n
+                 * This is to be an unique (sequential) number in the DXF
+                 * file.\n
+                 * Group code = 5. */
         int color;
                 /*!< Color of the entity.\n
                  * Defaults to \c BYLAYER if ommitted in the DXF file.\n
@@ -74,6 +80,94 @@ dxf_entity
 } DxfEntity, * DxfEntityPtr;
 
 
+/*!
+ * \brief DXF definition of the common properties of an entity in compact
+ * form, stored in a \c DxfEntityHeaders table.
+ *
+ * The layer and linetype are numbers of names in the table and the
+ * thickness is only stored when it is not 0.0.
+ */
+typedef struct
+dxf_entity_header
+{
+        uint64_t handle;
+                /*!< Identification number (id-code) of the entity, all
+                 * 64 bits of the handle.\n
+                 * Group code = 5. */
+        uint32_t layer;
+                /*!< Number of the layer name in the names of the table.\n
+                 * Group code = 8. */
+        uint32_t linetype;
+                /*!< Number of the linetype name in the names of the
+                 * table.\n
+                 * Group code = 6. */
+        uint32_t flags;
+                /*!< Color in the lower 16 bits (group code = 62), with
+                 * \c DXF_ENTITY_PAPERSPACE (group code = 67) and the kind
+                 * of color. */
+        uint32_t thickness;
+                /*!< Number + 1 of the thickness in the table, 0 for a
+                 * thickness of 0.0.\n
+                 * Group code = 39. */
+} DxfEntityHeader, * DxfEntityHeaderPtr;
+
+
+/*!
+ * \brief Mask of the color in the flags of a \c DxfEntityHeader.
+ */
+#define DXF_ENTITY_COLOR 0xffff
+
+/*!
+ * \brief Flag of a \c DxfEntityHeader for an entity on \c PAPERSPACE.
+ */
+#define DXF_ENTITY_PAPERSPACE 0x10000
+
+/*!
+ * \brief Flag of a \c DxfEntityHeader for the color \c BYLAYER.
+ */
+#define DXF_ENTITY_COLOR_BYLAYER 0x20000
+
+/*!
+ * \brief Flag of a \c DxfEntityHeader for the color \c BYBLOCK.
+ */
+#define DXF_ENTITY_COLOR_BYBLOCK 0x40000
+
+/*!
+ * \brief Flag of a \c DxfEntityHeader for a negative color (the layer
+ * is off).
+ */
+#define DXF_ENTITY_COLOR_OFF 0x80000
+
+
+/*!
+ * \brief DXF definition of a table of the common properties of the
+ * entities of a document, in compact form.
+ */
+typedef struct
+dxf_entity_headers
+{
+        DxfEntityHeader *headers;
+                /*!< the headers, in the order they were added. */
+        size_t count;
+                /*!< number of headers. */
+        size_t size;
+                /*!< allocated number of headers. */
+        double *thicknesses;
+                /*!< the thicknesses which are not 0.0. */
+        size_t thickness_count;
+                /*!< number of thicknesses. */
+        size_t thickness_size;
+                /*!< allocated number of thicknesses. */
+        DxfIntern *names;
+                /*!< layer and linetype names. */
+        int shared_names;
+                /*!< \c TRUE when \c names belongs to the caller. */
+        int acad_version_number;
+                /*!< AutoCAD version number of the entities, one for the
+                 * whole table: the version of the first entity added. */
+} DxfEntityHeaders, * DxfEntityHeadersPtr;
+
+
 /*!
  * \brief DXF entity types.
  */
@@ -101,7 +195,15 @@ dxf_entity_type
         TRACE,
         UCS,
         VIEW,
-        VPORT
+        VPORT,
+        ELLIPSE,
+        FACE3D,
+                /*!< \c 3DFACE. */
+        LWPOLYLINE,
+        VERTEX,
+        VIEWPORT,
+        DXF_MAX_ENTITY_TYPES
+                /*!< number of entity types. */
 } DxfEntityType;
 
 
@@ -114,6 +216,36 @@ dxf_read_entities
        char *dxf_entities_list,
        int acad_version_number
 );
+DxfEntityHeaders *
+dxf_entity_headers_new
+(
+        DxfIntern *names
+);
+long
+dxf_entity_headers_add
+(
+        DxfEntityHeaders *headers,
+        const DxfEntity *common
+);
+long
+dxf_entity_headers_add_handle
+(
+        DxfEntityHeaders *headers,
+        const DxfEntity *common,
+        uint64_t handle
+);
+int
+dxf_entity_headers_get
+(
+        DxfEntityHeaders *headers,
+        size_t index,
+        DxfEntity *common
+);
+void
+dxf_entity_headers_free
+(
+        DxfEntityHeaders *headers
+);
 int
 dxf_skip_entity
 (
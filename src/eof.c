@@ -30,6 +30,7 @@
  */
 
 #include "eof.h"
+#include "writer.h"
 
 /*!
  * \brief Write DXF output for an End Of File marker.
@@ -37,14 +38,14 @@
 int
 dxf_write_eof
 (
-        FILE *fp
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp
+                /*!< DXF file handle of output file (or device). */
 )
 {
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_write_eof () function.\n", __FILE__, __LINE__);
 #endif
-        fprintf (fp, "  0\nEOF\n");
+        dxf_write_group_string (fp, 0, "EOF");
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_eof () function.\n", __FILE__, __LINE__);
 #endif
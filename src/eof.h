@@ -37,7 +37,7 @@
 #include "global.h"
 
 
-int dxf_write_eof (FILE *fp);
+int dxf_write_eof (DxfWriter *fp);
 
 
 #endif /* __EOF_H_INCLUDED__ */
@@ -73,7 +73,7 @@ dxf_read_file
 #endif
         /* open the file */
         fp = dxf_read_init (filename);
-        while (fp)
+        while (fp && !dxf_read_eof (fp))
         {
                 dxf_read_line (temp_string, fp);
                 if (strcmp (temp_string, "999") == 0)
@@ -88,7 +88,7 @@ dxf_read_file
                 else if (strcmp (temp_string, "0") == 0)
                 {
                 /* Now follows some meaningfull dxf data. */
-                        while (!feof (fp->fp))
+                        while (!dxf_read_eof (fp))
                         {
                                 dxf_read_line (temp_string, fp);
                                 if (strcmp (temp_string, "SECTION") == 0)
@@ -127,8 +127,8 @@ dxf_read_file
 int
 dxf_write_file
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfHeader dxf_header,
                 /*!< a dxf header. */
         DxfClass dxf_classes_list,
@@ -41,7 +41,7 @@
 
 
 int dxf_read_file (char *filename);
-int dxf_write_file (FILE *fp, DxfHeader dxf_header, DxfClass dxf_classes_list, DxfTable dxf_tables_list, int acad_version_number);
+int dxf_write_file (DxfWriter *fp, DxfHeader dxf_header, DxfClass dxf_classes_list, DxfTable dxf_tables_list, int acad_version_number);
 
 
 #endif /* FILE_H */
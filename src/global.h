@@ -43,6 +43,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <string.h>
+#include <stdint.h>
 #include <getopt.h>
 #include <math.h>
 #include <errno.h>
@@ -63,8 +64,195 @@
 #define FALSE 0
 
 
+/*!
+ * \brief The sentinel at the start of a binary DXF file.
+ */
+#define DXF_BINARY_SENTINEL "AutoCAD Binary DXF\r\n\032"
+
+/*!
+ * \brief Length of \c DXF_BINARY_SENTINEL, including the terminating null
+ * character.
+ */
+#define DXF_BINARY_SENTINEL_LENGTH 22
+
+/*!
+ * \brief Size of the buffer for the value of a group of a binary DXF file
+ * formatted as a line (see \c dxf_read_next_line).
+ */
+#define DXF_BINARY_LINE_LENGTH 512
+
+
+/*!
+ * \brief Types of the raw values of groups in a binary DXF file.
+ *
+ * Numbers are stored little-endian.
+ */
+typedef enum
+dxf_binary_type
+{
+    DXF_BINARY_TEXT = 0, /*!< Text terminated with a null character (and all values of an ASCII DXF file) */
+    DXF_BINARY_DOUBLE, /*!< 8 byte floating point number */
+    DXF_BINARY_INT8, /*!< 1 byte integer (boolean) */
+    DXF_BINARY_INT16, /*!< 2 byte integer */
+    DXF_BINARY_INT32, /*!< 4 byte integer */
+    DXF_BINARY_INT64, /*!< 8 byte integer */
+    DXF_BINARY_CHUNK /*!< Binary data preceded by a 1 byte length */
+} DxfBinaryType;
+
+
+/*!
+ * \brief DXF definition of a group (a group code and its value).
+ *
+ * The value is a slice into the input buffer of the \c DxfFile it was
+ * read from, it is <b>not</b> null terminated and is
+ * only valid until the next group is read from that \c DxfFile.
+ */
+typedef struct
+dxf_group
+{
+    int code; /*!< Group code */
+    const char *value; /*!< First character of the value */
+    size_t length; /*!< Number of characters in the value */
+    DxfBinaryType binary; /*!< Type of a raw value read from a binary DXF file */
+} DxfGroup, * DxfGroupPtr;
+
+
+/*!
+ * \brief DXF definition of a block of strings borrowed by the entities
+ * read from a DXF file (see \c dxf_read_string).
+ */
+typedef struct
+dxf_string_block
+{
+    struct dxf_string_block *next; /*!< Previous (smaller) block */
+    size_t size; /*!< Number of bytes in \c data */
+    size_t length; /*!< Number of bytes used in \c data */
+    char *data; /*!< The strings, terminated with a '\0' */
+} DxfStringBlock, * DxfStringBlockPtr;
+
+
+/*!
+ * \brief DXF definition of a chunk of memory of a \c DxfArena, the bytes
+ * follow the struct.
+ */
+typedef struct
+dxf_arena_chunk
+{
+    struct dxf_arena_chunk *next; /*!< Chunk allocated before */
+    size_t size; /*!< Number of bytes in the chunk */
+    size_t used; /*!< Number of bytes handed out */
+} DxfArenaChunk, * DxfArenaChunkPtr;
+
+
+/*!
+ * \brief DXF definition of an arena, which holds the entities and
+ * strings of a document until they are all freed at once (see
+ * \c dxf_arena_free).
+ */
+typedef struct
+dxf_arena
+{
+    DxfArenaChunk *chunks; /*!< Chunks, the one memory is handed out from first */
+    size_t chunk_size; /*!< Size of a chunk */
+    size_t allocated; /*!< Number of bytes allocated for the chunks */
+    struct dxf_intern *names; /*!< Names interned for the entities in the arena, \c NULL until the first name */
+    int shared_names; /*!< \c TRUE when \c names belongs to another arena */
+} DxfArena, * DxfArenaPtr;
+
+
+/*!
+ * \brief DXF definition of a table of interned strings, which holds one
+ * copy of each distinct string (see \c dxf_intern_string).
+ *
+ * Used for the names of layers, linetypes, text styles and blocks, which
+ * are shared by many entities.
+ */
+typedef struct
+dxf_intern
+{
+    DxfArena *strings; /*!< Arena the strings, \c names and \c slots are stored in */
+    char **names; /*!< The strings, in the order they were interned */
+    size_t count; /*!< Number of strings */
+    size_t *slots; /*!< Number of slots followed by the hash table of the strings, index in \c names + 1, 0 for a free slot */
+    size_t size; /*!< Number of slots, a power of two, at least twice \c count */
+    void *lock; /*!< Mutex serializing the threads adding strings, \c NULL without threads */
+} DxfIntern, * DxfInternPtr;
+
+
+/*!
+ * \brief DXF definition of a pool of structs of one size, which hands out
+ * the structs from slabs and keeps the released structs in a free list
+ * (see \c dxf_pool_alloc).
+ *
+ * Used by the \c _new functions of the entities, so a drawing with many
+ * vertices does not call \c malloc once per vertex.
+ */
+typedef struct
+dxf_pool
+{
+    size_t size; /*!< Size of a struct, rounded up to the alignment */
+    size_t slab_items; /*!< Number of structs in a slab */
+    DxfArena *arena; /*!< Arena the slabs are allocated from, \c NULL for \c malloc */
+    void *slabs; /*!< Slabs allocated with \c malloc, linked through their first bytes */
+    char *next; /*!< Next struct never handed out in the current slab */
+    char *end; /*!< End of the current slab */
+    void *free_items; /*!< Released structs, linked through their first bytes */
+    size_t used; /*!< Number of structs handed out and not released, or kept by the threads (see \c cache) */
+    size_t allocated; /*!< Number of bytes allocated for the slabs */
+    void *lock; /*!< Mutex serializing the threads, \c NULL for a static pool until it is first used */
+    size_t cache; /*!< Number + 1 of the caches in which each thread keeps the structs it released, 0 without */
+    unsigned long generation; /*!< Number telling the caches of this pool from those of a pool freed before */
+} DxfPool, * DxfPoolPtr;
+
+/*!
+ * \brief Size of a struct of \c item_size bytes in a \c DxfPool, rounded
+ * up to a multiple of 8 bytes, so doubles and the link of a released
+ * struct are aligned.
+ */
+#define DXF_POOL_ITEM_SIZE(item_size) \
+        (((item_size) + 7) & ~((size_t) 7))
+
+/*!
+ * \brief Initializer of a static \c DxfPool for structs of \c item_size
+ * bytes, allocated with \c malloc.
+ */
+#define DXF_POOL_INITIALIZER(item_size) \
+        {DXF_POOL_ITEM_SIZE (item_size), DXF_POOL_SLAB_ITEMS, NULL, NULL, NULL, NULL, NULL, 0, 0, NULL, 0, 0}
+
+
+/*!
+ * \brief Maximum length of the name of a section in a
+ * \c DxfSectionRange.
+ */
+#define DXF_MAX_SECTION_NAME_LENGTH 32
+
+
+/*!
+ * \brief DXF definition of the location of a section in the buffer of a
+ * DXF file (see \c dxf_section_index).
+ */
+typedef struct
+dxf_section_range
+{
+    char name[DXF_MAX_SECTION_NAME_LENGTH]; /*!< Name of the section ("HEADER", "ENTITIES", ...) */
+    size_t start; /*!< Offset of the "  0" line of the SECTION marker */
+    size_t body; /*!< Offset of the first group after the name of the section */
+    size_t end; /*!< Offset of the "  0" line of the ENDSEC marker */
+    int line_number; /*!< Line number of the name of the section */
+} DxfSectionRange, * DxfSectionRangePtr;
+
+
 /*!
  * \brief DXF definition of a DXF file.
+ *
+ * When the file could be memory mapped \c buffer holds the complete
+ * contents of the file, otherwise \c buffer is a window which is
+ * refilled through \c fp.\n
+ * Lines are handed out as slices into \c buffer.\n
+ * A binary DXF file is read group by group, its values are handed out
+ * as raw slices into \c buffer.\n
+ * A compressed (gzip, zstd) file is decompressed into \c buffer through
+ * \c stream.
  */
 typedef struct
 dxf_file
@@ -72,9 +260,62 @@ dxf_file
     FILE *fp; /*!< File handle */
     char *filename; /*!< Dxf filename */
     int line_number; /*!< Last line read */
+    char *buffer; /*!< Contents (or a window on the contents) of the file */
+    size_t buffer_size; /*!< Allocated size of \c buffer */
+    size_t buffer_length; /*!< Number of valid bytes in \c buffer */
+    size_t buffer_position; /*!< Offset of the next line in \c buffer */
+    size_t buffer_mark; /*!< Offset of the last group read in \c buffer */
+    int mark_line_number; /*!< Line number at \c buffer_mark */
+    int mapped; /*!< \c TRUE when \c buffer is a memory mapping */
+    int borrowed; /*!< \c TRUE when \c buffer belongs to someone else */
+    int memory; /*!< \c TRUE when \c buffer was given to \c dxf_read_memory */
+    size_t *lines; /*!< Offsets of the line ends found in \c buffer */
+    size_t line_count; /*!< Number of line ends in \c lines */
+    size_t line_index; /*!< Index in \c lines of the end of the next line */
+    size_t lines_start; /*!< Offset in \c buffer where \c lines starts */
+    size_t lines_scanned; /*!< Offset in \c buffer up to which \c lines is complete */
+    int borrow_strings; /*!< \c TRUE when strings read are stored in \c strings */
+    DxfStringBlock *strings; /*!< Strings of the entity being read */
+    DxfSectionRange *sections; /*!< Sections found by \c dxf_section_index */
+    int section_count; /*!< Number of sections in \c sections */
+    int binary; /*!< Size of the group codes (1 or 2 bytes) of a binary DXF file, 0 for an ASCII DXF file */
+    int binary_value; /*!< \c TRUE when the value of \c binary_group is the next line */
+    DxfGroup binary_group; /*!< Group of a binary DXF file read as lines */
+    char binary_line[DXF_BINARY_LINE_LENGTH]; /*!< Last line formatted from \c binary_group */
+    struct dxf_stream *stream; /*!< Decompressor of a compressed file, \c NULL otherwise */
+    DxfArena *arena; /*!< Arena the strings read are stored in, \c NULL otherwise */
+    DxfIntern *names; /*!< Names of the entities read with \c borrow_strings without an arena, see \c dxf_read_names */
+    uint64_t handle; /*!< Handle (group code 5) of the entity being read, in all of its 64 bits, 0 without one */
 } DxfFile, * DxfFilePtr;
 
 
+/*!
+ * \brief DXF definition of a DXF file which is written.
+ *
+ * The groups are written as ASCII DXF, or as binary DXF when \c binary
+ * is set (see \c dxf_write_init).\n
+ * The groups are formatted into \c buffer, which is written to \c fp
+ * when it is full (see \c dxf_write_flush), or grows when \c memory is
+ * set.
+ */
+typedef struct
+dxf_writer
+{
+    FILE *fp; /*!< File handle */
+    char *filename; /*!< Dxf filename */
+    int binary; /*!< Size of the group codes (1 or 2 bytes) of a binary DXF file, 0 for an ASCII DXF file */
+    int borrowed; /*!< \c TRUE when \c fp belongs to someone else */
+    struct dxf_stream *stream; /*!< Compressor of a compressed file, \c NULL otherwise */
+    char *buffer; /*!< Groups which are not written to \c fp yet */
+    size_t buffer_length; /*!< Number of bytes in \c buffer */
+    size_t buffer_size; /*!< Allocated size of \c buffer */
+    int failed; /*!< \c TRUE when writing to \c fp failed */
+    int precision; /*!< Number of decimals of floating point values, -1 for the shortest number which reads back exactly */
+    int memory; /*!< \c TRUE when the groups are kept in \c buffer (see \c dxf_write_init_memory) */
+    long offset; /*!< Number of bytes written to \c fp (before compression) before the bytes in \c buffer */
+} DxfWriter, * DxfWriterPtr;
+
+
 /* AutoCAD(TM) versions by name */
 #define AutoCAD_10 1006
 #define AutoCAD_11 1009
@@ -127,7 +368,8 @@ dxf_file
         /*!< AutoCAD 2011. */
 
 /*!
- * The maximum of parameters in a \a DxfObject
+ * The maximum of parameters in a list of \a DxfParam (a \a DxfObject
+ * stores a variable number of \a DxfValue).
  */
 #define DXF_MAX_PARAM 2000
 
@@ -141,6 +383,44 @@ dxf_file
  */
 #define DXF_MAX_STRING_LENGTH 255
 
+/*!
+ * The initial size of the read buffer of a \a DxfFile which is not memory
+ * mapped.
+ */
+#define DXF_READ_BUFFER_SIZE 65536
+
+/*!
+ * The size of the write buffer of a \a DxfWriter.
+ */
+#define DXF_WRITE_BUFFER_SIZE 262144
+
+/*!
+ * The number of line ends located in one scan of the buffer of a
+ * \a DxfFile.
+ */
+#define DXF_READ_LINES 4096
+
+/*!
+ * The initial size of the block of strings borrowed by the entities read
+ * from a \a DxfFile.
+ */
+#define DXF_READ_STRINGS_SIZE 4096
+
+/*!
+ * The default size of a chunk of a \a DxfArena.
+ */
+#define DXF_ARENA_CHUNK_SIZE 65536
+
+/*!
+ * The initial number of slots of a \a DxfIntern.
+ */
+#define DXF_INTERN_SIZE 64
+
+/*!
+ * The number of structs in a slab of a \a DxfPool.
+ */
+#define DXF_POOL_SLAB_ITEMS 256
+
 /*!
  * \brief DXF color definition, entities with this color follow the color
  * definition of the block in which it lives.
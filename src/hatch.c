@@ -31,6 +31,7 @@
 
 #include "global.h"
 #include "hatch.h"
+#include "writer.h"
 
 /*!
  * \brief Write DXF output to a file for a hatch entity.
@@ -90,8 +91,8 @@
 int
 dxf_write_hatch
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         char *pattern_name,
                 /*!< group code = 2. */
         int id_code,
@@ -190,63 +191,63 @@ dxf_write_hatch
                 fprintf (stderr, "    %s entity is relocated to layer 0", dxf_entity_name);
                 layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
-        fprintf (fp, "100\nAcDbHatch\n");
-        fprintf (fp, "  2\n%s\n", pattern_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
+        dxf_write_group_string (fp, 100, "AcDbHatch");
+        dxf_write_group_string (fp, 2, pattern_name);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
-        fprintf (fp, "210\n%f\n", extr_x0);
-        fprintf (fp, "220\n%f\n", extr_y0);
-        fprintf (fp, "230\n%f\n", extr_z0);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
+        dxf_write_group_double (fp, 210, extr_x0);
+        dxf_write_group_double (fp, 220, extr_y0);
+        dxf_write_group_double (fp, 230, extr_z0);
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
         if (!solid_fill)
         {
-                fprintf (fp, " 42\n%f\n", pattern_scale);
+                dxf_write_group_double (fp, 42, pattern_scale);
         }
-        fprintf (fp, " 47\n%f\n", pixel_size);
+        dxf_write_group_double (fp, 47, pixel_size);
         if (!solid_fill)
         {
-                fprintf (fp, " 52\n%f\n", pattern_angle);
+                dxf_write_group_double (fp, 52, pattern_angle);
         }
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
         if (paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp, " 70\n%d\n", solid_fill);
-        fprintf (fp, " 71\n%d\n", associative);
-        fprintf (fp, " 75\n%d\n", style);
+        dxf_write_group_int (fp, 70, solid_fill);
+        dxf_write_group_int (fp, 71, associative);
+        dxf_write_group_int (fp, 75, style);
         if (!solid_fill)
         {
-                fprintf (fp, " 77\n%d\n", pattern_double);
+                dxf_write_group_int (fp, 77, pattern_double);
         }
-        fprintf (fp, " 78\n%d\n", pattern_def_lines);
-        fprintf (fp, " 98\n%d\n", seed_points);
+        dxf_write_group_int (fp, 78, pattern_def_lines);
+        dxf_write_group_int (fp, 98, seed_points);
         if (!seed_points)
         {
                 for (i = 0; i < seed_points; i++)
                 {
-                        fprintf (fp, " 10\n%f\n", seed_x0[i]);
-                        fprintf (fp, " 20\n%f\n", seed_y0[i]);
+                        dxf_write_group_double (fp, 10, seed_x0[i]);
+                        dxf_write_group_double (fp, 20, seed_y0[i]);
                 }
         }
-        fprintf (fp, " 91\n%d\n", pattern_boundary_paths);
+        dxf_write_group_int (fp, 91, pattern_boundary_paths);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_hatch () function.\n", __FILE__, __LINE__);
 #endif
@@ -261,8 +262,8 @@ Requires AutoCAD version R14 or higher.
 int
 dxf_write_hatch_boundaries
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int hatch_boundary_paths,
                 /*!< group code = 91\n
                  * number of boundary paths (loops). */
@@ -448,8 +449,8 @@ dxf_write_hatch_boundaries
 int
 dxf_write_hatch_boundary_polyline_vertex
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         double x0,
                 /*!< group code = 10\n
                  * X-value of vertex point. */
@@ -465,9 +466,9 @@ dxf_write_hatch_boundary_polyline_vertex
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_write_hatch_boundary_polyline_vertex () function.\n", __FILE__, __LINE__);
 #endif
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        if (bulge != 0.0) fprintf (fp, " 42\n%f\n", bulge);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        if (bulge != 0.0) dxf_write_group_double (fp, 42, bulge);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_hatch_boundary_polyline_vertex () function.\n", __FILE__, __LINE__);
 #endif
@@ -480,8 +481,8 @@ dxf_write_hatch_boundary_polyline_vertex
 int
 dxf_write_hatch_boundary_path_polyline
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int has_bulge,
                 /*!< group code = 72\n
                  * polyline boundary data group only. */
@@ -506,9 +507,9 @@ dxf_write_hatch_boundary_path_polyline
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_write_hatch_boundary_path_polyline () function.\n", __FILE__, __LINE__);
 #endif
         int i;
-        fprintf (fp, " 72\n%d\n", has_bulge);
-        fprintf (fp, " 73\n%d\n", is_closed);
-        fprintf (fp, " 93\n%d\n", vertices);
+        dxf_write_group_int (fp, 72, has_bulge);
+        dxf_write_group_int (fp, 73, is_closed);
+        dxf_write_group_int (fp, 93, vertices);
         /* draw hatch boundary, write (n_coords) XY-coordinate pairs */
         for (i = 0; i < vertices; i++)
         {
@@ -545,8 +546,8 @@ dxf_write_hatch_boundary_path_polyline
 int
 dxf_write_hatch_pattern_def_line_dashes
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int dash_items,
                 /*!< group code = 79\n
                  * array of number of hatch pattern definition line dash
@@ -565,7 +566,7 @@ dxf_write_hatch_pattern_def_line_dashes
                 int i;
                 for (i = 0; i < dash_items; i++)
                 {
-                        fprintf (fp, " 49\n%f\n", dash_length[i]);
+                        dxf_write_group_double (fp, 49, dash_length[i]);
                 }
         }
         else
@@ -584,8 +585,8 @@ dxf_write_hatch_pattern_def_line_dashes
 int
 dxf_write_hatch_pattern_data
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int def_lines,
                 /*!< group code = 78\n
                  * number of hatch pattern definition lines. */
@@ -624,12 +625,12 @@ dxf_write_hatch_pattern_data
                 /* draw hatch pattern definition lines */
                 for (i = 0; i < def_lines; i++)
                 {
-                        fprintf (fp, " 53\n%f\n", def_line_angle[i]);
-                        fprintf (fp, " 43\n%f\n", def_line_x0[i]);
-                        fprintf (fp, " 44\n%f\n", def_line_y0[i]);
-                        fprintf (fp, " 45\n%f\n", def_line_x1[i]);
-                        fprintf (fp, " 46\n%f\n", def_line_y1[i]);
-                        fprintf (fp, " 79\n%d\n", def_line_dash_items[i]);
+                        dxf_write_group_double (fp, 53, def_line_angle[i]);
+                        dxf_write_group_double (fp, 43, def_line_x0[i]);
+                        dxf_write_group_double (fp, 44, def_line_y0[i]);
+                        dxf_write_group_double (fp, 45, def_line_x1[i]);
+                        dxf_write_group_double (fp, 46, def_line_y1[i]);
+                        dxf_write_group_int (fp, 79, def_line_dash_items[i]);
                         if (!def_line_dash_items)
                         {
                                 for (j = 0; j < *def_line_dash_items; j++)
@@ -309,7 +309,7 @@ dxf_hatch
         DxfHatchSeedPoint *points;
 } DxfHatch, * DxfHatchPtr;
 
-int dxf_write_hatch_boundary_path_polyline (FILE *fp,
+int dxf_write_hatch_boundary_path_polyline (DxfWriter *fp,
                                             int has_bulge,
                                             int is_closed,
                                             int vertices,
@@ -35,6 +35,7 @@
 #include "header.h"
 #include "section.h"
 #include "util.h"
+#include "writer.h"
 
 static char *acad_version_string (int version_number)
 {
@@ -595,179 +596,371 @@ dxf_init_header
 static void
 dxf_write_header_metric_new
 (
-        FILE *fp /*!< file pointer to output file (or device) */
+        DxfWriter *fp /*!< DXF file handle of output file (or device) */
 )
 {
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_write_header_metric_new () function.\n", __FILE__, __LINE__);
 #endif
-        fprintf (fp, "  0\nSECTION\n");
-        fprintf (fp, "  2\nHEADER\n");
-        fprintf (fp, "  9\n$ACADVER\n  1\nAC1014\n");
-        fprintf (fp, "  9\n$ACADMAINTVER\n 70\n     0\n");
-        fprintf (fp, "  9\n$DWGCODEPAGE\n  3\nANSI_1252\n");
-        fprintf (fp, "  9\n$INSBASE\n 10\n0.0\n 20\n0.0\n 30\n0.0\n");
-        fprintf (fp, "  9\n$EXTMIN\n 10\n-0.012816\n 20\n-0.009063\n 30\n-0.001526\n");
-        fprintf (fp, "  9\n$EXTMAX\n 10\n88.01056\n 20\n35.022217\n 30\n0.0\n");
-        fprintf (fp, "  9\n$LIMMIN\n 10\n0.0\n 20\n0.0\n");
-        fprintf (fp, "  9\n$LIMMAX\n 10\n420.0\n 20\n297.0\n");
-        fprintf (fp, "  9\n$ORTHOMODE\n 70\n     0\n");
-        fprintf (fp, "  9\n$REGENMODE\n 70\n     1\n");
-        fprintf (fp, "  9\n$FILLMODE\n 70\n     1\n");
-        fprintf (fp, "  9\n$QTEXTMODE\n 70\n     0\n");
-        fprintf (fp, "  9\n$MIRRTEXT\n 70\n     1\n");
-        fprintf (fp, "  9\n$DRAGMODE\n 70\n     2\n");
-        fprintf (fp, "  9\n$LTSCALE\n 40\n1.0\n");
-        fprintf (fp, "  9\n$OSMODE\n 70\n   125\n");
-        fprintf (fp, "  9\n$ATTMODE\n 70\n     1\n");
-        fprintf (fp, "  9\n$TEXTSIZE\n 40\n2.5\n");
-        fprintf (fp, "  9\n$TRACEWID\n 40\n1.0\n");
-        fprintf (fp, "  9\n$TEXTSTYLE\n  7\nSTANDARD\n");
-        fprintf (fp, "  9\n$CLAYER\n  8\n0\n");
-        fprintf (fp, "  9\n$CELTYPE\n  6\nBYLAYER\n");
-        fprintf (fp, "  9\n$CECOLOR\n 62\n   256\n");
-        fprintf (fp, "  9\n$CELTSCALE\n 40\n1.0\n");
-        fprintf (fp, "  9\n$DELOBJ\n 70\n     1\n");
-        fprintf (fp, "  9\n$DISPSILH\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMSCALE\n 40\n1.0\n");
-        fprintf (fp, "  9\n$DIMASZ\n 40\n2.5\n");
-        fprintf (fp, "  9\n$DIMEXO\n 40\n0.625\n");
-        fprintf (fp, "  9\n$DIMDLI\n 40\n3.75\n");
-        fprintf (fp, "  9\n$DIMRND\n 40\n0.0\n");
-        fprintf (fp, "  9\n$DIMDLE\n 40\n0.0\n");
-        fprintf (fp, "  9\n$DIMEXE\n 40\n1.25\n");
-        fprintf (fp, "  9\n$DIMTP\n 40\n0.0\n");
-        fprintf (fp, "  9\n$DIMTM\n 40\n0.0\n");
-        fprintf (fp, "  9\n$DIMTXT\n 40\n2.5\n");
-        fprintf (fp, "  9\n$DIMCEN\n 40\n2.5\n");
-        fprintf (fp, "  9\n$DIMTSZ\n 40\n0.0\n");
-        fprintf (fp, "  9\n$DIMTOL\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMLIM\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMTIH\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMTOH\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMSE1\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMSE2\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMTAD\n 70\n     1\n");
-        fprintf (fp, "  9\n$DIMZIN\n 70\n     8\n");
-        fprintf (fp, "  9\n$DIMBLK\n  1\n\n");
-        fprintf (fp, "  9\n$DIMASO\n 70\n     1\n");
-        fprintf (fp, "  9\n$DIMSHO\n 70\n     1\n");
-        fprintf (fp, "  9\n$DIMPOST\n  1\n\n");
-        fprintf (fp, "  9\n$DIMAPOST\n  1\n\n");
-        fprintf (fp, "  9\n$DIMALT\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMALTD\n 70\n     4\n");
-        fprintf (fp, "  9\n$DIMALTF\n 40\n0.0394\n");
-        fprintf (fp, "  9\n$DIMLFAC\n 40\n1.0\n");
-        fprintf (fp, "  9\n$DIMTOFL\n 70\n     1\n");
-        fprintf (fp, "  9\n$DIMTVP\n 40\n0.0\n");
-        fprintf (fp, "  9\n$DIMTIX\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMSOXD\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMSAH\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMBLK1\n  1\n\n");
-        fprintf (fp, "  9\n$DIMBLK2\n  1\n\n");
-        fprintf (fp, "  9\n$DIMSTYLE\n  2\nSTANDARD\n");
-        fprintf (fp, "  9\n$DIMCLRD\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMCLRE\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMCLRT\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMTFAC\n 40\n1.0\n");
-        fprintf (fp, "  9\n$DIMGAP\n 40\n0.625\n");
-        fprintf (fp, "  9\n$DIMJUST\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMSD1\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMSD2\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMTOLJ\n 70\n     1\n");
-        fprintf (fp, "  9\n$DIMTZIN\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMALTZ\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMALTTZ\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMFIT\n 70\n     3\n");
-        fprintf (fp, "  9\n$DIMUPT\n 70\n     0\n");
-        fprintf (fp, "  9\n$DIMUNIT\n 70\n     2\n");
-        fprintf (fp, "  9\n$DIMDEC\n 70\n     4\n");
-        fprintf (fp, "  9\n$DIMTDEC\n 70\n     4\n");
-        fprintf (fp, "  9\n$DIMALTU\n 70\n     2\n");
-        fprintf (fp, "  9\n$DIMALTTD\n 70\n     2\n");
-        fprintf (fp, "  9\n$DIMTXSTY\n  7\nSTANDARD\n");
-        fprintf (fp, "  9\n$DIMAUNIT\n 70\n     0\n");
-        fprintf (fp, "  9\n$LUNITS\n 70\n     2\n");
-        fprintf (fp, "  9\n$LUPREC\n 70\n     4\n");
-        fprintf (fp, "  9\n$SKETCHINC\n 40\n1.0\n");
-        fprintf (fp, "  9\n$FILLETRAD\n 40\n1.0\n");
-        fprintf (fp, "  9\n$AUNITS\n 70\n     0\n");
-        fprintf (fp, "  9\n$AUPREC\n 70\n     0\n");
-        fprintf (fp, "  9\n$MENU\n  1\n.\n");
-        fprintf (fp, "  9\n$ELEVATION\n 40\n0.0\n");
-        fprintf (fp, "  9\n$PELEVATION\n 40\n0.0\n");
-        fprintf (fp, "  9\n$THICKNESS\n 40\n0.0\n");
-        fprintf (fp, "  9\n$LIMCHECK\n 70\n     0\n");
-        fprintf (fp, "  9\n$BLIPMODE\n 70\n     0\n");
-        fprintf (fp, "  9\n$CHAMFERA\n 40\n10.0\n");
-        fprintf (fp, "  9\n$CHAMFERB\n 40\n10.0\n");
-        fprintf (fp, "  9\n$CHAMFERC\n 40\n0.0\n");
-        fprintf (fp, "  9\n$CHAMFERD\n 40\n0.0\n");
-        fprintf (fp, "  9\n$SKPOLY\n 70\n     0\n");
-        fprintf (fp, "  9\n$TDCREATE\n 40\n2452949.844398842\n");
-        fprintf (fp, "  9\n$TDUPDATE\n 40\n2453105.563639282\n");
-        fprintf (fp, "  9\n$TDINDWG\n 40\n0.0994079282\n");
-        fprintf (fp, "  9\n$TDUSRTIMER\n 40\n0.0994079282\n");
-        fprintf (fp, "  9\n$USRTIMER\n 70\n     1\n");
-        fprintf (fp, "  9\n$ANGBASE\n 50\n0.0\n");
-        fprintf (fp, "  9\n$ANGDIR\n 70\n     0\n");
-        fprintf (fp, "  9\n$PDMODE\n 70\n    98\n");
-        fprintf (fp, "  9\n$PDSIZE\n 40\n0.0\n");
-        fprintf (fp, "  9\n$PLINEWID\n 40\n0.0\n");
-        fprintf (fp, "  9\n$COORDS\n 70\n     2\n");
-        fprintf (fp, "  9\n$SPLFRAME\n 70\n     0\n");
-        fprintf (fp, "  9\n$SPLINETYPE\n 70\n     6\n");
-        fprintf (fp, "  9\n$SPLINESEGS\n 70\n     8\n");
-        fprintf (fp, "  9\n$ATTDIA\n 70\n     0\n");
-        fprintf (fp, "  9\n$ATTREQ\n 70\n     1\n");
-        fprintf (fp, "  9\n$HANDLING\n 70\n     1\n");
-        fprintf (fp, "  9\n$HANDSEED\n  5\n262\n");
-        fprintf (fp, "  9\n$SURFTAB1\n 70\n     6\n");
-        fprintf (fp, "  9\n$SURFTAB2\n 70\n     6\n");
-        fprintf (fp, "  9\n$SURFTYPE\n 70\n     6\n");
-        fprintf (fp, "  9\n$SURFU\n 70\n     6\n");
-        fprintf (fp, "  9\n$SURFV\n 70\n     6\n");
-        fprintf (fp, "  9\n$UCSNAME\n  2\n\n");
-        fprintf (fp, "  9\n$UCSORG\n 10\n0.0\n 20\n0.0\n 30\n0.0\n");
-        fprintf (fp, "  9\n$UCSXDIR\n 10\n1.0\n 20\n0.0\n 30\n0.0\n");
-        fprintf (fp, "  9\n$UCSYDIR\n 10\n0.0\n 20\n1.0\n 30\n0.0\n");
-        fprintf (fp, "  9\n$PUCSNAME\n  2\n\n");
-        fprintf (fp, "  9\n$PUCSORG\n 10\n0.0\n 20\n0.0\n 30\n0.0\n");
-        fprintf (fp, "  9\n$PUCSXDIR\n 10\n1.0\n 20\n0.0\n 30\n0.0\n");
-        fprintf (fp, "  9\n$PUCSYDIR\n 10\n0.0\n 20\n1.0\n 30\n0.0\n");
-        fprintf (fp, "  9\n$USERI1\n 70\n     0\n");
-        fprintf (fp, "  9\n$USERI2\n 70\n     0\n");
-        fprintf (fp, "  9\n$USERI3\n 70\n     0\n");
-        fprintf (fp, "  9\n$USERI4\n 70\n     0\n");
-        fprintf (fp, "  9\n$USERI5\n 70\n     0\n");
-        fprintf (fp, "  9\n$USERR1\n 40\n0.0\n");
-        fprintf (fp, "  9\n$USERR2\n 40\n0.0\n");
-        fprintf (fp, "  9\n$USERR3\n 40\n0.0\n");
-        fprintf (fp, "  9\n$USERR4\n 40\n0.0\n");
-        fprintf (fp, "  9\n$USERR5\n 40\n0.0\n");
-        fprintf (fp, "  9\n$WORLDVIEW\n 70\n     1\n");
-        fprintf (fp, "  9\n$SHADEDGE\n 70\n     3\n");
-        fprintf (fp, "  9\n$SHADEDIF\n 70\n    70\n");
-        fprintf (fp, "  9\n$TILEMODE\n 70\n     1\n");
-        fprintf (fp, "  9\n$MAXACTVP\n 70\n    48\n");
-        fprintf (fp, "  9\n$PINSBASE\n 10\n0.0\n 20\n0.0\n 30\n0.0\n");
-        fprintf (fp, "  9\n$PLIMCHECK\n 70\n     0\n");
-        fprintf (fp, "  9\n$PEXTMIN\n 10\n1.000000E+20\n 20\n1.000000E+20\n 30\n1.000000E+20\n");
-        fprintf (fp, "  9\n$PEXTMAX\n 10\n-1.000000E+20\n 20\n-1.000000E+20\n 30\n-1.000000E+20\n");
-        fprintf (fp, "  9\n$PLIMMIN\n 10\n0.0\n 20\n0.0\n");
-        fprintf (fp, "  9\n$PLIMMAX\n 10\n420.0\n 20\n297.0");
-        fprintf (fp, "  9\n$UNITMODE\n 70\n     0\n");
-        fprintf (fp, "  9\n$VISRETAIN\n 70\n     1\n");
-        fprintf (fp, "  9\n$PLINEGEN\n 70\n     0\n");
-        fprintf (fp, "  9\n$PSLTSCALE\n 70\n     1\n");
-        fprintf (fp, "  9\n$TREEDEPTH\n 70\n  3020\n");
-        fprintf (fp, "  9\n$PICKSTYLE\n 70\n     1\n");
-        fprintf (fp, "  9\n$CMLSTYLE\n  2\nSTANDARD\n");
-        fprintf (fp, "  9\n$CMLJUST\n 70\n     0\n");
-        fprintf (fp, "  9\n$CMLSCALE\n 40\n1.0\n");
-        fprintf (fp, "  9\n$PROXYGRAPHICS\n 70\n     1\n");
-        fprintf (fp, "  9\n$MEASUREMENT\n 70\n     0\n");
-        fprintf (fp, "  0\nENDSEC\n");
+        dxf_write_group_string (fp, 0, "SECTION");
+        dxf_write_group_string (fp, 2, "HEADER");
+        dxf_write_group_string (fp, 9, "$ACADVER");
+        dxf_write_group_string (fp, 1, "AC1014");
+        dxf_write_group_string (fp, 9, "$ACADMAINTVER");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DWGCODEPAGE");
+        dxf_write_group_string (fp, 3, "ANSI_1252");
+        dxf_write_group_string (fp, 9, "$INSBASE");
+        dxf_write_group_double (fp, 10, 0.0);
+        dxf_write_group_double (fp, 20, 0.0);
+        dxf_write_group_double (fp, 30, 0.0);
+        dxf_write_group_string (fp, 9, "$EXTMIN");
+        dxf_write_group_double (fp, 10, -0.012816);
+        dxf_write_group_double (fp, 20, -0.009063);
+        dxf_write_group_double (fp, 30, -0.001526);
+        dxf_write_group_string (fp, 9, "$EXTMAX");
+        dxf_write_group_double (fp, 10, 88.01056);
+        dxf_write_group_double (fp, 20, 35.022217);
+        dxf_write_group_double (fp, 30, 0.0);
+        dxf_write_group_string (fp, 9, "$LIMMIN");
+        dxf_write_group_double (fp, 10, 0.0);
+        dxf_write_group_double (fp, 20, 0.0);
+        dxf_write_group_string (fp, 9, "$LIMMAX");
+        dxf_write_group_double (fp, 10, 420.0);
+        dxf_write_group_double (fp, 20, 297.0);
+        dxf_write_group_string (fp, 9, "$ORTHOMODE");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$REGENMODE");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$FILLMODE");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$QTEXTMODE");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$MIRRTEXT");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$DRAGMODE");
+        dxf_write_group_int (fp, 70, 2);
+        dxf_write_group_string (fp, 9, "$LTSCALE");
+        dxf_write_group_double (fp, 40, 1.0);
+        dxf_write_group_string (fp, 9, "$OSMODE");
+        dxf_write_group_int (fp, 70, 125);
+        dxf_write_group_string (fp, 9, "$ATTMODE");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$TEXTSIZE");
+        dxf_write_group_double (fp, 40, 2.5);
+        dxf_write_group_string (fp, 9, "$TRACEWID");
+        dxf_write_group_double (fp, 40, 1.0);
+        dxf_write_group_string (fp, 9, "$TEXTSTYLE");
+        dxf_write_group_string (fp, 7, "STANDARD");
+        dxf_write_group_string (fp, 9, "$CLAYER");
+        dxf_write_group_string (fp, 8, "0");
+        dxf_write_group_string (fp, 9, "$CELTYPE");
+        dxf_write_group_string (fp, 6, "BYLAYER");
+        dxf_write_group_string (fp, 9, "$CECOLOR");
+        dxf_write_group_int (fp, 62, 256);
+        dxf_write_group_string (fp, 9, "$CELTSCALE");
+        dxf_write_group_double (fp, 40, 1.0);
+        dxf_write_group_string (fp, 9, "$DELOBJ");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$DISPSILH");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMSCALE");
+        dxf_write_group_double (fp, 40, 1.0);
+        dxf_write_group_string (fp, 9, "$DIMASZ");
+        dxf_write_group_double (fp, 40, 2.5);
+        dxf_write_group_string (fp, 9, "$DIMEXO");
+        dxf_write_group_double (fp, 40, 0.625);
+        dxf_write_group_string (fp, 9, "$DIMDLI");
+        dxf_write_group_double (fp, 40, 3.75);
+        dxf_write_group_string (fp, 9, "$DIMRND");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$DIMDLE");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$DIMEXE");
+        dxf_write_group_double (fp, 40, 1.25);
+        dxf_write_group_string (fp, 9, "$DIMTP");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$DIMTM");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$DIMTXT");
+        dxf_write_group_double (fp, 40, 2.5);
+        dxf_write_group_string (fp, 9, "$DIMCEN");
+        dxf_write_group_double (fp, 40, 2.5);
+        dxf_write_group_string (fp, 9, "$DIMTSZ");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$DIMTOL");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMLIM");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMTIH");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMTOH");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMSE1");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMSE2");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMTAD");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$DIMZIN");
+        dxf_write_group_int (fp, 70, 8);
+        dxf_write_group_string (fp, 9, "$DIMBLK");
+        dxf_write_group_string (fp, 1, "");
+        dxf_write_group_string (fp, 9, "$DIMASO");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$DIMSHO");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$DIMPOST");
+        dxf_write_group_string (fp, 1, "");
+        dxf_write_group_string (fp, 9, "$DIMAPOST");
+        dxf_write_group_string (fp, 1, "");
+        dxf_write_group_string (fp, 9, "$DIMALT");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMALTD");
+        dxf_write_group_int (fp, 70, 4);
+        dxf_write_group_string (fp, 9, "$DIMALTF");
+        dxf_write_group_double (fp, 40, 0.0394);
+        dxf_write_group_string (fp, 9, "$DIMLFAC");
+        dxf_write_group_double (fp, 40, 1.0);
+        dxf_write_group_string (fp, 9, "$DIMTOFL");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$DIMTVP");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$DIMTIX");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMSOXD");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMSAH");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMBLK1");
+        dxf_write_group_string (fp, 1, "");
+        dxf_write_group_string (fp, 9, "$DIMBLK2");
+        dxf_write_group_string (fp, 1, "");
+        dxf_write_group_string (fp, 9, "$DIMSTYLE");
+        dxf_write_group_string (fp, 2, "STANDARD");
+        dxf_write_group_string (fp, 9, "$DIMCLRD");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMCLRE");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMCLRT");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMTFAC");
+        dxf_write_group_double (fp, 40, 1.0);
+        dxf_write_group_string (fp, 9, "$DIMGAP");
+        dxf_write_group_double (fp, 40, 0.625);
+        dxf_write_group_string (fp, 9, "$DIMJUST");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMSD1");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMSD2");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMTOLJ");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$DIMTZIN");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMALTZ");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMALTTZ");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMFIT");
+        dxf_write_group_int (fp, 70, 3);
+        dxf_write_group_string (fp, 9, "$DIMUPT");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$DIMUNIT");
+        dxf_write_group_int (fp, 70, 2);
+        dxf_write_group_string (fp, 9, "$DIMDEC");
+        dxf_write_group_int (fp, 70, 4);
+        dxf_write_group_string (fp, 9, "$DIMTDEC");
+        dxf_write_group_int (fp, 70, 4);
+        dxf_write_group_string (fp, 9, "$DIMALTU");
+        dxf_write_group_int (fp, 70, 2);
+        dxf_write_group_string (fp, 9, "$DIMALTTD");
+        dxf_write_group_int (fp, 70, 2);
+        dxf_write_group_string (fp, 9, "$DIMTXSTY");
+        dxf_write_group_string (fp, 7, "STANDARD");
+        dxf_write_group_string (fp, 9, "$DIMAUNIT");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$LUNITS");
+        dxf_write_group_int (fp, 70, 2);
+        dxf_write_group_string (fp, 9, "$LUPREC");
+        dxf_write_group_int (fp, 70, 4);
+        dxf_write_group_string (fp, 9, "$SKETCHINC");
+        dxf_write_group_double (fp, 40, 1.0);
+        dxf_write_group_string (fp, 9, "$FILLETRAD");
+        dxf_write_group_double (fp, 40, 1.0);
+        dxf_write_group_string (fp, 9, "$AUNITS");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$AUPREC");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$MENU");
+        dxf_write_group_string (fp, 1, ".");
+        dxf_write_group_string (fp, 9, "$ELEVATION");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$PELEVATION");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$THICKNESS");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$LIMCHECK");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$BLIPMODE");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$CHAMFERA");
+        dxf_write_group_double (fp, 40, 10.0);
+        dxf_write_group_string (fp, 9, "$CHAMFERB");
+        dxf_write_group_double (fp, 40, 10.0);
+        dxf_write_group_string (fp, 9, "$CHAMFERC");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$CHAMFERD");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$SKPOLY");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$TDCREATE");
+        dxf_write_group_double (fp, 40, 2452949.844398842);
+        dxf_write_group_string (fp, 9, "$TDUPDATE");
+        dxf_write_group_double (fp, 40, 2453105.563639282);
+        dxf_write_group_string (fp, 9, "$TDINDWG");
+        dxf_write_group_double (fp, 40, 0.0994079282);
+        dxf_write_group_string (fp, 9, "$TDUSRTIMER");
+        dxf_write_group_double (fp, 40, 0.0994079282);
+        dxf_write_group_string (fp, 9, "$USRTIMER");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$ANGBASE");
+        dxf_write_group_double (fp, 50, 0.0);
+        dxf_write_group_string (fp, 9, "$ANGDIR");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$PDMODE");
+        dxf_write_group_int (fp, 70, 98);
+        dxf_write_group_string (fp, 9, "$PDSIZE");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$PLINEWID");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$COORDS");
+        dxf_write_group_int (fp, 70, 2);
+        dxf_write_group_string (fp, 9, "$SPLFRAME");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$SPLINETYPE");
+        dxf_write_group_int (fp, 70, 6);
+        dxf_write_group_string (fp, 9, "$SPLINESEGS");
+        dxf_write_group_int (fp, 70, 8);
+        dxf_write_group_string (fp, 9, "$ATTDIA");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$ATTREQ");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$HANDLING");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$HANDSEED");
+        dxf_write_group_string (fp, 5, "262");
+        dxf_write_group_string (fp, 9, "$SURFTAB1");
+        dxf_write_group_int (fp, 70, 6);
+        dxf_write_group_string (fp, 9, "$SURFTAB2");
+        dxf_write_group_int (fp, 70, 6);
+        dxf_write_group_string (fp, 9, "$SURFTYPE");
+        dxf_write_group_int (fp, 70, 6);
+        dxf_write_group_string (fp, 9, "$SURFU");
+        dxf_write_group_int (fp, 70, 6);
+        dxf_write_group_string (fp, 9, "$SURFV");
+        dxf_write_group_int (fp, 70, 6);
+        dxf_write_group_string (fp, 9, "$UCSNAME");
+        dxf_write_group_string (fp, 2, "");
+        dxf_write_group_string (fp, 9, "$UCSORG");
+        dxf_write_group_double (fp, 10, 0.0);
+        dxf_write_group_double (fp, 20, 0.0);
+        dxf_write_group_double (fp, 30, 0.0);
+        dxf_write_group_string (fp, 9, "$UCSXDIR");
+        dxf_write_group_double (fp, 10, 1.0);
+        dxf_write_group_double (fp, 20, 0.0);
+        dxf_write_group_double (fp, 30, 0.0);
+        dxf_write_group_string (fp, 9, "$UCSYDIR");
+        dxf_write_group_double (fp, 10, 0.0);
+        dxf_write_group_double (fp, 20, 1.0);
+        dxf_write_group_double (fp, 30, 0.0);
+        dxf_write_group_string (fp, 9, "$PUCSNAME");
+        dxf_write_group_string (fp, 2, "");
+        dxf_write_group_string (fp, 9, "$PUCSORG");
+        dxf_write_group_double (fp, 10, 0.0);
+        dxf_write_group_double (fp, 20, 0.0);
+        dxf_write_group_double (fp, 30, 0.0);
+        dxf_write_group_string (fp, 9, "$PUCSXDIR");
+        dxf_write_group_double (fp, 10, 1.0);
+        dxf_write_group_double (fp, 20, 0.0);
+        dxf_write_group_double (fp, 30, 0.0);
+        dxf_write_group_string (fp, 9, "$PUCSYDIR");
+        dxf_write_group_double (fp, 10, 0.0);
+        dxf_write_group_double (fp, 20, 1.0);
+        dxf_write_group_double (fp, 30, 0.0);
+        dxf_write_group_string (fp, 9, "$USERI1");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$USERI2");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$USERI3");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$USERI4");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$USERI5");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$USERR1");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$USERR2");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$USERR3");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$USERR4");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$USERR5");
+        dxf_write_group_double (fp, 40, 0.0);
+        dxf_write_group_string (fp, 9, "$WORLDVIEW");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$SHADEDGE");
+        dxf_write_group_int (fp, 70, 3);
+        dxf_write_group_string (fp, 9, "$SHADEDIF");
+        dxf_write_group_int (fp, 70, 70);
+        dxf_write_group_string (fp, 9, "$TILEMODE");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$MAXACTVP");
+        dxf_write_group_int (fp, 70, 48);
+        dxf_write_group_string (fp, 9, "$PINSBASE");
+        dxf_write_group_double (fp, 10, 0.0);
+        dxf_write_group_double (fp, 20, 0.0);
+        dxf_write_group_double (fp, 30, 0.0);
+        dxf_write_group_string (fp, 9, "$PLIMCHECK");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$PEXTMIN");
+        dxf_write_group_string (fp, 10, "1.000000E+20");
+        dxf_write_group_string (fp, 20, "1.000000E+20");
+        dxf_write_group_string (fp, 30, "1.000000E+20");
+        dxf_write_group_string (fp, 9, "$PEXTMAX");
+        dxf_write_group_string (fp, 10, "-1.000000E+20");
+        dxf_write_group_string (fp, 20, "-1.000000E+20");
+        dxf_write_group_string (fp, 30, "-1.000000E+20");
+        dxf_write_group_string (fp, 9, "$PLIMMIN");
+        dxf_write_group_double (fp, 10, 0.0);
+        dxf_write_group_double (fp, 20, 0.0);
+        dxf_write_group_string (fp, 9, "$PLIMMAX");
+        dxf_write_group_double (fp, 10, 420.0);
+        dxf_write_group_double (fp, 20, 297.0);
+        dxf_write_group_string (fp, 9, "$UNITMODE");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$VISRETAIN");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$PLINEGEN");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$PSLTSCALE");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$TREEDEPTH");
+        dxf_write_group_int (fp, 70, 3020);
+        dxf_write_group_string (fp, 9, "$PICKSTYLE");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$CMLSTYLE");
+        dxf_write_group_string (fp, 2, "STANDARD");
+        dxf_write_group_string (fp, 9, "$CMLJUST");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 9, "$CMLSCALE");
+        dxf_write_group_double (fp, 40, 1.0);
+        dxf_write_group_string (fp, 9, "$PROXYGRAPHICS");
+        dxf_write_group_int (fp, 70, 1);
+        dxf_write_group_string (fp, 9, "$MEASUREMENT");
+        dxf_write_group_int (fp, 70, 0);
+        dxf_write_group_string (fp, 0, "ENDSEC");
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_header_metric_new () function.\n", __FILE__, __LINE__);
 #endif
@@ -780,8 +973,8 @@ dxf_write_header_metric_new
 int
 dxf_write_header
 (
-        FILE *fp,
-                /*!< DXF file handle of input file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfHeader dxf_header,
                 /*!< DXF header entity. */
         int acad_version_number
@@ -793,228 +986,787 @@ dxf_write_header
         char *dxf_entity_name = strdup ("HEADER");
 
         dxf_section_write (fp, dxf_entity_name);
-        fprintf (fp, "  9\n$ACADVER\n  1\n%s\n", dxf_header.AcadVer);
-        if (acad_version_number >= AC1014) fprintf (fp, "  9\n$ACADMAINTVER\n 70\n%i\n", dxf_header.AcadMaintVer);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DWGCODEPAGE\n  3\n%s\n", dxf_header.DWGCodePage);
-        fprintf (fp, "  9\n$INSBASE\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.InsBase.x0, dxf_header.InsBase.y0, dxf_header.InsBase.z0);
-        fprintf (fp, "  9\n$EXTMIN\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.ExtMin.x0, dxf_header.ExtMin.y0, dxf_header.ExtMin.z0);
-        fprintf (fp, "  9\n$EXTMAX\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.ExtMax.x0, dxf_header.ExtMax.y0, dxf_header.ExtMax.z0);
-        fprintf (fp, "  9\n$LIMMIN\n 10\n%f\n 20\n%f\n", dxf_header.LimMin.x0, dxf_header.LimMin.y0);
-        fprintf (fp, "  9\n$LIMMAX\n 10\n%f\n 20\n%f\n", dxf_header.LimMax.x0, dxf_header.LimMax.y0);
-        fprintf (fp, "  9\n$ORTHOMODE\n 70\n%i\n", dxf_header.OrthoMode);
-        fprintf (fp, "  9\n$REGENMODE\n 70\n%i\n", dxf_header.RegenMode);
-        fprintf (fp, "  9\n$FILLMODE\n 70\n%i\n", dxf_header.FillMode);
-        fprintf (fp, "  9\n$QTEXTMODE\n 70\n%i\n", dxf_header.QTextMode);
-        fprintf (fp, "  9\n$MIRRTEXT\n 70\n%i\n", dxf_header.MirrText);
-        if (acad_version_number <= AC1015) fprintf (fp, "  9\n$DRAGMODE\n 70\n%i\n", dxf_header.DragMode);
-        fprintf (fp, "  9\n$LTSCALE\n 40\n%f\n", dxf_header.LTScale);
-        if (acad_version_number <= AC1014) fprintf (fp, "  9\n$OSMODE\n 70\n%i\n", dxf_header.OSMode);
-        fprintf (fp, "  9\n$ATTMODE\n 70\n%i\n", dxf_header.AttMode);
-        fprintf (fp, "  9\n$TEXTSIZE\n 40\n%f\n", dxf_header.TextSize);
-        fprintf (fp, "  9\n$TRACEWID\n 40\n%f\n", dxf_header.TraceWid);
-        fprintf (fp, "  9\n$TEXTSTYLE\n  7\n%s\n", dxf_header.TextStyle);
-        fprintf (fp, "  9\n$CLAYER\n  8\n%s\n", dxf_header.CLayer);
-        fprintf (fp, "  9\n$CELTYPE\n  6\n%s\n", dxf_header.CELType);
-        fprintf (fp, "  9\n$CECOLOR\n 62\n%i\n", dxf_header.CEColor);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$CELTSCALE\n 40\n%f\n", dxf_header.CELTScale);
-        if ((acad_version_number == AC1012) || (acad_version_number == AC1014)) fprintf (fp, "  9\n$DELOBJ\n 70\n%i\n", dxf_header.DelObj);
-        if (acad_version_number <= AC1012) fprintf (fp, "  9\n$DISPSILH\n 70\n%i\n", dxf_header.DispSilH);
-        fprintf (fp, "  9\n$DIMSCALE\n 40\n%f\n", dxf_header.DimSCALE);
-        fprintf (fp, "  9\n$DIMASZ\n 40\n%f\n", dxf_header.DimASZ);
-        fprintf (fp, "  9\n$DIMEXO\n 40\n%f\n", dxf_header.DimEXO);
-        fprintf (fp, "  9\n$DIMDLI\n 40\n%f\n", dxf_header.DimDLI);
-        fprintf (fp, "  9\n$DIMRND\n 40\n%f\n", dxf_header.DimRND);
-        fprintf (fp, "  9\n$DIMDLE\n 40\n%f\n", dxf_header.DimDLE);
-        fprintf (fp, "  9\n$DIMEXE\n 40\n%f\n", dxf_header.DimEXE);
-        fprintf (fp, "  9\n$DIMTP\n 40\n%f\n", dxf_header.DimTP);
-        fprintf (fp, "  9\n$DIMTM\n 40\n%f\n", dxf_header.DimTM);
-        fprintf (fp, "  9\n$DIMTXT\n 40\n%f\n", dxf_header.DimTXT);
-        fprintf (fp, "  9\n$DIMCEN\n 40\n%f\n", dxf_header.DimCEN);
-        fprintf (fp, "  9\n$DIMTSZ\n 40\n%f\n", dxf_header.DimTSZ);
-        fprintf (fp, "  9\n$DIMTOL\n 70\n%i\n", dxf_header.DimTOL);
-        fprintf (fp, "  9\n$DIMLIM\n 70\n%i\n", dxf_header.DimLIM);
-        fprintf (fp, "  9\n$DIMTIH\n 70\n%i\n", dxf_header.DimTIH);
-        fprintf (fp, "  9\n$DIMTOH\n 70\n%i\n", dxf_header.DimTOH);
-        fprintf (fp, "  9\n$DIMSE1\n 70\n%i\n", dxf_header.DimSE1);
-        fprintf (fp, "  9\n$DIMSE2\n 70\n%i\n", dxf_header.DimSE2);
-        fprintf (fp, "  9\n$DIMTAD\n 70\n%i\n", dxf_header.DimTAD);
-        fprintf (fp, "  9\n$DIMZIN\n 70\n%i\n", dxf_header.DimZIN);
-        fprintf (fp, "  9\n$DIMBLK\n  1\n%s\n", dxf_header.DimBLK);
-        fprintf (fp, "  9\n$DIMASO\n 70\n%i\n", dxf_header.DimASO);
-        fprintf (fp, "  9\n$DIMSHO\n 70\n%i\n", dxf_header.DimSHO);
-        fprintf (fp, "  9\n$DIMPOST\n  1\n%s\n", dxf_header.DimPOST);
-        fprintf (fp, "  9\n$DIMAPOST\n  1\n%s\n", dxf_header.DimAPOST);
-        fprintf (fp, "  9\n$DIMALT\n 70\n%i\n", dxf_header.DimALT);
-        fprintf (fp, "  9\n$DIMALTD\n 70\n%i\n", dxf_header.DimALTD);
-        fprintf (fp, "  9\n$DIMALTF\n 40\n%f\n", dxf_header.DimALTF);
-        fprintf (fp, "  9\n$DIMLFAC\n 40\n%f\n", dxf_header.DimLFAC);
-        fprintf (fp, "  9\n$DIMTOFL\n 70\n%i\n", dxf_header.DimTOFL);
-        fprintf (fp, "  9\n$DIMTVP\n 40\n%f\n", dxf_header.DimTVP);
-        fprintf (fp, "  9\n$DIMTIX\n 70\n%i\n", dxf_header.DimTIX);
-        fprintf (fp, "  9\n$DIMSOXD\n 70\n%i\n", dxf_header.DimSOXD);
-        fprintf (fp, "  9\n$DIMSAH\n 70\n%i\n", dxf_header.DimSAH);
-        fprintf (fp, "  9\n$DIMBLK1\n  1\n%s\n", dxf_header.DimBLK1);
-        fprintf (fp, "  9\n$DIMBLK2\n  1\n%s\n", dxf_header.DimBLK2);
-        fprintf (fp, "  9\n$DIMSTYLE\n  2\n%s\n", dxf_header.DimSTYLE);
-        fprintf (fp, "  9\n$DIMCLRD\n 70\n%i\n", dxf_header.DimCLRD);
-        fprintf (fp, "  9\n$DIMCLRE\n 70\n%i\n", dxf_header.DimCLRE);
-        fprintf (fp, "  9\n$DIMCLRT\n 70\n%i\n", dxf_header.DimCLRT);
-        fprintf (fp, "  9\n$DIMTFAC\n 40\n%f\n", dxf_header.DimTFAC);
-        fprintf (fp, "  9\n$DIMGAP\n 40\n%f\n", dxf_header.DimGAP);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMJUST\n 70\n%i\n", dxf_header.DimJUST);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMSD1\n 70\n%i\n", dxf_header.DimSD1);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMSD2\n 70\n%i\n", dxf_header.DimSD2);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMTOLJ\n 70\n%i\n", dxf_header.DimTOLJ);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMTZIN\n 70\n%i\n", dxf_header.DimTZIN);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMALTZ\n 70\n%i\n", dxf_header.DimALTZ);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMALTTZ\n 70\n%i\n", dxf_header.DimALTTZ);
-        if ((acad_version_number == AC1012) || (acad_version_number == AC1014)) fprintf (fp, "  9\n$DIMFIT\n 70\n%i\n", dxf_header.DimFIT);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMUPT\n 70\n%i\n", dxf_header.DimUPT);
-        if ((acad_version_number == AC1012) || (acad_version_number == AC1014)) fprintf (fp, "  9\n$DIMUNIT\n 70\n%i\n", dxf_header.DimUNIT);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMDEC\n 70\n%i\n", dxf_header.DimDEC);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMTDEC\n 70\n%i\n", dxf_header.DimTDEC);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMALTU\n 70\n%i\n", dxf_header.DimALTU);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMALTTD\n 70\n%i\n", dxf_header.DimALTTD);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMTXSTY\n  7\n%s\n", dxf_header.DimTXSTY);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMAUNIT\n 70\n%i\n", dxf_header.DimAUNIT);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMADEC\n 70\n%i\n", dxf_header.DimADEC);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMALTRND\n 40\n%f\n", dxf_header.DimALTRND);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMAZIN\n 70\n%i\n", dxf_header.DimAZIN);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMDSEP\n 70\n%i\n", dxf_header.DimDSEP);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMATFIT\n 70\n%i\n", dxf_header.DimATFIT);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMFRAC\n 70\n%i\n", dxf_header.DimFRAC);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMLDRBLK\n  1\n%s\n", dxf_header.DimLDRBLK);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMLUNIT\n 70\n%i\n", dxf_header.DimLUNIT);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMLWD\n 70\n%i\n", dxf_header.DimLWD);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMLWE\n 70\n%i\n", dxf_header.DimLWE);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMTMOVE\n 70\n%i\n", dxf_header.DimTMOVE);
-        fprintf (fp, "  9\n$LUNITS\n 70\n%i\n", dxf_header.LUnits);
-        fprintf (fp, "  9\n$LUPREC\n 70\n%i\n", dxf_header.LUPrec);
-        fprintf (fp, "  9\n$SKETCHINC\n 40\n%f\n", dxf_header.Sketchinc);
-        fprintf (fp, "  9\n$FILLETRAD\n 40\n%f\n", dxf_header.FilletRad);
-        fprintf (fp, "  9\n$AUNITS\n 70\n%i\n", dxf_header.AUnits);
-        fprintf (fp, "  9\n$AUPREC\n 70\n%i\n", dxf_header.AUPrec);
-        fprintf (fp, "  9\n$MENU\n  1\n%s\n", dxf_header.Menu);
-        fprintf (fp, "  9\n$ELEVATION\n 40\n%f\n", dxf_header.Elevation);
-        fprintf (fp, "  9\n$PELEVATION\n 40\n%f\n", dxf_header.PElevation);
-        fprintf (fp, "  9\n$THICKNESS\n 40\n%f\n", dxf_header.Thickness);
-        fprintf (fp, "  9\n$LIMCHECK\n 70\n%i\n", dxf_header.LimCheck);
-        if (acad_version_number <= AC1014) fprintf (fp, "  9\n$BLIPMODE\n 70\n%i\n", dxf_header.BlipMode);
-        fprintf (fp, "  9\n$CHAMFERA\n 40\n%f\n", dxf_header.ChamferA);
-        fprintf (fp, "  9\n$CHAMFERB\n 40\n%f\n", dxf_header.ChamferB);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$CHAMFERC\n 40\n%f\n", dxf_header.ChamferC);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$CHAMFERD\n 40\n%f\n", dxf_header.ChamferD);
-        fprintf (fp, "  9\n$SKPOLY\n 70\n%i\n", dxf_header.SKPoly);
-        fprintf (fp, "  9\n$TDCREATE\n 40\n%f\n", dxf_header.TDCreate);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$TDUCREATE\n 40\n%f\n", dxf_header.TDUCreate);
-        fprintf (fp, "  9\n$TDUPDATE\n 40\n%f\n", dxf_header.TDUpdate);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$TDUUPDATE\n 40\n%f\n", dxf_header.TDUUpdate);
-        fprintf (fp, "  9\n$TDINDWG\n 40\n%f\n", dxf_header.TDInDWG);
-        fprintf (fp, "  9\n$TDUSRTIMER\n 40\n%f\n", dxf_header.TDUSRTimer);
-        fprintf (fp, "  9\n$USRTIMER\n 70\n%i\n", dxf_header.USRTimer);
-        fprintf (fp, "  9\n$ANGBASE\n 50\n%f\n", dxf_header.AngBase);
-        fprintf (fp, "  9\n$ANGDIR\n 70\n%i\n", dxf_header.AngDir);
-        fprintf (fp, "  9\n$PDMODE\n 70\n%i\n", dxf_header.PDMode);
-        fprintf (fp, "  9\n$PDSIZE\n 40\n%f\n", dxf_header.PDSize);
-        fprintf (fp, "  9\n$PLINEWID\n 40\n%f\n", dxf_header.PLineWid);
-        if (acad_version_number <= AC1014) fprintf (fp, "  9\n$COORDS\n 70\n%i\n", dxf_header.Coords);
-        fprintf (fp, "  9\n$SPLFRAME\n 70\n%i\n", dxf_header.SPLFrame);
-        fprintf (fp, "  9\n$SPLINETYPE\n 70\n%i\n", dxf_header.SPLineType);
-        if (acad_version_number <= AC1014) fprintf (fp, "  9\n$ATTDIA\n 70\n%i\n", dxf_header.AttDia);
-        if (acad_version_number <= AC1014) fprintf (fp, "  9\n$ATTREQ\n 70\n%i\n", dxf_header.AttReq);
-        if (acad_version_number <= AC1014) fprintf (fp, "  9\n$HANDLING\n 70\n%i\n", dxf_header.Handling);
-        fprintf (fp, "  9\n$SPLINESEGS\n 70\n%i\n", dxf_header.SPLineSegs);
-        fprintf (fp, "  9\n$HANDSEED\n  5\n%s\n", dxf_header.HandSeed);
-        fprintf (fp, "  9\n$SURFTAB1\n 70\n%i\n", dxf_header.SurfTab1);
-        fprintf (fp, "  9\n$SURFTAB2\n 70\n%i\n", dxf_header.SurfTab2);
-        fprintf (fp, "  9\n$SURFTYPE\n 70\n%i\n", dxf_header.SurfType);
-        fprintf (fp, "  9\n$SURFU\n 70\n%i\n", dxf_header.SurfU);
-        fprintf (fp, "  9\n$SURFV\n 70\n%i\n", dxf_header.SurfV);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSBASE\n  2\n%s\n", dxf_header.UCSBase);
-        fprintf (fp, "  9\n$UCSNAME\n  2\n%s\n", dxf_header.UCSName);
-        fprintf (fp, "  9\n$UCSORG\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSOrg.x0, dxf_header.UCSOrg.y0, dxf_header.UCSOrg.z0);
-        fprintf (fp, "  9\n$UCSXDIR\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSXDir.x0, dxf_header.UCSXDir.y0, dxf_header.UCSXDir.z0);
-        fprintf (fp, "  9\n$UCSYDIR\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSYDir.x0, dxf_header.UCSYDir.y0, dxf_header.UCSYDir.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORTHOREF\n  2\n%s\n", dxf_header.UCSOrthoRef);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORTHOVIEW\n 70\n%i\n", dxf_header.UCSOrthoView);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGTOP\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSOrgTop.x0, dxf_header.UCSOrgTop.y0, dxf_header.UCSOrgTop.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGBOTTOM\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSOrgBottom.x0, dxf_header.UCSOrgBottom.y0, dxf_header.UCSOrgBottom.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGLEFT\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSOrgLeft.x0, dxf_header.UCSOrgLeft.y0, dxf_header.UCSOrgLeft.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGRIGHT\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSOrgRight.x0, dxf_header.UCSOrgRight.y0, dxf_header.UCSOrgRight.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGFRONT\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSOrgFront.x0, dxf_header.UCSOrgFront.y0, dxf_header.UCSOrgFront.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGBACK\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSOrgBack.x0, dxf_header.UCSOrgBack.y0, dxf_header.UCSOrgBack.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSBASE\n  2\n%s\n", dxf_header.PUCSBase);
-        fprintf (fp, "  9\n$PUCSNAME\n  2\n%s\n", dxf_header.PUCSName);
-        fprintf (fp, "  9\n$PUCSORG\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSOrg.x0, dxf_header.PUCSOrg.y0, dxf_header.PUCSOrg.z0);
-        fprintf (fp, "  9\n$PUCSXDIR\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSXDir.x0, dxf_header.PUCSXDir.y0, dxf_header.PUCSXDir.z0);
-        fprintf (fp, "  9\n$PUCSYDIR\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSYDir.x0, dxf_header.PUCSYDir.y0, dxf_header.PUCSYDir.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORTHOREF\n  2\n%s\n", dxf_header.PUCSOrthoRef);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORTHOVIEW\n 70\n%i\n", dxf_header.PUCSOrthoView);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGTOP\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSOrgTop.x0, dxf_header.PUCSOrgTop.y0, dxf_header.PUCSOrgTop.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGBOTTOM\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSOrgBottom.x0, dxf_header.PUCSOrgBottom.y0, dxf_header.PUCSOrgBottom.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGLEFT\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSOrgLeft.x0, dxf_header.PUCSOrgLeft.y0, dxf_header.PUCSOrgLeft.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGRIGHT\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSOrgRight.x0, dxf_header.PUCSOrgRight.y0, dxf_header.PUCSOrgRight.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGFRONT\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSOrgFront.x0, dxf_header.PUCSOrgFront.y0, dxf_header.PUCSOrgFront.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGBACK\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSOrgBack.x0, dxf_header.PUCSOrgBack.y0, dxf_header.PUCSOrgBack.z0);
-        fprintf (fp, "  9\n$USERI1\n 70\n%i\n", dxf_header.UserI1);
-        fprintf (fp, "  9\n$USERI2\n 70\n%i\n", dxf_header.UserI2);
-        fprintf (fp, "  9\n$USERI3\n 70\n%i\n", dxf_header.UserI3);
-        fprintf (fp, "  9\n$USERI4\n 70\n%i\n", dxf_header.UserI4);
-        fprintf (fp, "  9\n$USERI5\n 70\n%i\n", dxf_header.UserI5);
-        fprintf (fp, "  9\n$USERR1\n 40\n%f\n", dxf_header.UserR1);
-        fprintf (fp, "  9\n$USERR2\n 40\n%f\n", dxf_header.UserR2);
-        fprintf (fp, "  9\n$USERR3\n 40\n%f\n", dxf_header.UserR3);
-        fprintf (fp, "  9\n$USERR4\n 40\n%f\n", dxf_header.UserR4);
-        fprintf (fp, "  9\n$USERR5\n 40\n%f\n", dxf_header.UserR5);
-        fprintf (fp, "  9\n$WORLDVIEW\n 70\n%i\n", dxf_header.WorldView);
-        fprintf (fp, "  9\n$SHADEDGE\n 70\n%i\n", dxf_header.ShadEdge);
-        fprintf (fp, "  9\n$SHADEDIF\n 70\n%i\n", dxf_header.ShadeDif);
-        fprintf (fp, "  9\n$TILEMODE\n 70\n%i\n", dxf_header.TileMode);
-        fprintf (fp, "  9\n$MAXACTVP\n 70\n%i\n", dxf_header.MaxActVP);
-        fprintf (fp, "  9\n$PINSBASE\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PInsBase.x0, dxf_header.PInsBase.y0, dxf_header.PInsBase.z0);
-        fprintf (fp, "  9\n$PLIMCHECK\n 70\n%i\n", dxf_header.PLimCheck);
-        fprintf (fp, "  9\n$PEXTMIN\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PExtMin.x0, dxf_header.PExtMin.y0, dxf_header.PExtMin.z0);
-        fprintf (fp, "  9\n$PEXTMAX\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PExtMax.x0, dxf_header.PExtMax.y0, dxf_header.PExtMax.z0);
-        fprintf (fp, "  9\n$PLIMMIN\n 10\n%f\n 20\n%f\n", dxf_header.PLimMin.x0, dxf_header.PLimMin.y0);
-        fprintf (fp, "  9\n$PLIMMAX\n 10\n%f\n 20\n%f\n", dxf_header.PLimMax.x0, dxf_header.PLimMax.y0);
-        fprintf (fp, "  9\n$UNITMODE\n 70\n%i\n", dxf_header.UnitMode);
-        fprintf (fp, "  9\n$VISRETAIN\n 70\n%i\n", dxf_header.VisRetain);
-        fprintf (fp, "  9\n$PLINEGEN\n 70\n%i\n", dxf_header.PLineGen);
-        fprintf (fp, "  9\n$PSLTSCALE\n 70\n%i\n", dxf_header.PSLTScale);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$TREEDEPTH\n 70\n%i\n", dxf_header.TreeDepth);
-        if ((acad_version_number == AC1012) || (acad_version_number == AC1014)) fprintf (fp, "  9\n$PICKSTYLE\n 70\n%i\n", dxf_header.PickStyle);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$CMLSTYLE\n  2\n%s\n", dxf_header.CMLStyle);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$CMLJUST\n 70\n%i\n", dxf_header.CMLJust);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$CMLSCALE\n 40\n%f\n", dxf_header.CMLScale);
-        if (acad_version_number >= AC1014) fprintf (fp, "  9\n$PROXYGRAPHICS\n 70\n%i\n", dxf_header.ProxyGraphics);
-        if (acad_version_number >= AC1014) fprintf (fp, "  9\n$MEASUREMENT\n 70\n%i\n", dxf_header.Measurement);
-        if (acad_version_number == AC1012) fprintf (fp, "  9\n$SAVEIMAGES\n 70\n%i\n", dxf_header.SaveImages);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$CELWEIGHT\n370\n%i\n", dxf_header.CELWeight);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$ENDCAPS\n280\n%i\n", dxf_header.EndCaps);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$JOINSTYLE\n280\n%i\n", dxf_header.JoinStyle);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$LWDISPLAY\n290\n%i\n", dxf_header.LWDisplay);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$INSUNITS\n 70\n%i\n", dxf_header.InsUnits);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$HYPERLINKBASE\n  1\n%s\n", dxf_header.HyperLinkBase);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$STYLESHEET\n  1\n%s\n", dxf_header.StyleSheet);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$XEDIT\n290\n%i\n", dxf_header.XEdit);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$CEPSNTYPE\n380\n%i\n", dxf_header.CEPSNType);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PSTYLEMODE\n290\n%i\n", dxf_header.PStyleMode);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$FINGERPRINTGUID\n  2\n%s\n", dxf_header.FingerPrintGUID);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$VERSIONGUID\n  2\n%s\n", dxf_header.VersionGUID);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$EXTNAMES\n290\n%i\n", dxf_header.ExtNames);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PSVPSCALE\n 40\n%f\n", dxf_header.PSVPScale);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$OLESTARTUP\n290\n%i\n", dxf_header.OLEStartUp);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$SORTENTS\n280\n%i\n", dxf_header.SortEnts);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$INDEXCTL\n280\n%i\n", dxf_header.IndexCtl);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$HIDETEXT\n280\n%i\n", dxf_header.HideText);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$XCLIPFRAME\n290\n%i\n", dxf_header.XClipFrame);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$HALOGAP\n280\n%i\n", dxf_header.HaloGap);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$OBSCOLOR\n 70\n%i\n", dxf_header.ObsColor);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$OBSLTYPE\n280\n%i\n", dxf_header.ObsLType);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$INTERSECTIONDISPLAY\n280\n%i\n", dxf_header.InterSectionDisplay);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$INTERSECTIONCOLOR\n 70\n%i\n", dxf_header.InterSectionColor);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$DIMASSOC\n280\n%i\n", dxf_header.DimASSOC);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$PROJECTNAME\n  1\n%s\n", dxf_header.ProjectName);
+        dxf_write_group_string (fp, 9, "$ACADVER");
+        dxf_write_group_string (fp, 1, dxf_header.AcadVer);
+        if (acad_version_number >= AC1014)
+        {
+                dxf_write_group_string (fp, 9, "$ACADMAINTVER");
+                dxf_write_group_int (fp, 70, dxf_header.AcadMaintVer);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DWGCODEPAGE");
+                dxf_write_group_string (fp, 3, dxf_header.DWGCodePage);
+        }
+        dxf_write_group_string (fp, 9, "$INSBASE");
+        dxf_write_group_double (fp, 10, dxf_header.InsBase.x0);
+        dxf_write_group_double (fp, 20, dxf_header.InsBase.y0);
+        dxf_write_group_double (fp, 30, dxf_header.InsBase.z0);
+        dxf_write_group_string (fp, 9, "$EXTMIN");
+        dxf_write_group_double (fp, 10, dxf_header.ExtMin.x0);
+        dxf_write_group_double (fp, 20, dxf_header.ExtMin.y0);
+        dxf_write_group_double (fp, 30, dxf_header.ExtMin.z0);
+        dxf_write_group_string (fp, 9, "$EXTMAX");
+        dxf_write_group_double (fp, 10, dxf_header.ExtMax.x0);
+        dxf_write_group_double (fp, 20, dxf_header.ExtMax.y0);
+        dxf_write_group_double (fp, 30, dxf_header.ExtMax.z0);
+        dxf_write_group_string (fp, 9, "$LIMMIN");
+        dxf_write_group_double (fp, 10, dxf_header.LimMin.x0);
+        dxf_write_group_double (fp, 20, dxf_header.LimMin.y0);
+        dxf_write_group_string (fp, 9, "$LIMMAX");
+        dxf_write_group_double (fp, 10, dxf_header.LimMax.x0);
+        dxf_write_group_double (fp, 20, dxf_header.LimMax.y0);
+        dxf_write_group_string (fp, 9, "$ORTHOMODE");
+        dxf_write_group_int (fp, 70, dxf_header.OrthoMode);
+        dxf_write_group_string (fp, 9, "$REGENMODE");
+        dxf_write_group_int (fp, 70, dxf_header.RegenMode);
+        dxf_write_group_string (fp, 9, "$FILLMODE");
+        dxf_write_group_int (fp, 70, dxf_header.FillMode);
+        dxf_write_group_string (fp, 9, "$QTEXTMODE");
+        dxf_write_group_int (fp, 70, dxf_header.QTextMode);
+        dxf_write_group_string (fp, 9, "$MIRRTEXT");
+        dxf_write_group_int (fp, 70, dxf_header.MirrText);
+        if (acad_version_number <= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DRAGMODE");
+                dxf_write_group_int (fp, 70, dxf_header.DragMode);
+        }
+        dxf_write_group_string (fp, 9, "$LTSCALE");
+        dxf_write_group_double (fp, 40, dxf_header.LTScale);
+        if (acad_version_number <= AC1014)
+        {
+                dxf_write_group_string (fp, 9, "$OSMODE");
+                dxf_write_group_int (fp, 70, dxf_header.OSMode);
+        }
+        dxf_write_group_string (fp, 9, "$ATTMODE");
+        dxf_write_group_int (fp, 70, dxf_header.AttMode);
+        dxf_write_group_string (fp, 9, "$TEXTSIZE");
+        dxf_write_group_double (fp, 40, dxf_header.TextSize);
+        dxf_write_group_string (fp, 9, "$TRACEWID");
+        dxf_write_group_double (fp, 40, dxf_header.TraceWid);
+        dxf_write_group_string (fp, 9, "$TEXTSTYLE");
+        dxf_write_group_string (fp, 7, dxf_header.TextStyle);
+        dxf_write_group_string (fp, 9, "$CLAYER");
+        dxf_write_group_string (fp, 8, dxf_header.CLayer);
+        dxf_write_group_string (fp, 9, "$CELTYPE");
+        dxf_write_group_string (fp, 6, dxf_header.CELType);
+        dxf_write_group_string (fp, 9, "$CECOLOR");
+        dxf_write_group_int (fp, 62, dxf_header.CEColor);
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$CELTSCALE");
+                dxf_write_group_double (fp, 40, dxf_header.CELTScale);
+        }
+        if ((acad_version_number == AC1012) || (acad_version_number == AC1014))
+        {
+                dxf_write_group_string (fp, 9, "$DELOBJ");
+                dxf_write_group_int (fp, 70, dxf_header.DelObj);
+        }
+        if (acad_version_number <= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DISPSILH");
+                dxf_write_group_int (fp, 70, dxf_header.DispSilH);
+        }
+        dxf_write_group_string (fp, 9, "$DIMSCALE");
+        dxf_write_group_double (fp, 40, dxf_header.DimSCALE);
+        dxf_write_group_string (fp, 9, "$DIMASZ");
+        dxf_write_group_double (fp, 40, dxf_header.DimASZ);
+        dxf_write_group_string (fp, 9, "$DIMEXO");
+        dxf_write_group_double (fp, 40, dxf_header.DimEXO);
+        dxf_write_group_string (fp, 9, "$DIMDLI");
+        dxf_write_group_double (fp, 40, dxf_header.DimDLI);
+        dxf_write_group_string (fp, 9, "$DIMRND");
+        dxf_write_group_double (fp, 40, dxf_header.DimRND);
+        dxf_write_group_string (fp, 9, "$DIMDLE");
+        dxf_write_group_double (fp, 40, dxf_header.DimDLE);
+        dxf_write_group_string (fp, 9, "$DIMEXE");
+        dxf_write_group_double (fp, 40, dxf_header.DimEXE);
+        dxf_write_group_string (fp, 9, "$DIMTP");
+        dxf_write_group_double (fp, 40, dxf_header.DimTP);
+        dxf_write_group_string (fp, 9, "$DIMTM");
+        dxf_write_group_double (fp, 40, dxf_header.DimTM);
+        dxf_write_group_string (fp, 9, "$DIMTXT");
+        dxf_write_group_double (fp, 40, dxf_header.DimTXT);
+        dxf_write_group_string (fp, 9, "$DIMCEN");
+        dxf_write_group_double (fp, 40, dxf_header.DimCEN);
+        dxf_write_group_string (fp, 9, "$DIMTSZ");
+        dxf_write_group_double (fp, 40, dxf_header.DimTSZ);
+        dxf_write_group_string (fp, 9, "$DIMTOL");
+        dxf_write_group_int (fp, 70, dxf_header.DimTOL);
+        dxf_write_group_string (fp, 9, "$DIMLIM");
+        dxf_write_group_int (fp, 70, dxf_header.DimLIM);
+        dxf_write_group_string (fp, 9, "$DIMTIH");
+        dxf_write_group_int (fp, 70, dxf_header.DimTIH);
+        dxf_write_group_string (fp, 9, "$DIMTOH");
+        dxf_write_group_int (fp, 70, dxf_header.DimTOH);
+        dxf_write_group_string (fp, 9, "$DIMSE1");
+        dxf_write_group_int (fp, 70, dxf_header.DimSE1);
+        dxf_write_group_string (fp, 9, "$DIMSE2");
+        dxf_write_group_int (fp, 70, dxf_header.DimSE2);
+        dxf_write_group_string (fp, 9, "$DIMTAD");
+        dxf_write_group_int (fp, 70, dxf_header.DimTAD);
+        dxf_write_group_string (fp, 9, "$DIMZIN");
+        dxf_write_group_int (fp, 70, dxf_header.DimZIN);
+        dxf_write_group_string (fp, 9, "$DIMBLK");
+        dxf_write_group_string (fp, 1, dxf_header.DimBLK);
+        dxf_write_group_string (fp, 9, "$DIMASO");
+        dxf_write_group_int (fp, 70, dxf_header.DimASO);
+        dxf_write_group_string (fp, 9, "$DIMSHO");
+        dxf_write_group_int (fp, 70, dxf_header.DimSHO);
+        dxf_write_group_string (fp, 9, "$DIMPOST");
+        dxf_write_group_string (fp, 1, dxf_header.DimPOST);
+        dxf_write_group_string (fp, 9, "$DIMAPOST");
+        dxf_write_group_string (fp, 1, dxf_header.DimAPOST);
+        dxf_write_group_string (fp, 9, "$DIMALT");
+        dxf_write_group_int (fp, 70, dxf_header.DimALT);
+        dxf_write_group_string (fp, 9, "$DIMALTD");
+        dxf_write_group_int (fp, 70, dxf_header.DimALTD);
+        dxf_write_group_string (fp, 9, "$DIMALTF");
+        dxf_write_group_double (fp, 40, dxf_header.DimALTF);
+        dxf_write_group_string (fp, 9, "$DIMLFAC");
+        dxf_write_group_double (fp, 40, dxf_header.DimLFAC);
+        dxf_write_group_string (fp, 9, "$DIMTOFL");
+        dxf_write_group_int (fp, 70, dxf_header.DimTOFL);
+        dxf_write_group_string (fp, 9, "$DIMTVP");
+        dxf_write_group_double (fp, 40, dxf_header.DimTVP);
+        dxf_write_group_string (fp, 9, "$DIMTIX");
+        dxf_write_group_int (fp, 70, dxf_header.DimTIX);
+        dxf_write_group_string (fp, 9, "$DIMSOXD");
+        dxf_write_group_int (fp, 70, dxf_header.DimSOXD);
+        dxf_write_group_string (fp, 9, "$DIMSAH");
+        dxf_write_group_int (fp, 70, dxf_header.DimSAH);
+        dxf_write_group_string (fp, 9, "$DIMBLK1");
+        dxf_write_group_string (fp, 1, dxf_header.DimBLK1);
+        dxf_write_group_string (fp, 9, "$DIMBLK2");
+        dxf_write_group_string (fp, 1, dxf_header.DimBLK2);
+        dxf_write_group_string (fp, 9, "$DIMSTYLE");
+        dxf_write_group_string (fp, 2, dxf_header.DimSTYLE);
+        dxf_write_group_string (fp, 9, "$DIMCLRD");
+        dxf_write_group_int (fp, 70, dxf_header.DimCLRD);
+        dxf_write_group_string (fp, 9, "$DIMCLRE");
+        dxf_write_group_int (fp, 70, dxf_header.DimCLRE);
+        dxf_write_group_string (fp, 9, "$DIMCLRT");
+        dxf_write_group_int (fp, 70, dxf_header.DimCLRT);
+        dxf_write_group_string (fp, 9, "$DIMTFAC");
+        dxf_write_group_double (fp, 40, dxf_header.DimTFAC);
+        dxf_write_group_string (fp, 9, "$DIMGAP");
+        dxf_write_group_double (fp, 40, dxf_header.DimGAP);
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMJUST");
+                dxf_write_group_int (fp, 70, dxf_header.DimJUST);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMSD1");
+                dxf_write_group_int (fp, 70, dxf_header.DimSD1);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMSD2");
+                dxf_write_group_int (fp, 70, dxf_header.DimSD2);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMTOLJ");
+                dxf_write_group_int (fp, 70, dxf_header.DimTOLJ);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMTZIN");
+                dxf_write_group_int (fp, 70, dxf_header.DimTZIN);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMALTZ");
+                dxf_write_group_int (fp, 70, dxf_header.DimALTZ);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMALTTZ");
+                dxf_write_group_int (fp, 70, dxf_header.DimALTTZ);
+        }
+        if ((acad_version_number == AC1012) || (acad_version_number == AC1014))
+        {
+                dxf_write_group_string (fp, 9, "$DIMFIT");
+                dxf_write_group_int (fp, 70, dxf_header.DimFIT);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMUPT");
+                dxf_write_group_int (fp, 70, dxf_header.DimUPT);
+        }
+        if ((acad_version_number == AC1012) || (acad_version_number == AC1014))
+        {
+                dxf_write_group_string (fp, 9, "$DIMUNIT");
+                dxf_write_group_int (fp, 70, dxf_header.DimUNIT);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMDEC");
+                dxf_write_group_int (fp, 70, dxf_header.DimDEC);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMTDEC");
+                dxf_write_group_int (fp, 70, dxf_header.DimTDEC);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMALTU");
+                dxf_write_group_int (fp, 70, dxf_header.DimALTU);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMALTTD");
+                dxf_write_group_int (fp, 70, dxf_header.DimALTTD);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMTXSTY");
+                dxf_write_group_string (fp, 7, dxf_header.DimTXSTY);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMAUNIT");
+                dxf_write_group_int (fp, 70, dxf_header.DimAUNIT);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMADEC");
+                dxf_write_group_int (fp, 70, dxf_header.DimADEC);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMALTRND");
+                dxf_write_group_double (fp, 40, dxf_header.DimALTRND);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMAZIN");
+                dxf_write_group_int (fp, 70, dxf_header.DimAZIN);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMDSEP");
+                dxf_write_group_int (fp, 70, dxf_header.DimDSEP);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMATFIT");
+                dxf_write_group_int (fp, 70, dxf_header.DimATFIT);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMFRAC");
+                dxf_write_group_int (fp, 70, dxf_header.DimFRAC);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMLDRBLK");
+                dxf_write_group_string (fp, 1, dxf_header.DimLDRBLK);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMLUNIT");
+                dxf_write_group_int (fp, 70, dxf_header.DimLUNIT);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMLWD");
+                dxf_write_group_int (fp, 70, dxf_header.DimLWD);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMLWE");
+                dxf_write_group_int (fp, 70, dxf_header.DimLWE);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMTMOVE");
+                dxf_write_group_int (fp, 70, dxf_header.DimTMOVE);
+        }
+        dxf_write_group_string (fp, 9, "$LUNITS");
+        dxf_write_group_int (fp, 70, dxf_header.LUnits);
+        dxf_write_group_string (fp, 9, "$LUPREC");
+        dxf_write_group_int (fp, 70, dxf_header.LUPrec);
+        dxf_write_group_string (fp, 9, "$SKETCHINC");
+        dxf_write_group_double (fp, 40, dxf_header.Sketchinc);
+        dxf_write_group_string (fp, 9, "$FILLETRAD");
+        dxf_write_group_double (fp, 40, dxf_header.FilletRad);
+        dxf_write_group_string (fp, 9, "$AUNITS");
+        dxf_write_group_int (fp, 70, dxf_header.AUnits);
+        dxf_write_group_string (fp, 9, "$AUPREC");
+        dxf_write_group_int (fp, 70, dxf_header.AUPrec);
+        dxf_write_group_string (fp, 9, "$MENU");
+        dxf_write_group_string (fp, 1, dxf_header.Menu);
+        dxf_write_group_string (fp, 9, "$ELEVATION");
+        dxf_write_group_double (fp, 40, dxf_header.Elevation);
+        dxf_write_group_string (fp, 9, "$PELEVATION");
+        dxf_write_group_double (fp, 40, dxf_header.PElevation);
+        dxf_write_group_string (fp, 9, "$THICKNESS");
+        dxf_write_group_double (fp, 40, dxf_header.Thickness);
+        dxf_write_group_string (fp, 9, "$LIMCHECK");
+        dxf_write_group_int (fp, 70, dxf_header.LimCheck);
+        if (acad_version_number <= AC1014)
+        {
+                dxf_write_group_string (fp, 9, "$BLIPMODE");
+                dxf_write_group_int (fp, 70, dxf_header.BlipMode);
+        }
+        dxf_write_group_string (fp, 9, "$CHAMFERA");
+        dxf_write_group_double (fp, 40, dxf_header.ChamferA);
+        dxf_write_group_string (fp, 9, "$CHAMFERB");
+        dxf_write_group_double (fp, 40, dxf_header.ChamferB);
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$CHAMFERC");
+                dxf_write_group_double (fp, 40, dxf_header.ChamferC);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$CHAMFERD");
+                dxf_write_group_double (fp, 40, dxf_header.ChamferD);
+        }
+        dxf_write_group_string (fp, 9, "$SKPOLY");
+        dxf_write_group_int (fp, 70, dxf_header.SKPoly);
+        dxf_write_group_string (fp, 9, "$TDCREATE");
+        dxf_write_group_double (fp, 40, dxf_header.TDCreate);
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$TDUCREATE");
+                dxf_write_group_double (fp, 40, dxf_header.TDUCreate);
+        }
+        dxf_write_group_string (fp, 9, "$TDUPDATE");
+        dxf_write_group_double (fp, 40, dxf_header.TDUpdate);
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$TDUUPDATE");
+                dxf_write_group_double (fp, 40, dxf_header.TDUUpdate);
+        }
+        dxf_write_group_string (fp, 9, "$TDINDWG");
+        dxf_write_group_double (fp, 40, dxf_header.TDInDWG);
+        dxf_write_group_string (fp, 9, "$TDUSRTIMER");
+        dxf_write_group_double (fp, 40, dxf_header.TDUSRTimer);
+        dxf_write_group_string (fp, 9, "$USRTIMER");
+        dxf_write_group_int (fp, 70, dxf_header.USRTimer);
+        dxf_write_group_string (fp, 9, "$ANGBASE");
+        dxf_write_group_double (fp, 50, dxf_header.AngBase);
+        dxf_write_group_string (fp, 9, "$ANGDIR");
+        dxf_write_group_int (fp, 70, dxf_header.AngDir);
+        dxf_write_group_string (fp, 9, "$PDMODE");
+        dxf_write_group_int (fp, 70, dxf_header.PDMode);
+        dxf_write_group_string (fp, 9, "$PDSIZE");
+        dxf_write_group_double (fp, 40, dxf_header.PDSize);
+        dxf_write_group_string (fp, 9, "$PLINEWID");
+        dxf_write_group_double (fp, 40, dxf_header.PLineWid);
+        if (acad_version_number <= AC1014)
+        {
+                dxf_write_group_string (fp, 9, "$COORDS");
+                dxf_write_group_int (fp, 70, dxf_header.Coords);
+        }
+        dxf_write_group_string (fp, 9, "$SPLFRAME");
+        dxf_write_group_int (fp, 70, dxf_header.SPLFrame);
+        dxf_write_group_string (fp, 9, "$SPLINETYPE");
+        dxf_write_group_int (fp, 70, dxf_header.SPLineType);
+        if (acad_version_number <= AC1014)
+        {
+                dxf_write_group_string (fp, 9, "$ATTDIA");
+                dxf_write_group_int (fp, 70, dxf_header.AttDia);
+        }
+        if (acad_version_number <= AC1014)
+        {
+                dxf_write_group_string (fp, 9, "$ATTREQ");
+                dxf_write_group_int (fp, 70, dxf_header.AttReq);
+        }
+        if (acad_version_number <= AC1014)
+        {
+                dxf_write_group_string (fp, 9, "$HANDLING");
+                dxf_write_group_int (fp, 70, dxf_header.Handling);
+        }
+        dxf_write_group_string (fp, 9, "$SPLINESEGS");
+        dxf_write_group_int (fp, 70, dxf_header.SPLineSegs);
+        dxf_write_group_string (fp, 9, "$HANDSEED");
+        dxf_write_group_string (fp, 5, dxf_header.HandSeed);
+        dxf_write_group_string (fp, 9, "$SURFTAB1");
+        dxf_write_group_int (fp, 70, dxf_header.SurfTab1);
+        dxf_write_group_string (fp, 9, "$SURFTAB2");
+        dxf_write_group_int (fp, 70, dxf_header.SurfTab2);
+        dxf_write_group_string (fp, 9, "$SURFTYPE");
+        dxf_write_group_int (fp, 70, dxf_header.SurfType);
+        dxf_write_group_string (fp, 9, "$SURFU");
+        dxf_write_group_int (fp, 70, dxf_header.SurfU);
+        dxf_write_group_string (fp, 9, "$SURFV");
+        dxf_write_group_int (fp, 70, dxf_header.SurfV);
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSBASE");
+                dxf_write_group_string (fp, 2, dxf_header.UCSBase);
+        }
+        dxf_write_group_string (fp, 9, "$UCSNAME");
+        dxf_write_group_string (fp, 2, dxf_header.UCSName);
+        dxf_write_group_string (fp, 9, "$UCSORG");
+        dxf_write_group_double (fp, 10, dxf_header.UCSOrg.x0);
+        dxf_write_group_double (fp, 20, dxf_header.UCSOrg.y0);
+        dxf_write_group_double (fp, 30, dxf_header.UCSOrg.z0);
+        dxf_write_group_string (fp, 9, "$UCSXDIR");
+        dxf_write_group_double (fp, 10, dxf_header.UCSXDir.x0);
+        dxf_write_group_double (fp, 20, dxf_header.UCSXDir.y0);
+        dxf_write_group_double (fp, 30, dxf_header.UCSXDir.z0);
+        dxf_write_group_string (fp, 9, "$UCSYDIR");
+        dxf_write_group_double (fp, 10, dxf_header.UCSYDir.x0);
+        dxf_write_group_double (fp, 20, dxf_header.UCSYDir.y0);
+        dxf_write_group_double (fp, 30, dxf_header.UCSYDir.z0);
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSORTHOREF");
+                dxf_write_group_string (fp, 2, dxf_header.UCSOrthoRef);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSORTHOVIEW");
+                dxf_write_group_int (fp, 70, dxf_header.UCSOrthoView);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSORGTOP");
+                dxf_write_group_double (fp, 10, dxf_header.UCSOrgTop.x0);
+                dxf_write_group_double (fp, 20, dxf_header.UCSOrgTop.y0);
+                dxf_write_group_double (fp, 30, dxf_header.UCSOrgTop.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSORGBOTTOM");
+                dxf_write_group_double (fp, 10, dxf_header.UCSOrgBottom.x0);
+                dxf_write_group_double (fp, 20, dxf_header.UCSOrgBottom.y0);
+                dxf_write_group_double (fp, 30, dxf_header.UCSOrgBottom.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSORGLEFT");
+                dxf_write_group_double (fp, 10, dxf_header.UCSOrgLeft.x0);
+                dxf_write_group_double (fp, 20, dxf_header.UCSOrgLeft.y0);
+                dxf_write_group_double (fp, 30, dxf_header.UCSOrgLeft.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSORGRIGHT");
+                dxf_write_group_double (fp, 10, dxf_header.UCSOrgRight.x0);
+                dxf_write_group_double (fp, 20, dxf_header.UCSOrgRight.y0);
+                dxf_write_group_double (fp, 30, dxf_header.UCSOrgRight.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSORGFRONT");
+                dxf_write_group_double (fp, 10, dxf_header.UCSOrgFront.x0);
+                dxf_write_group_double (fp, 20, dxf_header.UCSOrgFront.y0);
+                dxf_write_group_double (fp, 30, dxf_header.UCSOrgFront.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSORGBACK");
+                dxf_write_group_double (fp, 10, dxf_header.UCSOrgBack.x0);
+                dxf_write_group_double (fp, 20, dxf_header.UCSOrgBack.y0);
+                dxf_write_group_double (fp, 30, dxf_header.UCSOrgBack.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSBASE");
+                dxf_write_group_string (fp, 2, dxf_header.PUCSBase);
+        }
+        dxf_write_group_string (fp, 9, "$PUCSNAME");
+        dxf_write_group_string (fp, 2, dxf_header.PUCSName);
+        dxf_write_group_string (fp, 9, "$PUCSORG");
+        dxf_write_group_double (fp, 10, dxf_header.PUCSOrg.x0);
+        dxf_write_group_double (fp, 20, dxf_header.PUCSOrg.y0);
+        dxf_write_group_double (fp, 30, dxf_header.PUCSOrg.z0);
+        dxf_write_group_string (fp, 9, "$PUCSXDIR");
+        dxf_write_group_double (fp, 10, dxf_header.PUCSXDir.x0);
+        dxf_write_group_double (fp, 20, dxf_header.PUCSXDir.y0);
+        dxf_write_group_double (fp, 30, dxf_header.PUCSXDir.z0);
+        dxf_write_group_string (fp, 9, "$PUCSYDIR");
+        dxf_write_group_double (fp, 10, dxf_header.PUCSYDir.x0);
+        dxf_write_group_double (fp, 20, dxf_header.PUCSYDir.y0);
+        dxf_write_group_double (fp, 30, dxf_header.PUCSYDir.z0);
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSORTHOREF");
+                dxf_write_group_string (fp, 2, dxf_header.PUCSOrthoRef);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSORTHOVIEW");
+                dxf_write_group_int (fp, 70, dxf_header.PUCSOrthoView);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSORGTOP");
+                dxf_write_group_double (fp, 10, dxf_header.PUCSOrgTop.x0);
+                dxf_write_group_double (fp, 20, dxf_header.PUCSOrgTop.y0);
+                dxf_write_group_double (fp, 30, dxf_header.PUCSOrgTop.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSORGBOTTOM");
+                dxf_write_group_double (fp, 10, dxf_header.PUCSOrgBottom.x0);
+                dxf_write_group_double (fp, 20, dxf_header.PUCSOrgBottom.y0);
+                dxf_write_group_double (fp, 30, dxf_header.PUCSOrgBottom.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSORGLEFT");
+                dxf_write_group_double (fp, 10, dxf_header.PUCSOrgLeft.x0);
+                dxf_write_group_double (fp, 20, dxf_header.PUCSOrgLeft.y0);
+                dxf_write_group_double (fp, 30, dxf_header.PUCSOrgLeft.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSORGRIGHT");
+                dxf_write_group_double (fp, 10, dxf_header.PUCSOrgRight.x0);
+                dxf_write_group_double (fp, 20, dxf_header.PUCSOrgRight.y0);
+                dxf_write_group_double (fp, 30, dxf_header.PUCSOrgRight.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSORGFRONT");
+                dxf_write_group_double (fp, 10, dxf_header.PUCSOrgFront.x0);
+                dxf_write_group_double (fp, 20, dxf_header.PUCSOrgFront.y0);
+                dxf_write_group_double (fp, 30, dxf_header.PUCSOrgFront.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSORGBACK");
+                dxf_write_group_double (fp, 10, dxf_header.PUCSOrgBack.x0);
+                dxf_write_group_double (fp, 20, dxf_header.PUCSOrgBack.y0);
+                dxf_write_group_double (fp, 30, dxf_header.PUCSOrgBack.z0);
+        }
+        dxf_write_group_string (fp, 9, "$USERI1");
+        dxf_write_group_int (fp, 70, dxf_header.UserI1);
+        dxf_write_group_string (fp, 9, "$USERI2");
+        dxf_write_group_int (fp, 70, dxf_header.UserI2);
+        dxf_write_group_string (fp, 9, "$USERI3");
+        dxf_write_group_int (fp, 70, dxf_header.UserI3);
+        dxf_write_group_string (fp, 9, "$USERI4");
+        dxf_write_group_int (fp, 70, dxf_header.UserI4);
+        dxf_write_group_string (fp, 9, "$USERI5");
+        dxf_write_group_int (fp, 70, dxf_header.UserI5);
+        dxf_write_group_string (fp, 9, "$USERR1");
+        dxf_write_group_double (fp, 40, dxf_header.UserR1);
+        dxf_write_group_string (fp, 9, "$USERR2");
+        dxf_write_group_double (fp, 40, dxf_header.UserR2);
+        dxf_write_group_string (fp, 9, "$USERR3");
+        dxf_write_group_double (fp, 40, dxf_header.UserR3);
+        dxf_write_group_string (fp, 9, "$USERR4");
+        dxf_write_group_double (fp, 40, dxf_header.UserR4);
+        dxf_write_group_string (fp, 9, "$USERR5");
+        dxf_write_group_double (fp, 40, dxf_header.UserR5);
+        dxf_write_group_string (fp, 9, "$WORLDVIEW");
+        dxf_write_group_int (fp, 70, dxf_header.WorldView);
+        dxf_write_group_string (fp, 9, "$SHADEDGE");
+        dxf_write_group_int (fp, 70, dxf_header.ShadEdge);
+        dxf_write_group_string (fp, 9, "$SHADEDIF");
+        dxf_write_group_int (fp, 70, dxf_header.ShadeDif);
+        dxf_write_group_string (fp, 9, "$TILEMODE");
+        dxf_write_group_int (fp, 70, dxf_header.TileMode);
+        dxf_write_group_string (fp, 9, "$MAXACTVP");
+        dxf_write_group_int (fp, 70, dxf_header.MaxActVP);
+        dxf_write_group_string (fp, 9, "$PINSBASE");
+        dxf_write_group_double (fp, 10, dxf_header.PInsBase.x0);
+        dxf_write_group_double (fp, 20, dxf_header.PInsBase.y0);
+        dxf_write_group_double (fp, 30, dxf_header.PInsBase.z0);
+        dxf_write_group_string (fp, 9, "$PLIMCHECK");
+        dxf_write_group_int (fp, 70, dxf_header.PLimCheck);
+        dxf_write_group_string (fp, 9, "$PEXTMIN");
+        dxf_write_group_double (fp, 10, dxf_header.PExtMin.x0);
+        dxf_write_group_double (fp, 20, dxf_header.PExtMin.y0);
+        dxf_write_group_double (fp, 30, dxf_header.PExtMin.z0);
+        dxf_write_group_string (fp, 9, "$PEXTMAX");
+        dxf_write_group_double (fp, 10, dxf_header.PExtMax.x0);
+        dxf_write_group_double (fp, 20, dxf_header.PExtMax.y0);
+        dxf_write_group_double (fp, 30, dxf_header.PExtMax.z0);
+        dxf_write_group_string (fp, 9, "$PLIMMIN");
+        dxf_write_group_double (fp, 10, dxf_header.PLimMin.x0);
+        dxf_write_group_double (fp, 20, dxf_header.PLimMin.y0);
+        dxf_write_group_string (fp, 9, "$PLIMMAX");
+        dxf_write_group_double (fp, 10, dxf_header.PLimMax.x0);
+        dxf_write_group_double (fp, 20, dxf_header.PLimMax.y0);
+        dxf_write_group_string (fp, 9, "$UNITMODE");
+        dxf_write_group_int (fp, 70, dxf_header.UnitMode);
+        dxf_write_group_string (fp, 9, "$VISRETAIN");
+        dxf_write_group_int (fp, 70, dxf_header.VisRetain);
+        dxf_write_group_string (fp, 9, "$PLINEGEN");
+        dxf_write_group_int (fp, 70, dxf_header.PLineGen);
+        dxf_write_group_string (fp, 9, "$PSLTSCALE");
+        dxf_write_group_int (fp, 70, dxf_header.PSLTScale);
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$TREEDEPTH");
+                dxf_write_group_int (fp, 70, dxf_header.TreeDepth);
+        }
+        if ((acad_version_number == AC1012) || (acad_version_number == AC1014))
+        {
+                dxf_write_group_string (fp, 9, "$PICKSTYLE");
+                dxf_write_group_int (fp, 70, dxf_header.PickStyle);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$CMLSTYLE");
+                dxf_write_group_string (fp, 2, dxf_header.CMLStyle);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$CMLJUST");
+                dxf_write_group_int (fp, 70, dxf_header.CMLJust);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$CMLSCALE");
+                dxf_write_group_double (fp, 40, dxf_header.CMLScale);
+        }
+        if (acad_version_number >= AC1014)
+        {
+                dxf_write_group_string (fp, 9, "$PROXYGRAPHICS");
+                dxf_write_group_int (fp, 70, dxf_header.ProxyGraphics);
+        }
+        if (acad_version_number >= AC1014)
+        {
+                dxf_write_group_string (fp, 9, "$MEASUREMENT");
+                dxf_write_group_int (fp, 70, dxf_header.Measurement);
+        }
+        if (acad_version_number == AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$SAVEIMAGES");
+                dxf_write_group_int (fp, 70, dxf_header.SaveImages);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$CELWEIGHT");
+                dxf_write_group_int (fp, 370, dxf_header.CELWeight);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$ENDCAPS");
+                dxf_write_group_int (fp, 280, dxf_header.EndCaps);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$JOINSTYLE");
+                dxf_write_group_int (fp, 280, dxf_header.JoinStyle);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$LWDISPLAY");
+                dxf_write_group_int (fp, 290, dxf_header.LWDisplay);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$INSUNITS");
+                dxf_write_group_int (fp, 70, dxf_header.InsUnits);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$HYPERLINKBASE");
+                dxf_write_group_string (fp, 1, dxf_header.HyperLinkBase);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$STYLESHEET");
+                dxf_write_group_string (fp, 1, dxf_header.StyleSheet);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$XEDIT");
+                dxf_write_group_int (fp, 290, dxf_header.XEdit);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$CEPSNTYPE");
+                dxf_write_group_int (fp, 380, dxf_header.CEPSNType);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PSTYLEMODE");
+                dxf_write_group_int (fp, 290, dxf_header.PStyleMode);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$FINGERPRINTGUID");
+                dxf_write_group_string (fp, 2, dxf_header.FingerPrintGUID);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$VERSIONGUID");
+                dxf_write_group_string (fp, 2, dxf_header.VersionGUID);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$EXTNAMES");
+                dxf_write_group_int (fp, 290, dxf_header.ExtNames);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PSVPSCALE");
+                dxf_write_group_double (fp, 40, dxf_header.PSVPScale);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$OLESTARTUP");
+                dxf_write_group_int (fp, 290, dxf_header.OLEStartUp);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$SORTENTS");
+                dxf_write_group_int (fp, 280, dxf_header.SortEnts);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$INDEXCTL");
+                dxf_write_group_int (fp, 280, dxf_header.IndexCtl);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$HIDETEXT");
+                dxf_write_group_int (fp, 280, dxf_header.HideText);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$XCLIPFRAME");
+                dxf_write_group_int (fp, 290, dxf_header.XClipFrame);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$HALOGAP");
+                dxf_write_group_int (fp, 280, dxf_header.HaloGap);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$OBSCOLOR");
+                dxf_write_group_int (fp, 70, dxf_header.ObsColor);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$OBSLTYPE");
+                dxf_write_group_int (fp, 280, dxf_header.ObsLType);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$INTERSECTIONDISPLAY");
+                dxf_write_group_int (fp, 280, dxf_header.InterSectionDisplay);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$INTERSECTIONCOLOR");
+                dxf_write_group_int (fp, 70, dxf_header.InterSectionColor);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$DIMASSOC");
+                dxf_write_group_int (fp, 280, dxf_header.DimASSOC);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$PROJECTNAME");
+                dxf_write_group_string (fp, 1, dxf_header.ProjectName);
+        }
         dxf_section_write_endsection (fp);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_header2 () function.\n", __FILE__, __LINE__);
@@ -1109,9 +1861,9 @@ dxf_read_header_parse_n_double
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_read_header_parse_n_double () function.\n", __FILE__, __LINE__);
 #endif
-        int f, n, i, ret = SUCCESS;
+        int i, ret = SUCCESS;
         double *dvar;
-        double tvar;
+        DxfGroup group;
         va_list dlist;
 
         /* test for header_var and version number. -3 makes it version agnostic */
@@ -1122,11 +1874,10 @@ dxf_read_header_parse_n_double
                 for (i = 1; i <= quant; i++)
                 {
                         dvar = va_arg(dlist, double *);
-                        /* prepare the string to read all vars */
-                        f = dxf_read_scanf (fp, "%d\n%'lf\n", &n, &tvar);
-                        if (f > 0 && dxf_read_is_double (n))
+                        /* read the group code and the locale independent value */
+                        if (dxf_read_group (fp, &group) && dxf_read_is_double (group.code))
                         {
-                                *dvar = tvar;
+                                *dvar = dxf_group_get_double (&group);
                         }
                         else
                         {
@@ -1330,9 +2081,12 @@ dxf_read_header_parser
         dxf_return(ret);
 
         /*
-        fprintf (fp, "  9\n$DIMDLI\n 40\n%f\n", dxf_header.DimDLI);
-        fprintf (fp, "  9\n$DIMRND\n 40\n%f\n", dxf_header.DimRND);
-        fprintf (fp, "  9\n$DIMDLE\n 40\n%f\n", dxf_header.DimDLE);
+        dxf_write_group_string (fp, 9, "$DIMDLI");
+        dxf_write_group_double (fp, 40, dxf_header.DimDLI);
+        dxf_write_group_string (fp, 9, "$DIMRND");
+        dxf_write_group_double (fp, 40, dxf_header.DimRND);
+        dxf_write_group_string (fp, 9, "$DIMDLE");
+        dxf_write_group_double (fp, 40, dxf_header.DimDLE);
         */
         ret = dxf_read_header_parse_n_double (fp, temp_string, "$DIMEXE",
                                               TRUE,
@@ -1340,8 +2094,10 @@ dxf_read_header_parser
                                               &dxf_header.DimEXE);
         dxf_return(ret);
         /*
-        fprintf (fp, "  9\n$DIMTP\n 40\n%f\n", dxf_header.DimTP);
-        fprintf (fp, "  9\n$DIMTM\n 40\n%f\n", dxf_header.DimTM);
+        dxf_write_group_string (fp, 9, "$DIMTP");
+        dxf_write_group_double (fp, 40, dxf_header.DimTP);
+        dxf_write_group_string (fp, 9, "$DIMTM");
+        dxf_write_group_double (fp, 40, dxf_header.DimTM);
         */
         ret = dxf_read_header_parse_n_double (fp, temp_string, "$DIMTXT",
                                               TRUE,
@@ -1349,42 +2105,72 @@ dxf_read_header_parser
                                               &dxf_header.DimTXT);
         dxf_return(ret);
         /*
-        fprintf (fp, "  9\n$DIMCEN\n 40\n%f\n", dxf_header.DimCEN);
-        fprintf (fp, "  9\n$DIMTSZ\n 40\n%f\n", dxf_header.DimTSZ);
-        fprintf (fp, "  9\n$DIMTOL\n 70\n%i\n", dxf_header.DimTOL);
-        fprintf (fp, "  9\n$DIMLIM\n 70\n%i\n", dxf_header.DimLIM);
-        fprintf (fp, "  9\n$DIMTIH\n 70\n%i\n", dxf_header.DimTIH);
-        fprintf (fp, "  9\n$DIMTOH\n 70\n%i\n", dxf_header.DimTOH);
-        fprintf (fp, "  9\n$DIMSE1\n 70\n%i\n", dxf_header.DimSE1);
-        fprintf (fp, "  9\n$DIMSE2\n 70\n%i\n", dxf_header.DimSE2);
-        fprintf (fp, "  9\n$DIMTAD\n 70\n%i\n", dxf_header.DimTAD);
-        fprintf (fp, "  9\n$DIMZIN\n 70\n%i\n", dxf_header.DimZIN);
-        fprintf (fp, "  9\n$DIMBLK\n  1\n%s\n", dxf_header.DimBLK);
-        fprintf (fp, "  9\n$DIMASO\n 70\n%i\n", dxf_header.DimASO);
-        fprintf (fp, "  9\n$DIMSHO\n 70\n%i\n", dxf_header.DimSHO);
-        fprintf (fp, "  9\n$DIMPOST\n  1\n%s\n", dxf_header.DimPOST);
-        fprintf (fp, "  9\n$DIMAPOST\n  1\n%s\n", dxf_header.DimAPOST);
-        fprintf (fp, "  9\n$DIMALT\n 70\n%i\n", dxf_header.DimALT);
-        fprintf (fp, "  9\n$DIMALTD\n 70\n%i\n", dxf_header.DimALTD);
-        fprintf (fp, "  9\n$DIMALTF\n 40\n%f\n", dxf_header.DimALTF);
-        fprintf (fp, "  9\n$DIMLFAC\n 40\n%f\n", dxf_header.DimLFAC);
-        fprintf (fp, "  9\n$DIMTOFL\n 70\n%i\n", dxf_header.DimTOFL);
-        fprintf (fp, "  9\n$DIMTVP\n 40\n%f\n", dxf_header.DimTVP);
-        fprintf (fp, "  9\n$DIMTIX\n 70\n%i\n", dxf_header.DimTIX);
-        fprintf (fp, "  9\n$DIMSOXD\n 70\n%i\n", dxf_header.DimSOXD);
-        fprintf (fp, "  9\n$DIMSAH\n 70\n%i\n", dxf_header.DimSAH);
-        fprintf (fp, "  9\n$DIMBLK1\n  1\n%s\n", dxf_header.DimBLK1);
-        fprintf (fp, "  9\n$DIMBLK2\n  1\n%s\n", dxf_header.DimBLK2);
+        dxf_write_group_string (fp, 9, "$DIMCEN");
+        dxf_write_group_double (fp, 40, dxf_header.DimCEN);
+        dxf_write_group_string (fp, 9, "$DIMTSZ");
+        dxf_write_group_double (fp, 40, dxf_header.DimTSZ);
+        dxf_write_group_string (fp, 9, "$DIMTOL");
+        dxf_write_group_int (fp, 70, dxf_header.DimTOL);
+        dxf_write_group_string (fp, 9, "$DIMLIM");
+        dxf_write_group_int (fp, 70, dxf_header.DimLIM);
+        dxf_write_group_string (fp, 9, "$DIMTIH");
+        dxf_write_group_int (fp, 70, dxf_header.DimTIH);
+        dxf_write_group_string (fp, 9, "$DIMTOH");
+        dxf_write_group_int (fp, 70, dxf_header.DimTOH);
+        dxf_write_group_string (fp, 9, "$DIMSE1");
+        dxf_write_group_int (fp, 70, dxf_header.DimSE1);
+        dxf_write_group_string (fp, 9, "$DIMSE2");
+        dxf_write_group_int (fp, 70, dxf_header.DimSE2);
+        dxf_write_group_string (fp, 9, "$DIMTAD");
+        dxf_write_group_int (fp, 70, dxf_header.DimTAD);
+        dxf_write_group_string (fp, 9, "$DIMZIN");
+        dxf_write_group_int (fp, 70, dxf_header.DimZIN);
+        dxf_write_group_string (fp, 9, "$DIMBLK");
+        dxf_write_group_string (fp, 1, dxf_header.DimBLK);
+        dxf_write_group_string (fp, 9, "$DIMASO");
+        dxf_write_group_int (fp, 70, dxf_header.DimASO);
+        dxf_write_group_string (fp, 9, "$DIMSHO");
+        dxf_write_group_int (fp, 70, dxf_header.DimSHO);
+        dxf_write_group_string (fp, 9, "$DIMPOST");
+        dxf_write_group_string (fp, 1, dxf_header.DimPOST);
+        dxf_write_group_string (fp, 9, "$DIMAPOST");
+        dxf_write_group_string (fp, 1, dxf_header.DimAPOST);
+        dxf_write_group_string (fp, 9, "$DIMALT");
+        dxf_write_group_int (fp, 70, dxf_header.DimALT);
+        dxf_write_group_string (fp, 9, "$DIMALTD");
+        dxf_write_group_int (fp, 70, dxf_header.DimALTD);
+        dxf_write_group_string (fp, 9, "$DIMALTF");
+        dxf_write_group_double (fp, 40, dxf_header.DimALTF);
+        dxf_write_group_string (fp, 9, "$DIMLFAC");
+        dxf_write_group_double (fp, 40, dxf_header.DimLFAC);
+        dxf_write_group_string (fp, 9, "$DIMTOFL");
+        dxf_write_group_int (fp, 70, dxf_header.DimTOFL);
+        dxf_write_group_string (fp, 9, "$DIMTVP");
+        dxf_write_group_double (fp, 40, dxf_header.DimTVP);
+        dxf_write_group_string (fp, 9, "$DIMTIX");
+        dxf_write_group_int (fp, 70, dxf_header.DimTIX);
+        dxf_write_group_string (fp, 9, "$DIMSOXD");
+        dxf_write_group_int (fp, 70, dxf_header.DimSOXD);
+        dxf_write_group_string (fp, 9, "$DIMSAH");
+        dxf_write_group_int (fp, 70, dxf_header.DimSAH);
+        dxf_write_group_string (fp, 9, "$DIMBLK1");
+        dxf_write_group_string (fp, 1, dxf_header.DimBLK1);
+        dxf_write_group_string (fp, 9, "$DIMBLK2");
+        dxf_write_group_string (fp, 1, dxf_header.DimBLK2);
         */
         ret = dxf_read_header_parse_string (fp, temp_string, "$DIMSTYLE",
                                             &dxf_header.DimSTYLE,
                                             TRUE);
         dxf_return(ret);
         /*
-        fprintf (fp, "  9\n$DIMCLRD\n 70\n%i\n", dxf_header.DimCLRD);
-        fprintf (fp, "  9\n$DIMCLRE\n 70\n%i\n", dxf_header.DimCLRE);
-        fprintf (fp, "  9\n$DIMCLRT\n 70\n%i\n", dxf_header.DimCLRT);
-        fprintf (fp, "  9\n$DIMTFAC\n 40\n%f\n", dxf_header.DimTFAC);
+        dxf_write_group_string (fp, 9, "$DIMCLRD");
+        dxf_write_group_int (fp, 70, dxf_header.DimCLRD);
+        dxf_write_group_string (fp, 9, "$DIMCLRE");
+        dxf_write_group_int (fp, 70, dxf_header.DimCLRE);
+        dxf_write_group_string (fp, 9, "$DIMCLRT");
+        dxf_write_group_int (fp, 70, dxf_header.DimCLRT);
+        dxf_write_group_string (fp, 9, "$DIMTFAC");
+        dxf_write_group_double (fp, 40, dxf_header.DimTFAC);
         */
         ret = dxf_read_header_parse_n_double (fp, temp_string, "$DIMGAP",
                                               TRUE,
@@ -1392,21 +2178,81 @@ dxf_read_header_parser
                                               &dxf_header.DimGAP);
         dxf_return(ret);
         /*
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMJUST\n 70\n%i\n", dxf_header.DimJUST);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMSD1\n 70\n%i\n", dxf_header.DimSD1);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMSD2\n 70\n%i\n", dxf_header.DimSD2);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMTOLJ\n 70\n%i\n", dxf_header.DimTOLJ);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMTZIN\n 70\n%i\n", dxf_header.DimTZIN);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMALTZ\n 70\n%i\n", dxf_header.DimALTZ);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMALTTZ\n 70\n%i\n", dxf_header.DimALTTZ);
-        if ((acad_version_number == AC1012) || (acad_version_number == AC1014)) fprintf (fp, "  9\n$DIMFIT\n 70\n%i\n", dxf_header.DimFIT);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMUPT\n 70\n%i\n", dxf_header.DimUPT);
-        if ((acad_version_number == AC1012) || (acad_version_number == AC1014)) fprintf (fp, "  9\n$DIMUNIT\n 70\n%i\n", dxf_header.DimUNIT);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMDEC\n 70\n%i\n", dxf_header.DimDEC);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMTDEC\n 70\n%i\n", dxf_header.DimTDEC);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMALTU\n 70\n%i\n", dxf_header.DimALTU);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMALTTD\n 70\n%i\n", dxf_header.DimALTTD);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMTXSTY\n  7\n%s\n", dxf_header.DimTXSTY);
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMJUST");
+                dxf_write_group_int (fp, 70, dxf_header.DimJUST);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMSD1");
+                dxf_write_group_int (fp, 70, dxf_header.DimSD1);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMSD2");
+                dxf_write_group_int (fp, 70, dxf_header.DimSD2);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMTOLJ");
+                dxf_write_group_int (fp, 70, dxf_header.DimTOLJ);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMTZIN");
+                dxf_write_group_int (fp, 70, dxf_header.DimTZIN);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMALTZ");
+                dxf_write_group_int (fp, 70, dxf_header.DimALTZ);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMALTTZ");
+                dxf_write_group_int (fp, 70, dxf_header.DimALTTZ);
+        }
+        if ((acad_version_number == AC1012) || (acad_version_number == AC1014))
+        {
+                dxf_write_group_string (fp, 9, "$DIMFIT");
+                dxf_write_group_int (fp, 70, dxf_header.DimFIT);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMUPT");
+                dxf_write_group_int (fp, 70, dxf_header.DimUPT);
+        }
+        if ((acad_version_number == AC1012) || (acad_version_number == AC1014))
+        {
+                dxf_write_group_string (fp, 9, "$DIMUNIT");
+                dxf_write_group_int (fp, 70, dxf_header.DimUNIT);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMDEC");
+                dxf_write_group_int (fp, 70, dxf_header.DimDEC);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMTDEC");
+                dxf_write_group_int (fp, 70, dxf_header.DimTDEC);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMALTU");
+                dxf_write_group_int (fp, 70, dxf_header.DimALTU);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMALTTD");
+                dxf_write_group_int (fp, 70, dxf_header.DimALTTD);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$DIMTXSTY");
+                dxf_write_group_string (fp, 7, dxf_header.DimTXSTY);
+        }
         */
         ret = dxf_read_header_parse_int (fp, temp_string, "$DIMAUNIT",
                                          &dxf_header.DimAUNIT,
@@ -1418,21 +2264,57 @@ dxf_read_header_parser
                                          acad_version_number >= AC1015);
         dxf_return(ret);
         /*
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMALTRND\n 40\n%f\n", dxf_header.DimALTRND);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMAZIN\n 70\n%i\n", dxf_header.DimAZIN);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMDSEP\n 70\n%i\n", dxf_header.DimDSEP);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMATFIT\n 70\n%i\n", dxf_header.DimATFIT);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMFRAC\n 70\n%i\n", dxf_header.DimFRAC);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMLDRBLK\n  1\n%s\n", dxf_header.DimLDRBLK);
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMALTRND");
+                dxf_write_group_double (fp, 40, dxf_header.DimALTRND);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMAZIN");
+                dxf_write_group_int (fp, 70, dxf_header.DimAZIN);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMDSEP");
+                dxf_write_group_int (fp, 70, dxf_header.DimDSEP);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMATFIT");
+                dxf_write_group_int (fp, 70, dxf_header.DimATFIT);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMFRAC");
+                dxf_write_group_int (fp, 70, dxf_header.DimFRAC);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMLDRBLK");
+                dxf_write_group_string (fp, 1, dxf_header.DimLDRBLK);
+        }
         */
         ret = dxf_read_header_parse_int (fp, temp_string, "$DIMLUNIT",
                                          &dxf_header.DimLUNIT,
                                          acad_version_number >= AC1015);
         dxf_return(ret);
         /*
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMLWD\n 70\n%i\n", dxf_header.DimLWD);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMLWE\n 70\n%i\n", dxf_header.DimLWE);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMTMOVE\n 70\n%i\n", dxf_header.DimTMOVE);
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMLWD");
+                dxf_write_group_int (fp, 70, dxf_header.DimLWD);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMLWE");
+                dxf_write_group_int (fp, 70, dxf_header.DimLWE);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$DIMTMOVE");
+                dxf_write_group_int (fp, 70, dxf_header.DimTMOVE);
+        }
         */
         ret = dxf_read_header_parse_int (fp, temp_string, "$LUNITS",
                                          &dxf_header.LUnits,
@@ -1444,8 +2326,10 @@ dxf_read_header_parser
                                          TRUE);
         dxf_return(ret);
         /*
-        fprintf (fp, "  9\n$SKETCHINC\n 40\n%f\n", dxf_header.Sketchinc);
-        fprintf (fp, "  9\n$FILLETRAD\n 40\n%f\n", dxf_header.FilletRad);
+        dxf_write_group_string (fp, 9, "$SKETCHINC");
+        dxf_write_group_double (fp, 40, dxf_header.Sketchinc);
+        dxf_write_group_string (fp, 9, "$FILLETRAD");
+        dxf_write_group_double (fp, 40, dxf_header.FilletRad);
         */
         ret = dxf_read_header_parse_int (fp, temp_string, "$AUNITS",
                                          &dxf_header.AUnits,
@@ -1457,35 +2341,91 @@ dxf_read_header_parser
                                          TRUE);
         dxf_return(ret);
         /*
-        fprintf (fp, "  9\n$MENU\n  1\n%s\n", dxf_header.Menu);
-        fprintf (fp, "  9\n$ELEVATION\n 40\n%f\n", dxf_header.Elevation);
-        fprintf (fp, "  9\n$PELEVATION\n 40\n%f\n", dxf_header.PElevation);
-        fprintf (fp, "  9\n$THICKNESS\n 40\n%f\n", dxf_header.Thickness);
-        fprintf (fp, "  9\n$LIMCHECK\n 70\n%i\n", dxf_header.LimCheck);
-        if (acad_version_number <= AC1014) fprintf (fp, "  9\n$BLIPMODE\n 70\n%i\n", dxf_header.BlipMode);
-        fprintf (fp, "  9\n$CHAMFERA\n 40\n%f\n", dxf_header.ChamferA);
-        fprintf (fp, "  9\n$CHAMFERB\n 40\n%f\n", dxf_header.ChamferB);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$CHAMFERC\n 40\n%f\n", dxf_header.ChamferC);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$CHAMFERD\n 40\n%f\n", dxf_header.ChamferD);
-        fprintf (fp, "  9\n$SKPOLY\n 70\n%i\n", dxf_header.SKPoly);
-        fprintf (fp, "  9\n$TDCREATE\n 40\n%f\n", dxf_header.TDCreate);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$TDUCREATE\n 40\n%f\n", dxf_header.TDUCreate);
-        fprintf (fp, "  9\n$TDUPDATE\n 40\n%f\n", dxf_header.TDUpdate);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$TDUUPDATE\n 40\n%f\n", dxf_header.TDUUpdate);
-        fprintf (fp, "  9\n$TDINDWG\n 40\n%f\n", dxf_header.TDInDWG);
-        fprintf (fp, "  9\n$TDUSRTIMER\n 40\n%f\n", dxf_header.TDUSRTimer);
-        fprintf (fp, "  9\n$USRTIMER\n 70\n%i\n", dxf_header.USRTimer);
-        fprintf (fp, "  9\n$ANGBASE\n 50\n%f\n", dxf_header.AngBase);
-        fprintf (fp, "  9\n$ANGDIR\n 70\n%i\n", dxf_header.AngDir);
-        fprintf (fp, "  9\n$PDMODE\n 70\n%i\n", dxf_header.PDMode);
-        fprintf (fp, "  9\n$PDSIZE\n 40\n%f\n", dxf_header.PDSize);
-        fprintf (fp, "  9\n$PLINEWID\n 40\n%f\n", dxf_header.PLineWid);
-        if (acad_version_number <= AC1014) fprintf (fp, "  9\n$COORDS\n 70\n%i\n", dxf_header.Coords);
-        fprintf (fp, "  9\n$SPLFRAME\n 70\n%i\n", dxf_header.SPLFrame);
-        fprintf (fp, "  9\n$SPLINETYPE\n 70\n%i\n", dxf_header.SPLineType);
-        if (acad_version_number <= AC1014) fprintf (fp, "  9\n$ATTDIA\n 70\n%i\n", dxf_header.AttDia);
-        if (acad_version_number <= AC1014) fprintf (fp, "  9\n$ATTREQ\n 70\n%i\n", dxf_header.AttReq);
-        if (acad_version_number <= AC1014) fprintf (fp, "  9\n$HANDLING\n 70\n%i\n", dxf_header.Handling);
+        dxf_write_group_string (fp, 9, "$MENU");
+        dxf_write_group_string (fp, 1, dxf_header.Menu);
+        dxf_write_group_string (fp, 9, "$ELEVATION");
+        dxf_write_group_double (fp, 40, dxf_header.Elevation);
+        dxf_write_group_string (fp, 9, "$PELEVATION");
+        dxf_write_group_double (fp, 40, dxf_header.PElevation);
+        dxf_write_group_string (fp, 9, "$THICKNESS");
+        dxf_write_group_double (fp, 40, dxf_header.Thickness);
+        dxf_write_group_string (fp, 9, "$LIMCHECK");
+        dxf_write_group_int (fp, 70, dxf_header.LimCheck);
+        if (acad_version_number <= AC1014)
+        {
+                dxf_write_group_string (fp, 9, "$BLIPMODE");
+                dxf_write_group_int (fp, 70, dxf_header.BlipMode);
+        }
+        dxf_write_group_string (fp, 9, "$CHAMFERA");
+        dxf_write_group_double (fp, 40, dxf_header.ChamferA);
+        dxf_write_group_string (fp, 9, "$CHAMFERB");
+        dxf_write_group_double (fp, 40, dxf_header.ChamferB);
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$CHAMFERC");
+                dxf_write_group_double (fp, 40, dxf_header.ChamferC);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$CHAMFERD");
+                dxf_write_group_double (fp, 40, dxf_header.ChamferD);
+        }
+        dxf_write_group_string (fp, 9, "$SKPOLY");
+        dxf_write_group_int (fp, 70, dxf_header.SKPoly);
+        dxf_write_group_string (fp, 9, "$TDCREATE");
+        dxf_write_group_double (fp, 40, dxf_header.TDCreate);
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$TDUCREATE");
+                dxf_write_group_double (fp, 40, dxf_header.TDUCreate);
+        }
+        dxf_write_group_string (fp, 9, "$TDUPDATE");
+        dxf_write_group_double (fp, 40, dxf_header.TDUpdate);
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$TDUUPDATE");
+                dxf_write_group_double (fp, 40, dxf_header.TDUUpdate);
+        }
+        dxf_write_group_string (fp, 9, "$TDINDWG");
+        dxf_write_group_double (fp, 40, dxf_header.TDInDWG);
+        dxf_write_group_string (fp, 9, "$TDUSRTIMER");
+        dxf_write_group_double (fp, 40, dxf_header.TDUSRTimer);
+        dxf_write_group_string (fp, 9, "$USRTIMER");
+        dxf_write_group_int (fp, 70, dxf_header.USRTimer);
+        dxf_write_group_string (fp, 9, "$ANGBASE");
+        dxf_write_group_double (fp, 50, dxf_header.AngBase);
+        dxf_write_group_string (fp, 9, "$ANGDIR");
+        dxf_write_group_int (fp, 70, dxf_header.AngDir);
+        dxf_write_group_string (fp, 9, "$PDMODE");
+        dxf_write_group_int (fp, 70, dxf_header.PDMode);
+        dxf_write_group_string (fp, 9, "$PDSIZE");
+        dxf_write_group_double (fp, 40, dxf_header.PDSize);
+        dxf_write_group_string (fp, 9, "$PLINEWID");
+        dxf_write_group_double (fp, 40, dxf_header.PLineWid);
+        if (acad_version_number <= AC1014)
+        {
+                dxf_write_group_string (fp, 9, "$COORDS");
+                dxf_write_group_int (fp, 70, dxf_header.Coords);
+        }
+        dxf_write_group_string (fp, 9, "$SPLFRAME");
+        dxf_write_group_int (fp, 70, dxf_header.SPLFrame);
+        dxf_write_group_string (fp, 9, "$SPLINETYPE");
+        dxf_write_group_int (fp, 70, dxf_header.SPLineType);
+        if (acad_version_number <= AC1014)
+        {
+                dxf_write_group_string (fp, 9, "$ATTDIA");
+                dxf_write_group_int (fp, 70, dxf_header.AttDia);
+        }
+        if (acad_version_number <= AC1014)
+        {
+                dxf_write_group_string (fp, 9, "$ATTREQ");
+                dxf_write_group_int (fp, 70, dxf_header.AttReq);
+        }
+        if (acad_version_number <= AC1014)
+        {
+                dxf_write_group_string (fp, 9, "$HANDLING");
+                dxf_write_group_int (fp, 70, dxf_header.Handling);
+        }
         */
         ret = dxf_read_header_parse_int (fp, temp_string, "$SPLINESEGS",
                                          &dxf_header.SPLineSegs,
@@ -1497,114 +2437,396 @@ dxf_read_header_parser
                                             TRUE);
         dxf_return(ret);
     /*
-        fprintf (fp, "  9\n$SURFTAB1\n 70\n%i\n", dxf_header.SurfTab1);
-        fprintf (fp, "  9\n$SURFTAB2\n 70\n%i\n", dxf_header.SurfTab2);
-        fprintf (fp, "  9\n$SURFTYPE\n 70\n%i\n", dxf_header.SurfType);
-        fprintf (fp, "  9\n$SURFU\n 70\n%i\n", dxf_header.SurfU);
-        fprintf (fp, "  9\n$SURFV\n 70\n%i\n", dxf_header.SurfV);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSBASE\n  2\n%s\n", dxf_header.UCSBase);
-        fprintf (fp, "  9\n$UCSNAME\n  2\n%s\n", dxf_header.UCSName);
-        fprintf (fp, "  9\n$UCSORG\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSOrg.x0, dxf_header.UCSOrg.y0, dxf_header.UCSOrg.z0);
-        fprintf (fp, "  9\n$UCSXDIR\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSXDir.x0, dxf_header.UCSXDir.y0, dxf_header.UCSXDir.z0);
-        fprintf (fp, "  9\n$UCSYDIR\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSYDir.x0, dxf_header.UCSYDir.y0, dxf_header.UCSYDir.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORTHOREF\n  2\n%s\n", dxf_header.UCSOrthoRef);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORTHOVIEW\n 70\n%i\n", dxf_header.UCSOrthoView);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGTOP\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSOrgTop.x0, dxf_header.UCSOrgTop.y0, dxf_header.UCSOrgTop.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGBOTTOM\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSOrgBottom.x0, dxf_header.UCSOrgBottom.y0, dxf_header.UCSOrgBottom.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGLEFT\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSOrgLeft.x0, dxf_header.UCSOrgLeft.y0, dxf_header.UCSOrgLeft.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGRIGHT\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSOrgRight.x0, dxf_header.UCSOrgRight.y0, dxf_header.UCSOrgRight.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGFRONT\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSOrgFront.x0, dxf_header.UCSOrgFront.y0, dxf_header.UCSOrgFront.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGBACK\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.UCSOrgBack.x0, dxf_header.UCSOrgBack.y0, dxf_header.UCSOrgBack.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSBASE\n  2\n%s\n", dxf_header.PUCSBase);
-        fprintf (fp, "  9\n$PUCSNAME\n  2\n%s\n", dxf_header.PUCSName);
-        fprintf (fp, "  9\n$PUCSORG\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSOrg.x0, dxf_header.PUCSOrg.y0, dxf_header.PUCSOrg.z0);
-        fprintf (fp, "  9\n$PUCSXDIR\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSXDir.x0, dxf_header.PUCSXDir.y0, dxf_header.PUCSXDir.z0);
-        fprintf (fp, "  9\n$PUCSYDIR\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSYDir.x0, dxf_header.PUCSYDir.y0, dxf_header.PUCSYDir.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORTHOREF\n  2\n%s\n", dxf_header.PUCSOrthoRef);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORTHOVIEW\n 70\n%i\n", dxf_header.PUCSOrthoView);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGTOP\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSOrgTop.x0, dxf_header.PUCSOrgTop.y0, dxf_header.PUCSOrgTop.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGBOTTOM\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSOrgBottom.x0, dxf_header.PUCSOrgBottom.y0, dxf_header.PUCSOrgBottom.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGLEFT\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSOrgLeft.x0, dxf_header.PUCSOrgLeft.y0, dxf_header.PUCSOrgLeft.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGRIGHT\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSOrgRight.x0, dxf_header.PUCSOrgRight.y0, dxf_header.PUCSOrgRight.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGFRONT\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSOrgFront.x0, dxf_header.PUCSOrgFront.y0, dxf_header.PUCSOrgFront.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGBACK\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PUCSOrgBack.x0, dxf_header.PUCSOrgBack.y0, dxf_header.PUCSOrgBack.z0);
-        fprintf (fp, "  9\n$USERI1\n 70\n%i\n", dxf_header.UserI1);
-        fprintf (fp, "  9\n$USERI2\n 70\n%i\n", dxf_header.UserI2);
-        fprintf (fp, "  9\n$USERI3\n 70\n%i\n", dxf_header.UserI3);
-        fprintf (fp, "  9\n$USERI4\n 70\n%i\n", dxf_header.UserI4);
-        fprintf (fp, "  9\n$USERI5\n 70\n%i\n", dxf_header.UserI5);
-        fprintf (fp, "  9\n$USERR1\n 40\n%f\n", dxf_header.UserR1);
-        fprintf (fp, "  9\n$USERR2\n 40\n%f\n", dxf_header.UserR2);
-        fprintf (fp, "  9\n$USERR3\n 40\n%f\n", dxf_header.UserR3);
-        fprintf (fp, "  9\n$USERR4\n 40\n%f\n", dxf_header.UserR4);
-        fprintf (fp, "  9\n$USERR5\n 40\n%f\n", dxf_header.UserR5);
-        fprintf (fp, "  9\n$WORLDVIEW\n 70\n%i\n", dxf_header.WorldView);
-        fprintf (fp, "  9\n$SHADEDGE\n 70\n%i\n", dxf_header.ShadEdge);
-        fprintf (fp, "  9\n$SHADEDIF\n 70\n%i\n", dxf_header.ShadeDif);
-        fprintf (fp, "  9\n$TILEMODE\n 70\n%i\n", dxf_header.TileMode);
-        fprintf (fp, "  9\n$MAXACTVP\n 70\n%i\n", dxf_header.MaxActVP);
-        fprintf (fp, "  9\n$PINSBASE\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PInsBase.x0, dxf_header.PInsBase.y0, dxf_header.PInsBase.z0);
-        fprintf (fp, "  9\n$PLIMCHECK\n 70\n%i\n", dxf_header.PLimCheck);
-        fprintf (fp, "  9\n$PEXTMIN\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PExtMin.x0, dxf_header.PExtMin.y0, dxf_header.PExtMin.z0);
-        fprintf (fp, "  9\n$PEXTMAX\n 10\n%f\n 20\n%f\n 30\n%f\n", dxf_header.PExtMax.x0, dxf_header.PExtMax.y0, dxf_header.PExtMax.z0);
+        dxf_write_group_string (fp, 9, "$SURFTAB1");
+        dxf_write_group_int (fp, 70, dxf_header.SurfTab1);
+        dxf_write_group_string (fp, 9, "$SURFTAB2");
+        dxf_write_group_int (fp, 70, dxf_header.SurfTab2);
+        dxf_write_group_string (fp, 9, "$SURFTYPE");
+        dxf_write_group_int (fp, 70, dxf_header.SurfType);
+        dxf_write_group_string (fp, 9, "$SURFU");
+        dxf_write_group_int (fp, 70, dxf_header.SurfU);
+        dxf_write_group_string (fp, 9, "$SURFV");
+        dxf_write_group_int (fp, 70, dxf_header.SurfV);
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSBASE");
+                dxf_write_group_string (fp, 2, dxf_header.UCSBase);
+        }
+        dxf_write_group_string (fp, 9, "$UCSNAME");
+        dxf_write_group_string (fp, 2, dxf_header.UCSName);
+        dxf_write_group_string (fp, 9, "$UCSORG");
+        dxf_write_group_double (fp, 10, dxf_header.UCSOrg.x0);
+        dxf_write_group_double (fp, 20, dxf_header.UCSOrg.y0);
+        dxf_write_group_double (fp, 30, dxf_header.UCSOrg.z0);
+        dxf_write_group_string (fp, 9, "$UCSXDIR");
+        dxf_write_group_double (fp, 10, dxf_header.UCSXDir.x0);
+        dxf_write_group_double (fp, 20, dxf_header.UCSXDir.y0);
+        dxf_write_group_double (fp, 30, dxf_header.UCSXDir.z0);
+        dxf_write_group_string (fp, 9, "$UCSYDIR");
+        dxf_write_group_double (fp, 10, dxf_header.UCSYDir.x0);
+        dxf_write_group_double (fp, 20, dxf_header.UCSYDir.y0);
+        dxf_write_group_double (fp, 30, dxf_header.UCSYDir.z0);
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSORTHOREF");
+                dxf_write_group_string (fp, 2, dxf_header.UCSOrthoRef);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSORTHOVIEW");
+                dxf_write_group_int (fp, 70, dxf_header.UCSOrthoView);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSORGTOP");
+                dxf_write_group_double (fp, 10, dxf_header.UCSOrgTop.x0);
+                dxf_write_group_double (fp, 20, dxf_header.UCSOrgTop.y0);
+                dxf_write_group_double (fp, 30, dxf_header.UCSOrgTop.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSORGBOTTOM");
+                dxf_write_group_double (fp, 10, dxf_header.UCSOrgBottom.x0);
+                dxf_write_group_double (fp, 20, dxf_header.UCSOrgBottom.y0);
+                dxf_write_group_double (fp, 30, dxf_header.UCSOrgBottom.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSORGLEFT");
+                dxf_write_group_double (fp, 10, dxf_header.UCSOrgLeft.x0);
+                dxf_write_group_double (fp, 20, dxf_header.UCSOrgLeft.y0);
+                dxf_write_group_double (fp, 30, dxf_header.UCSOrgLeft.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSORGRIGHT");
+                dxf_write_group_double (fp, 10, dxf_header.UCSOrgRight.x0);
+                dxf_write_group_double (fp, 20, dxf_header.UCSOrgRight.y0);
+                dxf_write_group_double (fp, 30, dxf_header.UCSOrgRight.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSORGFRONT");
+                dxf_write_group_double (fp, 10, dxf_header.UCSOrgFront.x0);
+                dxf_write_group_double (fp, 20, dxf_header.UCSOrgFront.y0);
+                dxf_write_group_double (fp, 30, dxf_header.UCSOrgFront.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$UCSORGBACK");
+                dxf_write_group_double (fp, 10, dxf_header.UCSOrgBack.x0);
+                dxf_write_group_double (fp, 20, dxf_header.UCSOrgBack.y0);
+                dxf_write_group_double (fp, 30, dxf_header.UCSOrgBack.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSBASE");
+                dxf_write_group_string (fp, 2, dxf_header.PUCSBase);
+        }
+        dxf_write_group_string (fp, 9, "$PUCSNAME");
+        dxf_write_group_string (fp, 2, dxf_header.PUCSName);
+        dxf_write_group_string (fp, 9, "$PUCSORG");
+        dxf_write_group_double (fp, 10, dxf_header.PUCSOrg.x0);
+        dxf_write_group_double (fp, 20, dxf_header.PUCSOrg.y0);
+        dxf_write_group_double (fp, 30, dxf_header.PUCSOrg.z0);
+        dxf_write_group_string (fp, 9, "$PUCSXDIR");
+        dxf_write_group_double (fp, 10, dxf_header.PUCSXDir.x0);
+        dxf_write_group_double (fp, 20, dxf_header.PUCSXDir.y0);
+        dxf_write_group_double (fp, 30, dxf_header.PUCSXDir.z0);
+        dxf_write_group_string (fp, 9, "$PUCSYDIR");
+        dxf_write_group_double (fp, 10, dxf_header.PUCSYDir.x0);
+        dxf_write_group_double (fp, 20, dxf_header.PUCSYDir.y0);
+        dxf_write_group_double (fp, 30, dxf_header.PUCSYDir.z0);
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSORTHOREF");
+                dxf_write_group_string (fp, 2, dxf_header.PUCSOrthoRef);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSORTHOVIEW");
+                dxf_write_group_int (fp, 70, dxf_header.PUCSOrthoView);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSORGTOP");
+                dxf_write_group_double (fp, 10, dxf_header.PUCSOrgTop.x0);
+                dxf_write_group_double (fp, 20, dxf_header.PUCSOrgTop.y0);
+                dxf_write_group_double (fp, 30, dxf_header.PUCSOrgTop.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSORGBOTTOM");
+                dxf_write_group_double (fp, 10, dxf_header.PUCSOrgBottom.x0);
+                dxf_write_group_double (fp, 20, dxf_header.PUCSOrgBottom.y0);
+                dxf_write_group_double (fp, 30, dxf_header.PUCSOrgBottom.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSORGLEFT");
+                dxf_write_group_double (fp, 10, dxf_header.PUCSOrgLeft.x0);
+                dxf_write_group_double (fp, 20, dxf_header.PUCSOrgLeft.y0);
+                dxf_write_group_double (fp, 30, dxf_header.PUCSOrgLeft.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSORGRIGHT");
+                dxf_write_group_double (fp, 10, dxf_header.PUCSOrgRight.x0);
+                dxf_write_group_double (fp, 20, dxf_header.PUCSOrgRight.y0);
+                dxf_write_group_double (fp, 30, dxf_header.PUCSOrgRight.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSORGFRONT");
+                dxf_write_group_double (fp, 10, dxf_header.PUCSOrgFront.x0);
+                dxf_write_group_double (fp, 20, dxf_header.PUCSOrgFront.y0);
+                dxf_write_group_double (fp, 30, dxf_header.PUCSOrgFront.z0);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PUCSORGBACK");
+                dxf_write_group_double (fp, 10, dxf_header.PUCSOrgBack.x0);
+                dxf_write_group_double (fp, 20, dxf_header.PUCSOrgBack.y0);
+                dxf_write_group_double (fp, 30, dxf_header.PUCSOrgBack.z0);
+        }
+        dxf_write_group_string (fp, 9, "$USERI1");
+        dxf_write_group_int (fp, 70, dxf_header.UserI1);
+        dxf_write_group_string (fp, 9, "$USERI2");
+        dxf_write_group_int (fp, 70, dxf_header.UserI2);
+        dxf_write_group_string (fp, 9, "$USERI3");
+        dxf_write_group_int (fp, 70, dxf_header.UserI3);
+        dxf_write_group_string (fp, 9, "$USERI4");
+        dxf_write_group_int (fp, 70, dxf_header.UserI4);
+        dxf_write_group_string (fp, 9, "$USERI5");
+        dxf_write_group_int (fp, 70, dxf_header.UserI5);
+        dxf_write_group_string (fp, 9, "$USERR1");
+        dxf_write_group_double (fp, 40, dxf_header.UserR1);
+        dxf_write_group_string (fp, 9, "$USERR2");
+        dxf_write_group_double (fp, 40, dxf_header.UserR2);
+        dxf_write_group_string (fp, 9, "$USERR3");
+        dxf_write_group_double (fp, 40, dxf_header.UserR3);
+        dxf_write_group_string (fp, 9, "$USERR4");
+        dxf_write_group_double (fp, 40, dxf_header.UserR4);
+        dxf_write_group_string (fp, 9, "$USERR5");
+        dxf_write_group_double (fp, 40, dxf_header.UserR5);
+        dxf_write_group_string (fp, 9, "$WORLDVIEW");
+        dxf_write_group_int (fp, 70, dxf_header.WorldView);
+        dxf_write_group_string (fp, 9, "$SHADEDGE");
+        dxf_write_group_int (fp, 70, dxf_header.ShadEdge);
+        dxf_write_group_string (fp, 9, "$SHADEDIF");
+        dxf_write_group_int (fp, 70, dxf_header.ShadeDif);
+        dxf_write_group_string (fp, 9, "$TILEMODE");
+        dxf_write_group_int (fp, 70, dxf_header.TileMode);
+        dxf_write_group_string (fp, 9, "$MAXACTVP");
+        dxf_write_group_int (fp, 70, dxf_header.MaxActVP);
+        dxf_write_group_string (fp, 9, "$PINSBASE");
+        dxf_write_group_double (fp, 10, dxf_header.PInsBase.x0);
+        dxf_write_group_double (fp, 20, dxf_header.PInsBase.y0);
+        dxf_write_group_double (fp, 30, dxf_header.PInsBase.z0);
+        dxf_write_group_string (fp, 9, "$PLIMCHECK");
+        dxf_write_group_int (fp, 70, dxf_header.PLimCheck);
+        dxf_write_group_string (fp, 9, "$PEXTMIN");
+        dxf_write_group_double (fp, 10, dxf_header.PExtMin.x0);
+        dxf_write_group_double (fp, 20, dxf_header.PExtMin.y0);
+        dxf_write_group_double (fp, 30, dxf_header.PExtMin.z0);
+        dxf_write_group_string (fp, 9, "$PEXTMAX");
+        dxf_write_group_double (fp, 10, dxf_header.PExtMax.x0);
+        dxf_write_group_double (fp, 20, dxf_header.PExtMax.y0);
+        dxf_write_group_double (fp, 30, dxf_header.PExtMax.z0);
         */
         ret = dxf_read_header_parse_n_double (fp, temp_string, "$PLIMMIN",
                                               TRUE,
                                               2,
                                               &dxf_header.PLimMin.x0,
-                                              dxf_header.PLimMin.y0);
+                                              &dxf_header.PLimMin.y0);
         dxf_return(ret);
     
         ret = dxf_read_header_parse_n_double (fp, temp_string, "$PLIMMAX",
                                               TRUE,
                                               2,
                                               &dxf_header.PLimMax.x0,
-                                              dxf_header.PLimMax.y0);
+                                              &dxf_header.PLimMax.y0);
         dxf_return(ret);
         /*
-        fprintf (fp, "  9\n$UNITMODE\n 70\n%i\n", dxf_header.UnitMode);
-        fprintf (fp, "  9\n$VISRETAIN\n 70\n%i\n", dxf_header.VisRetain);
-        fprintf (fp, "  9\n$PLINEGEN\n 70\n%i\n", dxf_header.PLineGen);
-        fprintf (fp, "  9\n$PSLTSCALE\n 70\n%i\n", dxf_header.PSLTScale);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$TREEDEPTH\n 70\n%i\n", dxf_header.TreeDepth);
-        if ((acad_version_number == AC1012) || (acad_version_number == AC1014)) fprintf (fp, "  9\n$PICKSTYLE\n 70\n%i\n", dxf_header.PickStyle);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$CMLSTYLE\n  2\n%s\n", dxf_header.CMLStyle);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$CMLJUST\n 70\n%i\n", dxf_header.CMLJust);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$CMLSCALE\n 40\n%f\n", dxf_header.CMLScale);
-        if (acad_version_number >= AC1014) fprintf (fp, "  9\n$PROXYGRAPHICS\n 70\n%i\n", dxf_header.ProxyGraphics);
-        if (acad_version_number >= AC1014) fprintf (fp, "  9\n$MEASUREMENT\n 70\n%i\n", dxf_header.Measurement);
-        if (acad_version_number == AC1012) fprintf (fp, "  9\n$SAVEIMAGES\n 70\n%i\n", dxf_header.SaveImages);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$CELWEIGHT\n370\n%i\n", dxf_header.CELWeight);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$ENDCAPS\n280\n%i\n", dxf_header.EndCaps);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$JOINSTYLE\n280\n%i\n", dxf_header.JoinStyle);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$LWDISPLAY\n290\n%i\n", dxf_header.LWDisplay);
+        dxf_write_group_string (fp, 9, "$UNITMODE");
+        dxf_write_group_int (fp, 70, dxf_header.UnitMode);
+        dxf_write_group_string (fp, 9, "$VISRETAIN");
+        dxf_write_group_int (fp, 70, dxf_header.VisRetain);
+        dxf_write_group_string (fp, 9, "$PLINEGEN");
+        dxf_write_group_int (fp, 70, dxf_header.PLineGen);
+        dxf_write_group_string (fp, 9, "$PSLTSCALE");
+        dxf_write_group_int (fp, 70, dxf_header.PSLTScale);
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$TREEDEPTH");
+                dxf_write_group_int (fp, 70, dxf_header.TreeDepth);
+        }
+        if ((acad_version_number == AC1012) || (acad_version_number == AC1014))
+        {
+                dxf_write_group_string (fp, 9, "$PICKSTYLE");
+                dxf_write_group_int (fp, 70, dxf_header.PickStyle);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$CMLSTYLE");
+                dxf_write_group_string (fp, 2, dxf_header.CMLStyle);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$CMLJUST");
+                dxf_write_group_int (fp, 70, dxf_header.CMLJust);
+        }
+        if (acad_version_number >= AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$CMLSCALE");
+                dxf_write_group_double (fp, 40, dxf_header.CMLScale);
+        }
+        if (acad_version_number >= AC1014)
+        {
+                dxf_write_group_string (fp, 9, "$PROXYGRAPHICS");
+                dxf_write_group_int (fp, 70, dxf_header.ProxyGraphics);
+        }
+        if (acad_version_number >= AC1014)
+        {
+                dxf_write_group_string (fp, 9, "$MEASUREMENT");
+                dxf_write_group_int (fp, 70, dxf_header.Measurement);
+        }
+        if (acad_version_number == AC1012)
+        {
+                dxf_write_group_string (fp, 9, "$SAVEIMAGES");
+                dxf_write_group_int (fp, 70, dxf_header.SaveImages);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$CELWEIGHT");
+                dxf_write_group_int (fp, 370, dxf_header.CELWeight);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$ENDCAPS");
+                dxf_write_group_int (fp, 280, dxf_header.EndCaps);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$JOINSTYLE");
+                dxf_write_group_int (fp, 280, dxf_header.JoinStyle);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$LWDISPLAY");
+                dxf_write_group_int (fp, 290, dxf_header.LWDisplay);
+        }
         */
         ret = dxf_read_header_parse_int (fp, temp_string, "$INSUNITS",
                                          &dxf_header.InsUnits,
                                          acad_version_number >= AC1015);
         dxf_return(ret);
         /*
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$HYPERLINKBASE\n  1\n%s\n", dxf_header.HyperLinkBase);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$STYLESHEET\n  1\n%s\n", dxf_header.StyleSheet);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$XEDIT\n290\n%i\n", dxf_header.XEdit);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$CEPSNTYPE\n380\n%i\n", dxf_header.CEPSNType);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PSTYLEMODE\n290\n%i\n", dxf_header.PStyleMode);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$FINGERPRINTGUID\n  2\n%s\n", dxf_header.FingerPrintGUID);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$VERSIONGUID\n  2\n%s\n", dxf_header.VersionGUID);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$EXTNAMES\n290\n%i\n", dxf_header.ExtNames);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PSVPSCALE\n 40\n%f\n", dxf_header.PSVPScale);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$OLESTARTUP\n290\n%i\n", dxf_header.OLEStartUp);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$SORTENTS\n280\n%i\n", dxf_header.SortEnts);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$INDEXCTL\n280\n%i\n", dxf_header.IndexCtl);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$HIDETEXT\n280\n%i\n", dxf_header.HideText);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$XCLIPFRAME\n290\n%i\n", dxf_header.XClipFrame);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$HALOGAP\n280\n%i\n", dxf_header.HaloGap);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$OBSCOLOR\n 70\n%i\n", dxf_header.ObsColor);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$OBSLTYPE\n280\n%i\n", dxf_header.ObsLType);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$INTERSECTIONDISPLAY\n280\n%i\n", dxf_header.InterSectionDisplay);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$INTERSECTIONCOLOR\n 70\n%i\n", dxf_header.InterSectionColor);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$DIMASSOC\n280\n%i\n", dxf_header.DimASSOC);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$PROJECTNAME\n  1\n%s\n", dxf_header.ProjectName);        
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$HYPERLINKBASE");
+                dxf_write_group_string (fp, 1, dxf_header.HyperLinkBase);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$STYLESHEET");
+                dxf_write_group_string (fp, 1, dxf_header.StyleSheet);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$XEDIT");
+                dxf_write_group_int (fp, 290, dxf_header.XEdit);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$CEPSNTYPE");
+                dxf_write_group_int (fp, 380, dxf_header.CEPSNType);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PSTYLEMODE");
+                dxf_write_group_int (fp, 290, dxf_header.PStyleMode);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$FINGERPRINTGUID");
+                dxf_write_group_string (fp, 2, dxf_header.FingerPrintGUID);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$VERSIONGUID");
+                dxf_write_group_string (fp, 2, dxf_header.VersionGUID);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$EXTNAMES");
+                dxf_write_group_int (fp, 290, dxf_header.ExtNames);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$PSVPSCALE");
+                dxf_write_group_double (fp, 40, dxf_header.PSVPScale);
+        }
+        if (acad_version_number >= AC1015)
+        {
+                dxf_write_group_string (fp, 9, "$OLESTARTUP");
+                dxf_write_group_int (fp, 290, dxf_header.OLEStartUp);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$SORTENTS");
+                dxf_write_group_int (fp, 280, dxf_header.SortEnts);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$INDEXCTL");
+                dxf_write_group_int (fp, 280, dxf_header.IndexCtl);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$HIDETEXT");
+                dxf_write_group_int (fp, 280, dxf_header.HideText);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$XCLIPFRAME");
+                dxf_write_group_int (fp, 290, dxf_header.XClipFrame);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$HALOGAP");
+                dxf_write_group_int (fp, 280, dxf_header.HaloGap);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$OBSCOLOR");
+                dxf_write_group_int (fp, 70, dxf_header.ObsColor);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$OBSLTYPE");
+                dxf_write_group_int (fp, 280, dxf_header.ObsLType);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$INTERSECTIONDISPLAY");
+                dxf_write_group_int (fp, 280, dxf_header.InterSectionDisplay);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$INTERSECTIONCOLOR");
+                dxf_write_group_int (fp, 70, dxf_header.InterSectionColor);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$DIMASSOC");
+                dxf_write_group_int (fp, 280, dxf_header.DimASSOC);
+        }
+        if (acad_version_number >= AC1018)
+        {
+                dxf_write_group_string (fp, 9, "$PROJECTNAME");
+                dxf_write_group_string (fp, 1, dxf_header.ProjectName);
+        }
 */
         ret = dxf_read_header_parse_n_double (fp, temp_string, "$GRIDUNIT",
                                               acad_version_number >= AC1009,
@@ -1654,7 +2876,7 @@ dxf_read_header
         dxf_header._AcadVer = acad_version_number;
     
         /* a loop to read all the header with no particulary order */
-        while (!feof(fp->fp))
+        while (!dxf_read_eof (fp))
         {
                 /* reads the next header content */
                 dxf_read_scanf (fp, "%i\n%s\n", &n, temp_string);
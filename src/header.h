@@ -304,7 +304,7 @@ dxf_header
 
 int dxf_init_header (DxfHeader dxf_header, int acad_version_number);
 int dxf_read_header (DxfFile *fp, DxfHeader dxf_header);
-int dxf_write_header (FILE *fp, DxfHeader dxf_header, int acad_version_number);
+int dxf_write_header (DxfWriter *fp, DxfHeader dxf_header, int acad_version_number);
 
 #endif /* HEADER_H */
 
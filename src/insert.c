@@ -35,12 +35,25 @@
 
 
 #include "insert.h"
+#include "arena.h"
+#include "pool.h"
+#include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_insert_new are handed out by.
+ */
+static DxfPool dxf_insert_pool = DXF_POOL_INITIALIZER (sizeof (DxfInsert));
 
 
 /*!
  * \brief Allocate memory for a \c DxfInsert.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_insert_free.
  */
 DxfInsert *
 dxf_insert_new ()
@@ -50,31 +63,92 @@ dxf_insert_new ()
                 __FILE__, __LINE__);
 #endif
         DxfInsert *dxf_insert = NULL;
-        size_t size;
 
-        size = sizeof (DxfInsert);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_insert = malloc (size)) == NULL)
+        if ((dxf_insert = dxf_pool_alloc (&dxf_insert_pool)) == NULL)
         {
                 fprintf (stderr, "ERROR in dxf_insert_new () could not allocate memory for a DxfInsert struct.\n");
-                dxf_insert = NULL;
         }
-        else
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_insert_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_insert);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfInsert from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_insert_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfInsert *
+dxf_insert_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_insert_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfInsert *dxf_insert = NULL;
+
+        if (arena == NULL)
+        {
+                dxf_insert = dxf_insert_new ();
+        }
+        else if ((dxf_insert = dxf_arena_alloc (arena, sizeof (DxfInsert))) == NULL)
         {
-                memset (dxf_insert, 0, size);
+                fprintf (stderr, "ERROR in dxf_insert_new_arena () could not allocate memory for a DxfInsert struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_insert_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_insert_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_insert);
 }
 
 
+/*!
+ * \brief Release a \c DxfInsert allocated by \c dxf_insert_new to its pool.
+ *
+ * The struct has no strings of its own, the block name, layer and linetype are
+ * interned (see \c dxf_arena_intern).\n
+ * Not for a \c DxfInsert allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_insert_free
+(
+        DxfInsert *dxf_insert
+                /*!< DXF insert entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_insert_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        dxf_pool_release (&dxf_insert_pool, dxf_insert);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_insert_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in a \c INSERT entity.
  * 
+ * The layer, linetype and block name are interned in the names
+ * shared by the entities without an arena (see
+ * \c dxf_intern_shared), they stay valid until
+ * \c dxf_intern_shared_free.
+ *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
  */
@@ -89,16 +163,46 @@ dxf_insert_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_insert_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        dxf_insert = dxf_insert_new ();
+        dxf_insert = dxf_insert_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_insert_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_insert);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in a \c INSERT entity.
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_insert_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfInsert *
+dxf_insert_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_insert_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfInsert *dxf_insert = NULL;
+        dxf_insert = dxf_insert_new_arena (arena);
         if (dxf_insert == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_insert_init () could not allocate memory for a DxfInsert struct.\n");
+              fprintf (stderr, "ERROR in dxf_insert_init_arena () could not allocate memory for a DxfInsert struct.\n");
               return (NULL);
         }
-        dxf_insert->block_name = strdup ("");
+        dxf_insert->block_name = dxf_arena_intern (arena, "");
         dxf_insert->common.id_code = 0;
-        dxf_insert->common.linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dxf_insert->common.layer = strdup (DXF_DEFAULT_LAYER);
+        dxf_insert->common.linetype = dxf_arena_intern (arena, DXF_DEFAULT_LINETYPE);
+        dxf_insert->common.layer = dxf_arena_intern (arena, DXF_DEFAULT_LAYER);
         dxf_insert->x0 = 0.0;
         dxf_insert->y0 = 0.0;
         dxf_insert->z0 = 0.0;
@@ -119,13 +223,39 @@ dxf_insert_init
         dxf_insert->extr_y0 = 0.0;
         dxf_insert->extr_z0 = 0.0;
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_insert_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_insert_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_insert);
 }
 
 
+/*!
+ * \brief Schema of the \c INSERT entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_insert_schema[DXF_SCHEMA_SIZE] =
+{
+        DXF_SCHEMA_ENTITY_COMMON (DxfInsert),
+        [2] = DXF_SCHEMA_FIELD (DXF_FIELD_NAME, DxfInsert, block_name),
+        [10] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfInsert, x0),
+        [20] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfInsert, y0),
+        [30] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfInsert, z0),
+        [38] = DXF_SCHEMA_FIELD (DXF_FIELD_ELEVATION, DxfInsert, z0),
+        [41] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfInsert, rel_x_scale),
+        [42] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfInsert, rel_y_scale),
+        [43] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfInsert, rel_z_scale),
+        [44] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfInsert, column_spacing),
+        [45] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfInsert, row_spacing),
+        [50] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfInsert, rot_angle),
+        [66] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfInsert, attributes_follow),
+        [70] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfInsert, columns),
+        [71] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfInsert, rows),
+        [210] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfInsert, extr_x0),
+        [220] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfInsert, extr_y0),
+        [230] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfInsert, extr_z0)
+};
+
+
 /*!
  * \brief Read data from a DXF file into an \c INSERT entity.
  *
@@ -133,7 +263,8 @@ dxf_insert_init
  * Now follows some data for the \c INSERT, to be terminated with a "  0"
  * string announcing the following entity, or the end of the \c ENTITY
  * section marker \c ENDSEC. \n
- * While parsing the DXF file store data in \c dxf_insert. \n
+ * While parsing the DXF file store data in \c dxf_insert, the group
+ * codes are decoded through \c dxf_insert_schema. \n
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -141,12 +272,8 @@ dxf_insert_init
 int
 dxf_insert_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         DxfInsert *dxf_insert,
                 /*!< DXF insert entity. */
         int acad_version_number
@@ -157,221 +284,19 @@ dxf_insert_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_insert_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
         if (!dxf_insert)
         {
                 dxf_insert = dxf_insert_new ();
         }
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_insert_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (EXIT_FAILURE);
-                }
-                if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a block name
-                         * value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_insert->block_name);
-                }
-                else if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (*line_number)++;
-                        fscanf (fp, "%x\n", &dxf_insert->common.id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_insert->common.linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_insert->common.layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_insert->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_insert->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_insert->z0);
-                }
-                else if ((acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (dxf_insert->z0 = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_insert->z0);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_insert->common.thickness);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * relative X-scale. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_insert->rel_x_scale);
-                }
-                else if (strcmp (temp_string, "42") == 0)
-                {
-                        /* Now follows a string containing the
-                         * relative Y-scale. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_insert->rel_y_scale);
-                }
-                else if (strcmp (temp_string, "43") == 0)
-                {
-                        /* Now follows a string containing the
-                         * relative Z-scale. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_insert->rel_z_scale);
-                }
-                else if (strcmp (temp_string, "44") == 0)
-                {
-                        /* Now follows a string containing the
-                         * column spacing. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_insert->column_spacing);
-                }
-                else if (strcmp (temp_string, "45") == 0)
-                {
-                        /* Now follows a string containing the
-                         * row spacing. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_insert->row_spacing);
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing the
-                         * rotation angle. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_insert->rot_angle);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_insert->common.color);
-                }
-                else if (strcmp (temp_string, "66") == 0)
-                {
-                        /* Now follows a string containing the
-                         * attributes follow flag. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_insert->attributes_follow);
-                        /*! \todo After a set attributes_follow flag is
-                         * detected, parsing of following entities should
-                         * be implemented until the end of sequence
-                         * marker (\c SEQEND) is encountered. */
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_insert->common.paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * number of columns. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_insert->columns);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the
-                         * number of rows. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_insert->rows);
-                }
-                else if ((acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_insert->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_insert->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_insert->extr_z0);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning: in dxf_insert_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_insert_schema, dxf_insert, NULL,
+                "INSERT", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_insert_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -381,8 +306,8 @@ dxf_insert_read
 int
 dxf_insert_write_lowlevel
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< group code = 5. */
         char *block_name,
@@ -493,67 +418,67 @@ dxf_insert_write_lowlevel
                         dxf_entity_name);
                 rows = 1;
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
-        fprintf (fp, "  2\n%s\n", block_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
+        dxf_write_group_string (fp, 2, block_name);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
         if (rel_x_scale != 1.0)
         {
-                fprintf (fp, " 41\n%f\n", rel_x_scale);
+                dxf_write_group_double (fp, 41, rel_x_scale);
         }
         if (rel_y_scale != 1.0)
         {
-                fprintf (fp, " 42\n%f\n", rel_y_scale);
+                dxf_write_group_double (fp, 42, rel_y_scale);
         }
         if (rel_z_scale != 1.0)
         {
-                fprintf (fp, " 43\n%f\n", rel_z_scale);
+                dxf_write_group_double (fp, 43, rel_z_scale);
         }
         if ((columns > 1) && (column_spacing > 0.0))
         {
-                fprintf (fp, " 44\n%f\n", column_spacing);
+                dxf_write_group_double (fp, 44, column_spacing);
         }
         if ((rows > 1) && (row_spacing > 0.0))
         {
-                fprintf (fp, " 45\n%f\n", row_spacing);
+                dxf_write_group_double (fp, 45, row_spacing);
         }
         if (rot_angle != 0.0)
         {
-                fprintf (fp, " 50\n%f\n", rot_angle);
+                dxf_write_group_double (fp, 50, rot_angle);
         }
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
         if (attributes_follow != 0)
         {
-                fprintf (fp, " 66\n%d\n", attributes_follow);
+                dxf_write_group_int (fp, 66, attributes_follow);
         }
         if (paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
         if (columns > 1)
         {
-                fprintf (fp, " 70\n%d\n", columns);
+                dxf_write_group_int (fp, 70, columns);
         }
         if (rows > 1)
         {
-                fprintf (fp, " 71\n%d\n", rows);
+                dxf_write_group_int (fp, 71, rows);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_insert2 () function.\n",
@@ -568,8 +493,8 @@ dxf_insert_write_lowlevel
 int
 dxf_insert_write
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfInsert dxf_insert
                 /*!< DXF insert entity. */
 )
@@ -628,67 +553,67 @@ dxf_insert_write
                         dxf_entity_name);
                 dxf_insert.rows = 1;
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
-        fprintf (fp, "  2\n%s\n", dxf_insert.block_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
+        dxf_write_group_string (fp, 2, dxf_insert.block_name);
         if (dxf_insert.common.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_insert.common.id_code);
+                dxf_write_group_hex (fp, 5, dxf_insert.common.id_code);
         }
         if (strcmp (dxf_insert.common.linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", dxf_insert.common.linetype);
+                dxf_write_group_string (fp, 6, dxf_insert.common.linetype);
         }
-        fprintf (fp, "  8\n%s\n", dxf_insert.common.layer);
-        fprintf (fp, " 10\n%f\n", dxf_insert.x0);
-        fprintf (fp, " 20\n%f\n", dxf_insert.y0);
-        fprintf (fp, " 30\n%f\n", dxf_insert.z0);
+        dxf_write_group_string (fp, 8, dxf_insert.common.layer);
+        dxf_write_group_double (fp, 10, dxf_insert.x0);
+        dxf_write_group_double (fp, 20, dxf_insert.y0);
+        dxf_write_group_double (fp, 30, dxf_insert.z0);
         if (dxf_insert.common.thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", dxf_insert.common.thickness);
+                dxf_write_group_double (fp, 39, dxf_insert.common.thickness);
         }
         if (dxf_insert.rel_x_scale != 1.0)
         {
-                fprintf (fp, " 41\n%f\n", dxf_insert.rel_x_scale);
+                dxf_write_group_double (fp, 41, dxf_insert.rel_x_scale);
         }
         if (dxf_insert.rel_y_scale != 1.0)
         {
-                fprintf (fp, " 42\n%f\n", dxf_insert.rel_y_scale);
+                dxf_write_group_double (fp, 42, dxf_insert.rel_y_scale);
         }
         if (dxf_insert.rel_z_scale != 1.0)
         {
-                fprintf (fp, " 43\n%f\n", dxf_insert.rel_z_scale);
+                dxf_write_group_double (fp, 43, dxf_insert.rel_z_scale);
         }
         if ((dxf_insert.columns > 1) && (dxf_insert.column_spacing > 0.0))
         {
-                fprintf (fp, " 44\n%f\n", dxf_insert.column_spacing);
+                dxf_write_group_double (fp, 44, dxf_insert.column_spacing);
         }
         if ((dxf_insert.rows > 1) && (dxf_insert.row_spacing > 0.0))
         {
-                fprintf (fp, " 45\n%f\n", dxf_insert.row_spacing);
+                dxf_write_group_double (fp, 45, dxf_insert.row_spacing);
         }
         if (dxf_insert.rot_angle != 0.0)
         {
-                fprintf (fp, " 50\n%f\n", dxf_insert.rot_angle);
+                dxf_write_group_double (fp, 50, dxf_insert.rot_angle);
         }
         if (dxf_insert.common.color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", dxf_insert.common.color);
+                dxf_write_group_int (fp, 62, dxf_insert.common.color);
         }
         if (dxf_insert.attributes_follow != 0)
         {
-                fprintf (fp, " 66\n%d\n", dxf_insert.attributes_follow);
+                dxf_write_group_int (fp, 66, dxf_insert.attributes_follow);
         }
         if (dxf_insert.common.paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
         if (dxf_insert.columns > 1)
         {
-                fprintf (fp, " 70\n%d\n", dxf_insert.columns);
+                dxf_write_group_int (fp, 70, dxf_insert.columns);
         }
         if (dxf_insert.rows > 1)
         {
-                fprintf (fp, " 71\n%d\n", dxf_insert.rows);
+                dxf_write_group_int (fp, 71, dxf_insert.rows);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_insert_write () function.\n",
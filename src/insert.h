@@ -111,23 +111,36 @@ dxf_insert
 DxfInsert *
 dxf_insert_new ();
 DxfInsert *
+dxf_insert_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_insert_free
+(
+        DxfInsert *dxf_insert
+);
+DxfInsert *
 dxf_insert_init
 (
         DxfInsert *dxf_insert
 );
+DxfInsert *
+dxf_insert_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_insert_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfInsert *dxf_insert,
         int acad_version_number
 );
 int
 dxf_insert_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *block_name,
         char *linetype,
@@ -151,7 +164,7 @@ dxf_insert_write_lowlevel
 int
 dxf_insert_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfInsert dxf_insert
 );
 
@@ -0,0 +1,533 @@
+/*!
+ * \file intern.c
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Functions for a table of interned strings.
+ *
+ * A table holds one copy of each distinct string, so the layer name of
+ * millions of entities takes the memory of a single string, and two names
+ * are the same when their pointers are the same.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "libdxf.h"
+#endif
+#if HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+#include "intern.h"
+#include "arena.h"
+
+
+#if defined (__GNUC__)
+/*!
+ * \brief Loads a member published by another thread.
+ */
+#define DXF_INTERN_LOAD(member) __atomic_load_n (&(member), __ATOMIC_ACQUIRE)
+/*!
+ * \brief Publishes a member to the threads reading the table.
+ */
+#define DXF_INTERN_STORE(member, value) __atomic_store_n (&(member), (value), __ATOMIC_RELEASE)
+/*!
+ * \brief Lookups read the table without taking the mutex.
+ */
+#define DXF_INTERN_LOCK_FREE 1
+#else
+#define DXF_INTERN_LOAD(member) (member)
+#define DXF_INTERN_STORE(member, value) ((member) = (value))
+#define DXF_INTERN_LOCK_FREE 0
+#endif
+
+
+/*!
+ * \brief Computes the FNV-1a hash of \c length characters of a string.
+ *
+ * \return the hash.
+ */
+static size_t
+dxf_intern_hash
+(
+        const char *string,
+                /*!< the string. */
+        size_t length
+                /*!< number of characters. */
+)
+{
+        size_t hash = 2166136261u;
+        size_t i;
+
+        for (i = 0; i < length; i++)
+        {
+                hash ^= (unsigned char) string[i];
+                hash *= 16777619u;
+        }
+        return (hash);
+}
+
+
+/*!
+ * \brief Allocates the slots and the names of a table with \c size
+ * slots from the arena of its strings.
+ *
+ * The arrays replaced by a larger table stay in the arena until the table
+ * is freed, so a thread looking up a string without the mutex never reads
+ * freed memory; as the table doubles they take less memory than the
+ * current arrays.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * was allocated.
+ */
+static int
+dxf_intern_allocate
+(
+        DxfIntern *intern,
+                /*!< the table. */
+        size_t size
+                /*!< number of slots, a power of two. */
+)
+{
+        size_t *slots;
+        char **names;
+        size_t i;
+        size_t j;
+
+        /* The number of slots goes in front of the slots, so a lookup
+         * reads them together. */
+        slots = dxf_arena_alloc (intern->strings, (size + 1) * sizeof (size_t));
+        names = dxf_arena_alloc (intern->strings, size / 2 * sizeof (char *));
+        if (!slots || !names)
+        {
+                fprintf (stderr, "Error in dxf_intern_allocate () could not allocate memory for the slots.\n");
+                return (EXIT_FAILURE);
+        }
+        slots[0] = size;
+        for (i = 0; i < intern->count; i++)
+        {
+                names[i] = intern->names[i];
+                j = dxf_intern_hash (names[i], strlen (names[i])) & (size - 1);
+                while (slots[j + 1])
+                        j = (j + 1) & (size - 1);
+                slots[j + 1] = i + 1;
+        }
+        /* The names first, a slot found in the new slots has its name in
+         * the new names. */
+        DXF_INTERN_STORE (intern->names, names);
+        DXF_INTERN_STORE (intern->slots, slots);
+        intern->size = size;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Allocates an empty table of interned strings.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the table
+ * when succesful.
+ */
+DxfIntern *
+dxf_intern_new ()
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_intern_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfIntern *intern;
+
+        intern = malloc (sizeof (DxfIntern));
+        if (!intern)
+        {
+                fprintf (stderr, "Error in dxf_intern_new () could not allocate memory for a DxfIntern struct.\n");
+                return (NULL);
+        }
+        /* Names are few and short. */
+        intern->strings = dxf_arena_new (DXF_READ_STRINGS_SIZE);
+        intern->names = NULL;
+        intern->count = 0;
+        intern->slots = NULL;
+        intern->size = 0;
+        intern->lock = NULL;
+#if HAVE_PTHREAD_H
+        intern->lock = malloc (sizeof (pthread_mutex_t));
+        if (intern->lock && (pthread_mutex_init (intern->lock, NULL) != 0))
+        {
+                free (intern->lock);
+                intern->lock = NULL;
+        }
+        if (!intern->lock)
+        {
+                fprintf (stderr, "Error in dxf_intern_new () could not create a mutex.\n");
+                dxf_intern_free (intern);
+                return (NULL);
+        }
+#endif
+        if (!intern->strings
+                || (dxf_intern_allocate (intern, DXF_INTERN_SIZE) != EXIT_SUCCESS))
+        {
+                fprintf (stderr, "Error in dxf_intern_new () could not allocate memory for the strings.\n");
+                dxf_intern_free (intern);
+                return (NULL);
+        }
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_intern_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (intern);
+}
+
+
+/*!
+ * \brief Looks up \c length characters of a string with hash \c hash in
+ * the slots of a table.
+ *
+ * Reads the slots as published by \c dxf_intern_allocate and
+ * \c dxf_intern_index, so it needs no mutex where the table is read
+ * lock free.
+ *
+ * \return \c -1 when the string is not in the table, the number of the
+ * string otherwise.
+ */
+static long
+dxf_intern_probe
+(
+        DxfIntern *intern,
+                /*!< the table. */
+        const char *string,
+                /*!< the string. */
+        size_t length,
+                /*!< number of characters of \c string. */
+        size_t hash
+                /*!< hash of the string. */
+)
+{
+        size_t *slots;
+        size_t slot;
+        size_t size;
+        size_t i;
+        char *value;
+
+        slots = DXF_INTERN_LOAD (intern->slots);
+        size = slots[0];
+        i = hash & (size - 1);
+        while ((slot = DXF_INTERN_LOAD (slots[i + 1])) != 0)
+        {
+                /* Loaded after the slot, so it holds the name. */
+                value = DXF_INTERN_LOAD (intern->names)[slot - 1];
+                if ((strncmp (value, string, length) == 0)
+                        && (value[length] == '\0'))
+                        return ((long) slot - 1);
+                i = (i + 1) & (size - 1);
+        }
+        return (-1);
+}
+
+
+/*!
+ * \brief Looks up \c length characters of a string in a table, without
+ * adding it.
+ *
+ * A table may be used by several threads at the same time, a lookup does
+ * not take the mutex of the table (with GCC compatible compilers).
+ *
+ * \return \c -1 when the string is not in the table, the number of the
+ * string (see \c dxf_intern_index) otherwise.
+ */
+long
+dxf_intern_find
+(
+        DxfIntern *intern,
+                /*!< the table. */
+        const char *string,
+                /*!< the string. */
+        size_t length
+                /*!< number of characters of \c string. */
+)
+{
+        long index;
+
+#if HAVE_PTHREAD_H && !DXF_INTERN_LOCK_FREE
+        pthread_mutex_lock (intern->lock);
+#endif
+        index = dxf_intern_probe (intern, string, length, dxf_intern_hash (string, length));
+#if HAVE_PTHREAD_H && !DXF_INTERN_LOCK_FREE
+        pthread_mutex_unlock (intern->lock);
+#endif
+        return (index);
+}
+
+
+/*!
+ * \brief Looks up \c length characters of a string in a table, the
+ * string is added when it is not found.
+ *
+ * Strings are numbered from 0 in the order they are added, the number of
+ * a string never changes (see \c dxf_intern_name).\n
+ * A table may be used by several threads at the same time. Only adding a
+ * string takes the mutex of the table, a string found is looked up
+ * without it (with GCC compatible compilers), so threads reading the
+ * same names do not wait for each other.
+ *
+ * \return \c -1 when no memory was allocated, the number of the string
+ * when succesful.
+ */
+long
+dxf_intern_index
+(
+        DxfIntern *intern,
+                /*!< the table. */
+        const char *string,
+                /*!< the string. */
+        size_t length
+                /*!< number of characters of \c string. */
+)
+{
+        char *value;
+        long index;
+        size_t hash;
+        size_t i;
+
+        hash = dxf_intern_hash (string, length);
+#if DXF_INTERN_LOCK_FREE
+        index = dxf_intern_probe (intern, string, length, hash);
+        if (index >= 0)
+                return (index);
+#endif
+#if HAVE_PTHREAD_H
+        pthread_mutex_lock (intern->lock);
+#endif
+        /* Another thread may have added the string meanwhile. */
+        index = dxf_intern_probe (intern, string, length, hash);
+        /* Keep at least half of the slots free. */
+        if ((index < 0)
+                && ((2 * (intern->count + 1) <= intern->size)
+                        || (dxf_intern_allocate (intern, 2 * intern->size) == EXIT_SUCCESS)))
+        {
+                value = dxf_arena_strndup (intern->strings, string, length);
+                if (value)
+                {
+                        i = hash & (intern->size - 1);
+                        while (intern->slots[i + 1])
+                                i = (i + 1) & (intern->size - 1);
+                        /* The name before its number and its slot. */
+                        intern->names[intern->count] = value;
+                        index = (long) intern->count;
+                        DXF_INTERN_STORE (intern->count, intern->count + 1);
+                        DXF_INTERN_STORE (intern->slots[i + 1], (size_t) index + 1);
+                }
+        }
+#if HAVE_PTHREAD_H
+        pthread_mutex_unlock (intern->lock);
+#endif
+        return (index);
+}
+
+
+/*!
+ * \brief Looks up \c length characters of a string in a table, the
+ * string is added when it is not found.
+ *
+ * The same string always gives the same pointer, so interned strings are
+ * compared by comparing their pointers. The strings are freed with the
+ * table and must not be changed or freed.\n
+ * A table may be used by several threads at the same time.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * interned string, terminated with a '\\0', when succesful.
+ */
+char *
+dxf_intern_string
+(
+        DxfIntern *intern,
+                /*!< the table. */
+        const char *string,
+                /*!< the string. */
+        size_t length
+                /*!< number of characters of \c string. */
+)
+{
+        long index;
+
+        index = dxf_intern_index (intern, string, length);
+        if (index < 0)
+                return (NULL);
+        return (dxf_intern_name (intern, (size_t) index));
+}
+
+
+/*!
+ * \brief Gives the string with number \c index of a table (see
+ * \c dxf_intern_index).
+ *
+ * \return \c NULL when the table has no string with number \c index, a
+ * pointer to the interned string otherwise.
+ */
+char *
+dxf_intern_name
+(
+        DxfIntern *intern,
+                /*!< the table. */
+        size_t index
+                /*!< number of the string. */
+)
+{
+        char *value = NULL;
+
+#if HAVE_PTHREAD_H && !DXF_INTERN_LOCK_FREE
+        pthread_mutex_lock (intern->lock);
+#endif
+        /* The names loaded after the count hold all counted names. */
+        if (index < DXF_INTERN_LOAD (intern->count))
+                value = DXF_INTERN_LOAD (intern->names)[index];
+#if HAVE_PTHREAD_H && !DXF_INTERN_LOCK_FREE
+        pthread_mutex_unlock (intern->lock);
+#endif
+        return (value);
+}
+
+
+#if HAVE_PTHREAD_H
+/*!
+ * \brief Guards the creation and release of \c dxf_intern_shared_names.
+ */
+static pthread_mutex_t dxf_intern_shared_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+
+/*!
+ * \brief Table of the names shared by the entities without an arena.
+ */
+static DxfIntern *dxf_intern_shared_names = NULL;
+
+
+/*!
+ * \brief Gives the table of names shared by all entities which are not
+ * allocated from an arena.
+ *
+ * The table is created by the first call and lives until
+ * \c dxf_intern_shared_free, like the pools of the entities (see
+ * \c dxf_pool_alloc) it is not bound to a document, so the numbers of
+ * its names are the same for all those entities.\n
+ * Documents read into an arena have a table of their own, freed with the
+ * arena (see \c dxf_arena_names).
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the table
+ * when succesful.
+ */
+DxfIntern *
+dxf_intern_shared ()
+{
+        DxfIntern *names;
+
+#if DXF_INTERN_LOCK_FREE
+        names = DXF_INTERN_LOAD (dxf_intern_shared_names);
+        if (names)
+                return (names);
+#endif
+#if HAVE_PTHREAD_H
+        pthread_mutex_lock (&dxf_intern_shared_lock);
+#endif
+        names = dxf_intern_shared_names;
+        if (!names)
+        {
+                names = dxf_intern_new ();
+                DXF_INTERN_STORE (dxf_intern_shared_names, names);
+        }
+#if HAVE_PTHREAD_H
+        pthread_mutex_unlock (&dxf_intern_shared_lock);
+#endif
+        return (names);
+}
+
+
+/*!
+ * \brief Frees the table of names shared by the entities without an
+ * arena, the next call to \c dxf_intern_shared creates a new one.
+ *
+ * The names of all entities which were read or initialized without an
+ * arena point into this table, as do the frozen layers of viewports
+ * without an arena: call this between documents when none of those
+ * entities is in use anymore, and no other thread reads or initializes
+ * one, so a long running program does not keep the names of every
+ * document it read.
+ */
+void
+dxf_intern_shared_free ()
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_intern_shared_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfIntern *names;
+
+#if HAVE_PTHREAD_H
+        pthread_mutex_lock (&dxf_intern_shared_lock);
+#endif
+        names = dxf_intern_shared_names;
+        DXF_INTERN_STORE (dxf_intern_shared_names, NULL);
+#if HAVE_PTHREAD_H
+        pthread_mutex_unlock (&dxf_intern_shared_lock);
+#endif
+        dxf_intern_free (names);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_intern_shared_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
+/*!
+ * \brief Frees a table with all its strings.
+ */
+void
+dxf_intern_free
+(
+        DxfIntern *intern
+                /*!< the table. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_intern_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        if (intern != NULL)
+        {
+#if HAVE_PTHREAD_H
+                if (intern->lock)
+                        pthread_mutex_destroy (intern->lock);
+#endif
+                free (intern->lock);
+                dxf_arena_free (intern->strings);
+                free (intern);
+        }
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_intern_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
+/* EOF */
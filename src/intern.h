@@ -0,0 +1,83 @@
+/*!
+ * \file intern.h
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Definition of a table of interned strings.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifndef INTERN_H
+#define INTERN_H
+
+
+#include "global.h"
+
+
+DxfIntern *
+dxf_intern_new ();
+long
+dxf_intern_find
+(
+        DxfIntern *intern,
+        const char *string,
+        size_t length
+);
+long
+dxf_intern_index
+(
+        DxfIntern *intern,
+        const char *string,
+        size_t length
+);
+char *
+dxf_intern_string
+(
+        DxfIntern *intern,
+        const char *string,
+        size_t length
+);
+char *
+dxf_intern_name
+(
+        DxfIntern *intern,
+        size_t index
+);
+DxfIntern *
+dxf_intern_shared ();
+void
+dxf_intern_shared_free ();
+void
+dxf_intern_free
+(
+        DxfIntern *intern
+);
+
+
+#endif /* INTERN_H */
+
+
+/* EOF */
@@ -31,12 +31,25 @@
 
 
 #include "line.h"
+#include "arena.h"
+#include "pool.h"
+#include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_line_new are handed out by.
+ */
+static DxfPool dxf_line_pool = DXF_POOL_INITIALIZER (sizeof (DxfLine));
 
 
 /*!
  * \brief Allocate memory for a \c DxfLine.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_line_free.
  * 
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
@@ -49,31 +62,91 @@ dxf_line_new ()
                 __FILE__, __LINE__);
 #endif
         DxfLine *dxf_line = NULL;
-        size_t size;
 
-        size = sizeof (DxfLine);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_line = malloc (size)) == NULL)
+        if ((dxf_line = dxf_pool_alloc (&dxf_line_pool)) == NULL)
         {
                 fprintf (stderr, "ERROR in dxf_line_new () could not allocate memory for a DxfLine struct.\n");
-                dxf_line = NULL;
         }
-        else
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_line_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_line);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfLine from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_line_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfLine *
+dxf_line_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_line_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfLine *dxf_line = NULL;
+
+        if (arena == NULL)
+        {
+                dxf_line = dxf_line_new ();
+        }
+        else if ((dxf_line = dxf_arena_alloc (arena, sizeof (DxfLine))) == NULL)
         {
-                memset (dxf_line, 0, size);
+                fprintf (stderr, "ERROR in dxf_line_new_arena () could not allocate memory for a DxfLine struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_line_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_line_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_line);
 }
 
 
+/*!
+ * \brief Release a \c DxfLine allocated by \c dxf_line_new to its pool.
+ *
+ * The struct has no strings of its own, the layer and linetype are
+ * interned (see \c dxf_arena_intern).\n
+ * Not for a \c DxfLine allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_line_free
+(
+        DxfLine *dxf_line
+                /*!< DXF line entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_line_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        dxf_pool_release (&dxf_line_pool, dxf_line);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_line_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in an \c LINE entity.
  * 
+ * The layer and linetype are interned in the names shared by the
+ * entities without an arena (see \c dxf_intern_shared), they stay
+ * valid until \c dxf_intern_shared_free.
+ *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
  */
@@ -88,15 +161,45 @@ dxf_line_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_line_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        dxf_line = dxf_line_new ();
+        dxf_line = dxf_line_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_line_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_line);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in an \c LINE entity.
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_line_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfLine *
+dxf_line_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_line_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfLine *dxf_line = NULL;
+        dxf_line = dxf_line_new_arena (arena);
         if (dxf_line == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_line_init () could not allocate memory for a DxfLine struct.\n");
+              fprintf (stderr, "ERROR in dxf_line_init_arena () could not allocate memory for a DxfLine struct.\n");
               return (NULL);
         }
         dxf_line->common.id_code = 0;
-        dxf_line->common.linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dxf_line->common.layer = strdup (DXF_DEFAULT_LAYER);
+        dxf_line->common.linetype = dxf_arena_intern (arena, DXF_DEFAULT_LINETYPE);
+        dxf_line->common.layer = dxf_arena_intern (arena, DXF_DEFAULT_LAYER);
         dxf_line->x0 = 0.0;
         dxf_line->y0 = 0.0;
         dxf_line->z0 = 0.0;
@@ -111,13 +214,32 @@ dxf_line_init
         dxf_line->common.paperspace = DXF_MODELSPACE;
         dxf_line->common.acad_version_number = 0;
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_line_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_line_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_line);
 }
 
 
+/*!
+ * \brief Schema of the \c LINE entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_line_schema[DXF_SCHEMA_SIZE] =
+{
+        DXF_SCHEMA_ENTITY_COMMON (DxfLine),
+        [10] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLine, x0),
+        [11] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLine, x1),
+        [20] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLine, y0),
+        [21] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLine, y1),
+        [30] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLine, z0),
+        [31] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLine, z1),
+        [38] = DXF_SCHEMA_FIELD (DXF_FIELD_ELEVATION, DxfLine, z0),
+        [210] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLine, extr_x0),
+        [220] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLine, extr_y0),
+        [230] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLine, extr_z0)
+};
+
+
 /*!
  * \brief Read data from a DXF file into an \c LINE entity.
  *
@@ -125,7 +247,8 @@ dxf_line_init
  * Now follows some data for the \c LINE, to be terminated with a
  * "  0" string announcing the following entity, or the end of the
  * \c ENTITY section marker \c ENDSEC. \n
- * While parsing the DXF file store data in \c dxf_line.
+ * While parsing the DXF file store data in \c dxf_line, the group
+ * codes are decoded through \c dxf_line_schema.
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -133,12 +256,8 @@ dxf_line_init
 int
 dxf_line_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         DxfLine *dxf_line,
                 /*!< DXF ellipse entity. */
         int acad_version_number
@@ -149,172 +268,19 @@ dxf_line_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_line_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
         if (!dxf_line)
         {
                 dxf_line = dxf_line_new ();
         }
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_line_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (EXIT_FAILURE);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (*line_number)++;
-                        fscanf (fp, "%x\n", &dxf_line->common.id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_line->common.linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_line->common.layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_line->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_line->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_line->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_line->x1);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_line->y1);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_line->z1);
-                }
-                else if ((acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (dxf_line->z0 = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_line->z0);
-                        /*! \todo Consider to add 
-                         * dxf_line->z1 = dxf_line.z0;
-                         * for the elevation could affect both
-                         * Z-coordinates. */
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_line->common.thickness);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_line->common.color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_line->common.paperspace);
-                }
-                else if ((acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_line->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_line->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_line->extr_z0);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning: in dxf_line_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_line_schema, dxf_line, NULL,
+                "LINE", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_line_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -327,8 +293,8 @@ dxf_line_read
 int
 dxf_line_write_lowlevel
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< group code = 5. */
         char *linetype,
@@ -386,33 +352,33 @@ dxf_line_write_lowlevel
                         dxf_entity_name);
                 layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
-        fprintf (fp, " 11\n%f\n", x1);
-        fprintf (fp, " 21\n%f\n", y1);
-        fprintf (fp, " 31\n%f\n", z1);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
+        dxf_write_group_double (fp, 11, x1);
+        dxf_write_group_double (fp, 21, y1);
+        dxf_write_group_double (fp, 31, z1);
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
         if (paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_line_write_lowlevel () function.\n",
@@ -431,8 +397,8 @@ dxf_line_write_lowlevel
 int
 dxf_line_write
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfLine dxf_line
                 /*!< DXF line entity. */
 )
@@ -460,33 +426,33 @@ dxf_line_write
                         dxf_entity_name);
                 dxf_line.common.layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (dxf_line.common.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_line.common.id_code);
+                dxf_write_group_hex (fp, 5, dxf_line.common.id_code);
         }
         if (strcmp (dxf_line.common.linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", dxf_line.common.linetype);
+                dxf_write_group_string (fp, 6, dxf_line.common.linetype);
         }
-        fprintf (fp, "  8\n%s\n", dxf_line.common.layer);
-        fprintf (fp, " 10\n%f\n", dxf_line.x0);
-        fprintf (fp, " 20\n%f\n", dxf_line.y0);
-        fprintf (fp, " 30\n%f\n", dxf_line.z0);
-        fprintf (fp, " 11\n%f\n", dxf_line.x1);
-        fprintf (fp, " 21\n%f\n", dxf_line.y1);
-        fprintf (fp, " 31\n%f\n", dxf_line.z1);
+        dxf_write_group_string (fp, 8, dxf_line.common.layer);
+        dxf_write_group_double (fp, 10, dxf_line.x0);
+        dxf_write_group_double (fp, 20, dxf_line.y0);
+        dxf_write_group_double (fp, 30, dxf_line.z0);
+        dxf_write_group_double (fp, 11, dxf_line.x1);
+        dxf_write_group_double (fp, 21, dxf_line.y1);
+        dxf_write_group_double (fp, 31, dxf_line.z1);
         if (dxf_line.common.thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", dxf_line.common.thickness);
+                dxf_write_group_double (fp, 39, dxf_line.common.thickness);
         }
         if (dxf_line.common.color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", dxf_line.common.color);
+                dxf_write_group_int (fp, 62, dxf_line.common.color);
         }
         if (dxf_line.common.paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_line_write () function.\n",
@@ -496,4 +462,98 @@ dxf_line_write
 }
 
 
+/*!
+ * \brief Write DXF output to fp for a batch of line entities, given as
+ * arrays of coordinates.
+ *
+ * All lines are written with the same layer and color, with the
+ * default linetype and no thickness.\n
+ * \c z0 and \c z1 can be \c NULL for lines in the XY-plane.\n
+ * When \c handle is not \c NULL the lines get the handles \c *handle,
+ * \c *handle + 1, ..., and \c *handle is set to the next free handle.\n
+ * Lines of which the start point and end point are identical are
+ * skipped, as by \c dxf_line_write.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when a line was
+ * skipped or an error occured.
+ */
+int
+dxf_line_write_batch
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        size_t count,
+                /*!< number of lines. */
+        const double *x0,
+                /*!< X-values of the start points. */
+        const double *y0,
+                /*!< Y-values of the start points. */
+        const double *z0,
+                /*!< Z-values of the start points, or \c NULL. */
+        const double *x1,
+                /*!< X-values of the end points. */
+        const double *y1,
+                /*!< Y-values of the end points. */
+        const double *z1,
+                /*!< Z-values of the end points, or \c NULL. */
+        const char *layer,
+                /*!< layer of all entities. */
+        int color,
+                /*!< color of all entities. */
+        int *handle
+                /*!< next free handle, or \c NULL to write the entities
+                 * without a handle. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_line_write_batch () function.\n",
+                __FILE__, __LINE__);
+#endif
+        int ret = EXIT_SUCCESS;
+        size_t i;
+        double za;
+        double zb;
+
+        if (!layer || (strcmp (layer, "") == 0))
+        {
+                fprintf (stderr, "Warning in dxf_line_write_batch () empty layer string for the LINE entities.\n");
+                fprintf (stderr, "    LINE entities are relocated to layer 0\n");
+                layer = DXF_DEFAULT_LAYER;
+        }
+        for (i = 0; i < count; i++)
+        {
+                za = z0 ? z0[i] : 0.0;
+                zb = z1 ? z1[i] : 0.0;
+                if ((x0[i] == x1[i]) && (y0[i] == y1[i]) && (za == zb))
+                {
+                        fprintf (stderr, "Error in dxf_line_write_batch () start point and end point are identical for LINE entity %lu, skipping it.\n",
+                                (unsigned long) i);
+                        ret = EXIT_FAILURE;
+                        continue;
+                }
+                dxf_write_group_string (fp, 0, "LINE");
+                if (handle)
+                {
+                        dxf_write_group_hex (fp, 5, (*handle)++);
+                }
+                dxf_write_group_string (fp, 8, layer);
+                dxf_write_group_double (fp, 10, x0[i]);
+                dxf_write_group_double (fp, 20, y0[i]);
+                dxf_write_group_double (fp, 30, za);
+                dxf_write_group_double (fp, 11, x1[i]);
+                dxf_write_group_double (fp, 21, y1[i]);
+                dxf_write_group_double (fp, 31, zb);
+                if (color != DXF_COLOR_BYLAYER)
+                {
+                        dxf_write_group_int (fp, 62, color);
+                }
+        }
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_line_write_batch () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (fp->failed ? EXIT_FAILURE : ret);
+}
+
+
 /* EOF */
@@ -78,23 +78,36 @@ dxf_line
 DxfLine *
 dxf_line_new ();
 DxfLine *
+dxf_line_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_line_free
+(
+        DxfLine *dxf_line
+);
+DxfLine *
 dxf_line_init
 (
         DxfLine *dxf_line
 );
+DxfLine *
+dxf_line_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_line_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfLine *dxf_line,
         int acad_version_number
 );
 int
 dxf_line_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *linetype,
         char *layer,
@@ -111,9 +124,24 @@ dxf_line_write_lowlevel
 int
 dxf_line_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfLine dxf_line
 );
+int
+dxf_line_write_batch
+(
+        DxfWriter *fp,
+        size_t count,
+        const double *x0,
+        const double *y0,
+        const double *z0,
+        const double *x1,
+        const double *y1,
+        const double *z1,
+        const char *layer,
+        int color,
+        int *handle
+);
 
 
 /* EOF */
@@ -33,12 +33,25 @@
 
 
 #include "lwpolyline.h"
+#include "arena.h"
+#include "pool.h"
+#include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_lwpolyline_new are handed out by.
+ */
+static DxfPool dxf_lwpolyline_pool = DXF_POOL_INITIALIZER (sizeof (DxfLWPolyline));
 
 
 /*!
  * \brief Allocate memory for a \c DxfLWPolyline.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_lwpolyline_free.
  */
 DxfLWPolyline *
 dxf_lwpolyline_new ()
@@ -48,31 +61,91 @@ dxf_lwpolyline_new ()
                 __FILE__, __LINE__);
 #endif
         DxfLWPolyline *dxf_lwpolyline = NULL;
-        size_t size;
 
-        size = sizeof (DxfLWPolyline);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_lwpolyline = malloc (size)) == NULL)
+        if ((dxf_lwpolyline = dxf_pool_alloc (&dxf_lwpolyline_pool)) == NULL)
         {
-                fprintf (stderr, "ERROR in dxf_lwpolyline_new () could not allocate memory for a DxfArc struct.\n");
-                dxf_lwpolyline = NULL;
+                fprintf (stderr, "ERROR in dxf_lwpolyline_new () could not allocate memory for a DxfLWPolyline struct.\n");
         }
-        else
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_lwpolyline_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_lwpolyline);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfLWPolyline from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_lwpolyline_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfLWPolyline *
+dxf_lwpolyline_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_lwpolyline_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfLWPolyline *dxf_lwpolyline = NULL;
+
+        if (arena == NULL)
         {
-                memset (dxf_lwpolyline, 0, size);
+                dxf_lwpolyline = dxf_lwpolyline_new ();
+        }
+        else if ((dxf_lwpolyline = dxf_arena_alloc (arena, sizeof (DxfLWPolyline))) == NULL)
+        {
+                fprintf (stderr, "ERROR in dxf_lwpolyline_new_arena () could not allocate memory for a DxfLWPolyline struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_lwpolyline_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_lwpolyline_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_lwpolyline);
 }
 
 
+/*!
+ * \brief Release a \c DxfLWPolyline allocated by \c dxf_lwpolyline_new to its pool.
+ *
+ * The struct has no strings of its own, the layer and linetype are
+ * interned (see \c dxf_arena_intern).\n
+ * Not for a \c DxfLWPolyline allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_lwpolyline_free
+(
+        DxfLWPolyline *dxf_lwpolyline
+                /*!< DXF lwpolyline entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_lwpolyline_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        dxf_pool_release (&dxf_lwpolyline_pool, dxf_lwpolyline);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_lwpolyline_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in a \c LWPOLYLINE entity.
  * 
+ * The layer and linetype are interned in the names shared by the
+ * entities without an arena (see \c dxf_intern_shared), they stay
+ * valid until \c dxf_intern_shared_free.
+ *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
  */
@@ -87,15 +160,45 @@ dxf_lwpolyline_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_lwpolyline_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        dxf_lwpolyline = dxf_lwpolyline_new ();
+        dxf_lwpolyline = dxf_lwpolyline_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_lwpolyline_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_lwpolyline);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in a \c LWPOLYLINE entity.
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_lwpolyline_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfLWPolyline *
+dxf_lwpolyline_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_lwpolyline_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfLWPolyline *dxf_lwpolyline = NULL;
+        dxf_lwpolyline = dxf_lwpolyline_new_arena (arena);
         if (dxf_lwpolyline == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_lwpolyline_init () could not allocate memory for a DxfLWPolyline struct.\n");
+              fprintf (stderr, "ERROR in dxf_lwpolyline_init_arena () could not allocate memory for a DxfLWPolyline struct.\n");
               return (NULL);
         }
         dxf_lwpolyline->common.id_code = 0;
-        dxf_lwpolyline->common.linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dxf_lwpolyline->common.layer = strdup (DXF_DEFAULT_LAYER);
+        dxf_lwpolyline->common.linetype = dxf_arena_intern (arena, DXF_DEFAULT_LINETYPE);
+        dxf_lwpolyline->common.layer = dxf_arena_intern (arena, DXF_DEFAULT_LAYER);
         dxf_lwpolyline->x0 = 0.0;
         dxf_lwpolyline->y0 = 0.0;
         dxf_lwpolyline->common.thickness = 0.0;
@@ -111,13 +214,32 @@ dxf_lwpolyline_init
         dxf_lwpolyline->extr_z0 = 0.0;
         dxf_lwpolyline->common.acad_version_number = 0;
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_lwpolyline_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_lwpolyline_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_lwpolyline);
 }
 
 
+/*!
+ * \brief Schema of the \c LWPOLYLINE entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_lwpolyline_schema[DXF_SCHEMA_SIZE] =
+{
+        DXF_SCHEMA_ENTITY_COMMON (DxfLWPolyline),
+        [10] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLWPolyline, x0),
+        [20] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLWPolyline, y0),
+        [40] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLWPolyline, start_width),
+        [41] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLWPolyline, end_width),
+        [43] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLWPolyline, constant_width),
+        [70] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfLWPolyline, flag),
+        [90] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfLWPolyline, number_vertices),
+        [210] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLWPolyline, extr_x0),
+        [220] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLWPolyline, extr_y0),
+        [230] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfLWPolyline, extr_z0)
+};
+
+
 /*!
  * \brief Read data from a DXF file into an \c LWPOLYLINE entity.
  *
@@ -125,7 +247,8 @@ dxf_lwpolyline_init
  * Now follows some data for the \c LWPOLYLINE, to be terminated with a
  * "  0" string announcing the following entity, or the end of the
  * \c ENTITY section marker \c ENDSEC. \n
- * While parsing the DXF file store data in \c dxf_lwpolyline. \n
+ * While parsing the DXF file store data in \c dxf_lwpolyline, the group
+ * codes are decoded through \c dxf_lwpolyline_schema. \n
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -133,12 +256,8 @@ dxf_lwpolyline_init
 int
 dxf_lwpolyline_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         DxfLWPolyline *dxf_lwpolyline,
                 /*!< DXF light weight polyline entity. */
         int acad_version_number
@@ -149,163 +268,19 @@ dxf_lwpolyline_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_lwpolyline_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
         if (!dxf_lwpolyline)
         {
                 dxf_lwpolyline = dxf_lwpolyline_new ();
         }
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_lwpolyline_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (EXIT_FAILURE);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (*line_number)++;
-                        fscanf (fp, "%x\n", &dxf_lwpolyline->common.id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_lwpolyline->common.linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_lwpolyline->common.layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the primary point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_lwpolyline->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the primary point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_lwpolyline->y0);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_lwpolyline->common.thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * starting width. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_lwpolyline->start_width);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * end width. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_lwpolyline->end_width);
-                }
-                else if (strcmp (temp_string, "43") == 0)
-                {
-                        /* Now follows a string containing the
-                         * constant width. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_lwpolyline->constant_width);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_lwpolyline->common.color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_lwpolyline->common.paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * flag value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_lwpolyline->flag);
-                }
-                else if (strcmp (temp_string, "90") == 0)
-                {
-                        /* Now follows a string containing the number
-                         * of following vertices. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_lwpolyline->number_vertices);
-                }
-                else if ((acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_lwpolyline->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_lwpolyline->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_lwpolyline->extr_z0);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning: in dxf_lwpolyline_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_lwpolyline_schema, dxf_lwpolyline, NULL,
+                "LWPOLYLINE", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_lwpolyline_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -320,8 +295,8 @@ dxf_lwpolyline_read
 int
 dxf_lwpolyline_write_lowlevel
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< group code = 5. */
         char *linetype,
@@ -388,46 +363,46 @@ dxf_lwpolyline_write_lowlevel
                         dxf_entity_name);
                 layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
         if ((constant_width = 0.0) && (start_width != end_width))
         {
-                fprintf (fp, " 40\n%f\n", start_width);
-                fprintf (fp, " 41\n%f\n", end_width);
+                dxf_write_group_double (fp, 40, start_width);
+                dxf_write_group_double (fp, 41, end_width);
         }
         else
         {
-                fprintf (fp, " 43\n%f\n", constant_width);
+                dxf_write_group_double (fp, 43, constant_width);
         }
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
         if (paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp, " 70\n%d\n", flag);
-        fprintf (fp, " 90\n%d\n", number_vertices);
+        dxf_write_group_int (fp, 70, flag);
+        dxf_write_group_int (fp, 90, number_vertices);
         if (acad_version_number >= AutoCAD_12)
         {
-                fprintf (fp, "210\n%f\n", extr_x0);
-                fprintf (fp, "220\n%f\n", extr_y0);
-                fprintf (fp, "230\n%f\n", extr_z0);
+                dxf_write_group_double (fp, 210, extr_x0);
+                dxf_write_group_double (fp, 220, extr_y0);
+                dxf_write_group_double (fp, 230, extr_z0);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_lwpolyline_write_lowlevel () function.\n",
@@ -448,8 +423,8 @@ dxf_lwpolyline_write_lowlevel
 int
 dxf_lwpolyline_write
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfLWPolyline dxf_lwpolyline,
                 /*!< DXF polyline entity. */
         int acad_version_number
@@ -470,47 +445,47 @@ dxf_lwpolyline_write
                         dxf_entity_name);
                 dxf_lwpolyline.common.layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (dxf_lwpolyline.common.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_lwpolyline.common.id_code);
+                dxf_write_group_hex (fp, 5, dxf_lwpolyline.common.id_code);
         }
         if (strcmp (dxf_lwpolyline.common.linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", dxf_lwpolyline.common.linetype);
+                dxf_write_group_string (fp, 6, dxf_lwpolyline.common.linetype);
         }
-        fprintf (fp, "  8\n%s\n", dxf_lwpolyline.common.layer);
-        fprintf (fp, " 10\n%f\n", dxf_lwpolyline.x0);
-        fprintf (fp, " 20\n%f\n", dxf_lwpolyline.y0);
+        dxf_write_group_string (fp, 8, dxf_lwpolyline.common.layer);
+        dxf_write_group_double (fp, 10, dxf_lwpolyline.x0);
+        dxf_write_group_double (fp, 20, dxf_lwpolyline.y0);
         if (dxf_lwpolyline.common.thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", dxf_lwpolyline.common.thickness);
+                dxf_write_group_double (fp, 39, dxf_lwpolyline.common.thickness);
         }
         if ((dxf_lwpolyline.constant_width = 0.0)
                 && (dxf_lwpolyline.start_width != dxf_lwpolyline.end_width))
         {
-                fprintf (fp, " 40\n%f\n", dxf_lwpolyline.start_width);
-                fprintf (fp, " 41\n%f\n", dxf_lwpolyline.end_width);
+                dxf_write_group_double (fp, 40, dxf_lwpolyline.start_width);
+                dxf_write_group_double (fp, 41, dxf_lwpolyline.end_width);
         }
         else
         {
-                fprintf (fp, " 43\n%f\n", dxf_lwpolyline.constant_width);
+                dxf_write_group_double (fp, 43, dxf_lwpolyline.constant_width);
         }
         if (dxf_lwpolyline.common.color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", dxf_lwpolyline.common.color);
+                dxf_write_group_int (fp, 62, dxf_lwpolyline.common.color);
         }
         if (dxf_lwpolyline.common.paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp, " 70\n%d\n", dxf_lwpolyline.flag);
-        fprintf (fp, " 90\n%d\n", dxf_lwpolyline.number_vertices);
+        dxf_write_group_int (fp, 70, dxf_lwpolyline.flag);
+        dxf_write_group_int (fp, 90, dxf_lwpolyline.number_vertices);
         if (acad_version_number >= AutoCAD_12)
         {
-                fprintf (fp, "210\n%f\n", dxf_lwpolyline.extr_x0);
-                fprintf (fp, "220\n%f\n", dxf_lwpolyline.extr_y0);
-                fprintf (fp, "230\n%f\n", dxf_lwpolyline.extr_z0);
+                dxf_write_group_double (fp, 210, dxf_lwpolyline.extr_x0);
+                dxf_write_group_double (fp, 220, dxf_lwpolyline.extr_y0);
+                dxf_write_group_double (fp, 230, dxf_lwpolyline.extr_z0);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_lwpolyline_write () function.\n",
@@ -520,4 +495,86 @@ dxf_lwpolyline_write
 }
 
 
+/*!
+ * \brief Write DXF output to fp for a batch of light weight polyline
+ * entities, given as arrays of vertices.
+ *
+ * The vertices of polyline \c i are \c x[j] and \c y[j] for \c j from
+ * \c first[i] up to (not including) \c first[i + 1], so \c first has
+ * \c count + 1 entries.\n
+ * All polylines are written with the same layer, color and \c flag
+ * (1 for closed polylines).\n
+ * When \c handle is not \c NULL the polylines get the handles
+ * \c *handle, \c *handle + 1, ..., and \c *handle is set to the next
+ * free handle.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occured.
+ */
+int
+dxf_lwpolyline_write_batch
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        size_t count,
+                /*!< number of polylines. */
+        const size_t *first,
+                /*!< index of the first vertex of each polyline, and the
+                 * number of vertices. */
+        const double *x,
+                /*!< X-values of the vertices. */
+        const double *y,
+                /*!< Y-values of the vertices. */
+        int flag,
+                /*!< polyline flag of all polylines. */
+        const char *layer,
+                /*!< layer of all entities. */
+        int color,
+                /*!< color of all entities. */
+        int *handle
+                /*!< next free handle, or \c NULL to write the entities
+                 * without a handle. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_lwpolyline_write_batch () function.\n",
+                __FILE__, __LINE__);
+#endif
+        size_t i;
+        size_t j;
+
+        if (!layer || (strcmp (layer, "") == 0))
+        {
+                fprintf (stderr, "Warning in dxf_lwpolyline_write_batch () empty layer string for the LWPOLYLINE entities.\n");
+                fprintf (stderr, "    LWPOLYLINE entities are relocated to layer 0\n");
+                layer = DXF_DEFAULT_LAYER;
+        }
+        for (i = 0; i < count; i++)
+        {
+                dxf_write_group_string (fp, 0, "LWPOLYLINE");
+                if (handle)
+                {
+                        dxf_write_group_hex (fp, 5, (*handle)++);
+                }
+                dxf_write_group_string (fp, 8, layer);
+                if (color != DXF_COLOR_BYLAYER)
+                {
+                        dxf_write_group_int (fp, 62, color);
+                }
+                dxf_write_group_int (fp, 70, flag);
+                dxf_write_group_int (fp, 90, (int) (first[i + 1] - first[i]));
+                for (j = first[i]; j < first[i + 1]; j++)
+                {
+                        dxf_write_group_double (fp, 10, x[j]);
+                        dxf_write_group_double (fp, 20, y[j]);
+                }
+        }
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_lwpolyline_write_batch () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (fp->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
 /* EOF */
@@ -100,23 +100,36 @@ dxf_lwpolyline
 DxfLWPolyline *
 dxf_lwpolyline_new ();
 DxfLWPolyline *
+dxf_lwpolyline_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_lwpolyline_free
+(
+        DxfLWPolyline *dxf_lwpolyline
+);
+DxfLWPolyline *
 dxf_lwpolyline_init
 (
         DxfLWPolyline *dxf_lwpolyline
 );
+DxfLWPolyline *
+dxf_lwpolyline_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_lwpolyline_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfLWPolyline *dxf_lwpolyline,
         int acad_version_number
 );
 int
 dxf_lwpolyline_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *linetype,
         char *layer,
@@ -138,10 +151,23 @@ dxf_lwpolyline_write_lowlevel
 int
 dxf_lwpolyline_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfLWPolyline dxf_lwpolyline,
         int acad_version_number
 );
+int
+dxf_lwpolyline_write_batch
+(
+        DxfWriter *fp,
+        size_t count,
+        const size_t *first,
+        const double *x,
+        const double *y,
+        int flag,
+        const char *layer,
+        int color,
+        int *handle
+);
 
 
 #endif /* _LWPOLYLINE_H */
@@ -31,6 +31,9 @@
 
 
 #include "object.h"
+#include "arena.h"
+#include "reader.h"
+#include "util.h"
 
 
 /*!
@@ -56,4 +59,242 @@ dxf_write_objects
 }
 
 
+/*!
+ * \brief Stores a group of an object in \c value.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * was allocated.
+ */
+static int
+dxf_object_read_value
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        const DxfGroup *group,
+                /*!< the group. */
+        DxfValue *value
+                /*!< the value. */
+)
+{
+        value->code = (short) group->code;
+        switch (dxf_binary_type (group->code))
+        {
+                case DXF_BINARY_DOUBLE:
+                        value->type = DXF_VALUE_DOUBLE;
+                        value->value.D = dxf_group_get_double (group);
+                        break;
+                case DXF_BINARY_INT8:
+                case DXF_BINARY_INT16:
+                case DXF_BINARY_INT32:
+                        value->type = DXF_VALUE_INT;
+                        value->value.I = dxf_group_get_int (group);
+                        break;
+                default:
+                        value->type = DXF_VALUE_STRING;
+                        value->value.S = dxf_read_string (fp, group);
+                        if (!value->value.S)
+                                return (EXIT_FAILURE);
+                        break;
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Reads the objects of the \c OBJECTS section of a DXF file.
+ *
+ * The groups of an object are collected in a buffer which is reused for
+ * all objects, each object gets a copy with exactly its number of
+ * values.\n
+ * The type names are interned (see \c dxf_arena_intern).\n
+ * When \c arena is not \c NULL the objects, their values and strings are
+ * allocated from \c arena. They are freed by \c dxf_arena_free instead
+ * of \c dxf_objects_free.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_read_objects
+(
+        const char *filename,
+                /*!< filename of input file (or device). */
+        DxfArena *arena,
+                /*!< arena for the objects, or \c NULL. */
+        DxfObject **objects,
+                /*!< the objects, in file order. */
+        size_t *count
+                /*!< number of objects in \c objects. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_read_objects () function.\n", __FILE__, __LINE__);
+#endif
+        DxfReader *reader;
+        DxfReaderEvent event;
+        DxfObject *object = NULL;
+        DxfObject *grown;
+        DxfValue *values = NULL;
+        DxfValue *buffer;
+        size_t value_count = 0;
+        size_t value_size = 0;
+        size_t size = 0;
+        int in_objects = FALSE;
+        int ret = EXIT_SUCCESS;
+
+        *objects = NULL;
+        *count = 0;
+        reader = dxf_reader_open (filename);
+        if (!reader)
+                return (EXIT_FAILURE);
+        reader->fp->arena = arena;
+        while ((ret == EXIT_SUCCESS)
+                && (dxf_reader_next (reader, &event) > DXF_EVENT_EOF))
+        {
+                switch (event.type)
+                {
+                        case DXF_EVENT_SECTION_BEGIN:
+                                in_objects = (strcmp (event.name, "OBJECTS") == 0);
+                                break;
+                        case DXF_EVENT_SECTION_END:
+                                in_objects = FALSE;
+                                break;
+                        case DXF_EVENT_ENTITY_BEGIN:
+                                if (!in_objects)
+                                        break;
+                                if (*count == size)
+                                {
+                                        size = size ? 2 * size : 256;
+                                        grown = realloc (*objects, size * sizeof (DxfObject));
+                                        if (!grown)
+                                        {
+                                                fprintf (stderr, "Error in dxf_read_objects () could not allocate memory for the objects.\n");
+                                                ret = EXIT_FAILURE;
+                                                break;
+                                        }
+                                        *objects = grown;
+                                }
+                                object = &(*objects)[*count];
+                                object->name = dxf_arena_intern (arena, event.name);
+                                object->values = NULL;
+                                object->count = 0;
+                                value_count = 0;
+                                if (!object->name)
+                                        ret = EXIT_FAILURE;
+                                break;
+                        case DXF_EVENT_GROUP:
+                                if (!in_objects || !object)
+                                        break;
+                                if (value_count == value_size)
+                                {
+                                        value_size = value_size ? 2 * value_size : 64;
+                                        buffer = realloc (values, value_size * sizeof (DxfValue));
+                                        if (!buffer)
+                                        {
+                                                fprintf (stderr, "Error in dxf_read_objects () could not allocate memory for the values.\n");
+                                                ret = EXIT_FAILURE;
+                                                break;
+                                        }
+                                        values = buffer;
+                                }
+                                if (dxf_object_read_value (reader->fp, &event.group,
+                                        &values[value_count]) != EXIT_SUCCESS)
+                                {
+                                        ret = EXIT_FAILURE;
+                                        break;
+                                }
+                                value_count++;
+                                break;
+                        case DXF_EVENT_ENTITY_END:
+                                if (!in_objects || !object)
+                                        break;
+                                if (value_count > 0)
+                                {
+                                        object->values = arena
+                                                ? dxf_arena_alloc (arena, value_count * sizeof (DxfValue))
+                                                : malloc (value_count * sizeof (DxfValue));
+                                        if (!object->values)
+                                        {
+                                                fprintf (stderr, "Error in dxf_read_objects () could not allocate memory for the values.\n");
+                                                ret = EXIT_FAILURE;
+                                                break;
+                                        }
+                                        memcpy (object->values, values, value_count * sizeof (DxfValue));
+                                        object->count = value_count;
+                                }
+                                (*count)++;
+                                object = NULL;
+                                break;
+                        default:
+                                break;
+                }
+        }
+        if (event.type == DXF_EVENT_ERROR)
+                ret = EXIT_FAILURE;
+        if (object && (ret != EXIT_SUCCESS) && !arena)
+        {
+                /* Free the strings of the object which was not done. */
+                while (value_count > 0)
+                {
+                        value_count--;
+                        if (values[value_count].type == DXF_VALUE_STRING)
+                                free (values[value_count].value.S);
+                }
+        }
+        free (values);
+        if (arena && *objects)
+        {
+                /* Move the objects into the arena as well. */
+                grown = *objects;
+                *objects = dxf_arena_alloc (arena, *count * sizeof (DxfObject));
+                if (*objects)
+                        memcpy (*objects, grown, *count * sizeof (DxfObject));
+                else
+                {
+                        *count = 0;
+                        ret = EXIT_FAILURE;
+                }
+                free (grown);
+        }
+        dxf_reader_close (reader);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_read_objects () function.\n", __FILE__, __LINE__);
+#endif
+        return (ret);
+}
+
+
+/*!
+ * \brief Frees the objects read by \c dxf_read_objects without an arena.
+ *
+ * The type names are interned and are not freed (see
+ * \c dxf_arena_intern).
+ */
+void
+dxf_objects_free
+(
+        DxfObject *objects,
+                /*!< the objects. */
+        size_t count
+                /*!< number of objects in \c objects. */
+)
+{
+        size_t i;
+        size_t j;
+
+        if (!objects)
+                return;
+        for (i = 0; i < count; i++)
+        {
+                for (j = 0; j < objects[i].count; j++)
+                {
+                        if (objects[i].values[j].type == DXF_VALUE_STRING)
+                                free (objects[i].values[j].value.S);
+                }
+                free (objects[i].values);
+        }
+        free (objects);
+}
+
+
 /* EOF */
@@ -41,20 +41,41 @@
 
 /*!
  * \brief DXF definition of an object.
+ *
+ * The groups of an object are stored as a variable number of values, an
+ * object takes the memory of the groups it has.
  */
 typedef struct
 dxf_object
 {
-        DxfEntityType entity_type;
-                /*!< dxf entity type. */
-        DxfParam parameter[DXF_MAX_PARAM];
-                /*!< corresponding values stored in here. */
-} DxfObject;
+        char *name;
+                /*!< type name of the object, for example
+                 * \c DICTIONARY.\n
+                 * Group code = 0. */
+        DxfValue *values;
+                /*!< the groups of the object, in file order. */
+        size_t count;
+                /*!< number of groups in \c values. */
+} DxfObject, * DxfObjectPtr;
 
 
 
 
 int dxf_write_objects (char *dxf_objects_list, int acad_version_number);
+int
+dxf_read_objects
+(
+        const char *filename,
+        DxfArena *arena,
+        DxfObject **objects,
+        size_t *count
+);
+void
+dxf_objects_free
+(
+        DxfObject *objects,
+        size_t count
+);
 
 
 #endif /* __OBJECT_H_INCLUDED__ */
@@ -0,0 +1,852 @@
+/*!
+ * \file parallel.c
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Functions for parallel reading and writing of the ENTITIES
+ * section.
+ *
+ * The entities in the \c ENTITIES section are independent records, each
+ * starting with a "  0" group.\n
+ * When the file is memory mapped the section is split into chunks at
+ * the start of an entity, the chunks are read by a pool of threads and
+ * the entities are merged in file order.\n
+ * When writing, batches of entities are formatted by a pool of threads
+ * into a buffer per thread, the buffers are written in order.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "libdxf.h"
+#endif
+#if HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+#include <unistd.h>
+#include "parallel.h"
+#include "callback.h"
+#include "reader.h"
+#include "section.h"
+#include "arena.h"
+#include "util.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Number of entities formatted by one thread at a time in
+ * \c dxf_write_entities_parallel.
+ */
+#define DXF_PARALLEL_WRITE_BATCH 16384
+
+
+/*!
+ * \brief DXF definition of a chunk of the \c ENTITIES section, read by
+ * one thread.
+ */
+typedef struct
+dxf_parallel_chunk
+{
+        DxfFile *fp;
+                /*!< DXF file handle of the chunk, which includes the
+                 * "  0" group following the chunk, so the last entity
+                 * ends like any other entity. */
+        size_t limit;
+                /*!< offset in \c fp of the end of the chunk. */
+        int acad_version_number;
+                /*!< AutoCAD version number. */
+        DxfArena *arena;
+                /*!< arena the entities are allocated from, \c NULL for
+                 * \c malloc. */
+        DxfEntityRecord *records;
+                /*!< entities read from the chunk. */
+        size_t count;
+                /*!< number of entities in \c records. */
+        size_t size;
+                /*!< allocated number of entities in \c records. */
+        int ret;
+                /*!< \c EXIT_SUCCESS when the chunk was read. */
+        int threaded;
+                /*!< \c TRUE when the chunk is read by a worker thread. */
+} DxfParallelChunk, * DxfParallelChunkPtr;
+
+
+/*!
+ * \brief DXF definition of a batch of entities, formatted by one thread.
+ */
+typedef struct
+dxf_parallel_batch
+{
+        DxfWriter *fp;
+                /*!< DXF file handle the entities are formatted into, a
+                 * DxfWriter opened with \c dxf_write_init_memory. */
+        const DxfEntityRecord *records;
+                /*!< the entities. */
+        size_t count;
+                /*!< number of entities in \c records. */
+        int acad_version_number;
+                /*!< AutoCAD version number. */
+        int ret;
+                /*!< \c EXIT_SUCCESS when all entities were written. */
+        int threaded;
+                /*!< \c TRUE when the batch is formatted by a worker
+                 * thread. */
+} DxfParallelBatch, * DxfParallelBatchPtr;
+
+
+/*!
+ * \brief Tests if a line contains a group code.
+ */
+static int
+dxf_parallel_line_is_code
+(
+        const char *line,
+                /*!< first character of the line. */
+        size_t length
+                /*!< number of characters in the line. */
+)
+{
+        size_t i = 0;
+        size_t digits = 0;
+
+        while ((i < length) && ((line[i] == ' ') || (line[i] == '\t')))
+                i++;
+        if ((i < length) && (line[i] == '-'))
+                i++;
+        while ((i < length) && (line[i] >= '0') && (line[i] <= '9'))
+        {
+                i++;
+                digits++;
+        }
+        while ((i < length) && isspace ((unsigned char) line[i]))
+                i++;
+        return ((digits > 0) && (i == length));
+}
+
+
+/*!
+ * \brief Finds the start of the first entity at or after \c offset.
+ *
+ * A "  0" group code is recognized by the line "0" followed by a line
+ * which is not a number (the name of the entity) and a line with a group
+ * code. A value "0" is always followed by a group code, so it is never
+ * mistaken for the start of an entity.
+ *
+ * \return the offset of the "  0" line, or \c end when no entity starts
+ * in the range.
+ */
+static size_t
+dxf_parallel_split
+(
+        const char *buffer,
+                /*!< the buffer. */
+        size_t offset,
+                /*!< offset to start searching, the start of a line or
+                 * any position inside of a line. */
+        size_t start,
+                /*!< offset of the first line of the range. */
+        size_t end
+                /*!< offset after the last line of the range. */
+)
+{
+        const char *line[3];
+        size_t length[3];
+        const char *p;
+        size_t next;
+        int i;
+
+        /* Move to the start of the next line. */
+        if ((offset > start) && (buffer[offset - 1] != '\n'))
+        {
+                p = memchr (buffer + offset, '\n', end - offset);
+                if (!p)
+                        return (end);
+                offset = (size_t) (p - buffer) + 1;
+        }
+        while (offset < end)
+        {
+                next = offset;
+                for (i = 0; i < 3; i++)
+                {
+                        line[i] = buffer + next;
+                        p = memchr (line[i], '\n', end - next);
+                        if (!p)
+                                return (end);
+                        length[i] = (size_t) (p - line[i]);
+                        next = (size_t) (p - buffer) + 1;
+                }
+                if (dxf_line_is (line[0], length[0], "0")
+                        && !dxf_parallel_line_is_code (line[1], length[1])
+                        && dxf_parallel_line_is_code (line[2], length[2]))
+                        return (offset);
+                offset = (size_t) (line[1] - buffer);
+        }
+        return (end);
+}
+
+
+/*!
+ * \brief Skips the two lines of the group at \c offset.
+ *
+ * \return the offset after the group, or \c end.
+ */
+static size_t
+dxf_parallel_skip_group
+(
+        const char *buffer,
+                /*!< the buffer. */
+        size_t offset,
+                /*!< offset of the group code line. */
+        size_t end
+                /*!< offset after the last line of the buffer. */
+)
+{
+        const char *p;
+        int i;
+
+        for (i = 0; i < 2; i++)
+        {
+                p = memchr (buffer + offset, '\n', end - offset);
+                if (!p)
+                        return (end);
+                offset = (size_t) (p - buffer) + 1;
+        }
+        return (offset);
+}
+
+
+/*!
+ * \brief Reads the entities of a chunk until the end of the chunk or the
+ * \c ENDSEC marker.
+ *
+ * Entities of types without a reader are skipped.
+ *
+ * \return \c NULL, for \c pthread_create.
+ */
+static void *
+dxf_parallel_read_chunk
+(
+        void *data
+                /*!< the \c DxfParallelChunk. */
+)
+{
+        DxfParallelChunk *chunk = data;
+        DxfFile *fp = chunk->fp;
+        const DxfCallbackType *callback_type;
+        DxfEntityRecord *records;
+        DxfGroup group;
+        size_t size;
+        void *entity;
+
+        chunk->ret = EXIT_SUCCESS;
+        fp->arena = chunk->arena;
+        while ((fp->buffer_position < chunk->limit) && dxf_read_group (fp, &group))
+        {
+                if (group.code != 0)
+                {
+                        fprintf (stderr, "Error in dxf_read_entities_parallel () \"  0\" expected while reading from: %s in line: %d.\n",
+                                fp->filename, fp->line_number);
+                        chunk->ret = EXIT_FAILURE;
+                        break;
+                }
+                if (dxf_group_is (&group, 0, "ENDSEC"))
+                {
+                        dxf_read_unread_group (fp);
+                        break;
+                }
+                callback_type = dxf_callback_type_by_name (&group);
+                if (!callback_type)
+                {
+                        /* Skip the groups of the entity. */
+                        while (dxf_read_group (fp, &group) && (group.code != 0))
+                                ;
+                        if (group.code == 0)
+                                dxf_read_unread_group (fp);
+                        continue;
+                }
+                if (chunk->count == chunk->size)
+                {
+                        chunk->size = chunk->size ? 2 * chunk->size : 1024;
+                        records = realloc (chunk->records,
+                                chunk->size * sizeof (DxfEntityRecord));
+                        if (!records)
+                        {
+                                fprintf (stderr, "Error in dxf_read_entities_parallel () could not allocate memory for the entities.\n");
+                                chunk->ret = EXIT_FAILURE;
+                                break;
+                        }
+                        chunk->records = records;
+                }
+                entity = callback_type->init (chunk->arena, &size);
+                if (!entity)
+                {
+                        chunk->ret = EXIT_FAILURE;
+                        break;
+                }
+                chunk->records[chunk->count].type = callback_type->type;
+                chunk->records[chunk->count].line_number = fp->line_number - 1;
+                chunk->records[chunk->count].entity = entity;
+                chunk->records[chunk->count].handle = 0;
+                chunk->count++;
+                if (callback_type->read (fp, entity, chunk->acad_version_number) != EXIT_SUCCESS)
+                {
+                        chunk->ret = EXIT_FAILURE;
+                        break;
+                }
+                chunk->records[chunk->count - 1].handle = fp->handle;
+        }
+        return (NULL);
+}
+
+
+/*!
+ * \brief Reads all entities of the \c ENTITIES section of a DXF file,
+ * with \c threads threads.
+ *
+ * The section is split into \c threads chunks at the start of an entity,
+ * the line numbers of each chunk are corrected with the number of lines
+ * in the preceding chunks.\n
+ * When the file can not be memory mapped, is a binary DXF file, or the
+ * library was built without threads, the section is read by the calling
+ * thread.\n
+ * Entities of types without a reader (see \c dxf_callback_type_by_name)
+ * are skipped.\n
+ * When \c arena is not \c NULL the entities, their strings and
+ * \c records are allocated from \c arena, each thread fills an arena of
+ * its own which is added to \c arena afterwards. All of them are freed
+ * at once by \c dxf_arena_free, instead of \c dxf_entity_records_free.\n
+ * The names of layers, linetypes, text styles and blocks are interned in
+ * \c arena by all threads, so entities on the same layer have the same
+ * pointer as layer name (see \c dxf_arena_intern).\n
+ * When \c headers is not \c NULL the common properties of the entities
+ * are added to it in file order, with their 64 bit handles; \c APPID
+ * entities have none and are not added.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_read_entities_arena
+(
+        const char *filename,
+                /*!< filename of input file (or device). */
+        int threads,
+                /*!< number of threads, 0 for the number of processors. */
+        DxfArena *arena,
+                /*!< arena for the entities, or \c NULL. */
+        DxfEntityRecord **records,
+                /*!< the entities, in file order. */
+        size_t *count,
+                /*!< number of entities in \c records. */
+        DxfEntityHeaders *headers
+                /*!< table for the common properties of the entities, or
+                 * \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_read_entities_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfReader *reader;
+        DxfReaderEvent event;
+        DxfFile *fp;
+        DxfParallelChunk *chunks;
+        DxfEntityRecord *entities;
+        const DxfSectionRange *section;
+        size_t start, end, split, offset, total;
+        int line_number;
+        int ret = EXIT_SUCCESS;
+        int i;
+        size_t j;
+#if HAVE_PTHREAD_H
+        pthread_t *workers;
+#endif
+
+        *records = NULL;
+        *count = 0;
+        reader = dxf_reader_open (filename);
+        if (!reader)
+                return (EXIT_FAILURE);
+        fp = reader->fp;
+        /* Skip to the start of the ENTITIES section. */
+        while (dxf_reader_next (reader, &event) > DXF_EVENT_EOF)
+        {
+                if ((event.type == DXF_EVENT_SECTION_BEGIN)
+                        && (strcmp (event.name, "ENTITIES") == 0))
+                        break;
+        }
+        if (event.type != DXF_EVENT_SECTION_BEGIN)
+        {
+                dxf_reader_close (reader);
+                return ((event.type == DXF_EVENT_EOF) ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+        if (threads <= 0)
+                threads = (int) sysconf (_SC_NPROCESSORS_ONLN);
+        if (!fp->mapped || fp->binary || (threads <= 0))
+                threads = 1;
+        chunks = malloc ((size_t) threads * sizeof (DxfParallelChunk));
+        if (!chunks)
+        {
+                fprintf (stderr, "Error in dxf_read_entities_arena () could not allocate memory for the chunks.\n");
+                dxf_reader_close (reader);
+                return (EXIT_FAILURE);
+        }
+        memset (chunks, 0, (size_t) threads * sizeof (DxfParallelChunk));
+        if (threads == 1)
+        {
+                /* Read the section from the file itself. */
+                chunks[0].fp = fp;
+                chunks[0].arena = arena;
+                chunks[0].limit = (size_t) -1;
+                chunks[0].acad_version_number = reader->acad_version_number;
+                dxf_parallel_read_chunk (&chunks[0]);
+                ret = chunks[0].ret;
+        }
+        else
+        {
+                start = fp->buffer_position;
+                end = fp->buffer_length;
+                if (dxf_section_index (fp) == EXIT_SUCCESS)
+                {
+                        section = dxf_section_find (fp, "ENTITIES");
+                        if (section)
+                                end = section->end;
+                }
+                split = start;
+                for (i = 0; i < threads; i++)
+                {
+                        offset = start + (end - start) / threads * (i + 1);
+                        if (offset < split)
+                                offset = split;
+                        offset = (i == threads - 1) ? end
+                                : dxf_parallel_split (fp->buffer, offset, split, end);
+                        chunks[i].acad_version_number = reader->acad_version_number;
+                        chunks[i].limit = offset - split;
+                        chunks[i].arena = arena ? dxf_arena_new (arena->chunk_size) : NULL;
+                        if (chunks[i].arena
+                                && (dxf_arena_share_names (arena, chunks[i].arena) != EXIT_SUCCESS))
+                        {
+                                dxf_arena_free (chunks[i].arena);
+                                chunks[i].arena = NULL;
+                        }
+                        chunks[i].fp = dxf_read_view (fp, split,
+                                dxf_parallel_skip_group (fp->buffer, offset,
+                                        fp->buffer_length));
+                        if (!chunks[i].fp || (arena && !chunks[i].arena))
+                        {
+                                dxf_read_close (chunks[i].fp);
+                                dxf_arena_free (chunks[i].arena);
+                                ret = EXIT_FAILURE;
+                                threads = i;
+                                break;
+                        }
+                        split = offset;
+                }
+#if HAVE_PTHREAD_H
+                workers = malloc ((size_t) threads * sizeof (pthread_t));
+                for (i = 0; i < threads; i++)
+                {
+                        chunks[i].threaded = workers && (pthread_create (&workers[i],
+                                NULL, dxf_parallel_read_chunk, &chunks[i]) == 0);
+                        if (!chunks[i].threaded)
+                                dxf_parallel_read_chunk (&chunks[i]);
+                }
+                for (i = 0; i < threads; i++)
+                {
+                        if (chunks[i].threaded)
+                                pthread_join (workers[i], NULL);
+                }
+                free (workers);
+#else
+                for (i = 0; i < threads; i++)
+                        dxf_parallel_read_chunk (&chunks[i]);
+#endif
+                /* Correct the line numbers with the number of lines in
+                 * the preceding chunks. */
+                line_number = fp->line_number;
+                for (i = 0; i < threads; i++)
+                {
+                        for (j = 0; j < chunks[i].count; j++)
+                                chunks[i].records[j].line_number += line_number;
+                        line_number += chunks[i].fp->line_number;
+                        if (chunks[i].ret != EXIT_SUCCESS)
+                                ret = EXIT_FAILURE;
+                        dxf_read_close (chunks[i].fp);
+                        /* The names are shared, so the adoption does not
+                         * fail. */
+                        if (arena
+                                && (dxf_arena_adopt (arena, chunks[i].arena) != EXIT_SUCCESS))
+                                ret = EXIT_FAILURE;
+                }
+        }
+        /* Merge the entities in file order. */
+        if (threads == 1)
+        {
+                *records = chunks[0].records;
+                *count = chunks[0].count;
+        }
+        else
+        {
+                total = 0;
+                for (i = 0; i < threads; i++)
+                        total += chunks[i].count;
+                if (total > 0)
+                        *records = malloc (total * sizeof (DxfEntityRecord));
+                if ((total > 0) && !*records)
+                {
+                        fprintf (stderr, "Error in dxf_read_entities_arena () could not allocate memory for the entities.\n");
+                        ret = EXIT_FAILURE;
+                }
+                for (i = 0; i < threads; i++)
+                {
+                        if (*records)
+                        {
+                                memcpy (*records + *count, chunks[i].records,
+                                        chunks[i].count * sizeof (DxfEntityRecord));
+                                *count += chunks[i].count;
+                                free (chunks[i].records);
+                        }
+                        else if (arena)
+                                free (chunks[i].records);
+                        else
+                                dxf_entity_records_free (chunks[i].records, chunks[i].count);
+                }
+        }
+        if (arena && *records)
+        {
+                /* Move the records into the arena as well. */
+                entities = *records;
+                *records = dxf_arena_alloc (arena, *count * sizeof (DxfEntityRecord));
+                if (*records)
+                        memcpy (*records, entities, *count * sizeof (DxfEntityRecord));
+                else
+                {
+                        *count = 0;
+                        ret = EXIT_FAILURE;
+                }
+                free (entities);
+        }
+        for (j = 0; headers && (j < *count); j++)
+        {
+                if ((*records)[j].type == APPID)
+                        continue;
+                if (dxf_entity_headers_add_handle (headers,
+                        (const DxfEntity *) (*records)[j].entity,
+                        (*records)[j].handle) < 0)
+                {
+                        ret = EXIT_FAILURE;
+                        break;
+                }
+        }
+        free (chunks);
+        dxf_reader_close (reader);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_read_entities_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (ret);
+}
+
+
+/*!
+ * \brief Reads all entities of the \c ENTITIES section of a DXF file,
+ * with \c threads threads (see \c dxf_read_entities_arena).
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred. \c records must be freed with \c dxf_entity_records_free.
+ */
+int
+dxf_read_entities_parallel
+(
+        const char *filename,
+                /*!< filename of input file (or device). */
+        int threads,
+                /*!< number of threads, 0 for the number of processors. */
+        DxfEntityRecord **records,
+                /*!< the entities, in file order. */
+        size_t *count
+                /*!< number of entities in \c records. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_read_entities_parallel () function.\n",
+                __FILE__, __LINE__);
+#endif
+        int ret;
+
+        ret = dxf_read_entities_arena (filename, threads, NULL, records, count, NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_read_entities_parallel () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (ret);
+}
+
+
+/*!
+ * \brief Writes the entities of a batch.
+ *
+ * Entities of types without a writer are skipped.
+ *
+ * \return \c NULL, for \c pthread_create.
+ */
+static void *
+dxf_parallel_write_batch
+(
+        void *data
+                /*!< the \c DxfParallelBatch. */
+)
+{
+        DxfParallelBatch *batch = data;
+        const DxfCallbackType *callback_type;
+        size_t i;
+
+        batch->ret = EXIT_SUCCESS;
+        for (i = 0; i < batch->count; i++)
+        {
+                callback_type = dxf_callback_type_by_type (batch->records[i].type);
+                if (!callback_type || !callback_type->write)
+                {
+                        fprintf (stderr, "Error in dxf_write_entities_parallel () entity type %d can not be written.\n",
+                                (int) batch->records[i].type);
+                        batch->ret = EXIT_FAILURE;
+                        continue;
+                }
+                if (callback_type->write (batch->fp, batch->records[i].entity,
+                        batch->acad_version_number) != EXIT_SUCCESS)
+                        batch->ret = EXIT_FAILURE;
+        }
+        return (NULL);
+}
+
+
+/*!
+ * \brief Writes entities to the \c ENTITIES section of a DXF file, with
+ * \c threads threads.
+ *
+ * The entities are split into batches of \c DXF_PARALLEL_WRITE_BATCH
+ * entities, one batch per thread at a time. Each thread formats its
+ * batch into a buffer of its own, the buffers are written to \c fp in
+ * the order of \c records, so the output does not depend on the number
+ * of threads.\n
+ * When \c handle is not \c NULL the entities with an id-code of 0 get
+ * the handles \c *handle, \c *handle + 1, ..., in the order of
+ * \c records, before any entity is formatted.\n
+ * The "  0" SECTION and ENDSEC groups are not written.\n
+ * When the library was built without threads the entities are written by
+ * the calling thread.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an entity
+ * could not be written (the entity is skipped) or an error occurred.
+ */
+int
+dxf_write_entities_parallel
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        const DxfEntityRecord *records,
+                /*!< the entities. */
+        size_t count,
+                /*!< number of entities in \c records. */
+        int acad_version_number,
+                /*!< AutoCAD version number. */
+        int threads,
+                /*!< number of threads, 0 for the number of processors. */
+        int *handle
+                /*!< next free handle, or \c NULL to keep the id-codes of
+                 * the entities. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_write_entities_parallel () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfParallelBatch *batches;
+        const DxfCallbackType *callback_type;
+        size_t next;
+        int *id_code;
+        int skipped = FALSE;
+        int ret = EXIT_SUCCESS;
+        int i;
+        size_t j;
+#if HAVE_PTHREAD_H
+        pthread_t *workers;
+#endif
+
+        if (!fp)
+        {
+                fprintf (stderr, "Error in dxf_write_entities_parallel () file handle is not initialised (NULL pointer).\n");
+                return (EXIT_FAILURE);
+        }
+        /* Handles are assigned up front, so they do not depend on the
+         * order in which the batches are formatted. */
+        for (j = 0; handle && (j < count); j++)
+        {
+                callback_type = dxf_callback_type_by_type (records[j].type);
+                if (!callback_type)
+                        continue;
+                id_code = (int *) ((char *) records[j].entity + callback_type->id_code);
+                if (*id_code == 0)
+                        *id_code = (*handle)++;
+        }
+        if (threads <= 0)
+                threads = (int) sysconf (_SC_NPROCESSORS_ONLN);
+        if ((size_t) threads > (count + DXF_PARALLEL_WRITE_BATCH - 1) / DXF_PARALLEL_WRITE_BATCH)
+                threads = (int) ((count + DXF_PARALLEL_WRITE_BATCH - 1) / DXF_PARALLEL_WRITE_BATCH);
+#if !HAVE_PTHREAD_H
+        threads = 1;
+#endif
+        if (threads <= 1)
+        {
+                /* Format the entities into the file itself. */
+                DxfParallelBatch batch;
+
+                batch.fp = fp;
+                batch.records = records;
+                batch.count = count;
+                batch.acad_version_number = acad_version_number;
+                dxf_parallel_write_batch (&batch);
+                if ((batch.ret != EXIT_SUCCESS) || fp->failed)
+                        ret = EXIT_FAILURE;
+#if DEBUG
+                fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_entities_parallel () function.\n",
+                        __FILE__, __LINE__);
+#endif
+                return (ret);
+        }
+        batches = malloc ((size_t) threads * sizeof (DxfParallelBatch));
+        if (!batches)
+        {
+                fprintf (stderr, "Error in dxf_write_entities_parallel () could not allocate memory for the batches.\n");
+                return (EXIT_FAILURE);
+        }
+        memset (batches, 0, (size_t) threads * sizeof (DxfParallelBatch));
+        for (i = 0; i < threads; i++)
+        {
+                batches[i].fp = dxf_write_init_memory (fp->binary);
+                if (!batches[i].fp)
+                {
+                        ret = EXIT_FAILURE;
+                        break;
+                }
+                batches[i].fp->precision = fp->precision;
+                batches[i].acad_version_number = acad_version_number;
+        }
+#if HAVE_PTHREAD_H
+        workers = malloc ((size_t) threads * sizeof (pthread_t));
+#endif
+        next = 0;
+        while ((ret == EXIT_SUCCESS) && (next < count))
+        {
+                for (i = 0; i < threads; i++)
+                {
+                        batches[i].records = records + next;
+                        batches[i].count = count - next;
+                        if (batches[i].count > DXF_PARALLEL_WRITE_BATCH)
+                                batches[i].count = DXF_PARALLEL_WRITE_BATCH;
+                        next += batches[i].count;
+                        batches[i].fp->buffer_length = 0;
+#if HAVE_PTHREAD_H
+                        batches[i].threaded = workers && (pthread_create (&workers[i],
+                                NULL, dxf_parallel_write_batch, &batches[i]) == 0);
+                        if (!batches[i].threaded)
+                                dxf_parallel_write_batch (&batches[i]);
+#else
+                        dxf_parallel_write_batch (&batches[i]);
+#endif
+                }
+                /* Write the buffers in the order of the entities. */
+                for (i = 0; i < threads; i++)
+                {
+#if HAVE_PTHREAD_H
+                        if (batches[i].threaded)
+                                pthread_join (workers[i], NULL);
+#endif
+                        /* A skipped entity does not stop the other
+                         * entities. */
+                        if (batches[i].ret != EXIT_SUCCESS)
+                                skipped = TRUE;
+                        if (batches[i].fp->failed)
+                                ret = EXIT_FAILURE;
+                        if (dxf_write_data (fp, batches[i].fp->buffer,
+                                batches[i].fp->buffer_length) != EXIT_SUCCESS)
+                                ret = EXIT_FAILURE;
+                }
+        }
+#if HAVE_PTHREAD_H
+        free (workers);
+#endif
+        for (i = 0; i < threads; i++)
+        {
+                if (batches[i].fp)
+                        dxf_write_close (batches[i].fp);
+        }
+        free (batches);
+        if (skipped)
+                ret = EXIT_FAILURE;
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_entities_parallel () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (ret);
+}
+
+
+/*!
+ * \brief Frees the entities read by \c dxf_read_entities_parallel.
+ *
+ * The entities are released to the pools of their types together with
+ * their strings, by the \c free function of their \c DxfCallbackType
+ * (see \c dxf_text_free); the names are interned and are kept.\n
+ * Entities read into an arena by \c dxf_read_entities_arena are freed
+ * with the arena instead.
+ */
+void
+dxf_entity_records_free
+(
+        DxfEntityRecord *records,
+                /*!< the entities. */
+        size_t count
+                /*!< number of entities in \c records. */
+)
+{
+        const DxfCallbackType *callback_type;
+        size_t i;
+
+        if (!records)
+                return;
+        for (i = 0; i < count; i++)
+        {
+                callback_type = dxf_callback_type_by_type (records[i].type);
+                if (callback_type)
+                        callback_type->free (records[i].entity);
+                else
+                        free (records[i].entity);
+        }
+        free (records);
+}
+
+
+/* EOF */
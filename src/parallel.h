@@ -0,0 +1,100 @@
+/*!
+ * \file parallel.h
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Definition of parallel reading and writing of the ENTITIES
+ * section.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+
+#include "global.h"
+#include "entity.h"
+
+
+/*!
+ * \brief DXF definition of an entity read by
+ * \c dxf_read_entities_parallel.
+ */
+typedef struct
+dxf_entity_record
+{
+        DxfEntityType type;
+                /*!< type of the entity. */
+        int line_number;
+                /*!< line number of the "  0" group of the entity. */
+        void *entity;
+                /*!< the entity, for example a \c DxfLine for \c LINE. */
+        uint64_t handle;
+                /*!< handle of the entity in all of its 64 bits, 0 without
+                 * one (the id-code of \c entity only holds 32 bits). */
+} DxfEntityRecord, * DxfEntityRecordPtr;
+
+
+int
+dxf_read_entities_parallel
+(
+        const char *filename,
+        int threads,
+        DxfEntityRecord **records,
+        size_t *count
+);
+int
+dxf_read_entities_arena
+(
+        const char *filename,
+        int threads,
+        DxfArena *arena,
+        DxfEntityRecord **records,
+        size_t *count,
+        DxfEntityHeaders *headers
+);
+int
+dxf_write_entities_parallel
+(
+        DxfWriter *fp,
+        const DxfEntityRecord *records,
+        size_t count,
+        int acad_version_number,
+        int threads,
+        int *handle
+);
+void
+dxf_entity_records_free
+(
+        DxfEntityRecord *records,
+        size_t count
+);
+
+
+#endif /* PARALLEL_H */
+
+
+/* EOF */
@@ -29,6 +29,10 @@
  * <hr>
  */
 
+#ifndef PARAM_H
+#define PARAM_H
+
+
 #include "global.h"
 
 /*!
@@ -47,4 +51,52 @@ dxf_param
                 /*!< string value. */
 } DxfParam;
 
+
+/*!
+ * \brief Types of the value of a \c DxfValue.
+ */
+typedef enum
+dxf_value_type
+{
+        DXF_VALUE_INT,
+                /*!< value is stored in \c I. */
+        DXF_VALUE_DOUBLE,
+                /*!< value is stored in \c D. */
+        DXF_VALUE_STRING
+                /*!< value is stored in \c S (also handles, 64 bit
+                 * integers and binary chunks, as read from an ASCII DXF
+                 * file). */
+} DxfValueType;
+
+
+/*!
+ * \brief DXF definition of a group code with its value, the type of the
+ * value follows from the group code (see \c dxf_binary_type).
+ *
+ * Unlike \c DxfParam only the space for the type of the value is used:
+ * a string is stored elsewhere (for example in an arena).
+ */
+typedef struct
+dxf_value
+{
+        short code;
+                /*!< group code. */
+        unsigned char type;
+                /*!< a \c DxfValueType. */
+        union
+        {
+                int I;
+                        /*!< integer value. */
+                double D;
+                        /*!< double value. */
+                char *S;
+                        /*!< string value. */
+        } value;
+                /*!< the value. */
+} DxfValue, * DxfValuePtr;
+
+
+#endif /* PARAM_H */
+
+
 /* EOF */
@@ -44,12 +44,25 @@
 
 
 #include "point.h"
+#include "arena.h"
+#include "pool.h"
+#include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_point_new are handed out by.
+ */
+static DxfPool dxf_point_pool = DXF_POOL_INITIALIZER (sizeof (DxfPoint));
 
 
 /*!
  * \brief Allocate memory for a \c DxfPoint.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_point_free.
  */
 DxfPoint *
 dxf_point_new ()
@@ -59,31 +72,91 @@ dxf_point_new ()
                 __FILE__, __LINE__);
 #endif
         DxfPoint *dxf_point = NULL;
-        size_t size;
 
-        size = sizeof (DxfPoint);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_point = malloc (size)) == NULL)
+        if ((dxf_point = dxf_pool_alloc (&dxf_point_pool)) == NULL)
         {
                 fprintf (stderr, "ERROR in dxf_point_new () could not allocate memory for a DxfPoint struct.\n");
-                dxf_point = NULL;
         }
-        else
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_point_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_point);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfPoint from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_point_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfPoint *
+dxf_point_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_point_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfPoint *dxf_point = NULL;
+
+        if (arena == NULL)
         {
-                memset (dxf_point, 0, size);
+                dxf_point = dxf_point_new ();
+        }
+        else if ((dxf_point = dxf_arena_alloc (arena, sizeof (DxfPoint))) == NULL)
+        {
+                fprintf (stderr, "ERROR in dxf_point_new_arena () could not allocate memory for a DxfPoint struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_point_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_point_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_point);
 }
 
 
+/*!
+ * \brief Release a \c DxfPoint allocated by \c dxf_point_new to its pool.
+ *
+ * The struct has no strings of its own, the layer and linetype are
+ * interned (see \c dxf_arena_intern).\n
+ * Not for a \c DxfPoint allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_point_free
+(
+        DxfPoint *dxf_point
+                /*!< DXF point entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_point_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        dxf_pool_release (&dxf_point_pool, dxf_point);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_point_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in a \c POINT entity.
  * 
+ * The layer and linetype are interned in the names shared by the
+ * entities without an arena (see \c dxf_intern_shared), they stay
+ * valid until \c dxf_intern_shared_free.
+ *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
  */
@@ -98,15 +171,45 @@ dxf_point_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_point_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        dxf_point = dxf_point_new ();
+        dxf_point = dxf_point_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_point_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_point);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in a \c POINT entity.
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_point_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfPoint *
+dxf_point_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_point_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfPoint *dxf_point = NULL;
+        dxf_point = dxf_point_new_arena (arena);
         if (dxf_point == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_point_init () could not allocate memory for a DxfPoint struct.\n");
+              fprintf (stderr, "ERROR in dxf_point_init_arena () could not allocate memory for a DxfPoint struct.\n");
               return (NULL);
         }
         dxf_point->common.id_code = 0;
-        dxf_point->common.linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dxf_point->common.layer = strdup (DXF_DEFAULT_LAYER);
+        dxf_point->common.linetype = dxf_arena_intern (arena, DXF_DEFAULT_LINETYPE);
+        dxf_point->common.layer = dxf_arena_intern (arena, DXF_DEFAULT_LAYER);
         dxf_point->x0 = 0.0;
         dxf_point->y0 = 0.0;
         dxf_point->z0 = 0.0;
@@ -118,13 +221,29 @@ dxf_point_init
         dxf_point->common.paperspace = DXF_MODELSPACE;
         dxf_point->common.acad_version_number = 0;
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_point_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_point_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_point);
 }
 
 
+/*!
+ * \brief Schema of the \c POINT entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_point_schema[DXF_SCHEMA_SIZE] =
+{
+        DXF_SCHEMA_ENTITY_COMMON (DxfPoint),
+        [10] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfPoint, x0),
+        [20] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfPoint, y0),
+        [30] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfPoint, z0),
+        [38] = DXF_SCHEMA_FIELD (DXF_FIELD_ELEVATION, DxfPoint, z0),
+        [210] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfPoint, extr_x0),
+        [220] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfPoint, extr_y0),
+        [230] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfPoint, extr_z0)
+};
+
+
 /*!
  * \brief Read data from a DXF file into a \c POINT entity.
  *
@@ -132,7 +251,8 @@ dxf_point_init
  * Now follows some data for the \c POINT, to be terminated with a
  * "  0" string announcing the following entity, or the end of the
  * \c ENTITY section marker \c ENDSEC. \n
- * While parsing the DXF file store data in \c dxf_point. \n
+ * While parsing the DXF file store data in \c dxf_point, the group
+ * codes are decoded through \c dxf_point_schema. \n
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -140,12 +260,8 @@ dxf_point_init
 int
 dxf_point_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         DxfPoint *dxf_point,
                 /*!< DXF ellipse entity. */
         int acad_version_number
@@ -156,147 +272,15 @@ dxf_point_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_point_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_point_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (0);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (*line_number)++;
-                        fscanf (fp, "%x\n", &dxf_point->common.id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_point->common.linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_point->common.layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_point->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_point->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_point->z0);
-                }
-                else if ((acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (dxf_point->z0 = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_point->z0);
-                        /*! \todo Consider to add 
-                         * dxf_line->z1 = dxf_line.z0;
-                         * for the elevation could affect both
-                         * Z-coordinates. */
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_point->common.thickness);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_point->common.color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_point->common.paperspace);
-                }
-                else if ((acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_point->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_point->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_point->extr_z0);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning: in dxf_point_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_point_schema, dxf_point, NULL,
+                "POINT", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_point_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -309,8 +293,8 @@ dxf_point_read
 int
 dxf_point_write_lowlevel
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< group code = 5. */
         char *layer,
@@ -346,26 +330,26 @@ dxf_point_write_lowlevel
                         dxf_entity_name);
                 layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
         if (paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_point_write_lowlevel () function.\n",
@@ -384,8 +368,8 @@ dxf_point_write_lowlevel
 int
 dxf_point_write
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfPoint dxf_point
                 /*!< DXF point entity. */
 )
@@ -405,26 +389,26 @@ dxf_point_write
                         dxf_entity_name);
                 dxf_point.common.layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (dxf_point.common.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_point.common.id_code);
+                dxf_write_group_hex (fp, 5, dxf_point.common.id_code);
         }
-        fprintf (fp, "  8\n%s\n", dxf_point.common.layer);
-        fprintf (fp, " 10\n%f\n", dxf_point.x0);
-        fprintf (fp, " 20\n%f\n", dxf_point.y0);
-        fprintf (fp, " 30\n%f\n", dxf_point.z0);
+        dxf_write_group_string (fp, 8, dxf_point.common.layer);
+        dxf_write_group_double (fp, 10, dxf_point.x0);
+        dxf_write_group_double (fp, 20, dxf_point.y0);
+        dxf_write_group_double (fp, 30, dxf_point.z0);
         if (dxf_point.common.thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", dxf_point.common.thickness);
+                dxf_write_group_double (fp, 39, dxf_point.common.thickness);
         }
         if (dxf_point.common.color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", dxf_point.common.color);
+                dxf_write_group_int (fp, 62, dxf_point.common.color);
         }
         if (dxf_point.common.paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_point_write () function.\n",
@@ -434,4 +418,75 @@ dxf_point_write
 }
 
 
+/*!
+ * \brief Write DXF output to fp for a batch of point entities, given as
+ * arrays of coordinates.
+ *
+ * All points are written with the same layer and color.\n
+ * \c z0 can be \c NULL for points in the XY-plane.\n
+ * When \c handle is not \c NULL the points get the handles
+ * \c *handle, \c *handle + 1, ..., and \c *handle is set to the next
+ * free handle.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occured.
+ */
+int
+dxf_point_write_batch
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        size_t count,
+                /*!< number of points. */
+        const double *x0,
+                /*!< X-values of the points. */
+        const double *y0,
+                /*!< Y-values of the points. */
+        const double *z0,
+                /*!< Z-values of the points, or \c NULL. */
+        const char *layer,
+                /*!< layer of all entities. */
+        int color,
+                /*!< color of all entities. */
+        int *handle
+                /*!< next free handle, or \c NULL to write the entities
+                 * without a handle. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_point_write_batch () function.\n",
+                __FILE__, __LINE__);
+#endif
+        size_t i;
+
+        if (!layer || (strcmp (layer, "") == 0))
+        {
+                fprintf (stderr, "Warning in dxf_point_write_batch () empty layer string for the POINT entities.\n");
+                fprintf (stderr, "    POINT entities are relocated to layer 0\n");
+                layer = DXF_DEFAULT_LAYER;
+        }
+        for (i = 0; i < count; i++)
+        {
+                dxf_write_group_string (fp, 0, "POINT");
+                if (handle)
+                {
+                        dxf_write_group_hex (fp, 5, (*handle)++);
+                }
+                dxf_write_group_string (fp, 8, layer);
+                dxf_write_group_double (fp, 10, x0[i]);
+                dxf_write_group_double (fp, 20, y0[i]);
+                dxf_write_group_double (fp, 30, z0 ? z0[i] : 0.0);
+                if (color != DXF_COLOR_BYLAYER)
+                {
+                        dxf_write_group_int (fp, 62, color);
+                }
+        }
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_point_write_batch () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (fp->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
 /* EOF */
@@ -80,23 +80,36 @@ dxf_point
 DxfPoint *
 dxf_point_new ();
 DxfPoint *
+dxf_point_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_point_free
+(
+        DxfPoint *dxf_point
+);
+DxfPoint *
 dxf_point_init
 (
         DxfPoint *dxf_point
 );
+DxfPoint *
+dxf_point_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_point_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfPoint *dxf_point,
         int acad_version_number
 );
 int
 dxf_point_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *layer,
         double x0,
@@ -109,9 +122,21 @@ dxf_point_write_lowlevel
 int
 dxf_point_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfPoint dxf_point
 );
+int
+dxf_point_write_batch
+(
+        DxfWriter *fp,
+        size_t count,
+        const double *x0,
+        const double *y0,
+        const double *z0,
+        const char *layer,
+        int color,
+        int *handle
+);
 
 
 #endif /* POINT_H */
@@ -31,12 +31,25 @@
 
 
 #include "polyline.h"
+#include "arena.h"
+#include "pool.h"
+#include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_polyline_new are handed out by.
+ */
+static DxfPool dxf_polyline_pool = DXF_POOL_INITIALIZER (sizeof (DxfPolyline));
 
 
 /*!
  * \brief Allocate memory for a \c DxfPolyline.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_polyline_free.
  */
 DxfPolyline *
 dxf_polyline_new ()
@@ -46,31 +59,91 @@ dxf_polyline_new ()
                 __FILE__, __LINE__);
 #endif
         DxfPolyline *dxf_polyline = NULL;
-        size_t size;
 
-        size = sizeof (DxfPolyline);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_polyline = malloc (size)) == NULL)
+        if ((dxf_polyline = dxf_pool_alloc (&dxf_polyline_pool)) == NULL)
+        {
+                fprintf (stderr, "ERROR in dxf_polyline_new () could not allocate memory for a DxfPolyline struct.\n");
+        }
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_polyline_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_polyline);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfPolyline from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_polyline_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfPolyline *
+dxf_polyline_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_polyline_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfPolyline *dxf_polyline = NULL;
+
+        if (arena == NULL)
         {
-                fprintf (stderr, "ERROR in dxf_polyline_new () could not allocate memory for a DxfArc struct.\n");
-                dxf_polyline = NULL;
+                dxf_polyline = dxf_polyline_new ();
         }
-        else
+        else if ((dxf_polyline = dxf_arena_alloc (arena, sizeof (DxfPolyline))) == NULL)
         {
-                memset (dxf_polyline, 0, size);
+                fprintf (stderr, "ERROR in dxf_polyline_new_arena () could not allocate memory for a DxfPolyline struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_polyline_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_polyline_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_polyline);
 }
 
 
+/*!
+ * \brief Release a \c DxfPolyline allocated by \c dxf_polyline_new to its pool.
+ *
+ * The struct has no strings of its own, the layer and linetype are
+ * interned (see \c dxf_arena_intern).\n
+ * Not for a \c DxfPolyline allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_polyline_free
+(
+        DxfPolyline *dxf_polyline
+                /*!< DXF polyline entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_polyline_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        dxf_pool_release (&dxf_polyline_pool, dxf_polyline);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_polyline_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in a \c POLYLINE entity.
  * 
+ * The layer and linetype are interned in the names shared by the
+ * entities without an arena (see \c dxf_intern_shared), they stay
+ * valid until \c dxf_intern_shared_free.
+ *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
  */
@@ -85,15 +158,45 @@ dxf_polyline_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_polyline_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        dxf_polyline = dxf_polyline_new ();
+        dxf_polyline = dxf_polyline_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_polyline_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_polyline);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in a \c POLYLINE entity.
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_polyline_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfPolyline *
+dxf_polyline_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_polyline_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfPolyline *dxf_polyline = NULL;
+        dxf_polyline = dxf_polyline_new_arena (arena);
         if (dxf_polyline == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_polyline_init () could not allocate memory for a DxfPolyline struct.\n");
+              fprintf (stderr, "ERROR in dxf_polyline_init_arena () could not allocate memory for a DxfPolyline struct.\n");
               return (NULL);
         }
         dxf_polyline->common.id_code = 0;
-        dxf_polyline->common.linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dxf_polyline->common.layer = strdup (DXF_DEFAULT_LAYER);
+        dxf_polyline->common.linetype = dxf_arena_intern (arena, DXF_DEFAULT_LINETYPE);
+        dxf_polyline->common.layer = dxf_arena_intern (arena, DXF_DEFAULT_LAYER);
         dxf_polyline->x0 = 0.0;
         dxf_polyline->y0 = 0.0;
         dxf_polyline->z0 = 0.0;
@@ -114,7 +217,7 @@ dxf_polyline_init
         dxf_polyline->extr_z0 = 0.0;
         dxf_polyline->common.acad_version_number = 0;
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_polyline_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_polyline_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_polyline);
@@ -122,6 +225,30 @@ dxf_polyline_init
 
 
 
+/*!
+ * \brief Schema of the \c POLYLINE entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_polyline_schema[DXF_SCHEMA_SIZE] =
+{
+        DXF_SCHEMA_ENTITY_COMMON (DxfPolyline),
+        [10] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfPolyline, x0),
+        [20] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfPolyline, y0),
+        [30] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfPolyline, z0),
+        [40] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfPolyline, start_width),
+        [41] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfPolyline, end_width),
+        [66] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfPolyline, vertices_follow),
+        [70] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfPolyline, flag),
+        [71] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfPolyline, polygon_mesh_M_vertex_count),
+        [72] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfPolyline, polygon_mesh_N_vertex_count),
+        [73] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfPolyline, smooth_M_surface_density),
+        [74] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfPolyline, smooth_N_surface_density),
+        [75] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfPolyline, surface_type),
+        [210] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfPolyline, extr_x0),
+        [220] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfPolyline, extr_y0),
+        [230] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfPolyline, extr_z0)
+};
+
+
 /*!
  * \brief Read data from a DXF file into an \c POLYLINE entity.
  *
@@ -129,7 +256,8 @@ dxf_polyline_init
  * Now follows some data for the \c POLYLINE, to be terminated with a
  * "  0" string announcing the following entity, or the end of the
  * \c ENTITY section marker \c ENDSEC. \n
- * While parsing the DXF file store data in \c dxf_polyline. \n
+ * While parsing the DXF file store data in \c dxf_polyline, the group
+ * codes are decoded through \c dxf_polyline_schema. \n
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -137,12 +265,8 @@ dxf_polyline_init
 int
 dxf_polyline_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         DxfPolyline *dxf_polyline,
                 /*!< DXF polyline entity. */
         int acad_version_number
@@ -153,198 +277,19 @@ dxf_polyline_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_polyline_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
         if (!dxf_polyline)
         {
                 dxf_polyline = dxf_polyline_new ();
         }
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_polyline_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (EXIT_FAILURE);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (*line_number)++;
-                        fscanf (fp, "%x\n", &dxf_polyline->common.id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_polyline->common.linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_polyline->common.layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the primary point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_polyline->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the primary point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_polyline->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the primary point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_polyline->z0);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_polyline->common.thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * starting width. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_polyline->start_width);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * end width. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_polyline->end_width);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_polyline->common.color);
-                }
-                else if (strcmp (temp_string, "66") == 0)
-                {
-                        /* Now follows a string containing the
-                         * vertces follow flag. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_polyline->vertices_follow);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_polyline->common.paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * flag value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_polyline->flag);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the polygon
-                         * mesh M vertex count value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_polyline->polygon_mesh_M_vertex_count);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing the polygon
-                         * mesh N vertex count value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_polyline->polygon_mesh_N_vertex_count);
-                }
-                else if (strcmp (temp_string, "73") == 0)
-                {
-                        /* Now follows a string containing the smooth M
-                         * surface density value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_polyline->smooth_M_surface_density);
-                }
-                else if (strcmp (temp_string, "74") == 0)
-                {
-                        /* Now follows a string containing the smooth N
-                         * surface density value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_polyline->smooth_M_surface_density);
-                }
-                else if (strcmp (temp_string, "75") == 0)
-                {
-                        /* Now follows a string containing the surface
-                         * type value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_polyline->surface_type);
-                }
-                else if ((acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_polyline->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_polyline->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_polyline->extr_z0);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning: in dxf_lwpolyline_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_polyline_schema, dxf_polyline, NULL,
+                "POLYLINE", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_lwpolyline_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -357,8 +302,8 @@ dxf_polyline_read
 int
 dxf_polyline_write_lowlevel
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< group code = 5. */
         char *linetype,
@@ -446,46 +391,46 @@ dxf_polyline_write_lowlevel
                         dxf_entity_name, id_code);
                 return (EXIT_FAILURE);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
         if (start_width != 0.0)
         {
-                fprintf (fp, " 40\n%f\n", start_width);
+                dxf_write_group_double (fp, 40, start_width);
         }
         if (end_width != 0.0)
         {
-                fprintf (fp, " 41\n%f\n", end_width);
+                dxf_write_group_double (fp, 41, end_width);
         }
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
-        fprintf (fp, " 66\n%d\n", vertices_follow);
+        dxf_write_group_int (fp, 66, vertices_follow);
         if (paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp, " 70\n%d\n", flag);
-        fprintf (fp, " 71\n%d\n", polygon_mesh_M_vertex_count);
-        fprintf (fp, " 72\n%d\n", polygon_mesh_N_vertex_count);
-        fprintf (fp, " 73\n%d\n", smooth_M_surface_density);
-        fprintf (fp, " 74\n%d\n", smooth_N_surface_density);
-        fprintf (fp, " 75\n%d\n", surface_type);
+        dxf_write_group_int (fp, 70, flag);
+        dxf_write_group_int (fp, 71, polygon_mesh_M_vertex_count);
+        dxf_write_group_int (fp, 72, polygon_mesh_N_vertex_count);
+        dxf_write_group_int (fp, 73, smooth_M_surface_density);
+        dxf_write_group_int (fp, 74, smooth_N_surface_density);
+        dxf_write_group_int (fp, 75, surface_type);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_polyline_write_lowlevel () function.\n",
                 __FILE__, __LINE__);
@@ -503,8 +448,8 @@ dxf_polyline_write_lowlevel
 int
 dxf_polyline_write
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfPolyline dxf_polyline
                 /*!< DXF polyline entity. */
 )
@@ -541,46 +486,46 @@ dxf_polyline_write
                         dxf_entity_name, dxf_polyline.common.id_code);
                 return (EXIT_FAILURE);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (dxf_polyline.common.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_polyline.common.id_code);
+                dxf_write_group_hex (fp, 5, dxf_polyline.common.id_code);
         }
         if (strcmp (dxf_polyline.common.linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", dxf_polyline.common.linetype);
+                dxf_write_group_string (fp, 6, dxf_polyline.common.linetype);
         }
-        fprintf (fp, "  8\n%s\n", dxf_polyline.common.layer);
-        fprintf (fp, " 10\n%f\n", dxf_polyline.x0);
-        fprintf (fp, " 20\n%f\n", dxf_polyline.y0);
-        fprintf (fp, " 30\n%f\n", dxf_polyline.z0);
+        dxf_write_group_string (fp, 8, dxf_polyline.common.layer);
+        dxf_write_group_double (fp, 10, dxf_polyline.x0);
+        dxf_write_group_double (fp, 20, dxf_polyline.y0);
+        dxf_write_group_double (fp, 30, dxf_polyline.z0);
         if (dxf_polyline.common.thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", dxf_polyline.common.thickness);
+                dxf_write_group_double (fp, 39, dxf_polyline.common.thickness);
         }
         if (dxf_polyline.start_width != 0.0)
         {
-                fprintf (fp, " 40\n%f\n", dxf_polyline.start_width);
+                dxf_write_group_double (fp, 40, dxf_polyline.start_width);
         }
         if (dxf_polyline.end_width != 0.0)
         {
-                fprintf (fp, " 41\n%f\n", dxf_polyline.end_width);
+                dxf_write_group_double (fp, 41, dxf_polyline.end_width);
         }
         if (dxf_polyline.common.color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", dxf_polyline.common.color);
+                dxf_write_group_int (fp, 62, dxf_polyline.common.color);
         }
-        fprintf (fp, " 66\n%d\n", dxf_polyline.vertices_follow);
+        dxf_write_group_int (fp, 66, dxf_polyline.vertices_follow);
         if (dxf_polyline.common.paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp, " 70\n%d\n", dxf_polyline.flag);
-        fprintf (fp, " 71\n%d\n", dxf_polyline.polygon_mesh_M_vertex_count);
-        fprintf (fp, " 72\n%d\n", dxf_polyline.polygon_mesh_N_vertex_count);
-        fprintf (fp, " 73\n%d\n", dxf_polyline.smooth_M_surface_density);
-        fprintf (fp, " 74\n%d\n", dxf_polyline.smooth_N_surface_density);
-        fprintf (fp, " 75\n%d\n", dxf_polyline.surface_type);
+        dxf_write_group_int (fp, 70, dxf_polyline.flag);
+        dxf_write_group_int (fp, 71, dxf_polyline.polygon_mesh_M_vertex_count);
+        dxf_write_group_int (fp, 72, dxf_polyline.polygon_mesh_N_vertex_count);
+        dxf_write_group_int (fp, 73, dxf_polyline.smooth_M_surface_density);
+        dxf_write_group_int (fp, 74, dxf_polyline.smooth_N_surface_density);
+        dxf_write_group_int (fp, 75, dxf_polyline.surface_type);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_polyline_write () function.\n",
                 __FILE__, __LINE__);
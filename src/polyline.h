@@ -166,23 +166,36 @@ dxf_polyline
 DxfPolyline *
 dxf_polyline_new ();
 DxfPolyline *
+dxf_polyline_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_polyline_free
+(
+        DxfPolyline *dxf_polyline
+);
+DxfPolyline *
 dxf_polyline_init
 (
         DxfPolyline *dxf_polyline
 );
+DxfPolyline *
+dxf_polyline_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_polyline_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfPolyline *dxf_polyline,
         int acad_version_number
 );
 int
 dxf_polyline_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *linetype,
         char *layer,
@@ -205,7 +218,7 @@ dxf_polyline_write_lowlevel
 int
 dxf_polyline_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfPolyline dxf_polyline
 );
 
@@ -0,0 +1,674 @@
+/*!
+ * \file pool.c
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Functions for a pool allocator for structs of one size.
+ *
+ * Structs are handed out from slabs of \c DXF_POOL_SLAB_ITEMS structs by
+ * moving a pointer, released structs are kept in a free list and handed
+ * out again before the slab, so allocating and releasing many entities
+ * does not call \c malloc and \c free for each of them.\n
+ * The slabs are allocated with \c malloc, or from an arena which frees
+ * them with the document.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "libdxf.h"
+#endif
+#if HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+#include "pool.h"
+#include "arena.h"
+
+
+/*!
+ * \brief Size of the header of a slab allocated with \c malloc, the link
+ * to the slab allocated before.
+ */
+#define DXF_POOL_HEADER DXF_POOL_ITEM_SIZE (sizeof (void *))
+
+
+/*!
+ * \brief \c TRUE when each thread keeps the structs it released in a
+ * cache of its own, which needs threads and thread local variables.
+ */
+#if HAVE_PTHREAD_H && defined (__GNUC__)
+#define DXF_POOL_THREAD_CACHE 1
+#else
+#define DXF_POOL_THREAD_CACHE 0
+#endif
+
+
+#if HAVE_PTHREAD_H
+/*!
+ * \brief Mutex serializing the creation of the mutexes of the static
+ * pools (see \c DXF_POOL_INITIALIZER), the assignment of the caches, and
+ * a static pool of which the mutex could not be created.
+ */
+static pthread_mutex_t dxf_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+
+#if DXF_POOL_THREAD_CACHE
+/*!
+ * \brief Number of pools of which the threads keep the released structs,
+ * the other pools are always locked.
+ */
+#define DXF_POOL_CACHES 64
+
+/*!
+ * \brief Number of released structs a thread keeps of a pool, a full
+ * cache is given back to the pool, an empty cache takes half as many
+ * structs at once.
+ */
+#define DXF_POOL_CACHE_ITEMS 128
+
+
+/*!
+ * \brief DXF definition of the structs of a pool kept by a thread.
+ */
+typedef struct
+dxf_pool_cache
+{
+        unsigned long generation;
+                /*!< generation of the pool the structs belong to. */
+        void *items;
+                /*!< the structs, linked through their first bytes. */
+        void *last;
+                /*!< last struct in \c items. */
+        size_t count;
+                /*!< number of structs in \c items. */
+} DxfPoolCache;
+
+
+/*!
+ * \brief The pools the caches are assigned to, \c NULL for a free cache.
+ */
+static DxfPool *dxf_pool_caches[DXF_POOL_CACHES];
+
+
+/*!
+ * \brief Last generation given to a pool.
+ */
+static unsigned long dxf_pool_generation = 0;
+
+
+/*!
+ * \brief The caches of the current thread, allocated the first time it
+ * uses a pool with a cache.
+ *
+ * A single pointer with the initial exec model, so the library finds it
+ * without a call also when it is loaded as a shared library.
+ */
+static __thread DxfPoolCache *dxf_pool_thread_caches
+        __attribute__ ((tls_model ("initial-exec"))) = NULL;
+
+
+/*!
+ * \brief Key with which the caches of a thread are given back to their
+ * pools when it exits.
+ */
+static pthread_key_t dxf_pool_key;
+
+
+/*!
+ * \brief Guards the creation of \c dxf_pool_key.
+ */
+static pthread_once_t dxf_pool_key_once = PTHREAD_ONCE_INIT;
+
+
+/*!
+ * \brief Assigns a cache to a pool allocated with \c malloc, under
+ * \c dxf_pool_lock.
+ *
+ * A pool without a cache, when all are assigned, is always locked.
+ */
+static void
+dxf_pool_assign
+(
+        DxfPool *pool
+                /*!< the pool. */
+)
+{
+        size_t i;
+
+        if (pool->arena)
+                return;
+        for (i = 0; i < DXF_POOL_CACHES; i++)
+        {
+                if (!dxf_pool_caches[i])
+                {
+                        dxf_pool_caches[i] = pool;
+                        pool->generation = ++dxf_pool_generation;
+                        pool->cache = i + 1;
+                        return;
+                }
+        }
+}
+
+
+/*!
+ * \brief Gives the structs in a cache back to its pool, under the mutex
+ * of the pool.
+ */
+static void
+dxf_pool_give_back
+(
+        DxfPool *pool,
+                /*!< the pool. */
+        DxfPoolCache *cache
+                /*!< the cache, emptied. */
+)
+{
+        if (cache->items)
+        {
+                *(void **) cache->last = pool->free_items;
+                pool->free_items = cache->items;
+                pool->used -= cache->count;
+        }
+        cache->items = NULL;
+        cache->last = NULL;
+        cache->count = 0;
+}
+
+
+/*!
+ * \brief Gives the caches of an exiting thread back to the pools which
+ * still exist, and frees them.
+ */
+static void
+dxf_pool_thread_exit
+(
+        void *caches
+                /*!< the caches of the thread. */
+)
+{
+        DxfPoolCache *cache = caches;
+        DxfPool *pool;
+        size_t i;
+
+        pthread_mutex_lock (&dxf_pool_lock);
+        for (i = 0; i < DXF_POOL_CACHES; i++)
+        {
+                pool = dxf_pool_caches[i];
+                if (pool && cache[i].items
+                        && (cache[i].generation == pool->generation))
+                {
+                        pthread_mutex_lock (pool->lock);
+                        dxf_pool_give_back (pool, &cache[i]);
+                        pthread_mutex_unlock (pool->lock);
+                }
+        }
+        pthread_mutex_unlock (&dxf_pool_lock);
+        dxf_pool_thread_caches = NULL;
+        free (cache);
+}
+
+
+/*!
+ * \brief Creates \c dxf_pool_key.
+ */
+static void
+dxf_pool_key_new ()
+{
+        pthread_key_create (&dxf_pool_key, dxf_pool_thread_exit);
+}
+
+
+/*!
+ * \brief Gives the cache of the current thread for a pool, when the
+ * fast path in \c dxf_pool_alloc or \c dxf_pool_release did not find
+ * it.
+ *
+ * A cache still holding the structs of a pool which was freed since is
+ * emptied without touching them.
+ *
+ * \return the cache, or \c NULL when the pool has none or the caches
+ * of the thread could not be allocated.
+ */
+static DxfPoolCache *
+dxf_pool_cache
+(
+        DxfPool *pool
+                /*!< the pool, of which the mutex was given by
+                 * \c dxf_pool_mutex. */
+)
+{
+        DxfPoolCache *caches = dxf_pool_thread_caches;
+        DxfPoolCache *cache;
+
+        if (!pool->cache)
+                return (NULL);
+        if (!caches)
+        {
+                caches = calloc (DXF_POOL_CACHES, sizeof (DxfPoolCache));
+                if (!caches)
+                        return (NULL);
+                pthread_once (&dxf_pool_key_once, dxf_pool_key_new);
+                pthread_setspecific (dxf_pool_key, caches);
+                dxf_pool_thread_caches = caches;
+        }
+        cache = &caches[pool->cache - 1];
+        if (cache->generation != pool->generation)
+        {
+                cache->generation = pool->generation;
+                cache->items = NULL;
+                cache->last = NULL;
+                cache->count = 0;
+        }
+        return (cache);
+}
+
+
+/*!
+ * \brief Gives the cache of the current thread for a pool without a
+ * call, when the pool and the thread have used it before.
+ *
+ * \return the cache, or \c NULL when the slow path must be taken.
+ */
+static inline DxfPoolCache *
+dxf_pool_cache_fast
+(
+        DxfPool *pool
+                /*!< the pool. */
+)
+{
+        DxfPoolCache *caches = dxf_pool_thread_caches;
+        DxfPoolCache *cache;
+
+        if (!caches || !__atomic_load_n (&pool->lock, __ATOMIC_ACQUIRE)
+                || !pool->cache)
+                return (NULL);
+        cache = &caches[pool->cache - 1];
+        if (cache->generation != pool->generation)
+                return (NULL);
+        return (cache);
+}
+#endif
+
+
+#if HAVE_PTHREAD_H
+/*!
+ * \brief Gives the mutex of a pool, a static pool gets a mutex and a
+ * cache of its own the first time it is used.
+ *
+ * So threads allocating structs of different types do not wait for each
+ * other. The mutex of a static pool lives as long as the process, like
+ * its slabs.
+ *
+ * \return the mutex.
+ */
+static pthread_mutex_t *
+dxf_pool_mutex
+(
+        DxfPool *pool
+                /*!< the pool. */
+)
+{
+        pthread_mutex_t *lock;
+
+#if defined (__GNUC__)
+        lock = __atomic_load_n (&pool->lock, __ATOMIC_ACQUIRE);
+        if (lock)
+                return (lock);
+#endif
+        pthread_mutex_lock (&dxf_pool_lock);
+        lock = pool->lock;
+        if (!lock)
+        {
+                lock = malloc (sizeof (pthread_mutex_t));
+                if (lock && (pthread_mutex_init (lock, NULL) == 0))
+                {
+#if DXF_POOL_THREAD_CACHE
+                        dxf_pool_assign (pool);
+#endif
+#if defined (__GNUC__)
+                        __atomic_store_n (&pool->lock, lock, __ATOMIC_RELEASE);
+#else
+                        pool->lock = lock;
+#endif
+                }
+                else
+                {
+                        free (lock);
+                        lock = &dxf_pool_lock;
+                }
+        }
+        pthread_mutex_unlock (&dxf_pool_lock);
+        return (lock);
+}
+#endif
+
+
+/*!
+ * \brief Allocates a pool for structs of \c size bytes.
+ *
+ * With an arena the slabs are allocated from the arena and are freed with
+ * the arena, \c dxf_pool_free only frees the pool itself.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the pool
+ * when succesful.
+ */
+DxfPool *
+dxf_pool_new
+(
+        DxfArena *arena,
+                /*!< arena, or \c NULL. */
+        size_t size
+                /*!< size of a struct. */
+)
+{
+        DxfPool *pool;
+
+        pool = malloc (sizeof (DxfPool));
+        if (!pool)
+        {
+                fprintf (stderr, "Error in dxf_pool_new () could not allocate memory for a DxfPool struct.\n");
+                return (NULL);
+        }
+        pool->size = DXF_POOL_ITEM_SIZE ((size > 0) ? size : 1);
+        pool->slab_items = DXF_POOL_SLAB_ITEMS;
+        pool->arena = arena;
+        pool->slabs = NULL;
+        pool->next = NULL;
+        pool->end = NULL;
+        pool->free_items = NULL;
+        pool->used = 0;
+        pool->allocated = 0;
+        pool->lock = NULL;
+        pool->cache = 0;
+        pool->generation = 0;
+#if HAVE_PTHREAD_H
+        pool->lock = malloc (sizeof (pthread_mutex_t));
+        if (!pool->lock || (pthread_mutex_init (pool->lock, NULL) != 0))
+        {
+                fprintf (stderr, "Error in dxf_pool_new () could not create a mutex.\n");
+                free (pool->lock);
+                free (pool);
+                return (NULL);
+        }
+#endif
+#if DXF_POOL_THREAD_CACHE
+        pthread_mutex_lock (&dxf_pool_lock);
+        dxf_pool_assign (pool);
+        pthread_mutex_unlock (&dxf_pool_lock);
+#endif
+        return (pool);
+}
+
+
+/*!
+ * \brief Takes a struct from the free list or the current slab of a
+ * pool, with the pool locked.
+ *
+ * \return \c NULL when the pool has none left and \c grow is \c FALSE,
+ * or no memory was allocated, a pointer to the struct otherwise.
+ */
+static void *
+dxf_pool_take
+(
+        DxfPool *pool,
+                /*!< the pool. */
+        int grow
+                /*!< \c TRUE to allocate a new slab when needed. */
+)
+{
+        char *slab;
+        void *item;
+
+        item = pool->free_items;
+        if (item)
+                pool->free_items = *(void **) item;
+        else
+        {
+                if (grow && (pool->next == pool->end))
+                {
+                        if (pool->arena)
+                                slab = dxf_arena_alloc (pool->arena,
+                                        pool->slab_items * pool->size);
+                        else
+                        {
+                                slab = malloc (DXF_POOL_HEADER
+                                        + pool->slab_items * pool->size);
+                                if (slab)
+                                {
+                                        *(void **) slab = pool->slabs;
+                                        pool->slabs = slab;
+                                        slab += DXF_POOL_HEADER;
+                                }
+                        }
+                        if (slab)
+                        {
+                                pool->next = slab;
+                                pool->end = slab + pool->slab_items * pool->size;
+                                pool->allocated += pool->slab_items * pool->size;
+                        }
+                }
+                if (pool->next != pool->end)
+                {
+                        item = pool->next;
+                        pool->next += pool->size;
+                }
+        }
+        if (item)
+                pool->used++;
+        return (item);
+}
+
+
+/*!
+ * \brief Hands out a struct of a pool, filled with zeros.
+ *
+ * A struct released by the same thread is handed out first, without
+ * locking the pool. Otherwise a released struct or a struct of the
+ * current slab is handed out, a new slab is allocated when the current
+ * one is used up; the thread then keeps up to half a cache of them for
+ * the next calls.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the struct
+ * when succesful.
+ */
+void *
+dxf_pool_alloc
+(
+        DxfPool *pool
+                /*!< the pool. */
+)
+{
+        void *item;
+#if HAVE_PTHREAD_H
+        pthread_mutex_t *lock;
+#endif
+#if DXF_POOL_THREAD_CACHE
+        DxfPoolCache *cache = dxf_pool_cache_fast (pool);
+        void *extra;
+
+        if (cache && cache->items)
+        {
+                item = cache->items;
+                cache->items = *(void **) item;
+                cache->count--;
+                memset (item, 0, pool->size);
+                return (item);
+        }
+#endif
+#if HAVE_PTHREAD_H
+        lock = dxf_pool_mutex (pool);
+#endif
+#if DXF_POOL_THREAD_CACHE
+        if (!cache)
+                cache = dxf_pool_cache (pool);
+#endif
+#if HAVE_PTHREAD_H
+        pthread_mutex_lock (lock);
+#endif
+        item = dxf_pool_take (pool, TRUE);
+#if DXF_POOL_THREAD_CACHE
+        while (cache && item && (cache->count < DXF_POOL_CACHE_ITEMS / 2)
+                && ((extra = dxf_pool_take (pool, FALSE)) != NULL))
+        {
+                *(void **) extra = cache->items;
+                if (!cache->items)
+                        cache->last = extra;
+                cache->items = extra;
+                cache->count++;
+        }
+#endif
+#if HAVE_PTHREAD_H
+        pthread_mutex_unlock (lock);
+#endif
+        if (!item)
+        {
+                fprintf (stderr, "Error in dxf_pool_alloc () could not allocate memory for a slab.\n");
+                return (NULL);
+        }
+        memset (item, 0, pool->size);
+        return (item);
+}
+
+
+/*!
+ * \brief Releases a struct handed out by \c dxf_pool_alloc to its pool,
+ * to be handed out again.
+ *
+ * The struct is kept by the releasing thread, a full cache is given back
+ * to the pool, and so is the cache of a thread which exits.\n
+ * \c item must have been handed out by \c pool: memory of an arena or
+ * of another pool ends up in the free list and is handed out again.
+ */
+void
+dxf_pool_release
+(
+        DxfPool *pool,
+                /*!< the pool. */
+        void *item
+                /*!< the struct, or \c NULL. */
+)
+{
+#if HAVE_PTHREAD_H
+        pthread_mutex_t *lock;
+#endif
+#if DXF_POOL_THREAD_CACHE
+        DxfPoolCache *cache;
+#endif
+
+        if (!item)
+                return;
+#if DXF_POOL_THREAD_CACHE
+        cache = dxf_pool_cache_fast (pool);
+        if (cache && (cache->count < DXF_POOL_CACHE_ITEMS))
+        {
+                *(void **) item = cache->items;
+                if (!cache->items)
+                        cache->last = item;
+                cache->items = item;
+                cache->count++;
+                return;
+        }
+#endif
+#if HAVE_PTHREAD_H
+        lock = dxf_pool_mutex (pool);
+#endif
+#if DXF_POOL_THREAD_CACHE
+        if (!cache)
+                cache = dxf_pool_cache (pool);
+        if (cache)
+        {
+                if (cache->count == DXF_POOL_CACHE_ITEMS)
+                {
+                        pthread_mutex_lock (lock);
+                        dxf_pool_give_back (pool, cache);
+                        pthread_mutex_unlock (lock);
+                }
+                *(void **) item = cache->items;
+                if (!cache->items)
+                        cache->last = item;
+                cache->items = item;
+                cache->count++;
+                return;
+        }
+#endif
+#if HAVE_PTHREAD_H
+        pthread_mutex_lock (lock);
+#endif
+        *(void **) item = pool->free_items;
+        pool->free_items = item;
+        pool->used--;
+#if HAVE_PTHREAD_H
+        pthread_mutex_unlock (lock);
+#endif
+}
+
+
+/*!
+ * \brief Frees a pool allocated by \c dxf_pool_new and the slabs it
+ * allocated with \c malloc.
+ *
+ * The structs handed out by the pool are freed with it, the structs
+ * other threads keep of it are forgotten by them.
+ */
+void
+dxf_pool_free
+(
+        DxfPool *pool
+                /*!< the pool, or \c NULL. */
+)
+{
+        void *slab;
+
+        if (!pool)
+                return;
+#if DXF_POOL_THREAD_CACHE
+        if (pool->cache)
+        {
+                pthread_mutex_lock (&dxf_pool_lock);
+                dxf_pool_caches[pool->cache - 1] = NULL;
+                pthread_mutex_unlock (&dxf_pool_lock);
+                if (dxf_pool_thread_caches)
+                        dxf_pool_thread_caches[pool->cache - 1].generation = 0;
+        }
+#endif
+        while (pool->slabs)
+        {
+                slab = pool->slabs;
+                pool->slabs = *(void **) slab;
+                free (slab);
+        }
+#if HAVE_PTHREAD_H
+        if (pool->lock)
+        {
+                pthread_mutex_destroy (pool->lock);
+                free (pool->lock);
+        }
+#endif
+        free (pool);
+}
+
+
+/* EOF */
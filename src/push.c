@@ -0,0 +1,244 @@
+/*!
+ * \file push.c
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Functions for a DXF push parser.
+ *
+ * A push parser is fed the bytes of a DXF file in chunks of any size, as
+ * they arrive (for example from a socket), and calls a handler for the
+ * same events as \c dxf_reader_next.\n
+ * A group (or a number of a binary DXF file) which is split over two
+ * chunks is parsed when the second chunk is fed.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#include "push.h"
+#include "util.h"
+
+
+/*!
+ * \brief Allocates a push parser.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the push
+ * parser when succesful.
+ */
+DxfPushParser *
+dxf_push_parser_new
+(
+        DxfPushCallback callback,
+                /*!< handler for the events. */
+        void *user_data
+                /*!< data passed to the handler. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_push_parser_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfPushParser *parser;
+        DxfFile *fp;
+
+        parser = malloc (sizeof (DxfPushParser));
+        fp = malloc (sizeof (DxfFile));
+        if (!parser || !fp)
+        {
+                fprintf (stderr, "Error in dxf_push_parser_new () could not allocate memory for a DxfPushParser struct.\n");
+                free (parser);
+                free (fp);
+                return (NULL);
+        }
+        memset (parser, 0, sizeof (DxfPushParser));
+        memset (fp, 0, sizeof (DxfFile));
+        /* A DxfFile without file handle, its buffer is filled by
+         * dxf_read_append. */
+        fp->filename = strdup ("(push)");
+        parser->reader = dxf_reader_open_file (fp);
+        if (!parser->reader)
+        {
+                free (parser);
+                return (NULL);
+        }
+        parser->callback = callback;
+        parser->user_data = user_data;
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_push_parser_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (parser);
+}
+
+
+/*!
+ * \brief Tests if the next event can be read from the bytes fed so far.
+ *
+ * One event reads at most two groups ("  0" "SECTION" and the name of
+ * the section).
+ *
+ * \return \c TRUE when the buffer holds two complete groups,
+ * \c FALSE otherwise.
+ */
+static int
+dxf_push_parser_ready
+(
+        DxfPushParser *parser
+                /*!< DXF push parser. */
+)
+{
+        DxfFile *fp = parser->reader->fp;
+        size_t offset;
+        size_t size;
+        int i;
+
+        offset = fp->buffer_position;
+        for (i = 0; i < 2; i++)
+        {
+                size = dxf_read_group_size (fp, offset);
+                if (size == 0)
+                        return (FALSE);
+                offset += size;
+        }
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Reads the events from the bytes fed so far and calls the
+ * handler for each of them.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the data is
+ * not a valid DXF file.
+ */
+static int
+dxf_push_parser_run
+(
+        DxfPushParser *parser,
+                /*!< DXF push parser. */
+        int final
+                /*!< \c TRUE when all bytes were fed. */
+)
+{
+        DxfFile *fp = parser->reader->fp;
+        DxfReaderEvent event;
+
+        if (!parser->detected)
+        {
+                /* The sentinel of a binary DXF file and the size of its
+                 * group codes follow from the first 24 bytes. */
+                if (!final && (fp->buffer_length < DXF_BINARY_SENTINEL_LENGTH + 2))
+                        return (EXIT_SUCCESS);
+                dxf_read_detect (fp);
+                parser->detected = TRUE;
+        }
+        while (!parser->done && (final || dxf_push_parser_ready (parser)))
+        {
+                dxf_reader_next (parser->reader, &event);
+                if (event.type <= DXF_EVENT_EOF)
+                {
+                        parser->done = TRUE;
+                        parser->error = (event.type == DXF_EVENT_ERROR);
+                }
+                if (parser->callback
+                        && (parser->callback (&event, parser->user_data) != EXIT_SUCCESS))
+                        parser->done = TRUE;
+        }
+        return (parser->error ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Feeds the next bytes of a DXF file to a push parser.
+ *
+ * The handler is called for every event which can be read from the
+ * bytes fed so far; \c data is copied and may be reused afterwards.\n
+ * Bytes fed after the end of the file (or after the handler stopped the
+ * parser) are ignored.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the data is
+ * not a valid DXF file or no memory was allocated.
+ */
+int
+dxf_push_parser_feed
+(
+        DxfPushParser *parser,
+                /*!< DXF push parser. */
+        const char *data,
+                /*!< the next bytes. */
+        size_t length
+                /*!< number of bytes in \c data. */
+)
+{
+        if (parser->done)
+                return (parser->error ? EXIT_FAILURE : EXIT_SUCCESS);
+        if (dxf_read_append (parser->reader->fp, data, length) != EXIT_SUCCESS)
+        {
+                parser->done = TRUE;
+                parser->error = TRUE;
+                return (EXIT_FAILURE);
+        }
+        return (dxf_push_parser_run (parser, FALSE));
+}
+
+
+/*!
+ * \brief Tells a push parser that all bytes were fed.
+ *
+ * The remaining events are read, up to \c DXF_EVENT_EOF (a missing
+ * \c EOF marker is tolerated, like by \c dxf_reader_next).
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the data is
+ * not a valid (or a truncated) DXF file.
+ */
+int
+dxf_push_parser_finish
+(
+        DxfPushParser *parser
+                /*!< DXF push parser. */
+)
+{
+        return (dxf_push_parser_run (parser, TRUE));
+}
+
+
+/*!
+ * \brief Frees a push parser and the bytes it kept.
+ */
+void
+dxf_push_parser_free
+(
+        DxfPushParser *parser
+                /*!< DXF push parser. */
+)
+{
+        if (parser)
+        {
+                dxf_reader_close (parser->reader);
+                free (parser);
+        }
+}
+
+
+/* EOF */
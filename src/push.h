@@ -0,0 +1,112 @@
+/*!
+ * \file push.h
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Definition of a DXF push parser.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifndef PUSH_H
+#define PUSH_H
+
+
+#include "global.h"
+#include "reader.h"
+
+
+/*!
+ * \brief Handler for the events of a push parser, see
+ * \c dxf_push_parser_new.
+ *
+ * \c event is only valid during the call.
+ *
+ * \return \c EXIT_SUCCESS to continue parsing, any other value stops
+ * the push parser.
+ */
+typedef int (*DxfPushCallback)
+(
+        const DxfReaderEvent *event,
+        void *user_data
+);
+
+
+/*!
+ * \brief DXF definition of a push parser.
+ *
+ * The bytes fed which do not complete a group yet are kept until the
+ * next call of \c dxf_push_parser_feed.
+ */
+typedef struct
+dxf_push_parser
+{
+        DxfReader *reader;
+                /*!< pull reader on the bytes fed so far. */
+        DxfPushCallback callback;
+                /*!< handler for the events. */
+        void *user_data;
+                /*!< data passed to the handler. */
+        int detected;
+                /*!< \c TRUE when it is known whether the data is a
+                 * binary DXF file. */
+        int done;
+                /*!< \c TRUE after \c DXF_EVENT_EOF or
+                 * \c DXF_EVENT_ERROR, or when the handler stopped the
+                 * parser. */
+        int error;
+                /*!< \c TRUE after \c DXF_EVENT_ERROR. */
+} DxfPushParser, * DxfPushParserPtr;
+
+
+DxfPushParser *
+dxf_push_parser_new
+(
+        DxfPushCallback callback,
+        void *user_data
+);
+int
+dxf_push_parser_feed
+(
+        DxfPushParser *parser,
+        const char *data,
+        size_t length
+);
+int
+dxf_push_parser_finish
+(
+        DxfPushParser *parser
+);
+void
+dxf_push_parser_free
+(
+        DxfPushParser *parser
+);
+
+
+#endif /* PUSH_H */
+
+
+/* EOF */
@@ -0,0 +1,345 @@
+/*!
+ * \file reader.c
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Functions for a DXF pull reader.
+ *
+ * The pull reader walks through a DXF file one event at a time, without
+ * building a document:\n
+ * <pre>
+ * reader = dxf_reader_open (filename);
+ * while (dxf_reader_next (reader, &event) > DXF_EVENT_EOF)
+ * {
+ *         ...
+ * }
+ * dxf_reader_close (reader);
+ * </pre>
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#include "reader.h"
+#include "util.h"
+
+
+/*!
+ * \brief The reader is outside of a section.
+ */
+#define DXF_READER_FILE 0
+
+/*!
+ * \brief The reader is inside of a section, outside of an entity.
+ */
+#define DXF_READER_SECTION 1
+
+/*!
+ * \brief The reader is inside of an entity.
+ */
+#define DXF_READER_ENTITY 2
+
+/*!
+ * \brief The reader has returned \c DXF_EVENT_EOF or
+ * \c DXF_EVENT_ERROR.
+ */
+#define DXF_READER_DONE 3
+
+
+/*!
+ * \brief Copies the value of a group into a string of
+ * \c DXF_MAX_STRING_LENGTH characters.
+ */
+static void
+dxf_reader_copy
+(
+        char *string,
+                /*!< destination of the copy. */
+        const DxfGroup *group
+                /*!< group read with \c dxf_read_group. */
+)
+{
+        size_t length;
+
+        length = group->length;
+        if (length > DXF_MAX_STRING_LENGTH - 1)
+                length = DXF_MAX_STRING_LENGTH - 1;
+        memcpy (string, group->value, length);
+        string[length] = '\0';
+}
+
+
+/*!
+ * \brief Ends the reader with an error.
+ *
+ * \return \c DXF_EVENT_ERROR.
+ */
+static DxfReaderEventType
+dxf_reader_error
+(
+        DxfReader *reader,
+                /*!< DXF pull reader. */
+        DxfReaderEvent *event,
+                /*!< the event. */
+        const char *message
+                /*!< description of the error. */
+)
+{
+        fprintf (stderr, "Error in dxf_reader_next () %s while reading from: %s in line: %d.\n",
+                message, reader->fp->filename, reader->fp->line_number);
+        reader->state = DXF_READER_DONE;
+        reader->done = DXF_EVENT_ERROR;
+        event->type = DXF_EVENT_ERROR;
+        event->name = NULL;
+        return (DXF_EVENT_ERROR);
+}
+
+
+/*!
+ * \brief Takes the AutoCAD version number from the \c $ACADVER variable.
+ *
+ * \c $ACADVER is followed by a group "  1" with the value "AC10nn".
+ */
+static void
+dxf_reader_version
+(
+        DxfReader *reader,
+                /*!< DXF pull reader. */
+        const DxfGroup *group
+                /*!< group of the current section. */
+)
+{
+        DxfGroup version;
+
+        if (dxf_group_is (group, 9, "$ACADVER"))
+        {
+                reader->acadver = TRUE;
+                return;
+        }
+        if (reader->acadver && (group->code == 1) && (group->length > 2)
+                && (strncmp (group->value, "AC", 2) == 0))
+        {
+                version = *group;
+                version.value += 2;
+                version.length -= 2;
+                reader->acad_version_number = dxf_group_get_int (&version);
+        }
+        reader->acadver = FALSE;
+}
+
+
+/*!
+ * \brief Opens a DXF file for reading with \c dxf_reader_next.
+ *
+ * \return \c NULL when the file could not be opened or no memory was
+ * allocated, a pointer to the reader when succesful.
+ */
+DxfReader *
+dxf_reader_open
+(
+        const char *filename
+                /*!< filename of input file (or device). */
+)
+{
+        DxfFile *fp;
+
+        fp = dxf_read_init (filename);
+        if (!fp)
+                return (NULL);
+        return (dxf_reader_open_file (fp));
+}
+
+
+/*!
+ * \brief Opens a reader for \c dxf_reader_next on a DxfFile which is
+ * open already, for example one from \c dxf_read_memory.
+ *
+ * The reader takes \c fp over, it is closed by \c dxf_reader_close (or
+ * here when an error occurs).
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the reader
+ * when succesful.
+ */
+DxfReader *
+dxf_reader_open_file
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_reader_open_file () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfReader *reader;
+
+        if (!fp)
+                return (NULL);
+        reader = malloc (sizeof (DxfReader));
+        if (!reader)
+        {
+                fprintf (stderr, "Error in dxf_reader_open_file () could not allocate memory for a DxfReader struct.\n");
+                dxf_read_close (fp);
+                return (NULL);
+        }
+        memset (reader, 0, sizeof (DxfReader));
+        reader->fp = fp;
+        reader->state = DXF_READER_FILE;
+        reader->acad_version_number = AutoCAD_12;
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_reader_open_file () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (reader);
+}
+
+
+/*!
+ * \brief Reads the next event from a DXF file.
+ *
+ * Sections are reported with a \c DXF_EVENT_SECTION_BEGIN and a
+ * \c DXF_EVENT_SECTION_END event, every "  0" group inside of a section
+ * with a \c DXF_EVENT_ENTITY_BEGIN and a \c DXF_EVENT_ENTITY_END event,
+ * all other groups with a \c DXF_EVENT_GROUP event.\n
+ * Comments (group code 999) are reported as groups.\n
+ * The AutoCAD version number is kept in \c acad_version_number.
+ *
+ * \return the type of the event, \c DXF_EVENT_EOF at the end of the
+ * file and \c DXF_EVENT_ERROR when an error occurred, both are returned
+ * again by subsequent calls.
+ */
+DxfReaderEventType
+dxf_reader_next
+(
+        DxfReader *reader,
+                /*!< DXF pull reader. */
+        DxfReaderEvent *event
+                /*!< the event read. */
+)
+{
+        DxfFile *fp = reader->fp;
+        DxfGroup *group = &event->group;
+
+        if (reader->state == DXF_READER_DONE)
+        {
+                event->type = reader->done;
+                event->name = NULL;
+                return (reader->done);
+        }
+        if (!dxf_read_group (fp, group))
+        {
+                if (!dxf_read_eof (fp))
+                        return (dxf_reader_error (reader, event, "invalid group"));
+                if (reader->state != DXF_READER_FILE)
+                        return (dxf_reader_error (reader, event, "unexpected end of file"));
+                /* A missing EOF marker is tolerated. */
+                reader->state = DXF_READER_DONE;
+                reader->done = DXF_EVENT_EOF;
+                event->type = DXF_EVENT_EOF;
+                event->name = NULL;
+                return (DXF_EVENT_EOF);
+        }
+        event->name = NULL;
+        switch (reader->state)
+        {
+                case DXF_READER_ENTITY:
+                        if (group->code != 0)
+                                break;
+                        /* The "  0" group belongs to the next entity. */
+                        dxf_read_unread_group (fp);
+                        reader->state = DXF_READER_SECTION;
+                        event->type = DXF_EVENT_ENTITY_END;
+                        event->name = reader->entity;
+                        return (DXF_EVENT_ENTITY_END);
+                case DXF_READER_SECTION:
+                        if (group->code != 0)
+                        {
+                                dxf_reader_version (reader, group);
+                                break;
+                        }
+                        if (dxf_group_is (group, 0, "ENDSEC"))
+                        {
+                                reader->state = DXF_READER_FILE;
+                                event->type = DXF_EVENT_SECTION_END;
+                                event->name = reader->section;
+                                return (DXF_EVENT_SECTION_END);
+                        }
+                        dxf_reader_copy (reader->entity, group);
+                        reader->state = DXF_READER_ENTITY;
+                        event->type = DXF_EVENT_ENTITY_BEGIN;
+                        event->name = reader->entity;
+                        return (DXF_EVENT_ENTITY_BEGIN);
+                case DXF_READER_FILE:
+                default:
+                        if (group->code == 999)
+                                break;
+                        if (dxf_group_is (group, 0, "EOF"))
+                        {
+                                reader->state = DXF_READER_DONE;
+                                reader->done = DXF_EVENT_EOF;
+                                event->type = DXF_EVENT_EOF;
+                                return (DXF_EVENT_EOF);
+                        }
+                        if (!dxf_group_is (group, 0, "SECTION"))
+                                return (dxf_reader_error (reader, event, "\"SECTION\" expected"));
+                        if (!dxf_read_group (fp, group) || (group->code != 2))
+                                return (dxf_reader_error (reader, event, "section name expected"));
+                        dxf_reader_copy (reader->section, group);
+                        reader->state = DXF_READER_SECTION;
+                        event->type = DXF_EVENT_SECTION_BEGIN;
+                        event->name = reader->section;
+                        return (DXF_EVENT_SECTION_BEGIN);
+        }
+        event->type = DXF_EVENT_GROUP;
+        return (DXF_EVENT_GROUP);
+}
+
+
+/*!
+ * \brief Closes a DXF pull reader and the file it reads from.
+ */
+void
+dxf_reader_close
+(
+        DxfReader *reader
+                /*!< DXF pull reader. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_reader_close () function.\n",
+                __FILE__, __LINE__);
+#endif
+        if (reader)
+        {
+                dxf_read_close (reader->fp);
+                free (reader);
+        }
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_reader_close () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
+/* EOF */
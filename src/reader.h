@@ -0,0 +1,147 @@
+/*!
+ * \file reader.h
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Definition of a DXF pull reader.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifndef READER_H
+#define READER_H
+
+
+#include "global.h"
+
+
+/*!
+ * \brief Types of the events returned by \c dxf_reader_next.
+ */
+typedef enum
+dxf_reader_event_type
+{
+        DXF_EVENT_ERROR = -1,
+                /*!< the file could not be read, or is not a valid DXF
+                 * file. */
+        DXF_EVENT_EOF = 0,
+                /*!< the \c EOF marker (or the end of the file) was
+                 * reached. */
+        DXF_EVENT_SECTION_BEGIN,
+                /*!< a \c SECTION starts, \c name contains the name of
+                 * the section. */
+        DXF_EVENT_SECTION_END,
+                /*!< the \c ENDSEC marker of the section \c name was
+                 * read. */
+        DXF_EVENT_ENTITY_BEGIN,
+                /*!< a "  0" group starts an entity (or table, table
+                 * entry, block or object), \c name contains the type
+                 * name. */
+        DXF_EVENT_GROUP,
+                /*!< a group of the current entity, or of the current
+                 * section when outside an entity (for example the
+                 * variables in the \c HEADER section). */
+        DXF_EVENT_ENTITY_END
+                /*!< the entity \c name ends, the next "  0" group
+                 * follows. */
+} DxfReaderEventType;
+
+
+/*!
+ * \brief DXF definition of an event returned by \c dxf_reader_next.
+ *
+ * \c name and the value of \c group are only valid until the next call
+ * of \c dxf_reader_next.
+ */
+typedef struct
+dxf_reader_event
+{
+        DxfReaderEventType type;
+                /*!< type of the event. */
+        const char *name;
+                /*!< name of the section or entity, \c NULL for
+                 * \c DXF_EVENT_GROUP. */
+        DxfGroup group;
+                /*!< group for \c DXF_EVENT_GROUP, the "  0" (or
+                 * "  2") group for the other events. */
+} DxfReaderEvent, * DxfReaderEventPtr;
+
+
+/*!
+ * \brief DXF definition of a pull reader.
+ *
+ * The reader keeps no data of the entities read, memory use is
+ * constant regardless of the size of the file.
+ */
+typedef struct
+dxf_reader
+{
+        DxfFile *fp;
+                /*!< DXF file handle of input file (or device). */
+        int state;
+                /*!< position in the structure of the file. */
+        char section[DXF_MAX_STRING_LENGTH];
+                /*!< name of the current section. */
+        char entity[DXF_MAX_STRING_LENGTH];
+                /*!< name of the current entity. */
+        int acad_version_number;
+                /*!< AutoCAD version number, from the \c $ACADVER
+                 * variable in the \c HEADER section (\c AutoCAD_12 when
+                 * the file has no header). */
+        int acadver;
+                /*!< \c TRUE when the last group was \c $ACADVER. */
+        DxfReaderEventType done;
+                /*!< \c DXF_EVENT_EOF or \c DXF_EVENT_ERROR, the event
+                 * returned again once the reader is done. */
+} DxfReader, * DxfReaderPtr;
+
+
+DxfReader *
+dxf_reader_open
+(
+        const char *filename
+);
+DxfReader *
+dxf_reader_open_file
+(
+        DxfFile *fp
+);
+DxfReaderEventType
+dxf_reader_next
+(
+        DxfReader *reader,
+        DxfReaderEvent *event
+);
+void
+dxf_reader_close
+(
+        DxfReader *reader
+);
+
+
+#endif /* READER_H */
+
+
+/* EOF */
@@ -0,0 +1,296 @@
+/*!
+ * \file scan.c
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Line boundary scanner for ASCII DXF files.
+ *
+ * The line ends of a buffer are located in bulk, with SSE2 or AVX2
+ * instructions when the processor supports them (detected at run
+ * time), and with \c memchr otherwise.\n
+ * Carriage returns (CRLF files), padding and trailing white space are
+ * left in the lines, these are stripped by the consumer of the line
+ * ends (see \c dxf_read_next_line).
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "libdxf.h"
+#endif
+#include "scan.h"
+
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+#define DXF_SCAN_X86 1
+#include <immintrin.h>
+#else
+#define DXF_SCAN_X86 0
+#endif
+
+
+/*!
+ * \brief Signature of a line boundary scanner, see \c dxf_scan_lines.
+ */
+typedef size_t (*DxfScanFunction)
+(
+        const char *buffer,
+        size_t start,
+        size_t end,
+        size_t *lines,
+        size_t max,
+        size_t *scanned
+);
+
+
+/*!
+ * \brief Scalar line boundary scanner.
+ */
+static size_t
+dxf_scan_lines_scalar
+(
+        const char *buffer,
+        size_t start,
+        size_t end,
+        size_t *lines,
+        size_t max,
+        size_t *scanned
+)
+{
+        const char *p;
+        size_t count = 0;
+
+        while ((count < max) && (start < end))
+        {
+                p = memchr (buffer + start, '\n', end - start);
+                if (!p)
+                {
+                        start = end;
+                        break;
+                }
+                lines[count++] = (size_t) (p - buffer);
+                start = (size_t) (p - buffer) + 1;
+        }
+        *scanned = start;
+        return (count);
+}
+
+
+#if DXF_SCAN_X86
+/*!
+ * \brief Stores the line ends flagged in the bit \c mask of the block of
+ * \c width bytes at \c offset.
+ *
+ * \return the number of line ends in \c lines.
+ */
+static inline size_t
+dxf_scan_store_mask
+(
+        unsigned int mask,
+                /*!< one bit for every '\n' in the block. */
+        size_t offset,
+                /*!< offset of the block in the buffer. */
+        size_t width,
+                /*!< number of bytes in the block. */
+        size_t *lines,
+                /*!< array to store the offsets of the line ends in. */
+        size_t count,
+                /*!< number of line ends already in \c lines. */
+        size_t max,
+                /*!< size of \c lines. */
+        size_t *scanned
+                /*!< offset up to which the buffer was scanned. */
+)
+{
+        while (mask)
+        {
+                if (count == max)
+                {
+                        /* Continue after the last line end stored. */
+                        *scanned = lines[count - 1] + 1;
+                        return (count);
+                }
+                lines[count++] = offset + (size_t) __builtin_ctz (mask);
+                mask &= mask - 1;
+        }
+        *scanned = offset + width;
+        return (count);
+}
+
+
+/*!
+ * \brief SSE2 line boundary scanner, 16 bytes per step.
+ */
+__attribute__ ((target ("sse2")))
+static size_t
+dxf_scan_lines_sse2
+(
+        const char *buffer,
+        size_t start,
+        size_t end,
+        size_t *lines,
+        size_t max,
+        size_t *scanned
+)
+{
+        const __m128i newline = _mm_set1_epi8 ('\n');
+        __m128i block;
+        unsigned int mask;
+        size_t count = 0;
+        size_t tail;
+
+        while ((start + 16 <= end) && (count < max))
+        {
+                block = _mm_loadu_si128 ((const __m128i *) (buffer + start));
+                mask = (unsigned int) _mm_movemask_epi8 (_mm_cmpeq_epi8 (block, newline));
+                count = dxf_scan_store_mask (mask, start, 16, lines, count,
+                        max, &start);
+        }
+        if (count < max)
+        {
+                count += dxf_scan_lines_scalar (buffer, start, end,
+                        lines + count, max - count, &tail);
+                start = tail;
+        }
+        *scanned = start;
+        return (count);
+}
+
+
+/*!
+ * \brief AVX2 line boundary scanner, 32 bytes per step.
+ */
+__attribute__ ((target ("avx2")))
+static size_t
+dxf_scan_lines_avx2
+(
+        const char *buffer,
+        size_t start,
+        size_t end,
+        size_t *lines,
+        size_t max,
+        size_t *scanned
+)
+{
+        const __m256i newline = _mm256_set1_epi8 ('\n');
+        __m256i block;
+        unsigned int mask;
+        size_t count = 0;
+        size_t tail;
+
+        while ((start + 32 <= end) && (count < max))
+        {
+                block = _mm256_loadu_si256 ((const __m256i *) (buffer + start));
+                mask = (unsigned int) _mm256_movemask_epi8 (_mm256_cmpeq_epi8 (block, newline));
+                count = dxf_scan_store_mask (mask, start, 32, lines, count,
+                        max, &start);
+        }
+        if (count < max)
+        {
+                count += dxf_scan_lines_sse2 (buffer, start, end,
+                        lines + count, max - count, &tail);
+                start = tail;
+        }
+        *scanned = start;
+        return (count);
+}
+#endif
+
+
+/*!
+ * \brief Selects the fastest line boundary scanner supported by the
+ * processor.
+ */
+static DxfScanFunction
+dxf_scan_select (void)
+{
+#if DXF_SCAN_X86
+        __builtin_cpu_init ();
+        if (__builtin_cpu_supports ("avx2"))
+                return (dxf_scan_lines_avx2);
+        if (__builtin_cpu_supports ("sse2"))
+                return (dxf_scan_lines_sse2);
+#endif
+        return (dxf_scan_lines_scalar);
+}
+
+
+/*!
+ * \brief Locates the line ends ('\\n') in \c buffer from offset
+ * \c start up to offset \c end.
+ *
+ * The offsets of at most \c max line ends are stored in \c lines, in
+ * increasing order.\n
+ * \c scanned is set to the offset up to which all line ends are stored
+ * in \c lines, the scan is continued from there: \c end, or less when
+ * \c lines is full.
+ *
+ * \return the number of line ends stored in \c lines.
+ */
+size_t
+dxf_scan_lines
+(
+        const char *buffer,
+                /*!< the buffer to scan. */
+        size_t start,
+                /*!< offset of the first byte to scan. */
+        size_t end,
+                /*!< offset of the byte after the last byte to scan. */
+        size_t *lines,
+                /*!< array to store the offsets of the line ends in. */
+        size_t max,
+                /*!< size of \c lines. */
+        size_t *scanned
+                /*!< offset up to which the buffer was scanned. */
+)
+{
+        static DxfScanFunction scan = NULL;
+
+        if (!scan)
+                scan = dxf_scan_select ();
+        return (scan (buffer, start, end, lines, max, scanned));
+}
+
+
+/*!
+ * \brief Names the line boundary scanner used by \c dxf_scan_lines.
+ *
+ * \return "avx2", "sse2" or "scalar".
+ */
+const char *
+dxf_scan_name (void)
+{
+#if DXF_SCAN_X86
+        DxfScanFunction scan = dxf_scan_select ();
+
+        if (scan == dxf_scan_lines_avx2)
+                return ("avx2");
+        if (scan == dxf_scan_lines_sse2)
+                return ("sse2");
+#endif
+        return ("scalar");
+}
+
+
+/* EOF */
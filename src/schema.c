@@ -0,0 +1,236 @@
+/*!
+ * \file schema.c
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Functions for decoding DXF groups through a schema.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#include "schema.h"
+#include "util.h"
+
+
+/*!
+ * \brief Stores the value of a group as a string in \c member.
+ *
+ * The previous string is freed, unless the strings of \c fp are
+ * borrowed or stored in an arena (see \c dxf_read_string).
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * was allocated.
+ */
+int
+dxf_schema_store_string
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        char **member,
+                /*!< the string member of the entity. */
+        const DxfGroup *group
+                /*!< group read from \c fp. */
+)
+{
+        char *string;
+
+        string = dxf_read_string (fp, group);
+        if (!string)
+                return (EXIT_FAILURE);
+        if (!fp->borrow_strings && !fp->arena)
+                free (*member);
+        *member = string;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Stores the value of a group as a name in \c member (see
+ * \c dxf_read_name).
+ *
+ * The previous name is not freed, names are interned or borrowed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * was allocated.
+ */
+int
+dxf_schema_store_name
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        char **member,
+                /*!< the name member of the entity. */
+        const DxfGroup *group
+                /*!< group read from \c fp. */
+)
+{
+        char *string;
+
+        string = dxf_read_name (fp, group);
+        if (!string)
+                return (EXIT_FAILURE);
+        *member = string;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Store the value of \c group in \c entity as described by the
+ * schema entry \c field.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_schema_store
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        const DxfSchemaField *field,
+                /*!< schema entry for the group code of \c group. */
+        DxfGroup *group,
+                /*!< group read from \c fp. */
+        void *entity,
+                /*!< DXF entity to store the value in. */
+        int acad_version_number
+                /*!< AutoCAD version number. */
+)
+{
+        char *member = (char *) entity + field->offset;
+
+        switch (field->type)
+        {
+                case DXF_FIELD_IGNORE:
+                        break;
+                case DXF_FIELD_COMMENT:
+                        fprintf (stdout, "DXF comment: %.*s\n",
+                                (int) group->length, group->value);
+                        break;
+                case DXF_FIELD_INT:
+                        *(int *) member = dxf_group_get_int (group);
+                        break;
+                case DXF_FIELD_HEX:
+                        fp->handle = dxf_group_get_handle (group);
+                        *(int *) member = (int) (uint32_t) fp->handle;
+                        break;
+                case DXF_FIELD_DOUBLE:
+                        *(double *) member = dxf_group_get_double (group);
+                        break;
+                case DXF_FIELD_ELEVATION:
+                        /* Elevation is a pre AutoCAD R11 variable. */
+                        if (acad_version_number <= AutoCAD_11)
+                                *(double *) member = dxf_group_get_double (group);
+                        break;
+                case DXF_FIELD_STRING:
+                        return (dxf_schema_store_string (fp, (char **) member, group));
+                case DXF_FIELD_NAME:
+                        return (dxf_schema_store_name (fp, (char **) member, group));
+                case DXF_FIELD_UNKNOWN:
+                default:
+                        fprintf (stderr, "Warning: unknown group code %d found while reading from: %s in line: %d.\n",
+                                group->code, fp->filename, fp->line_number);
+                        break;
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read the groups of an entity from a DXF file into \c entity.
+ *
+ * The last line read from file contained the name of the entity.\n
+ * Now follows the data of the entity, to be terminated with a "  0"
+ * group code announcing the following entity, or the end of the section
+ * marker \c ENDSEC.\n
+ * This group is pushed back into \c fp, so the caller can read the name
+ * of the following entity.\n
+ * Every group code is decoded with a single lookup in \c schema, group
+ * codes with the type \c DXF_FIELD_CUSTOM are handed to \c hook.\n
+ * The handle of the entity is left in \c fp->handle, 0 when the entity
+ * has none.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_schema_read
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        const DxfSchemaField *schema,
+                /*!< schema of the entity, \c DXF_SCHEMA_SIZE entries. */
+        void *entity,
+                /*!< DXF entity to store the values in. */
+        DxfSchemaHook hook,
+                /*!< hook for \c DXF_FIELD_CUSTOM group codes, or
+                 * \c NULL. */
+        const char *entity_name,
+                /*!< name of the entity, used in messages. */
+        int acad_version_number
+                /*!< AutoCAD version number. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_schema_read () function.\n",
+                __FILE__, __LINE__);
+#endif
+        static const DxfSchemaField unknown = DXF_SCHEMA_TYPE (DXF_FIELD_UNKNOWN);
+        const DxfSchemaField *field;
+        DxfGroup group;
+
+        fp->handle = 0;
+        while (dxf_read_group (fp, &group))
+        {
+                if (group.code == 0)
+                {
+                        dxf_read_unread_group (fp);
+#if DEBUG
+                        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_schema_read () function.\n",
+                                __FILE__, __LINE__);
+#endif
+                        return (EXIT_SUCCESS);
+                }
+                if ((group.code > 0) && (group.code <= DXF_GROUP_CODE_MAX))
+                        field = &schema[group.code];
+                else
+                        field = &unknown;
+                if (field->type == DXF_FIELD_CUSTOM)
+                {
+                        if (!hook || (hook (fp, &group, entity, acad_version_number) != EXIT_SUCCESS))
+                                return (EXIT_FAILURE);
+                }
+                else if (dxf_schema_store (fp, field, &group, entity,
+                        acad_version_number) != EXIT_SUCCESS)
+                {
+                        return (EXIT_FAILURE);
+                }
+        }
+        fprintf (stderr, "Error in dxf_schema_read () unexpected end of the %s entity while reading from: %s in line: %d.\n",
+                entity_name, fp->filename, fp->line_number);
+        return (EXIT_FAILURE);
+}
+
+
+/* EOF */
@@ -0,0 +1,187 @@
+/*!
+ * \file schema.h
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Definition of group code schemas for DXF entities.
+ *
+ * A schema is a table indexed by group code, every entry tells the
+ * type of the value and the offset of the member of the entity struct
+ * where the value is to be stored.\n
+ * All entity readers share \c dxf_schema_read, so decoding a group is a
+ * single indexed lookup instead of a chain of string compares.\n
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifndef SCHEMA_H
+#define SCHEMA_H
+
+
+#include <stddef.h>
+#include "global.h"
+
+
+/*!
+ * \brief The highest group code in a DXF file.
+ */
+#define DXF_GROUP_CODE_MAX 1071
+
+/*!
+ * \brief The number of entries in a schema (group codes 0 up to and
+ * including \c DXF_GROUP_CODE_MAX).
+ */
+#define DXF_SCHEMA_SIZE (DXF_GROUP_CODE_MAX + 1)
+
+
+/*!
+ * \brief Types of the values stored by a schema.
+ */
+typedef enum
+dxf_field_type
+{
+        DXF_FIELD_UNKNOWN = 0,
+                /*!< group code is not known for this entity, a warning
+                 * is printed. */
+        DXF_FIELD_IGNORE,
+                /*!< group code is known, but the value is not stored
+                 * (for example subclass markers). */
+        DXF_FIELD_COMMENT,
+                /*!< value is a comment, printed on stdout. */
+        DXF_FIELD_INT,
+                /*!< value is stored in an \c int. */
+        DXF_FIELD_HEX,
+                /*!< hexadecimal value (handle) is stored in an \c int,
+                 * all 64 bits of it in \c handle of the \c DxfFile. */
+        DXF_FIELD_DOUBLE,
+                /*!< value is stored in a \c double. */
+        DXF_FIELD_ELEVATION,
+                /*!< value is stored in a \c double, for AutoCAD R11 and
+                 * older only. */
+        DXF_FIELD_STRING,
+                /*!< value is stored as a newly allocated \c char *, the
+                 * previous string is freed. */
+        DXF_FIELD_NAME,
+                /*!< name of a layer, linetype, text style or block,
+                 * stored like \c DXF_FIELD_STRING, but interned when the
+                 * entity is read into an arena. */
+        DXF_FIELD_CUSTOM
+                /*!< value is handed to the hook of the entity reader. */
+} DxfFieldType;
+
+
+/*!
+ * \brief DXF definition of a schema entry.
+ */
+typedef struct
+dxf_schema_field
+{
+        unsigned int type : 8;
+                /*!< a \c DxfFieldType. */
+        unsigned int offset : 24;
+                /*!< offset of the member in the entity struct. */
+} DxfSchemaField, * DxfSchemaFieldPtr;
+
+
+/*!
+ * \brief Hook for group codes with the type \c DXF_FIELD_CUSTOM.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+typedef int (*DxfSchemaHook)
+(
+        DxfFile *fp,
+        DxfGroup *group,
+        void *entity,
+        int acad_version_number
+);
+
+
+/*!
+ * \brief Initializer of a schema entry for \c member of \c structure.
+ */
+#define DXF_SCHEMA_FIELD(type, structure, member) \
+        { (type), offsetof (structure, member) }
+
+/*!
+ * \brief Initializer of a schema entry without a member.
+ */
+#define DXF_SCHEMA_TYPE(type) { (type), 0 }
+
+/*!
+ * \brief Initializers of the schema entries for the common properties
+ * of an entity (\c DxfEntity member \c common of \c structure).
+ */
+#define DXF_SCHEMA_ENTITY_COMMON(structure) \
+        [5] = DXF_SCHEMA_FIELD (DXF_FIELD_HEX, structure, common.id_code), \
+        [6] = DXF_SCHEMA_FIELD (DXF_FIELD_NAME, structure, common.linetype), \
+        [8] = DXF_SCHEMA_FIELD (DXF_FIELD_NAME, structure, common.layer), \
+        [39] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, structure, common.thickness), \
+        [62] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, structure, common.color), \
+        [67] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, structure, common.paperspace), \
+        [100] = DXF_SCHEMA_TYPE (DXF_FIELD_IGNORE), \
+        [999] = DXF_SCHEMA_TYPE (DXF_FIELD_COMMENT)
+
+
+int
+dxf_schema_read
+(
+        DxfFile *fp,
+        const DxfSchemaField *schema,
+        void *entity,
+        DxfSchemaHook hook,
+        const char *entity_name,
+        int acad_version_number
+);
+int
+dxf_schema_store_string
+(
+        DxfFile *fp,
+        char **member,
+        const DxfGroup *group
+);
+int
+dxf_schema_store_name
+(
+        DxfFile *fp,
+        char **member,
+        const DxfGroup *group
+);
+int
+dxf_schema_store
+(
+        DxfFile *fp,
+        const DxfSchemaField *field,
+        DxfGroup *group,
+        void *entity,
+        int acad_version_number
+);
+
+
+#endif /* SCHEMA_H */
+
+
+/* EOF */
@@ -34,6 +34,8 @@
 #include "header.h"
 #include "util.h"
 #include "block.h"
+#include "scan.h"
+#include "writer.h"
 
 
 /*!
@@ -56,7 +58,7 @@ dxf_section_read
         dxf_read_line (temp_string, fp);
         if (strcmp (temp_string, "2") == 0)
         {
-                while (!feof (fp->fp))
+                while (!dxf_read_eof (fp))
                 {
                         dxf_read_line (temp_string, fp);
                         if (strcmp (temp_string, "HEADER") == 0)
@@ -118,20 +120,319 @@ dxf_section_read
 }
 
 
+/*!
+ * \brief Adds a section to the sections of a DXF file.
+ *
+ * \return a pointer to the section, or \c NULL when no memory was
+ * allocated.
+ */
+static DxfSectionRange *
+dxf_section_index_add
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        size_t *size
+                /*!< allocated number of sections. */
+)
+{
+        DxfSectionRange *sections;
+        DxfSectionRange *section;
+
+        if (fp->section_count == (int) *size)
+        {
+                *size = *size ? 2 * *size : 8;
+                sections = realloc (fp->sections, *size * sizeof (DxfSectionRange));
+                if (!sections)
+                {
+                        fprintf (stderr, "Error in dxf_section_index () could not allocate memory for the sections.\n");
+                        return (NULL);
+                }
+                fp->sections = sections;
+        }
+        section = &fp->sections[fp->section_count++];
+        memset (section, 0, sizeof (DxfSectionRange));
+        return (section);
+}
+
+
+/*!
+ * \brief Records the location of every section of a binary DXF file.
+ *
+ * The groups are read with \c dxf_read_group, afterwards the position of
+ * \c fp is restored.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_section_index_binary
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+        DxfSectionRange *section = NULL;
+        DxfGroup group;
+        size_t size = 0;
+        size_t position = fp->buffer_position;
+        size_t offset;
+        int line_number = fp->line_number;
+        int ret = EXIT_SUCCESS;
+
+        /* A loaded buffer starts at the last group read. */
+        if (memcmp (fp->buffer, DXF_BINARY_SENTINEL, DXF_BINARY_SENTINEL_LENGTH) == 0)
+                ret = dxf_read_seek (fp, DXF_BINARY_SENTINEL_LENGTH, 0);
+        else
+                ret = dxf_read_seek (fp, 0,
+                        (fp->mapped || fp->borrowed || fp->memory)
+                        ? 0 : fp->mark_line_number);
+        offset = fp->buffer_position;
+        while ((ret == EXIT_SUCCESS) && dxf_read_group (fp, &group))
+        {
+                if (dxf_group_is (&group, 0, "SECTION"))
+                {
+                        if (section)
+                                section->end = offset;
+                        section = dxf_section_index_add (fp, &size);
+                        if (!section)
+                        {
+                                ret = EXIT_FAILURE;
+                                break;
+                        }
+                        section->start = offset;
+                        section->end = fp->buffer_length;
+                        if (dxf_read_group (fp, &group) && (group.code == 2))
+                                snprintf (section->name, DXF_MAX_SECTION_NAME_LENGTH,
+                                        "%.*s", (int) group.length, group.value);
+                        else
+                                dxf_read_unread_group (fp);
+                        section->body = fp->buffer_position;
+                        section->line_number = fp->line_number;
+                }
+                else if (section && dxf_group_is (&group, 0, "ENDSEC"))
+                {
+                        section->end = offset;
+                        section = NULL;
+                }
+                else if (dxf_group_is (&group, 0, "EOF"))
+                        break;
+                offset = fp->buffer_position;
+        }
+        dxf_read_seek (fp, position, line_number);
+        return (ret);
+}
+
+
+/*!
+ * \brief Records the location of every section of a DXF file.
+ *
+ * The lines of the file are visited once, in pairs of a group code and
+ * a value, without parsing the groups of the sections (the groups of a
+ * binary DXF file are skipped by their size). For every
+ * \c SECTION marker the name and the offsets of the markers are stored in
+ * the \c sections of \c fp, in file order.\n
+ * A file which is not memory mapped is read into memory first, see
+ * \c dxf_read_load.\n
+ * A section can then be read with \c dxf_section_seek, or handed to
+ * another thread with \c dxf_read_view.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_section_index
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_section_index () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfSectionRange *section = NULL;
+        size_t *lines;
+        size_t size = 0;
+        size_t count, scanned, offset, end, code_offset, i, n;
+        const char *line;
+        size_t length;
+        int line_number;
+        int code = -1;
+        int value_line = FALSE;
+        int name_expected = FALSE;
+        int done = FALSE;
+
+        if (dxf_read_load (fp) != EXIT_SUCCESS)
+        {
+                fprintf (stderr, "Error in dxf_section_index () could not read: %s.\n",
+                        fp->filename);
+                return (EXIT_FAILURE);
+        }
+        free (fp->sections);
+        fp->sections = NULL;
+        fp->section_count = 0;
+        if (fp->binary)
+                return (dxf_section_index_binary (fp));
+        lines = malloc (DXF_READ_LINES * sizeof (size_t));
+        if (!lines)
+        {
+                fprintf (stderr, "Error in dxf_section_index () could not allocate memory for the line ends.\n");
+                return (EXIT_FAILURE);
+        }
+        /* A loaded buffer starts at the last group read. */
+        line_number = (fp->mapped || fp->borrowed || fp->memory)
+                ? 0 : fp->mark_line_number;
+        offset = 0;
+        scanned = 0;
+        code_offset = 0;
+        while (!done && (offset < fp->buffer_length))
+        {
+                count = dxf_scan_lines (fp->buffer, scanned, fp->buffer_length,
+                        lines, DXF_READ_LINES, &scanned);
+                if (count == 0)
+                {
+                        /* Last line without a line terminator. */
+                        lines[0] = fp->buffer_length;
+                        count = 1;
+                }
+                for (i = 0; (i < count) && !done; i++)
+                {
+                        line = fp->buffer + offset;
+                        length = lines[i] - offset;
+                        end = (lines[i] < fp->buffer_length) ? lines[i] + 1
+                                : fp->buffer_length;
+                        line_number++;
+                        if (!value_line)
+                        {
+                                /* Only the group codes 0 and 2 matter. */
+                                code_offset = offset;
+                                code = dxf_line_is (line, length, "0") ? 0
+                                        : dxf_line_is (line, length, "2") ? 2 : -1;
+                        }
+                        else if (code == 0)
+                        {
+                                name_expected = FALSE;
+                                if (dxf_line_is (line, length, "SECTION"))
+                                {
+                                        if (section)
+                                                section->end = code_offset;
+                                        section = dxf_section_index_add (fp, &size);
+                                        if (!section)
+                                        {
+                                                free (lines);
+                                                return (EXIT_FAILURE);
+                                        }
+                                        section->start = code_offset;
+                                        section->body = end;
+                                        section->end = fp->buffer_length;
+                                        section->line_number = line_number;
+                                        name_expected = TRUE;
+                                }
+                                else if (section && dxf_line_is (line, length, "ENDSEC"))
+                                {
+                                        section->end = code_offset;
+                                        section = NULL;
+                                }
+                                else if (dxf_line_is (line, length, "EOF"))
+                                        done = TRUE;
+                        }
+                        else if (name_expected)
+                        {
+                                name_expected = FALSE;
+                                if (code == 2)
+                                {
+                                        while ((length > 0) && ((*line == ' ') || (*line == '\t')))
+                                        {
+                                                line++;
+                                                length--;
+                                        }
+                                        while ((length > 0) && isspace ((unsigned char) line[length - 1]))
+                                                length--;
+                                        n = (length < DXF_MAX_SECTION_NAME_LENGTH)
+                                                ? length : DXF_MAX_SECTION_NAME_LENGTH - 1;
+                                        memcpy (section->name, line, n);
+                                        section->name[n] = '\0';
+                                        section->body = end;
+                                        section->line_number = line_number;
+                                }
+                        }
+                        value_line = !value_line;
+                        offset = end;
+                }
+        }
+        free (lines);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_section_index () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Finds a section recorded by \c dxf_section_index.
+ *
+ * \return a pointer to the first section named \c name, or \c NULL when
+ * the file has no such section.
+ */
+const DxfSectionRange *
+dxf_section_find
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        const char *name
+                /*!< name of the section, e.g. "ENTITIES". */
+)
+{
+        int i;
+
+        for (i = 0; i < fp->section_count; i++)
+        {
+                if (strcmp (fp->sections[i].name, name) == 0)
+                        return (&fp->sections[i]);
+        }
+        return (NULL);
+}
+
+
+/*!
+ * \brief Moves a DxfFile to the first group of a section recorded by
+ * \c dxf_section_index.
+ *
+ * The section is read until its \c ENDSEC marker, like after reading the
+ * name of the section in \c dxf_section_read.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_section_seek
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        const DxfSectionRange *section
+                /*!< the section. */
+)
+{
+        return (dxf_read_seek (fp, section->body, section->line_number));
+}
+
+
 /*!
  * \brief Write DXF output to a file for a section marker.
  */
 int
 dxf_section_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         char *section_name
 )
 {
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_section_write () function.\n", __FILE__, __LINE__);
 #endif
-        fprintf (fp, "  0\nSECTION\n  2\n%s\n", section_name);
+        dxf_write_group_string (fp, 0, "SECTION");
+        dxf_write_group_string (fp, 2, section_name);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_section_write () function.\n", __FILE__, __LINE__);
 #endif
@@ -145,13 +446,13 @@ dxf_section_write
 int
 dxf_section_write_endsection
 (
-        FILE *fp
+        DxfWriter *fp
 )
 {
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_write_endsection () function.\n", __FILE__, __LINE__);
 #endif
-        fprintf (fp, "  0\nENDSEC\n");
+        dxf_write_group_string (fp, 0, "ENDSEC");
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_endsection () function.\n", __FILE__, __LINE__);
 #endif
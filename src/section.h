@@ -33,10 +33,15 @@
 #ifndef SECTION_H
 #define SECTION_H
 
+#include "global.h"
+
 
 int dxf_section_read (DxfFile *fp);
-int dxf_section_write (FILE *fp, char *section_name);
-int dxf_section_write_endsection (FILE *fp);
+int dxf_section_index (DxfFile *fp);
+const DxfSectionRange *dxf_section_find (DxfFile *fp, const char *name);
+int dxf_section_seek (DxfFile *fp, const DxfSectionRange *section);
+int dxf_section_write (DxfWriter *fp, char *section_name);
+int dxf_section_write_endsection (DxfWriter *fp);
 
 
 #endif /* SECTION_H */
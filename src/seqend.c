@@ -31,6 +31,7 @@
 
 
 #include "seqend.h"
+#include "writer.h"
 
 
 /*!
@@ -50,15 +51,15 @@
 int
 dxf_seqend_write
 (
-        FILE *fp
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp
+                /*!< DXF file handle of output file (or device). */
 )
 {
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_seqend_write () function.\n",
                 __FILE__, __LINE__);
 #endif
-        fprintf (fp, "  0\nSEQEND\n");
+        dxf_write_group_string (fp, 0, "SEQEND");
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_seqend_write () function.\n",
                 __FILE__, __LINE__);
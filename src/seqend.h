@@ -59,7 +59,7 @@ dxf_seqend
 int
 dxf_seqend_write
 (
-        FILE *fp
+        DxfWriter *fp
 );
 
 
@@ -0,0 +1,579 @@
+/*!
+ * \file session.c
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Functions for a streaming DXF writer session.
+ *
+ * A session writes a DXF file section by section, entity by entity,
+ * with the memory of the buffer of a DxfWriter, so a drawing which does
+ * not fit in memory can be written.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "libdxf.h"
+#endif
+#include "session.h"
+#include "callback.h"
+#include "eof.h"
+#include "section.h"
+#include "strtod.h"
+#include "writer.h"
+#include "3dface.h"
+#include "arc.h"
+#include "circle.h"
+#include "ellipse.h"
+#include "insert.h"
+#include "line.h"
+#include "point.h"
+#include "solid.h"
+#include "text.h"
+#include "vertex.h"
+
+
+/*!
+ * \brief The value of \c $EXTMIN of a drawing without entities, and
+ * minus the value of \c $EXTMAX.
+ */
+#define DXF_SESSION_NO_EXTENTS 1.0e20
+
+
+/*!
+ * \brief Writes a group with a handle of \c DXF_SESSION_HANDLE_WIDTH
+ * digits.
+ */
+static void
+dxf_write_session_group_handle
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        int code,
+                /*!< group code. */
+        int handle
+                /*!< the handle. */
+)
+{
+        char value[DXF_SESSION_HANDLE_WIDTH + 1];
+
+        snprintf (value, sizeof (value), "%0*x", DXF_SESSION_HANDLE_WIDTH,
+                (unsigned int) handle);
+        dxf_write_group_string (fp, code, value);
+}
+
+
+/*!
+ * \brief Writes a group with a floating point value of a fixed size,
+ * \c DXF_SESSION_DOUBLE_WIDTH characters (right aligned) in an ASCII DXF
+ * file.
+ */
+static void
+dxf_write_session_group_double
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        int code,
+                /*!< group code. */
+        double value
+                /*!< the value. */
+)
+{
+        char number[DXF_DTOA_LENGTH];
+        char padded[DXF_DTOA_LENGTH];
+
+        if (fp->binary)
+        {
+                dxf_write_group_double (fp, code, value);
+                return;
+        }
+        dxf_dtoa_shortest (number, value);
+        snprintf (padded, sizeof (padded), "%*s", DXF_SESSION_DOUBLE_WIDTH,
+                number);
+        dxf_write_group_string (fp, code, padded);
+}
+
+
+/*!
+ * \brief Overwrites a placeholder group written at \c offset by
+ * \c dxf_write_session_group_handle or
+ * \c dxf_write_session_group_double.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the group
+ * could not be overwritten.
+ */
+static int
+dxf_write_session_patch
+(
+        DxfWriteSession *session,
+                /*!< the session. */
+        long offset,
+                /*!< offset of the group. */
+        int code,
+                /*!< group code. */
+        int handle,
+                /*!< the handle, for a \c $HANDSEED group. */
+        double value
+                /*!< the value, for other groups. */
+)
+{
+        DxfWriter *group;
+        int ret;
+
+        group = dxf_write_init_memory (session->fp->binary);
+        if (!group)
+                return (EXIT_FAILURE);
+        if (code == 5)
+                dxf_write_session_group_handle (group, code, handle);
+        else
+                dxf_write_session_group_double (group, code, value);
+        ret = dxf_write_patch (session->fp, offset, group->buffer,
+                group->buffer_length);
+        dxf_write_close (group);
+        return (ret);
+}
+
+
+/*!
+ * \brief Ends the section being written.
+ */
+static void
+dxf_write_session_end_section
+(
+        DxfWriteSession *session
+                /*!< the session. */
+)
+{
+        if (session->section != DXF_SESSION_DONE)
+                dxf_section_write_endsection (session->fp);
+}
+
+
+/*!
+ * \brief Begins a session and its \c HEADER section.
+ *
+ * The header variables \c $ACADVER, \c $HANDSEED, \c $EXTMIN and
+ * \c $EXTMAX are written, other header variables can be written with
+ * \c dxf_write_group_string and friends until the next section begins.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * session when succesful.
+ */
+DxfWriteSession *
+dxf_write_session_begin
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        int acad_version_number,
+                /*!< AutoCAD version number. */
+        int handle
+                /*!< first handle given to the entities of the session. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_write_session_begin () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfWriteSession *session;
+        int i;
+
+        if (!fp)
+        {
+                fprintf (stderr, "Error in dxf_write_session_begin () file handle is not initialised (NULL pointer).\n");
+                return (NULL);
+        }
+        session = malloc (sizeof (DxfWriteSession));
+        if (!session)
+        {
+                fprintf (stderr, "Error in dxf_write_session_begin () could not allocate memory for a DxfWriteSession struct.\n");
+                return (NULL);
+        }
+        memset (session, 0, sizeof (DxfWriteSession));
+        session->fp = fp;
+        session->acad_version_number = acad_version_number;
+        session->section = DXF_SESSION_HEADER;
+        session->handle = handle;
+        dxf_section_write (fp, "HEADER");
+        dxf_write_group_string (fp, 9, "$ACADVER");
+        dxf_write_group_string (fp, 1, (acad_version_number >= AutoCAD_2000) ? "AC1015"
+                : (acad_version_number >= AutoCAD_14) ? "AC1014"
+                : (acad_version_number >= AutoCAD_13) ? "AC1012" : "AC1009");
+        dxf_write_group_string (fp, 9, "$HANDSEED");
+        session->handseed_offset = dxf_write_tell (fp);
+        dxf_write_session_group_handle (fp, 5, handle);
+        dxf_write_group_string (fp, 9, "$EXTMIN");
+        for (i = 0; i < 3; i++)
+        {
+                session->extmin_offset[i] = dxf_write_tell (fp);
+                dxf_write_session_group_double (fp, 10 * (i + 1),
+                        DXF_SESSION_NO_EXTENTS);
+        }
+        dxf_write_group_string (fp, 9, "$EXTMAX");
+        for (i = 0; i < 3; i++)
+        {
+                session->extmax_offset[i] = dxf_write_tell (fp);
+                dxf_write_session_group_double (fp, 10 * (i + 1),
+                        -DXF_SESSION_NO_EXTENTS);
+        }
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_session_begin () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (session);
+}
+
+
+/*!
+ * \brief Ends the \c HEADER section and begins the \c TABLES section.
+ *
+ * The tables are written with \c dxf_write_table and friends.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the
+ * \c TABLES section can not follow the section being written.
+ */
+int
+dxf_write_session_begin_tables
+(
+        DxfWriteSession *session
+                /*!< the session. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_write_session_begin_tables () function.\n",
+                __FILE__, __LINE__);
+#endif
+        if (session->section != DXF_SESSION_HEADER)
+        {
+                fprintf (stderr, "Error in dxf_write_session_begin_tables () the TABLES section has to follow the HEADER section.\n");
+                return (EXIT_FAILURE);
+        }
+        dxf_write_session_end_section (session);
+        dxf_section_write (session->fp, "TABLES");
+        session->section = DXF_SESSION_TABLES;
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_session_begin_tables () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (session->fp->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Ends the \c HEADER or \c TABLES section and begins the
+ * \c ENTITIES section.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the
+ * \c ENTITIES section can not follow the section being written.
+ */
+int
+dxf_write_session_begin_entities
+(
+        DxfWriteSession *session
+                /*!< the session. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_write_session_begin_entities () function.\n",
+                __FILE__, __LINE__);
+#endif
+        if (session->section > DXF_SESSION_TABLES)
+        {
+                fprintf (stderr, "Error in dxf_write_session_begin_entities () the ENTITIES section is written already.\n");
+                return (EXIT_FAILURE);
+        }
+        dxf_write_session_end_section (session);
+        dxf_section_write (session->fp, "ENTITIES");
+        session->section = DXF_SESSION_ENTITIES;
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_session_begin_entities () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (session->fp->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Extends \c $EXTMIN and \c $EXTMAX of a session with a point.
+ *
+ * \c dxf_write_session_add extends the extents with the points of the
+ * entities it knows, other entities are added to the extents with this
+ * function.
+ */
+void
+dxf_write_session_extend
+(
+        DxfWriteSession *session,
+                /*!< the session. */
+        double x,
+                /*!< X-value of the point. */
+        double y,
+                /*!< Y-value of the point. */
+        double z
+                /*!< Z-value of the point. */
+)
+{
+        double point[3];
+        int i;
+
+        point[0] = x;
+        point[1] = y;
+        point[2] = z;
+        for (i = 0; i < 3; i++)
+        {
+                if (!session->extents || (point[i] < session->extmin[i]))
+                        session->extmin[i] = point[i];
+                if (!session->extents || (point[i] > session->extmax[i]))
+                        session->extmax[i] = point[i];
+        }
+        session->extents = TRUE;
+}
+
+
+/*!
+ * \brief Extends the extents of a session with a box around a center.
+ */
+static void
+dxf_write_session_extend_box
+(
+        DxfWriteSession *session,
+                /*!< the session. */
+        double x,
+                /*!< X-value of the center. */
+        double y,
+                /*!< Y-value of the center. */
+        double z,
+                /*!< Z-value of the center. */
+        double size
+                /*!< half of the size of the box. */
+)
+{
+        dxf_write_session_extend (session, x - size, y - size, z);
+        dxf_write_session_extend (session, x + size, y + size, z);
+}
+
+
+/*!
+ * \brief Writes an entity to the \c ENTITIES section of a session.
+ *
+ * An entity with an id-code of 0 gets the next free handle of the
+ * session.\n
+ * The extents of the session are extended with the points of \c LINE,
+ * \c POINT, \c CIRCLE, \c ARC, \c ELLIPSE, \c TEXT, \c INSERT,
+ * \c 3DFACE, \c SOLID and \c VERTEX entities (circles, arcs and ellipses
+ * with the box around their center, the extrusion direction is not
+ * applied), see \c dxf_write_session_extend for other entities.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the entity
+ * could not be written.
+ */
+int
+dxf_write_session_add
+(
+        DxfWriteSession *session,
+                /*!< the session. */
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity
+                /*!< the entity, for example a \c DxfLine for \c LINE. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_write_session_add () function.\n",
+                __FILE__, __LINE__);
+#endif
+        const DxfCallbackType *callback_type;
+        int *id_code;
+        double size;
+
+        if (session->section != DXF_SESSION_ENTITIES)
+        {
+                fprintf (stderr, "Error in dxf_write_session_add () the ENTITIES section is not begun.\n");
+                return (EXIT_FAILURE);
+        }
+        callback_type = dxf_callback_type_by_type (type);
+        if (!callback_type || !callback_type->write)
+        {
+                fprintf (stderr, "Error in dxf_write_session_add () entity type %d can not be written.\n",
+                        (int) type);
+                return (EXIT_FAILURE);
+        }
+        id_code = (int *) ((char *) entity + callback_type->id_code);
+        if (*id_code == 0)
+                *id_code = session->handle++;
+        else if (*id_code >= session->handle)
+                session->handle = *id_code + 1;
+        switch (type)
+        {
+                case LINE:
+                {
+                        DxfLine *line = entity;
+                        dxf_write_session_extend (session, line->x0, line->y0, line->z0);
+                        dxf_write_session_extend (session, line->x1, line->y1, line->z1);
+                        break;
+                }
+                case POINT:
+                {
+                        DxfPoint *point = entity;
+                        dxf_write_session_extend (session, point->x0, point->y0, point->z0);
+                        break;
+                }
+                case CIRCLE:
+                {
+                        DxfCircle *circle = entity;
+                        dxf_write_session_extend_box (session, circle->x0,
+                                circle->y0, circle->z0, circle->radius);
+                        break;
+                }
+                case ARC:
+                {
+                        DxfArc *arc = entity;
+                        dxf_write_session_extend_box (session, arc->x0,
+                                arc->y0, arc->z0, arc->radius);
+                        break;
+                }
+                case ELLIPSE:
+                {
+                        DxfEllipse *ellipse = entity;
+                        size = sqrt (ellipse->x1 * ellipse->x1
+                                + ellipse->y1 * ellipse->y1
+                                + ellipse->z1 * ellipse->z1);
+                        dxf_write_session_extend_box (session, ellipse->x0,
+                                ellipse->y0, ellipse->z0, size);
+                        break;
+                }
+                case TEXT:
+                {
+                        DxfText *text = entity;
+                        dxf_write_session_extend (session, text->x0, text->y0, text->z0);
+                        break;
+                }
+                case INSERT:
+                {
+                        DxfInsert *insert = entity;
+                        dxf_write_session_extend (session, insert->x0, insert->y0, insert->z0);
+                        break;
+                }
+                case FACE3D:
+                {
+                        Dxf3dface *face = entity;
+                        dxf_write_session_extend (session, face->x0, face->y0, face->z0);
+                        dxf_write_session_extend (session, face->x1, face->y1, face->z1);
+                        dxf_write_session_extend (session, face->x2, face->y2, face->z2);
+                        dxf_write_session_extend (session, face->x3, face->y3, face->z3);
+                        break;
+                }
+                case SOLID:
+                {
+                        DxfSolid *solid = entity;
+                        dxf_write_session_extend (session, solid->x0, solid->y0, solid->z0);
+                        dxf_write_session_extend (session, solid->x1, solid->y1, solid->z1);
+                        dxf_write_session_extend (session, solid->x2, solid->y2, solid->z2);
+                        dxf_write_session_extend (session, solid->x3, solid->y3, solid->z3);
+                        break;
+                }
+                case VERTEX:
+                {
+                        DxfVertex *vertex = entity;
+                        dxf_write_session_extend (session, vertex->x0, vertex->y0, vertex->z0);
+                        break;
+                }
+                default:
+                        break;
+        }
+        if (callback_type->write (session->fp, entity,
+                session->acad_version_number) != EXIT_SUCCESS)
+                return (EXIT_FAILURE);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_session_add () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (session->fp->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Ends the section being written, writes the \c EOF marker,
+ * overwrites the placeholders of \c $HANDSEED, \c $EXTMIN and
+ * \c $EXTMAX and frees the session.
+ *
+ * The DxfWriter is not closed.\n
+ * When the placeholders can not be overwritten (a compressed file or a
+ * pipe, of which the header is not in the buffer anymore) they stay.
+ * Stale extents only give a warning, but a \c $HANDSEED below the
+ * handles used would let an editor hand out the same handles again, so
+ * the file is reported as failed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred or \c $HANDSEED could not be overwritten.
+ */
+int
+dxf_write_session_finish
+(
+        DxfWriteSession *session
+                /*!< the session. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_write_session_finish () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfWriter *fp;
+        int handseed;
+        int patched = TRUE;
+        int i;
+
+        if (!session)
+                return (EXIT_FAILURE);
+        fp = session->fp;
+        dxf_write_session_end_section (session);
+        dxf_write_eof (fp);
+        session->section = DXF_SESSION_DONE;
+        handseed = (dxf_write_session_patch (session, session->handseed_offset,
+                5, session->handle, 0.0) == EXIT_SUCCESS);
+        for (i = 0; session->extents && (i < 3); i++)
+        {
+                if (dxf_write_session_patch (session, session->extmin_offset[i],
+                        10 * (i + 1), 0, session->extmin[i]) != EXIT_SUCCESS)
+                        patched = FALSE;
+                if (dxf_write_session_patch (session, session->extmax_offset[i],
+                        10 * (i + 1), 0, session->extmax[i]) != EXIT_SUCCESS)
+                        patched = FALSE;
+        }
+        if (!handseed && !fp->failed)
+                fprintf (stderr, "Error in dxf_write_session_finish () $HANDSEED could not be written to: %s.\n",
+                        fp->filename);
+        else if (!patched && !fp->failed)
+                fprintf (stderr, "Warning in dxf_write_session_finish () $EXTMIN and $EXTMAX could not be written to: %s.\n",
+                        fp->filename);
+        free (session);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_session_finish () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return ((fp->failed || !handseed) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/* EOF */
@@ -0,0 +1,148 @@
+/*!
+ * \file session.h
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Definition of a streaming DXF writer session.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifndef SESSION_H
+#define SESSION_H
+
+
+#include "global.h"
+#include "entity.h"
+
+
+/*!
+ * \brief Number of hexadecimal digits of the \c $HANDSEED written by a
+ * session.
+ */
+#define DXF_SESSION_HANDLE_WIDTH 16
+
+/*!
+ * \brief Number of characters of the \c $EXTMIN and \c $EXTMAX
+ * coordinates written by a session to an ASCII DXF file, the longest
+ * number written by \c dxf_dtoa_shortest.
+ */
+#define DXF_SESSION_DOUBLE_WIDTH 24
+
+
+/*!
+ * \brief Sections of a DXF file written by a session.
+ */
+typedef enum
+dxf_session_section
+{
+        DXF_SESSION_HEADER,
+                /*!< \c HEADER section. */
+        DXF_SESSION_TABLES,
+                /*!< \c TABLES section. */
+        DXF_SESSION_ENTITIES,
+                /*!< \c ENTITIES section. */
+        DXF_SESSION_DONE
+                /*!< all sections and the \c EOF marker are written. */
+} DxfSessionSection;
+
+
+/*!
+ * \brief DXF definition of a streaming writer session.
+ *
+ * The groups are written as they come through the buffer of \c fp, the
+ * header variables which are only known at the end (\c $HANDSEED,
+ * \c $EXTMIN and \c $EXTMAX) are written as placeholders of a fixed
+ * size and overwritten by \c dxf_write_session_finish.
+ */
+typedef struct
+dxf_write_session
+{
+        DxfWriter *fp;
+                /*!< DXF file handle of output file (or device). */
+        int acad_version_number;
+                /*!< AutoCAD version number. */
+        DxfSessionSection section;
+                /*!< the section being written. */
+        int handle;
+                /*!< next free handle. */
+        int extents;
+                /*!< \c TRUE when \c extmin and \c extmax hold a point. */
+        double extmin[3];
+                /*!< lowest X, Y and Z of the entities written. */
+        double extmax[3];
+                /*!< highest X, Y and Z of the entities written. */
+        long handseed_offset;
+                /*!< offset of the \c $HANDSEED value group. */
+        long extmin_offset[3];
+                /*!< offsets of the \c $EXTMIN value groups. */
+        long extmax_offset[3];
+                /*!< offsets of the \c $EXTMAX value groups. */
+} DxfWriteSession, * DxfWriteSessionPtr;
+
+
+DxfWriteSession *
+dxf_write_session_begin
+(
+        DxfWriter *fp,
+        int acad_version_number,
+        int handle
+);
+int
+dxf_write_session_begin_tables
+(
+        DxfWriteSession *session
+);
+int
+dxf_write_session_begin_entities
+(
+        DxfWriteSession *session
+);
+int
+dxf_write_session_add
+(
+        DxfWriteSession *session,
+        DxfEntityType type,
+        void *entity
+);
+void
+dxf_write_session_extend
+(
+        DxfWriteSession *session,
+        double x,
+        double y,
+        double z
+);
+int
+dxf_write_session_finish
+(
+        DxfWriteSession *session
+);
+
+
+#endif /* SESSION_H */
+
+
+/* EOF */
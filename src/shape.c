@@ -31,12 +31,25 @@
 
 
 #include "shape.h"
+#include "arena.h"
+#include "pool.h"
+#include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_shape_new are handed out by.
+ */
+static DxfPool dxf_shape_pool = DXF_POOL_INITIALIZER (sizeof (DxfShape));
 
 
 /*!
  * \brief Allocate memory for a \c DxfShape.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_shape_free.
  */
 DxfShape *
 dxf_shape_new ()
@@ -46,32 +59,97 @@ dxf_shape_new ()
                 __FILE__, __LINE__);
 #endif
         DxfShape *dxf_shape = NULL;
-        size_t size;
 
-        size = sizeof (DxfShape);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_shape = malloc (size)) == NULL)
+        if ((dxf_shape = dxf_pool_alloc (&dxf_shape_pool)) == NULL)
         {
                 fprintf (stderr, "ERROR in dxf_shape_new () could not allocate memory for a DxfShape struct.\n");
-                dxf_shape = NULL;
         }
-        else
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_shape_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_shape);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfShape from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_shape_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfShape *
+dxf_shape_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_shape_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfShape *dxf_shape = NULL;
+
+        if (arena == NULL)
         {
-                memset (dxf_shape, 0, size);
+                dxf_shape = dxf_shape_new ();
+        }
+        else if ((dxf_shape = dxf_arena_alloc (arena, sizeof (DxfShape))) == NULL)
+        {
+                fprintf (stderr, "ERROR in dxf_shape_new_arena () could not allocate memory for a DxfShape struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_shape_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_shape_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_shape);
 }
 
 
+/*!
+ * \brief Release a \c DxfShape allocated by \c dxf_shape_new to its pool.
+ *
+ * \c shape_name, allocated with \c malloc by \c dxf_shape_init or
+ * \c dxf_shape_read, is freed as well; the layer and linetype are
+ * interned and are not (see \c dxf_arena_intern).\n
+ * Not for a \c DxfShape allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_shape_free
+(
+        DxfShape *dxf_shape
+                /*!< DXF shape entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_shape_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        if (dxf_shape)
+        {
+                free (dxf_shape->shape_name);
+        }
+        dxf_pool_release (&dxf_shape_pool, dxf_shape);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_shape_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in a \c SHAPE 
  * entity to default values.
  * 
+ * The layer and linetype are interned in the names shared by the
+ * entities without an arena (see \c dxf_intern_shared), they stay
+ * valid until \c dxf_intern_shared_free.
+ *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
  */
@@ -86,16 +164,46 @@ dxf_shape_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_shape_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        dxf_shape = dxf_shape_new ();
+        dxf_shape = dxf_shape_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_shape_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_shape);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in a \c SHAPE 
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_shape_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfShape *
+dxf_shape_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_shape_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfShape *dxf_shape = NULL;
+        dxf_shape = dxf_shape_new_arena (arena);
         if (dxf_shape == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_shape_init () could not allocate memory for a DxfShape struct.\n");
+              fprintf (stderr, "ERROR in dxf_shape_init_arena () could not allocate memory for a DxfShape struct.\n");
               return (NULL);
         }
         dxf_shape->common.id_code = 0;
-        dxf_shape->shape_name = strdup ("");
-        dxf_shape->common.linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dxf_shape->common.layer = strdup (DXF_DEFAULT_LAYER);
+        dxf_shape->shape_name = dxf_arena_strdup (arena, "");
+        dxf_shape->common.linetype = dxf_arena_intern (arena, DXF_DEFAULT_LINETYPE);
+        dxf_shape->common.layer = dxf_arena_intern (arena, DXF_DEFAULT_LAYER);
         dxf_shape->x0 = 0.0;
         dxf_shape->y0 = 0.0;
         dxf_shape->z0 = 0.0;
@@ -110,13 +218,34 @@ dxf_shape_init
         dxf_shape->common.paperspace = DXF_MODELSPACE;
         dxf_shape->common.acad_version_number = 0;
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_shape_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_shape_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_shape);
 }
 
 
+/*!
+ * \brief Schema of the \c SHAPE entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_shape_schema[DXF_SCHEMA_SIZE] =
+{
+        DXF_SCHEMA_ENTITY_COMMON (DxfShape),
+        [2] = DXF_SCHEMA_FIELD (DXF_FIELD_STRING, DxfShape, shape_name),
+        [10] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfShape, x0),
+        [20] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfShape, y0),
+        [30] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfShape, z0),
+        [38] = DXF_SCHEMA_FIELD (DXF_FIELD_ELEVATION, DxfShape, z0),
+        [40] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfShape, size),
+        [41] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfShape, rel_x_scale),
+        [50] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfShape, rot_angle),
+        [51] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfShape, obl_angle),
+        [210] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfShape, extr_x0),
+        [220] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfShape, extr_y0),
+        [230] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfShape, extr_z0)
+};
+
+
 /*!
  * \brief Read data from a DXF file into a \c SHAPE entity.
  *
@@ -124,6 +253,7 @@ dxf_shape_init
  * Hereafter follows some data for the \c SHAPE, to be terminated with
  * a "  0" string announcing the following entity, or the end of the
  * \c ENTITY section marker \c ENDSEC. \n
+ * The group codes are decoded through \c dxf_shape_schema.
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred while reading from the input file.
@@ -131,12 +261,8 @@ dxf_shape_init
 int
 dxf_shape_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         DxfShape *dxf_shape,
                 /*!< DXF shape entity. */
         int acad_version_number
@@ -147,182 +273,19 @@ dxf_shape_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_shape_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
         if (!dxf_shape)
         {
                 dxf_shape = dxf_shape_new ();
         }
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_shape_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (EXIT_FAILURE);
-                }
-                if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a shape
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_shape->shape_name);
-                }
-                else if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (*line_number)++;
-                        fscanf (fp, "%x\n", &dxf_shape->common.id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_shape->common.linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_shape->common.layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the insertion point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_shape->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the insertion point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_shape->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the insertion point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_shape->z0);
-                }
-                else if ((acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (dxf_shape->z0 = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_shape->z0);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_shape->common.thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * size. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_shape->size);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * relative X scale. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_shape->rel_x_scale);
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing the
-                         * rotation angle. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_shape->rot_angle);
-                }
-                else if (strcmp (temp_string, "51") == 0)
-                {
-                        /* Now follows a string containing the
-                         * oblique angle. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_shape->obl_angle);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_shape->common.color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_shape->common.paperspace);
-                }
-                else if ((acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_shape->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_shape->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_shape->extr_z0);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning in dxf_shape_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_shape_schema, dxf_shape, NULL,
+                "SHAPE", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_shape_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -332,8 +295,8 @@ dxf_shape_read
 int
 dxf_shape_write_lowlevel
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< group code = 5. */
         char *shape_name,
@@ -403,44 +366,44 @@ dxf_shape_write_lowlevel
                 fprintf (stderr, "Warning in dxf_shape_write_lowlevel () relative X-scale factor has a value of 0.0 for the %s entity with id-code: %x\n",
                         dxf_entity_name, id_code);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
-        fprintf (fp, "  2\n%s\n", shape_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
+        dxf_write_group_string (fp, 2, shape_name);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
-        fprintf (fp, " 40\n%f\n", size);
+        dxf_write_group_double (fp, 40, size);
         if (rel_x_scale != 1.0)
         {
-                fprintf (fp, " 41\n%f\n", rel_x_scale);
+                dxf_write_group_double (fp, 41, rel_x_scale);
         }
         if (rot_angle != 0.0)
         {
-                fprintf (fp, " 50\n%f\n", rot_angle);
+                dxf_write_group_double (fp, 50, rot_angle);
         }
         if (obl_angle != 0.0)
         {
-                fprintf (fp, " 51\n%f\n", obl_angle);
+                dxf_write_group_double (fp, 51, obl_angle);
         }
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
         if (paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_shape_write_lowlevel () function.\n", __FILE__, __LINE__);
@@ -455,8 +418,8 @@ dxf_shape_write_lowlevel
 int
 dxf_shape_write
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfShape dxf_shape
                 /*!< DXF shape entity. */
 )
@@ -496,44 +459,44 @@ dxf_shape_write
                 fprintf (stderr, "Warning: in dxf_shape_write () relative X-scale factor has a value of 0.0 for the %s entity with id-code: %x\n",
                         dxf_entity_name, dxf_shape.common.id_code);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
-        fprintf (fp, "  2\n%s\n", dxf_shape.shape_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
+        dxf_write_group_string (fp, 2, dxf_shape.shape_name);
         if (dxf_shape.common.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_shape.common.id_code);
+                dxf_write_group_hex (fp, 5, dxf_shape.common.id_code);
         }
         if (strcmp (dxf_shape.common.linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", dxf_shape.common.linetype);
+                dxf_write_group_string (fp, 6, dxf_shape.common.linetype);
         }
-        fprintf (fp, "  8\n%s\n", dxf_shape.common.layer);
-        fprintf (fp, " 10\n%f\n", dxf_shape.x0);
-        fprintf (fp, " 20\n%f\n", dxf_shape.y0);
-        fprintf (fp, " 30\n%f\n", dxf_shape.z0);
+        dxf_write_group_string (fp, 8, dxf_shape.common.layer);
+        dxf_write_group_double (fp, 10, dxf_shape.x0);
+        dxf_write_group_double (fp, 20, dxf_shape.y0);
+        dxf_write_group_double (fp, 30, dxf_shape.z0);
         if (dxf_shape.common.thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", dxf_shape.common.thickness);
+                dxf_write_group_double (fp, 39, dxf_shape.common.thickness);
         }
-        fprintf (fp, " 40\n%f\n", dxf_shape.size);
+        dxf_write_group_double (fp, 40, dxf_shape.size);
         if (dxf_shape.rel_x_scale != 1.0)
         {
-                fprintf (fp, " 41\n%f\n", dxf_shape.rel_x_scale);
+                dxf_write_group_double (fp, 41, dxf_shape.rel_x_scale);
         }
         if (dxf_shape.rot_angle != 0.0)
         {
-                fprintf (fp, " 50\n%f\n", dxf_shape.rot_angle);
+                dxf_write_group_double (fp, 50, dxf_shape.rot_angle);
         }
         if (dxf_shape.obl_angle != 0.0)
         {
-                fprintf (fp, " 51\n%f\n", dxf_shape.obl_angle);
+                dxf_write_group_double (fp, 51, dxf_shape.obl_angle);
         }
         if (dxf_shape.common.color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", dxf_shape.common.color);
+                dxf_write_group_int (fp, 62, dxf_shape.common.color);
         }
         if (dxf_shape.common.paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_shape_write () function.\n",
@@ -86,23 +86,36 @@ dxf_shape
 DxfShape *
 dxf_shape_new ();
 DxfShape *
+dxf_shape_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_shape_free
+(
+        DxfShape *dxf_shape
+);
+DxfShape *
 dxf_shape_init
 (
         DxfShape *dxf_shape
 );
+DxfShape *
+dxf_shape_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_shape_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfShape *dxf_shape,
         int acad_version_number
 );
 int
 dxf_shape_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *shape_name,
         char *linetype,
@@ -121,7 +134,7 @@ dxf_shape_write_lowlevel
 int
 dxf_shape_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfShape dxf_shape
 );
 
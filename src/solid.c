@@ -38,12 +38,25 @@
 
 
 #include "solid.h"
+#include "arena.h"
+#include "pool.h"
+#include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_solid_new are handed out by.
+ */
+static DxfPool dxf_solid_pool = DXF_POOL_INITIALIZER (sizeof (DxfSolid));
 
 
 /*!
  * \brief Allocate memory for a \c DxfSolid.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_solid_free.
  */
 DxfSolid *
 dxf_solid_new ()
@@ -53,31 +66,91 @@ dxf_solid_new ()
                 __FILE__, __LINE__);
 #endif
         DxfSolid *dxf_solid = NULL;
-        size_t size;
 
-        size = sizeof (DxfSolid);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_solid = malloc (size)) == NULL)
+        if ((dxf_solid = dxf_pool_alloc (&dxf_solid_pool)) == NULL)
         {
                 fprintf (stderr, "ERROR in dxf_solid_new () could not allocate memory for a DxfSolid struct.\n");
-                dxf_solid = NULL;
         }
-        else
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_solid_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_solid);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfSolid from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_solid_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfSolid *
+dxf_solid_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_solid_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfSolid *dxf_solid = NULL;
+
+        if (arena == NULL)
+        {
+                dxf_solid = dxf_solid_new ();
+        }
+        else if ((dxf_solid = dxf_arena_alloc (arena, sizeof (DxfSolid))) == NULL)
         {
-                memset (dxf_solid, 0, size);
+                fprintf (stderr, "ERROR in dxf_solid_new_arena () could not allocate memory for a DxfSolid struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_solid_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_solid_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_solid);
 }
 
 
+/*!
+ * \brief Release a \c DxfSolid allocated by \c dxf_solid_new to its pool.
+ *
+ * The struct has no strings of its own, the layer and linetype are
+ * interned (see \c dxf_arena_intern).\n
+ * Not for a \c DxfSolid allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_solid_free
+(
+        DxfSolid *dxf_solid
+                /*!< DXF solid entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_solid_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        dxf_pool_release (&dxf_solid_pool, dxf_solid);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_solid_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in a \c SOLID entity.
  * 
+ * The layer and linetype are interned in the names shared by the
+ * entities without an arena (see \c dxf_intern_shared), they stay
+ * valid until \c dxf_intern_shared_free.
+ *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
  */
@@ -92,15 +165,45 @@ dxf_solid_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_solid_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        dxf_solid = dxf_solid_new ();
+        dxf_solid = dxf_solid_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_solid_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_solid);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in a \c SOLID entity.
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_solid_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfSolid *
+dxf_solid_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_solid_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfSolid *dxf_solid = NULL;
+        dxf_solid = dxf_solid_new_arena (arena);
         if (dxf_solid == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_solid_init () could not allocate memory for a DxfSolid struct.\n");
+              fprintf (stderr, "ERROR in dxf_solid_init_arena () could not allocate memory for a DxfSolid struct.\n");
               return (NULL);
         }
         dxf_solid->common.id_code = 0;
-        dxf_solid->common.linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dxf_solid->common.layer = strdup (DXF_DEFAULT_LAYER);
+        dxf_solid->common.linetype = dxf_arena_intern (arena, DXF_DEFAULT_LINETYPE);
+        dxf_solid->common.layer = dxf_arena_intern (arena, DXF_DEFAULT_LAYER);
         dxf_solid->x0 = 0.0;
         dxf_solid->y0 = 0.0;
         dxf_solid->z0 = 0.0;
@@ -121,13 +224,38 @@ dxf_solid_init
         dxf_solid->common.paperspace = DXF_MODELSPACE;
         dxf_solid->common.acad_version_number = 0;
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_solid_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_solid_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_solid);
 }
 
 
+/*!
+ * \brief Schema of the \c SOLID entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_solid_schema[DXF_SCHEMA_SIZE] =
+{
+        DXF_SCHEMA_ENTITY_COMMON (DxfSolid),
+        [10] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfSolid, x0),
+        [11] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfSolid, x1),
+        [12] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfSolid, x2),
+        [13] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfSolid, x3),
+        [20] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfSolid, y0),
+        [21] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfSolid, y1),
+        [22] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfSolid, y2),
+        [23] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfSolid, y3),
+        [30] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfSolid, z0),
+        [31] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfSolid, z1),
+        [32] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfSolid, z2),
+        [33] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfSolid, z3),
+        [38] = DXF_SCHEMA_FIELD (DXF_FIELD_ELEVATION, DxfSolid, z0),
+        [210] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfSolid, extr_x0),
+        [220] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfSolid, extr_y0),
+        [230] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfSolid, extr_z0)
+};
+
+
 /*!
  * \brief Read data from a DXF file into an \c SOLID entity.
  *
@@ -135,6 +263,7 @@ dxf_solid_init
  * Now follows some data for the \c SOLID, to be terminated with a "  0"
  * string announcing the following entity, or the end of the \c ENTITY
  * section marker \c ENDSEC. \n
+ * The group codes are decoded through \c dxf_solid_schema.
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred while reading from the input file.
@@ -142,12 +271,8 @@ dxf_solid_init
 int
 dxf_solid_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         DxfSolid *dxf_solid,
                 /*!< DXF solid entity. */
         int acad_version_number
@@ -158,210 +283,19 @@ dxf_solid_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_solid_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
         if (!dxf_solid)
         {
                 dxf_solid = dxf_solid_new ();
         }
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_solid_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (0);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (*line_number)++;
-                        fscanf (fp, "%x\n", &dxf_solid->common.id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_solid->common.linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_solid->common.layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->x1);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->y1);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->z1);
-                }
-                else if (strcmp (temp_string, "12") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->x2);
-                }
-                else if (strcmp (temp_string, "22") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->y2);
-                }
-                else if (strcmp (temp_string, "32") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->z2);
-                }
-                else if (strcmp (temp_string, "13") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->x3);
-                }
-                else if (strcmp (temp_string, "23") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->y3);
-                }
-                else if (strcmp (temp_string, "33") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->z3);
-                }
-                else if ((acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (dxf_solid->z0 = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->z0);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->common.thickness);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_solid->common.color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_solid->common.paperspace);
-                }
-                else if ((acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_solid->extr_z0);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning in dxf_solid_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_solid_schema, dxf_solid, NULL,
+                "SOLID", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_solid_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -374,8 +308,8 @@ dxf_solid_read
 int
 dxf_solid_write_lowlevel
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< group code = 5. */
         char *linetype,
@@ -444,39 +378,39 @@ dxf_solid_write_lowlevel
                         dxf_entity_name);
                 layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
-        fprintf (fp, " 11\n%f\n", x1);
-        fprintf (fp, " 21\n%f\n", y1);
-        fprintf (fp, " 31\n%f\n", z1);
-        fprintf (fp, " 12\n%f\n", x2);
-        fprintf (fp, " 22\n%f\n", y2);
-        fprintf (fp, " 32\n%f\n", z2);
-        fprintf (fp, " 13\n%f\n", x3);
-        fprintf (fp, " 23\n%f\n", y3);
-        fprintf (fp, " 33\n%f\n", z3);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
+        dxf_write_group_double (fp, 11, x1);
+        dxf_write_group_double (fp, 21, y1);
+        dxf_write_group_double (fp, 31, z1);
+        dxf_write_group_double (fp, 12, x2);
+        dxf_write_group_double (fp, 22, y2);
+        dxf_write_group_double (fp, 32, z2);
+        dxf_write_group_double (fp, 13, x3);
+        dxf_write_group_double (fp, 23, y3);
+        dxf_write_group_double (fp, 33, z3);
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
         if (paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_solid_write_lowlevel () function.\n",
@@ -495,8 +429,8 @@ dxf_solid_write_lowlevel
 int
 dxf_solid_write
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfSolid dxf_solid
                 /*!< DXF solid entity. */
 )
@@ -515,39 +449,39 @@ dxf_solid_write
                         dxf_entity_name);
                 dxf_solid.common.layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (dxf_solid.common.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_solid.common.id_code);
+                dxf_write_group_hex (fp, 5, dxf_solid.common.id_code);
         }
         if (strcmp (dxf_solid.common.linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", dxf_solid.common.linetype);
+                dxf_write_group_string (fp, 6, dxf_solid.common.linetype);
         }
-        fprintf (fp, "  8\n%s\n", dxf_solid.common.layer);
-        fprintf (fp, " 10\n%f\n", dxf_solid.x0);
-        fprintf (fp, " 20\n%f\n", dxf_solid.y0);
-        fprintf (fp, " 30\n%f\n", dxf_solid.z0);
-        fprintf (fp, " 11\n%f\n", dxf_solid.x1);
-        fprintf (fp, " 21\n%f\n", dxf_solid.y1);
-        fprintf (fp, " 31\n%f\n", dxf_solid.z1);
-        fprintf (fp, " 12\n%f\n", dxf_solid.x2);
-        fprintf (fp, " 22\n%f\n", dxf_solid.y2);
-        fprintf (fp, " 32\n%f\n", dxf_solid.z2);
-        fprintf (fp, " 13\n%f\n", dxf_solid.x3);
-        fprintf (fp, " 23\n%f\n", dxf_solid.y3);
-        fprintf (fp, " 33\n%f\n", dxf_solid.z3);
+        dxf_write_group_string (fp, 8, dxf_solid.common.layer);
+        dxf_write_group_double (fp, 10, dxf_solid.x0);
+        dxf_write_group_double (fp, 20, dxf_solid.y0);
+        dxf_write_group_double (fp, 30, dxf_solid.z0);
+        dxf_write_group_double (fp, 11, dxf_solid.x1);
+        dxf_write_group_double (fp, 21, dxf_solid.y1);
+        dxf_write_group_double (fp, 31, dxf_solid.z1);
+        dxf_write_group_double (fp, 12, dxf_solid.x2);
+        dxf_write_group_double (fp, 22, dxf_solid.y2);
+        dxf_write_group_double (fp, 32, dxf_solid.z2);
+        dxf_write_group_double (fp, 13, dxf_solid.x3);
+        dxf_write_group_double (fp, 23, dxf_solid.y3);
+        dxf_write_group_double (fp, 33, dxf_solid.z3);
         if (dxf_solid.common.thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", dxf_solid.common.thickness);
+                dxf_write_group_double (fp, 39, dxf_solid.common.thickness);
         }
         if (dxf_solid.common.color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", dxf_solid.common.color);
+                dxf_write_group_int (fp, 62, dxf_solid.common.color);
         }
         if (dxf_solid.common.paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_solid_write () function.\n",
@@ -110,23 +110,36 @@ dxf_solid
 DxfSolid *
 dxf_solid_new ();
 DxfSolid *
+dxf_solid_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_solid_free
+(
+        DxfSolid *dxf_solid
+);
+DxfSolid *
 dxf_solid_init
 (
         DxfSolid *dxf_solid
 );
+DxfSolid *
+dxf_solid_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_solid_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfSolid *dxf_solid,
         int acad_version_number
 );
 int
 dxf_solid_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *linetype,
         char *layer,
@@ -149,7 +162,7 @@ dxf_solid_write_lowlevel
 int
 dxf_solid_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfSolid dxf_solid
 );
 
@@ -0,0 +1,571 @@
+/*!
+ * \file stream.c
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Functions for compressed (gzip, zstd) DXF streams.
+ *
+ * Compressed DXF files are decompressed while they are read into the
+ * buffer of a DxfFile (see \c dxf_read_init), and compressed while a
+ * DxfWriter writes them (see \c dxf_write_init).\n
+ * gzip needs zlib, zstd needs libzstd, at configure time.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "libdxf.h"
+#endif
+#if HAVE_ZLIB_H
+#include <zlib.h>
+#endif
+#if HAVE_ZSTD_H
+#include <zstd.h>
+#endif
+#include "stream.h"
+
+
+/*!
+ * \brief Size of the buffers for compressed bytes.
+ */
+#define DXF_STREAM_BUFFER_SIZE 65536
+
+
+/*!
+ * \brief DXF definition of a compressed stream.
+ */
+struct
+dxf_stream
+{
+        int compression;
+                /*!< \c DXF_COMPRESSION_GZIP or \c DXF_COMPRESSION_ZSTD. */
+        int writing;
+                /*!< \c TRUE when the stream is compressed, \c FALSE when
+                 * it is decompressed. */
+        int ended;
+                /*!< \c TRUE when the last compressed frame (or gzip
+                 * member) read was complete. */
+        int failed;
+                /*!< \c TRUE when an error occurred. */
+        unsigned char *input;
+                /*!< compressed bytes read, or bytes to compress. */
+        size_t input_length;
+                /*!< number of bytes in \c input. */
+        size_t input_position;
+                /*!< offset of the next byte to use in \c input. */
+        unsigned char *output;
+                /*!< compressed bytes to write. */
+#if HAVE_ZLIB_H
+        z_stream zlib;
+                /*!< state of zlib. */
+#endif
+#if HAVE_ZSTD_H
+        ZSTD_DCtx *zstd_decompress;
+                /*!< state of the zstd decompressor. */
+        ZSTD_CCtx *zstd_compress;
+                /*!< state of the zstd compressor. */
+#endif
+};
+
+
+/*!
+ * \brief Detects a compressed stream from its first bytes.
+ *
+ * \return \c DXF_COMPRESSION_GZIP, \c DXF_COMPRESSION_ZSTD, or
+ * \c DXF_COMPRESSION_NONE.
+ */
+int
+dxf_stream_detect
+(
+        const void *data,
+                /*!< the first bytes of the stream. */
+        size_t length
+                /*!< number of bytes in \c data. */
+)
+{
+        const unsigned char *p = data;
+
+        if ((length >= 2) && (p[0] == 0x1f) && (p[1] == 0x8b))
+                return (DXF_COMPRESSION_GZIP);
+        if ((length >= 4) && (p[0] == 0x28) && (p[1] == 0xb5)
+                && (p[2] == 0x2f) && (p[3] == 0xfd))
+                return (DXF_COMPRESSION_ZSTD);
+        return (DXF_COMPRESSION_NONE);
+}
+
+
+/*!
+ * \brief Returns the compression for a file from its extension (".gz",
+ * ".zst").
+ *
+ * \return \c DXF_COMPRESSION_GZIP, \c DXF_COMPRESSION_ZSTD, or
+ * \c DXF_COMPRESSION_NONE.
+ */
+int
+dxf_stream_by_name
+(
+        const char *filename
+                /*!< filename of the file. */
+)
+{
+        size_t length = strlen (filename);
+
+        if ((length > 3) && (strcmp (filename + length - 3, ".gz") == 0))
+                return (DXF_COMPRESSION_GZIP);
+        if ((length > 4) && (strcmp (filename + length - 4, ".zst") == 0))
+                return (DXF_COMPRESSION_ZSTD);
+        return (DXF_COMPRESSION_NONE);
+}
+
+
+/*!
+ * \brief Allocates a DxfStream and initializes the (de)compressor.
+ *
+ * \return \c NULL when the compression is not supported or no memory was
+ * allocated, a pointer to the DxfStream when succesful.
+ */
+static DxfStream *
+dxf_stream_new
+(
+        int compression,
+                /*!< \c DXF_COMPRESSION_GZIP or \c DXF_COMPRESSION_ZSTD. */
+        int writing
+                /*!< \c TRUE to compress, \c FALSE to decompress. */
+)
+{
+        DxfStream *stream;
+        int ret = EXIT_FAILURE;
+
+        stream = malloc (sizeof (DxfStream));
+        if (!stream)
+        {
+                fprintf (stderr, "Error in dxf_stream_new () could not allocate memory for a DxfStream struct.\n");
+                return (NULL);
+        }
+        memset (stream, 0, sizeof (DxfStream));
+        stream->compression = compression;
+        stream->writing = writing;
+        stream->ended = TRUE;
+        stream->input = malloc (DXF_STREAM_BUFFER_SIZE);
+        stream->output = writing ? malloc (DXF_STREAM_BUFFER_SIZE) : NULL;
+        if (!stream->input || (writing && !stream->output))
+        {
+                fprintf (stderr, "Error in dxf_stream_new () could not allocate memory for the buffers.\n");
+                dxf_stream_close (stream);
+                return (NULL);
+        }
+        switch (compression)
+        {
+#if HAVE_ZLIB_H
+                case DXF_COMPRESSION_GZIP:
+                        /* 16 selects a gzip header, 32 detects a gzip or
+                         * zlib header. */
+                        if (writing)
+                                ret = deflateInit2 (&stream->zlib, Z_DEFAULT_COMPRESSION,
+                                        Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+                        else
+                                ret = inflateInit2 (&stream->zlib, 15 + 32);
+                        ret = (ret == Z_OK) ? EXIT_SUCCESS : EXIT_FAILURE;
+                        break;
+#endif
+#if HAVE_ZSTD_H
+                case DXF_COMPRESSION_ZSTD:
+                        if (writing)
+                                stream->zstd_compress = ZSTD_createCCtx ();
+                        else
+                                stream->zstd_decompress = ZSTD_createDCtx ();
+                        ret = (stream->zstd_compress || stream->zstd_decompress)
+                                ? EXIT_SUCCESS : EXIT_FAILURE;
+                        break;
+#endif
+                default:
+                        fprintf (stderr, "Error in dxf_stream_new () compression %d is not supported by this build.\n",
+                                compression);
+                        stream->compression = DXF_COMPRESSION_NONE;
+                        break;
+        }
+        if (ret != EXIT_SUCCESS)
+        {
+                dxf_stream_close (stream);
+                return (NULL);
+        }
+        return (stream);
+}
+
+
+/*!
+ * \brief Opens a DxfStream for decompressing.
+ *
+ * \c data are the first compressed bytes, which were read to detect the
+ * compression.
+ *
+ * \return \c NULL when the compression is not supported or no memory was
+ * allocated, a pointer to the DxfStream when succesful.
+ */
+DxfStream *
+dxf_stream_read_open
+(
+        int compression,
+                /*!< \c DXF_COMPRESSION_GZIP or \c DXF_COMPRESSION_ZSTD. */
+        const void *data,
+                /*!< the compressed bytes read so far. */
+        size_t length
+                /*!< number of bytes in \c data, at most 64 KiB. */
+)
+{
+        DxfStream *stream;
+
+        stream = dxf_stream_new (compression, FALSE);
+        if (!stream)
+                return (NULL);
+        if (length > DXF_STREAM_BUFFER_SIZE)
+                length = DXF_STREAM_BUFFER_SIZE;
+        memcpy (stream->input, data, length);
+        stream->input_length = length;
+        return (stream);
+}
+
+
+/*!
+ * \brief Decompresses bytes read from \c fp into \c buffer.
+ *
+ * Concatenated gzip members and zstd frames are decompressed as one
+ * stream.
+ *
+ * \return \c EXIT_SUCCESS when done, \c length is 0 at the end of the
+ * stream, or \c EXIT_FAILURE when an error occurred.
+ */
+int
+dxf_stream_read
+(
+        DxfStream *stream,
+                /*!< the stream. */
+        FILE *fp,
+                /*!< file handle of input file (or device). */
+        char *buffer,
+                /*!< buffer for the decompressed bytes. */
+        size_t size,
+                /*!< size of \c buffer. */
+        size_t *length
+                /*!< number of bytes decompressed. */
+)
+{
+        int ret;
+
+        *length = 0;
+        while ((*length == 0) && !stream->failed)
+        {
+                if (stream->input_position == stream->input_length)
+                {
+                        stream->input_position = 0;
+                        stream->input_length = fread (stream->input, 1,
+                                DXF_STREAM_BUFFER_SIZE, fp);
+                        if (stream->input_length == 0)
+                        {
+                                if (ferror (fp) || !stream->ended)
+                                {
+                                        fprintf (stderr, "Error in dxf_stream_read () the compressed stream is %s.\n",
+                                                ferror (fp) ? "unreadable" : "truncated");
+                                        stream->failed = TRUE;
+                                }
+                                break;
+                        }
+                }
+                switch (stream->compression)
+                {
+#if HAVE_ZLIB_H
+                        case DXF_COMPRESSION_GZIP:
+                                if (stream->ended)
+                                {
+                                        inflateReset (&stream->zlib);
+                                        stream->ended = FALSE;
+                                }
+                                stream->zlib.next_in = stream->input + stream->input_position;
+                                stream->zlib.avail_in = (uInt) (stream->input_length - stream->input_position);
+                                stream->zlib.next_out = (Bytef *) buffer;
+                                stream->zlib.avail_out = (uInt) size;
+                                ret = inflate (&stream->zlib, Z_NO_FLUSH);
+                                stream->input_position = stream->input_length - stream->zlib.avail_in;
+                                *length = size - stream->zlib.avail_out;
+                                if (ret == Z_STREAM_END)
+                                        stream->ended = TRUE;
+                                else if ((ret != Z_OK) && (ret != Z_BUF_ERROR))
+                                        stream->failed = TRUE;
+                                break;
+#endif
+#if HAVE_ZSTD_H
+                        case DXF_COMPRESSION_ZSTD:
+                        {
+                                ZSTD_inBuffer in;
+                                ZSTD_outBuffer out;
+                                size_t remaining;
+
+                                in.src = stream->input;
+                                in.size = stream->input_length;
+                                in.pos = stream->input_position;
+                                out.dst = buffer;
+                                out.size = size;
+                                out.pos = 0;
+                                remaining = ZSTD_decompressStream (stream->zstd_decompress,
+                                        &out, &in);
+                                stream->input_position = in.pos;
+                                *length = out.pos;
+                                if (ZSTD_isError (remaining))
+                                        stream->failed = TRUE;
+                                else
+                                        stream->ended = (remaining == 0);
+                                break;
+                        }
+#endif
+                        default:
+                                stream->failed = TRUE;
+                                break;
+                }
+                if (stream->failed)
+                        fprintf (stderr, "Error in dxf_stream_read () the compressed stream is corrupt.\n");
+        }
+        return (stream->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Tests if a decompressed stream ended properly.
+ *
+ * \return \c TRUE when all compressed bytes were decompressed,
+ * \c FALSE otherwise.
+ */
+int
+dxf_stream_eof
+(
+        const DxfStream *stream
+                /*!< the stream. */
+)
+{
+        return (stream->ended && !stream->failed
+                && (stream->input_position == stream->input_length));
+}
+
+
+/*!
+ * \brief Opens a DxfStream for compressing.
+ *
+ * \return \c NULL when the compression is not supported or no memory was
+ * allocated, a pointer to the DxfStream when succesful.
+ */
+DxfStream *
+dxf_stream_write_open
+(
+        int compression
+                /*!< \c DXF_COMPRESSION_GZIP or \c DXF_COMPRESSION_ZSTD. */
+)
+{
+        return (dxf_stream_new (compression, TRUE));
+}
+
+
+/*!
+ * \brief Compresses the bytes collected in \c input and writes the
+ * compressed bytes to \c fp.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_stream_flush
+(
+        DxfStream *stream,
+                /*!< the stream. */
+        FILE *fp,
+                /*!< file handle of output file (or device). */
+        int finish
+                /*!< \c TRUE to end the stream. */
+)
+{
+        int done = FALSE;
+        size_t produced = 0;
+
+        while (!done && !stream->failed)
+        {
+                switch (stream->compression)
+                {
+#if HAVE_ZLIB_H
+                        case DXF_COMPRESSION_GZIP:
+                        {
+                                int ret;
+
+                                stream->zlib.next_in = stream->input;
+                                stream->zlib.avail_in = (uInt) stream->input_length;
+                                stream->zlib.next_out = stream->output;
+                                stream->zlib.avail_out = DXF_STREAM_BUFFER_SIZE;
+                                ret = deflate (&stream->zlib, finish ? Z_FINISH : Z_NO_FLUSH);
+                                memmove (stream->input, stream->zlib.next_in,
+                                        stream->zlib.avail_in);
+                                stream->input_length = stream->zlib.avail_in;
+                                produced = DXF_STREAM_BUFFER_SIZE - stream->zlib.avail_out;
+                                if ((ret != Z_OK) && (ret != Z_STREAM_END) && (ret != Z_BUF_ERROR))
+                                        stream->failed = TRUE;
+                                done = finish ? (ret == Z_STREAM_END)
+                                        : (stream->input_length == 0);
+                                break;
+                        }
+#endif
+#if HAVE_ZSTD_H
+                        case DXF_COMPRESSION_ZSTD:
+                        {
+                                ZSTD_inBuffer in;
+                                ZSTD_outBuffer out;
+                                size_t remaining;
+
+                                in.src = stream->input;
+                                in.size = stream->input_length;
+                                in.pos = 0;
+                                out.dst = stream->output;
+                                out.size = DXF_STREAM_BUFFER_SIZE;
+                                out.pos = 0;
+                                remaining = ZSTD_compressStream2 (stream->zstd_compress,
+                                        &out, &in, finish ? ZSTD_e_end : ZSTD_e_continue);
+                                memmove (stream->input, stream->input + in.pos,
+                                        in.size - in.pos);
+                                stream->input_length = in.size - in.pos;
+                                produced = out.pos;
+                                if (ZSTD_isError (remaining))
+                                        stream->failed = TRUE;
+                                done = finish ? (remaining == 0)
+                                        : (stream->input_length == 0);
+                                break;
+                        }
+#endif
+                        default:
+                                stream->failed = TRUE;
+                                break;
+                }
+                if (!stream->failed && (produced > 0)
+                        && (fwrite (stream->output, 1, produced, fp) != produced))
+                        stream->failed = TRUE;
+        }
+        if (stream->failed)
+                fprintf (stderr, "Error in dxf_stream_write () could not compress or write the stream.\n");
+        return (stream->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Compresses bytes and writes them to \c fp.
+ *
+ * The bytes are collected and compressed in blocks of 64 KiB.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_stream_write
+(
+        DxfStream *stream,
+                /*!< the stream. */
+        FILE *fp,
+                /*!< file handle of output file (or device). */
+        const void *data,
+                /*!< the bytes. */
+        size_t length
+                /*!< number of bytes in \c data. */
+)
+{
+        const char *p = data;
+        size_t n;
+
+        while (length > 0)
+        {
+                n = DXF_STREAM_BUFFER_SIZE - stream->input_length;
+                if (n > length)
+                        n = length;
+                memcpy (stream->input + stream->input_length, p, n);
+                stream->input_length += n;
+                p += n;
+                length -= n;
+                if ((stream->input_length == DXF_STREAM_BUFFER_SIZE)
+                        && (dxf_stream_flush (stream, fp, FALSE) != EXIT_SUCCESS))
+                        return (EXIT_FAILURE);
+        }
+        return (stream->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Compresses the remaining bytes and ends the compressed stream.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_stream_finish
+(
+        DxfStream *stream,
+                /*!< the stream. */
+        FILE *fp
+                /*!< file handle of output file (or device). */
+)
+{
+        return (dxf_stream_flush (stream, fp, TRUE));
+}
+
+
+/*!
+ * \brief Frees a DxfStream and the state of its (de)compressor.
+ */
+void
+dxf_stream_close
+(
+        DxfStream *stream
+                /*!< the stream. */
+)
+{
+        if (!stream)
+                return;
+        switch (stream->compression)
+        {
+#if HAVE_ZLIB_H
+                case DXF_COMPRESSION_GZIP:
+                        if (stream->writing)
+                                deflateEnd (&stream->zlib);
+                        else
+                                inflateEnd (&stream->zlib);
+                        break;
+#endif
+#if HAVE_ZSTD_H
+                case DXF_COMPRESSION_ZSTD:
+                        ZSTD_freeCCtx (stream->zstd_compress);
+                        ZSTD_freeDCtx (stream->zstd_decompress);
+                        break;
+#endif
+                default:
+                        break;
+        }
+        free (stream->input);
+        free (stream->output);
+        free (stream);
+}
+
+
+/* EOF */
@@ -0,0 +1,73 @@
+/*!
+ * \file stream.h
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Definition of compressed (gzip, zstd) DXF streams.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifndef STREAM_H
+#define STREAM_H
+
+
+#include "global.h"
+
+
+/*!
+ * \brief The stream is not compressed.
+ */
+#define DXF_COMPRESSION_NONE 0
+
+/*!
+ * \brief The stream is compressed with gzip (zlib).
+ */
+#define DXF_COMPRESSION_GZIP 1
+
+/*!
+ * \brief The stream is compressed with zstd.
+ */
+#define DXF_COMPRESSION_ZSTD 2
+
+
+typedef struct dxf_stream DxfStream;
+
+
+int dxf_stream_detect (const void *data, size_t length);
+int dxf_stream_by_name (const char *filename);
+DxfStream *dxf_stream_read_open (int compression, const void *data, size_t length);
+int dxf_stream_read (DxfStream *stream, FILE *fp, char *buffer, size_t size, size_t *length);
+int dxf_stream_eof (const DxfStream *stream);
+DxfStream *dxf_stream_write_open (int compression);
+int dxf_stream_write (DxfStream *stream, FILE *fp, const void *data, size_t length);
+int dxf_stream_finish (DxfStream *stream, FILE *fp);
+void dxf_stream_close (DxfStream *stream);
+
+
+#endif /* STREAM_H */
+
+
+/* EOF */
@@ -0,0 +1,79 @@
+/*!
+ * \file strtod.h
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Definition of locale independent conversion of DXF values to
+ * and from doubles.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifndef STRTOD_H
+#define STRTOD_H
+
+
+#include <stdint.h>
+#include "global.h"
+
+
+/*!
+ * \brief Size of the destination of \c dxf_dtoa_shortest and
+ * \c dxf_dtoa_fixed.
+ */
+#define DXF_DTOA_LENGTH 512
+
+/*!
+ * \brief Highest number of decimals of \c dxf_dtoa_fixed.
+ */
+#define DXF_DTOA_MAX_PRECISION 15
+
+
+size_t
+dxf_strtod
+(
+        const char *string,
+        size_t length,
+        double *value
+);
+size_t
+dxf_dtoa_shortest
+(
+        char *string,
+        double value
+);
+size_t
+dxf_dtoa_fixed
+(
+        char *string,
+        double value,
+        int precision
+);
+
+
+#endif /* STRTOD_H */
+
+
+/* EOF */
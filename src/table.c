@@ -33,19 +33,20 @@
 #include "global.h"
 #include "table.h"
 #include "section.h"
+#include "writer.h"
 
 
 /*!
  * \brief Write DXF output to a file for a table section.
  *
- * \param [FILE *fp]: the file pointer to write to.
+ * \param [DxfWriter *fp]: the DXF file handle to write to.
  * \return none.
  */
 int
 dxf_write_table
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int dxf_tables_list,
                 /*!< pointer to list of TABLES. */
         int dxf_tables_list_iter,
@@ -71,15 +72,15 @@ dxf_write_table
 /*!
  * \brief Write DXF output to a file for a table section.
  * 
- * \param [FILE *fp]: the file pointer to write to.
+ * \param [DxfWriter *fp]: the DXF file handle to write to.
  * \param [DxfTable dxf_table]: the table to write to file.
  * \return none.
  */
 int
 dxf_write_table_struct
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfTable dxf_table
                 /*!< DXF table section. */
 )
@@ -101,19 +102,19 @@ dxf_write_table_struct
 /*!
  * \brief Write DXF output to a file for an end of class section.
  * 
- * \param [FILE *fp]: the file pointer to write to.
+ * \param [DxfWriter *fp]: the DXF file handle to write to.
  * \return none.
  */
 int
 dxf_write_endtable
 (
-        FILE *fp
+        DxfWriter *fp
 )
 {
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_write_endtable () function.\n", __FILE__, __LINE__);
 #endif
-        fprintf (fp, "  0\nENDTAB\n");
+        dxf_write_group_string (fp, 0, "ENDTAB");
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_endtable () function.\n", __FILE__, __LINE__);
 #endif
@@ -124,7 +125,7 @@ dxf_write_endtable
 /*!
  * \brief Function generates dxf output to a file for tables entities.
  * 
- * \param [FILE *fp]: the file pointer to write to.
+ * \param [DxfWriter *fp]: the DXF file handle to write to.
  * \param [int *dxf_tables_list]: pointer to a list of dxf tables.
  * \param [int acad_version_number]: the AutoCAD version number.
  * \return none.
@@ -132,8 +133,8 @@ dxf_write_endtable
 int
 dxf_write_tables
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int *dxf_tables_list,
                 /*!< pointer to list of TABLES. */
         int acad_version_number
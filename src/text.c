@@ -31,12 +31,25 @@
 
 
 #include "text.h"
+#include "arena.h"
+#include "pool.h"
+#include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_text_new are handed out by.
+ */
+static DxfPool dxf_text_pool = DXF_POOL_INITIALIZER (sizeof (DxfText));
 
 
 /*!
  * \brief Allocate memory for a \c DxfText.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_text_free.
  */
 DxfText *
 dxf_text_new ()
@@ -46,31 +59,97 @@ dxf_text_new ()
                 __FILE__, __LINE__);
 #endif
         DxfText *dxf_text = NULL;
-        size_t size;
 
-        size = sizeof (DxfText);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_text = malloc (size)) == NULL)
+        if ((dxf_text = dxf_pool_alloc (&dxf_text_pool)) == NULL)
+        {
+                fprintf (stderr, "ERROR in dxf_text_new () could not allocate memory for a DxfText struct.\n");
+        }
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_text_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_text);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfText from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_text_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfText *
+dxf_text_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_text_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfText *dxf_text = NULL;
+
+        if (arena == NULL)
         {
-                fprintf (stderr, "ERROR in dxf_text_new () could not allocate memory for a DxfSolid struct.\n");
-                dxf_text = NULL;
+                dxf_text = dxf_text_new ();
         }
-        else
+        else if ((dxf_text = dxf_arena_alloc (arena, sizeof (DxfText))) == NULL)
         {
-                memset (dxf_text, 0, size);
+                fprintf (stderr, "ERROR in dxf_text_new_arena () could not allocate memory for a DxfText struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_text_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_text_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_text);
 }
 
 
+/*!
+ * \brief Release a \c DxfText allocated by \c dxf_text_new to its pool.
+ *
+ * \c text_value, allocated with \c malloc by \c dxf_text_init or
+ * \c dxf_text_read, is freed as well; the text style, layer and
+ * linetype are interned and are not (see \c dxf_arena_intern).\n
+ * Not for a \c DxfText allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_text_free
+(
+        DxfText *dxf_text
+                /*!< DXF text entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_text_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        if (dxf_text)
+        {
+                free (dxf_text->text_value);
+        }
+        dxf_pool_release (&dxf_text_pool, dxf_text);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_text_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in a \c TEXT entity.
  * 
+ * The layer, linetype and text style are interned in the names
+ * shared by the entities without an arena (see
+ * \c dxf_intern_shared), they stay valid until
+ * \c dxf_intern_shared_free.
+ *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
  */
@@ -85,17 +164,47 @@ dxf_text_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_text_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        dxf_text = dxf_text_new ();
+        dxf_text = dxf_text_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_text_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_text);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in a \c TEXT entity.
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_text_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfText *
+dxf_text_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_text_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfText *dxf_text = NULL;
+        dxf_text = dxf_text_new_arena (arena);
         if (dxf_text == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_text_init () could not allocate memory for a DxfText struct.\n");
+              fprintf (stderr, "ERROR in dxf_text_init_arena () could not allocate memory for a DxfText struct.\n");
               return (NULL);
         }
         dxf_text->common.id_code = 0;
-        dxf_text->text_value = strdup ("");
-        dxf_text->common.linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dxf_text->text_style = strdup ("");
-        dxf_text->common.layer = strdup (DXF_DEFAULT_LAYER);
+        dxf_text->text_value = dxf_arena_strdup (arena, "");
+        dxf_text->common.linetype = dxf_arena_intern (arena, DXF_DEFAULT_LINETYPE);
+        dxf_text->text_style = dxf_arena_intern (arena, "");
+        dxf_text->common.layer = dxf_arena_intern (arena, DXF_DEFAULT_LAYER);
         dxf_text->x0 = 0.0;
         dxf_text->y0 = 0.0;
         dxf_text->z0 = 0.0;
@@ -117,13 +226,38 @@ dxf_text_init
         dxf_text->extr_y0 = 0.0;
         dxf_text->extr_z0 = 0.0;
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_text_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_text_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_text);
 }
 
 
+/*!
+ * \brief Schema of the \c TEXT entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_text_schema[DXF_SCHEMA_SIZE] =
+{
+        DXF_SCHEMA_ENTITY_COMMON (DxfText),
+        [1] = DXF_SCHEMA_FIELD (DXF_FIELD_STRING, DxfText, text_value),
+        [7] = DXF_SCHEMA_FIELD (DXF_FIELD_NAME, DxfText, text_style),
+        [10] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfText, x0),
+        [20] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfText, y0),
+        [30] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfText, z0),
+        [38] = DXF_SCHEMA_FIELD (DXF_FIELD_ELEVATION, DxfText, z0),
+        [40] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfText, height),
+        [41] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfText, rel_x_scale),
+        [50] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfText, rot_angle),
+        [51] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfText, obl_angle),
+        [71] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfText, text_flags),
+        [72] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfText, hor_align),
+        [73] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfText, vert_align),
+        [210] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfText, extr_x0),
+        [220] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfText, extr_y0),
+        [230] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfText, extr_z0)
+};
+
+
 /*!
  * \brief Read data from a DXF file into a \c TEXT entity.
  *
@@ -131,7 +265,8 @@ dxf_text_init
  * Now follows some data for the \c TEXT, to be terminated with a "  0"
  * string announcing the following entity, or the end of the \c ENTITY
  * section marker \c ENDSEC. \n
- * While parsing the DXF file store data in \c dxf_text. \n
+ * While parsing the DXF file store data in \c dxf_text, the group
+ * codes are decoded through \c dxf_text_schema. \n
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -139,12 +274,8 @@ dxf_text_init
 int
 dxf_text_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         DxfText *dxf_text,
                 /*!< DXF text entity. */
         int acad_version_number
@@ -155,209 +286,19 @@ dxf_text_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_text_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
         if (!dxf_text)
         {
                 dxf_text = dxf_text_new ();
         }
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_text_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (EXIT_FAILURE);
-                }
-                if (strcmp (temp_string, "1") == 0)
-                {
-                        /* Now follows a string containing a text value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_text->text_value);
-                }
-                else if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (*line_number)++;
-                        fscanf (fp, "%x\n", &dxf_text->common.id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_text->common.linetype);
-                }
-                else if (strcmp (temp_string, "7") == 0)
-                {
-                        /* Now follows a string containing a text style
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_text->text_style);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_text->common.layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the insertion point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_text->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the insertion point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_text->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the insertion point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_text->z0);
-                }
-                else if ((acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (dxf_text->z0 = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_text->z0);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_text->common.thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * height. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_text->height);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * relative X-scale. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_text->rel_x_scale);
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing the
-                         * rotation angle. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_text->rot_angle);
-                }
-                else if (strcmp (temp_string, "51") == 0)
-                {
-                        /* Now follows a string containing the
-                         * oblique angle. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_text->obl_angle);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_text->common.color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_text->common.paperspace);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the
-                         * text flags value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_text->text_flags);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing the
-                         * horizontal alignment flag value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_text->hor_align);
-                }
-                else if (strcmp (temp_string, "73") == 0)
-                {
-                        /* Now follows a string containing the
-                         * vertical alignment flag value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_text->vert_align);
-                }
-                else if ((acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_text->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_text->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_text->extr_z0);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning: in dxf_text_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_text_schema, dxf_text, NULL,
+                "TEXT", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_text_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -367,8 +308,8 @@ dxf_text_read
 int
 dxf_text_write_lowlevel
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< group code = 5. */
         char *text_value,
@@ -485,24 +426,24 @@ dxf_text_write_lowlevel
                 fprintf (stderr, "Warning in dxf_text_write_lowlevel () relative X-scale factor has a value of 0.0 for the %s entity with id-code: %x\n",
                         dxf_entity_name, id_code);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
-        fprintf (fp, "  1\n%s\n", text_value);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
+        dxf_write_group_string (fp, 1, text_value);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
         if (strcmp (text_style, DXF_DEFAULT_TEXTSTYLE) != 0)
         {
-                fprintf (fp, "  7\n%s\n", text_style);
+                dxf_write_group_string (fp, 7, text_style);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
         if ((hor_align != 0) || (vert_align != 0))
         {
                 if ((x0 == x1) && (y0 == y1) && (z0 == z1))
@@ -516,47 +457,47 @@ dxf_text_write_lowlevel
                 }
                 else
                 {
-                        fprintf (fp, " 11\n%f\n", x1);
-                        fprintf (fp, " 21\n%f\n", y1);
-                        fprintf (fp, " 31\n%f\n", z1);
+                        dxf_write_group_double (fp, 11, x1);
+                        dxf_write_group_double (fp, 21, y1);
+                        dxf_write_group_double (fp, 31, z1);
                 }
         }
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
-        fprintf (fp, " 40\n%f\n", height);
+        dxf_write_group_double (fp, 40, height);
         if (rel_x_scale != 1.0)
         {
-                fprintf (fp, " 41\n%f\n", rel_x_scale);
+                dxf_write_group_double (fp, 41, rel_x_scale);
         }
         if (rot_angle != 0.0)
         {
-                fprintf (fp, " 50\n%f\n", rot_angle);
+                dxf_write_group_double (fp, 50, rot_angle);
         }
         if (obl_angle != 0.0)
         {
-                fprintf (fp, " 51\n%f\n", obl_angle);
+                dxf_write_group_double (fp, 51, obl_angle);
         }
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
         if (paperspace == 1)
         {
-                fprintf (fp, " 67\n%d\n", paperspace);
+                dxf_write_group_int (fp, 67, paperspace);
         }
         if (text_flags != 0)
         {
-                fprintf (fp, " 71\n%d\n", text_flags);
+                dxf_write_group_int (fp, 71, text_flags);
         }
         if (hor_align != 0)
         {
-                fprintf (fp, " 72\n%d\n", hor_align);
+                dxf_write_group_int (fp, 72, hor_align);
         }
         if (vert_align != 0)
         {
-                fprintf (fp, " 73\n%d\n", vert_align);
+                dxf_write_group_int (fp, 73, vert_align);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_text_write_lowlevel () function.\n",
@@ -572,8 +513,8 @@ dxf_text_write_lowlevel
 int
 dxf_text_write
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfText dxf_text
                 /*!< DXF text entity. */
 )
@@ -614,24 +555,24 @@ dxf_text_write
                 fprintf (stderr, "Warning in dxf_text_write () relative X-scale factor has a value of 0.0 for the %s entity with id-code: %x\n",
                         dxf_entity_name, dxf_text.common.id_code);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
-        fprintf (fp, "  1\n%s\n", dxf_text.text_value);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
+        dxf_write_group_string (fp, 1, dxf_text.text_value);
         if (dxf_text.common.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_text.common.id_code);
+                dxf_write_group_hex (fp, 5, dxf_text.common.id_code);
         }
         if (strcmp (dxf_text.common.linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", dxf_text.common.linetype);
+                dxf_write_group_string (fp, 6, dxf_text.common.linetype);
         }
         if (strcmp (dxf_text.text_style, DXF_DEFAULT_TEXTSTYLE) != 0)
         {
-                fprintf (fp, "  7\n%s\n", dxf_text.text_style);
+                dxf_write_group_string (fp, 7, dxf_text.text_style);
         }
-        fprintf (fp, "  8\n%s\n", dxf_text.common.layer);
-        fprintf (fp, " 10\n%f\n", dxf_text.x0);
-        fprintf (fp, " 20\n%f\n", dxf_text.y0);
-        fprintf (fp, " 30\n%f\n", dxf_text.z0);
+        dxf_write_group_string (fp, 8, dxf_text.common.layer);
+        dxf_write_group_double (fp, 10, dxf_text.x0);
+        dxf_write_group_double (fp, 20, dxf_text.y0);
+        dxf_write_group_double (fp, 30, dxf_text.z0);
         if ((dxf_text.hor_align != 0) || (dxf_text.vert_align != 0))
         {
                 if ((dxf_text.x0 == dxf_text.x1) && (dxf_text.y0 == dxf_text.y1) && (dxf_text.z0 == dxf_text.z1))
@@ -645,47 +586,47 @@ dxf_text_write
                 }
                 else
                 {
-                        fprintf (fp, " 11\n%f\n", dxf_text.x1);
-                        fprintf (fp, " 21\n%f\n", dxf_text.y1);
-                        fprintf (fp, " 31\n%f\n", dxf_text.z1);
+                        dxf_write_group_double (fp, 11, dxf_text.x1);
+                        dxf_write_group_double (fp, 21, dxf_text.y1);
+                        dxf_write_group_double (fp, 31, dxf_text.z1);
                 }
         }
         if (dxf_text.common.thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", dxf_text.common.thickness);
+                dxf_write_group_double (fp, 39, dxf_text.common.thickness);
         }
-        fprintf (fp, " 40\n%f\n", dxf_text.height);
+        dxf_write_group_double (fp, 40, dxf_text.height);
         if (dxf_text.rel_x_scale != 1.0)
         {
-                fprintf (fp, " 41\n%f\n", dxf_text.rel_x_scale);
+                dxf_write_group_double (fp, 41, dxf_text.rel_x_scale);
         }
         if (dxf_text.rot_angle != 0.0)
         {
-                fprintf (fp, " 50\n%f\n", dxf_text.rot_angle);
+                dxf_write_group_double (fp, 50, dxf_text.rot_angle);
         }
         if (dxf_text.obl_angle != 0.0)
         {
-                fprintf (fp, " 51\n%f\n", dxf_text.obl_angle);
+                dxf_write_group_double (fp, 51, dxf_text.obl_angle);
         }
         if (dxf_text.common.color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", dxf_text.common.color);
+                dxf_write_group_int (fp, 62, dxf_text.common.color);
         }
         if (dxf_text.common.paperspace == 1)
         {
-                fprintf (fp, " 67\n%d\n", dxf_text.common.paperspace);
+                dxf_write_group_int (fp, 67, dxf_text.common.paperspace);
         }
         if (dxf_text.text_flags != 0)
         {
-                fprintf (fp, " 71\n%d\n", dxf_text.text_flags);
+                dxf_write_group_int (fp, 71, dxf_text.text_flags);
         }
         if (dxf_text.hor_align != 0)
         {
-                fprintf (fp, " 72\n%d\n", dxf_text.hor_align);
+                dxf_write_group_int (fp, 72, dxf_text.hor_align);
         }
         if (dxf_text.vert_align != 0)
         {
-                fprintf (fp, " 73\n%d\n", dxf_text.vert_align);
+                dxf_write_group_int (fp, 73, dxf_text.vert_align);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_text_write () function.\n",
@@ -128,23 +128,36 @@ dxf_text
 DxfText *
 dxf_text_new ();
 DxfText *
+dxf_text_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_text_free
+(
+        DxfText *dxf_text
+);
+DxfText *
 dxf_text_init
 (
         DxfText *dxf_text
 );
+DxfText *
+dxf_text_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_text_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfText *dxf_text,
         int acad_version_number
 );
 int
 dxf_text_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *text_value,
         char *linetype,
@@ -170,7 +183,7 @@ dxf_text_write_lowlevel
 int
 dxf_text_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfText dxf_text
 );
 
@@ -31,6 +31,7 @@
 
 #include "global.h"
 #include "trace.h"
+#include "writer.h"
 
 /*!
  * \brief Write DXF output to a file for a trace entity.
@@ -38,8 +39,8 @@
 int
 dxf_write_trace
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< group code = 5. */
         char *linetype,
@@ -105,39 +106,39 @@ dxf_write_trace
                 fprintf (stderr, "    %s entity is relocated to layer 0", dxf_entity_name);
                 layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
-        fprintf (fp, " 11\n%f\n", x1);
-        fprintf (fp, " 21\n%f\n", y1);
-        fprintf (fp, " 31\n%f\n", z1);
-        fprintf (fp, " 12\n%f\n", x2);
-        fprintf (fp, " 22\n%f\n", y2);
-        fprintf (fp, " 32\n%f\n", z2);
-        fprintf (fp, " 13\n%f\n", x3);
-        fprintf (fp, " 23\n%f\n", y3);
-        fprintf (fp, " 33\n%f\n", z3);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
+        dxf_write_group_double (fp, 11, x1);
+        dxf_write_group_double (fp, 21, y1);
+        dxf_write_group_double (fp, 31, z1);
+        dxf_write_group_double (fp, 12, x2);
+        dxf_write_group_double (fp, 22, y2);
+        dxf_write_group_double (fp, 32, z2);
+        dxf_write_group_double (fp, 13, x3);
+        dxf_write_group_double (fp, 23, y3);
+        dxf_write_group_double (fp, 33, z3);
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
         if (paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_trace () function.\n", __FILE__, __LINE__);
@@ -151,8 +152,8 @@ dxf_write_trace
 int
 dxf_write_trace_struct
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfTrace dxf_trace
                 /*!< DXF trace entity. */
 )
@@ -168,39 +169,39 @@ dxf_write_trace_struct
                 fprintf (stderr, "    %s entity is relocated to layer 0", dxf_entity_name);
                 dxf_trace.layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (dxf_trace.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_trace.id_code);
+                dxf_write_group_hex (fp, 5, dxf_trace.id_code);
         }
         if (strcmp (dxf_trace.linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", dxf_trace.linetype);
+                dxf_write_group_string (fp, 6, dxf_trace.linetype);
         }
-        fprintf (fp, "  8\n%s\n", dxf_trace.layer);
-        fprintf (fp, " 10\n%f\n", dxf_trace.x0);
-        fprintf (fp, " 20\n%f\n", dxf_trace.y0);
-        fprintf (fp, " 30\n%f\n", dxf_trace.z0);
-        fprintf (fp, " 11\n%f\n", dxf_trace.x1);
-        fprintf (fp, " 21\n%f\n", dxf_trace.y1);
-        fprintf (fp, " 31\n%f\n", dxf_trace.z1);
-        fprintf (fp, " 12\n%f\n", dxf_trace.x2);
-        fprintf (fp, " 22\n%f\n", dxf_trace.y2);
-        fprintf (fp, " 32\n%f\n", dxf_trace.z2);
-        fprintf (fp, " 13\n%f\n", dxf_trace.x3);
-        fprintf (fp, " 23\n%f\n", dxf_trace.y3);
-        fprintf (fp, " 33\n%f\n", dxf_trace.z3);
+        dxf_write_group_string (fp, 8, dxf_trace.layer);
+        dxf_write_group_double (fp, 10, dxf_trace.x0);
+        dxf_write_group_double (fp, 20, dxf_trace.y0);
+        dxf_write_group_double (fp, 30, dxf_trace.z0);
+        dxf_write_group_double (fp, 11, dxf_trace.x1);
+        dxf_write_group_double (fp, 21, dxf_trace.y1);
+        dxf_write_group_double (fp, 31, dxf_trace.z1);
+        dxf_write_group_double (fp, 12, dxf_trace.x2);
+        dxf_write_group_double (fp, 22, dxf_trace.y2);
+        dxf_write_group_double (fp, 32, dxf_trace.z2);
+        dxf_write_group_double (fp, 13, dxf_trace.x3);
+        dxf_write_group_double (fp, 23, dxf_trace.y3);
+        dxf_write_group_double (fp, 33, dxf_trace.z3);
         if (dxf_trace.thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", dxf_trace.thickness);
+                dxf_write_group_double (fp, 39, dxf_trace.thickness);
         }
         if (dxf_trace.color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", dxf_trace.color);
+                dxf_write_group_int (fp, 62, dxf_trace.color);
         }
         if (dxf_trace.paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_write_trace_struct () function.\n", __FILE__, __LINE__);
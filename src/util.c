@@ -30,8 +30,19 @@
  */
 
 
+#ifdef HAVE_CONFIG_H
+#include "libdxf.h"
+#endif
 #include <stdarg.h>
+#if HAVE_MMAP
+#include <sys/mman.h>
+#endif
 #include "util.h"
+#include "strtod.h"
+#include "scan.h"
+#include "stream.h"
+#include "arena.h"
+#include "intern.h"
 
 
 int
@@ -63,11 +74,439 @@ dxf_read_is_string (int type)
                 return FALSE;
 }
 
+/*!
+ * \brief Maps the contents of an opened DxfFile into memory.
+ *
+ * Regular files with a size larger than zero are mapped read only, all
+ * other files (pipes, devices, empty files) are left to be read through
+ * the \c FILE handle.
+ *
+ * \return \c TRUE when the file is mapped, \c FALSE otherwise.
+ */
+static int
+dxf_read_map
+(
+        DxfFile *dxf_file
+                /*!< DXF file handle of input file (or device). */
+)
+{
+#if HAVE_MMAP
+        struct stat st;
+        void *buffer;
+
+        if (fstat (fileno (dxf_file->fp), &st) != 0)
+                return (FALSE);
+        if (!S_ISREG (st.st_mode) || (st.st_size <= 0))
+                return (FALSE);
+        buffer = mmap (NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE,
+                fileno (dxf_file->fp), 0);
+        if (buffer == MAP_FAILED)
+                return (FALSE);
+#ifdef MADV_SEQUENTIAL
+        madvise (buffer, (size_t) st.st_size, MADV_SEQUENTIAL);
+#endif
+        dxf_file->buffer = buffer;
+        dxf_file->buffer_size = (size_t) st.st_size;
+        dxf_file->buffer_length = (size_t) st.st_size;
+        dxf_file->buffer_position = 0;
+        dxf_file->mapped = TRUE;
+        return (TRUE);
+#else
+        return (FALSE);
+#endif
+}
+
+
+/*!
+ * \brief Makes room for \c size more bytes in the buffer of a DxfFile
+ * which is not memory mapped.
+ *
+ * The bytes from the last group read onwards are kept (see
+ * \c dxf_read_unread_group), the buffer grows when they do not leave
+ * enough room.
+ *
+ * \return \c TRUE when done, \c FALSE when no memory was allocated.
+ */
+static int
+dxf_read_make_room
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        size_t size
+                /*!< number of bytes. */
+)
+{
+        size_t keep;
+        size_t n;
+        char *buffer;
+
+        keep = fp->buffer_mark;
+        if (keep > 0)
+        {
+                memmove (fp->buffer, fp->buffer + keep,
+                        fp->buffer_length - keep);
+                fp->buffer_length -= keep;
+                fp->buffer_position -= keep;
+                fp->buffer_mark = 0;
+                /* The line ends found so far have moved, the lines which
+                 * were not read yet are scanned again. */
+                fp->line_count = 0;
+                fp->line_index = 0;
+                fp->lines_start = fp->buffer_position;
+                fp->lines_scanned = fp->buffer_position;
+        }
+        if (fp->buffer_size - fp->buffer_length < size)
+        {
+                n = (fp->buffer_size > 0) ? 2 * fp->buffer_size
+                        : DXF_READ_BUFFER_SIZE;
+                while (n - fp->buffer_length < size)
+                        n *= 2;
+                buffer = realloc (fp->buffer, n);
+                if (!buffer)
+                {
+                        fprintf (stderr, "Error: could not allocate memory for the read buffer of: %s.\n",
+                                fp->filename);
+                        return (FALSE);
+                }
+                fp->buffer = buffer;
+                fp->buffer_size = n;
+        }
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Refills the buffer of a DxfFile which is not memory mapped.
+ *
+ * The bytes from the last group read onwards are kept (see
+ * \c dxf_read_unread_group), the buffer grows when a single line does
+ * not fit.
+ *
+ * \return \c TRUE when bytes were added, \c FALSE at the end of the file
+ * or when an error occurred.
+ */
+static int
+dxf_read_fill
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+        size_t n;
+
+        if (fp->mapped || !fp->fp)
+                return (FALSE);
+        if (!dxf_read_make_room (fp, 1))
+                return (FALSE);
+        if (fp->stream)
+        {
+                if (dxf_stream_read (fp->stream, fp->fp,
+                        fp->buffer + fp->buffer_length,
+                        fp->buffer_size - fp->buffer_length, &n) != EXIT_SUCCESS)
+                        n = 0;
+        }
+        else
+                n = fread (fp->buffer + fp->buffer_length, 1,
+                        fp->buffer_size - fp->buffer_length, fp->fp);
+        if (ferror (fp->fp))
+        {
+                fprintf (stderr, "Error: while reading from: %s in line: %d.\n",
+                        fp->filename, fp->line_number);
+                return (FALSE);
+        }
+        fp->buffer_length += n;
+        return (n > 0);
+}
+
+
+/*!
+ * \brief Remembers the current position in a DxfFile for
+ * \c dxf_read_unread_group.
+ */
+static void
+dxf_read_mark
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+        fp->buffer_mark = fp->buffer_position;
+        fp->mark_line_number = fp->line_number;
+}
+
+
+/*!
+ * \brief Frees the blocks of borrowed strings of a DxfFile.
+ */
+static void
+dxf_read_free_strings
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+        DxfStringBlock *block;
+
+        while (fp->strings)
+        {
+                block = fp->strings;
+                fp->strings = block->next;
+                free (block);
+        }
+}
+
+
+/*!
+ * \brief Returns the type of the value of a group in a binary DXF file.
+ *
+ * \return the type which follows from the group code \c code.
+ */
+DxfBinaryType
+dxf_binary_type
+(
+        int code
+                /*!< the group code. */
+)
+{
+        if (((code >= 10) && (code <= 59))
+                || ((code >= 110) && (code <= 149))
+                || ((code >= 210) && (code <= 239))
+                || ((code >= 460) && (code <= 469))
+                || ((code >= 1010) && (code <= 1059)))
+                return (DXF_BINARY_DOUBLE);
+        if (((code >= 60) && (code <= 79))
+                || ((code >= 170) && (code <= 179))
+                || ((code >= 270) && (code <= 289))
+                || ((code >= 370) && (code <= 389))
+                || ((code >= 400) && (code <= 409))
+                || ((code >= 1060) && (code <= 1070)))
+                return (DXF_BINARY_INT16);
+        if (((code >= 90) && (code <= 99))
+                || ((code >= 420) && (code <= 429))
+                || ((code >= 440) && (code <= 459))
+                || (code == 1071))
+                return (DXF_BINARY_INT32);
+        if ((code >= 160) && (code <= 169))
+                return (DXF_BINARY_INT64);
+        if ((code >= 290) && (code <= 299))
+                return (DXF_BINARY_INT8);
+        if (((code >= 310) && (code <= 319)) || (code == 1004))
+                return (DXF_BINARY_CHUNK);
+        return (DXF_BINARY_TEXT);
+}
+
+
+/*!
+ * \brief Detects a compressed (gzip, zstd) DXF file from its magic bytes.
+ *
+ * A compressed file is not memory mapped, it is decompressed into the
+ * buffer by \c dxf_read_fill.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the
+ * compression is not supported.
+ */
+static int
+dxf_read_detect_compression
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+        char magic[4];
+        size_t n;
+        int compression;
+
+        if (fp->mapped)
+        {
+                if (dxf_stream_detect (fp->buffer, fp->buffer_length)
+                        == DXF_COMPRESSION_NONE)
+                        return (EXIT_SUCCESS);
+#if HAVE_MMAP
+                munmap (fp->buffer, fp->buffer_size);
+#endif
+                fp->buffer = NULL;
+                fp->buffer_size = 0;
+                fp->buffer_length = 0;
+                fp->mapped = FALSE;
+        }
+        /* The bytes of a pipe can not be read twice, they are handed to
+         * the decompressor or kept in the buffer. */
+        n = fread (magic, 1, sizeof (magic), fp->fp);
+        compression = dxf_stream_detect (magic, n);
+        if (compression != DXF_COMPRESSION_NONE)
+        {
+                fp->stream = dxf_stream_read_open (compression, magic, n);
+                return (fp->stream ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+        if (n > 0)
+        {
+                fp->buffer = malloc (DXF_READ_BUFFER_SIZE);
+                if (!fp->buffer)
+                        return (EXIT_FAILURE);
+                memcpy (fp->buffer, magic, n);
+                fp->buffer_size = DXF_READ_BUFFER_SIZE;
+                fp->buffer_length = n;
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Detects a binary DXF file from its sentinel.
+ *
+ * The size of the group codes follows from the first group ("  0"
+ * "SECTION" or a "999" comment): the second byte of a 2 byte group code
+ * is a small number, where a 1 byte group code is followed by text or
+ * by the 2 bytes of an extended group code (255).
+ */
+void
+dxf_read_detect
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+        const unsigned char *p;
+
+        if (!fp->mapped)
+                dxf_read_fill (fp);
+        if ((fp->buffer_length < DXF_BINARY_SENTINEL_LENGTH + 2)
+                || (memcmp (fp->buffer, DXF_BINARY_SENTINEL,
+                        DXF_BINARY_SENTINEL_LENGTH) != 0))
+                return;
+        p = (const unsigned char *) fp->buffer + DXF_BINARY_SENTINEL_LENGTH;
+        fp->binary = ((p[0] != 255) && (p[1] < ' ')) ? 2 : 1;
+        fp->buffer_position = DXF_BINARY_SENTINEL_LENGTH;
+}
+
+
+/*!
+ * \brief Makes sure that \c size bytes from the current position are in
+ * the buffer of a DxfFile.
+ *
+ * \return \c TRUE when the bytes are in the buffer, \c FALSE at the end
+ * of the file or when an error occurred.
+ */
+static int
+dxf_read_binary_ensure
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        size_t size
+                /*!< number of bytes. */
+)
+{
+        while (fp->buffer_length - fp->buffer_position < size)
+        {
+                if (!dxf_read_fill (fp))
+                        return (FALSE);
+        }
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Reads the next group from a binary DXF file.
+ *
+ * The value of \c group is a slice with the raw value, its type follows
+ * from the group code (see \c dxf_binary_type).\n
+ * The line number counter is incremented by two, like for the group code
+ * and value lines of an ASCII DXF file.
+ *
+ * \return \c TRUE when a group was read, \c FALSE at the end of the file
+ * or when the value is incomplete.
+ */
+static int
+dxf_read_binary_group
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        DxfGroup *group
+                /*!< group to store the group code and value in. */
+)
+{
+        const unsigned char *p;
+        const char *end = NULL;
+        size_t n;
+        size_t size;
+        int complete;
+
+        if (!dxf_read_binary_ensure (fp, fp->binary))
+                return (FALSE);
+        p = (const unsigned char *) fp->buffer + fp->buffer_position;
+        n = fp->binary;
+        if (n == 2)
+                group->code = (short) (p[0] | (p[1] << 8));
+        else if (p[0] != 255)
+                group->code = p[0];
+        else
+        {
+                /* An extended group code of 2 bytes. */
+                n = 3;
+                complete = dxf_read_binary_ensure (fp, n);
+                p = (const unsigned char *) fp->buffer + fp->buffer_position;
+                group->code = complete ? (short) (p[1] | (p[2] << 8)) : 255;
+        }
+        group->binary = dxf_binary_type (group->code);
+        switch (group->binary)
+        {
+                case DXF_BINARY_TEXT:
+                        /* The terminating null character is skipped. */
+                        complete = dxf_read_binary_ensure (fp, n + 1);
+                        while (complete && ((end = memchr (fp->buffer + fp->buffer_position + n,
+                                '\0', fp->buffer_length - fp->buffer_position - n)) == NULL))
+                                complete = dxf_read_fill (fp);
+                        group->length = complete
+                                ? (size_t) (end - (fp->buffer + fp->buffer_position + n))
+                                : 0;
+                        size = group->length + 1;
+                        break;
+                case DXF_BINARY_DOUBLE:
+                case DXF_BINARY_INT64:
+                        size = group->length = 8;
+                        break;
+                case DXF_BINARY_INT32:
+                        size = group->length = 4;
+                        break;
+                case DXF_BINARY_INT16:
+                        size = group->length = 2;
+                        break;
+                case DXF_BINARY_INT8:
+                        size = group->length = 1;
+                        break;
+                case DXF_BINARY_CHUNK:
+                default:
+                        /* The value is preceded by its length. */
+                        complete = dxf_read_binary_ensure (fp, n + 1);
+                        size = group->length = complete
+                                ? (unsigned char) fp->buffer[fp->buffer_position + n]
+                                : 0;
+                        n++;
+                        break;
+        }
+        if (!dxf_read_binary_ensure (fp, n + size))
+        {
+                fprintf (stderr, "Error: missing value for group code %d while reading from: %s in line: %d.\n",
+                        group->code, fp->filename, fp->line_number + 2);
+                return (FALSE);
+        }
+        group->value = fp->buffer + fp->buffer_position + n;
+        fp->buffer_position += n + size;
+        fp->line_number += 2;
+        return (TRUE);
+}
+
+
 /*!
  * \brief Opens a DxfFile, does error checking and resets the line number
  * counter.
  * 
- * Reset the line counting to 0.
+ * Reset the line counting to 0.\n
+ * The file is memory mapped when possible, see \c dxf_read_next_line.\n
+ * A gzip or zstd compressed file is detected from its magic bytes and
+ * decompressed while it is read.\n
+ * A binary DXF file is detected from its sentinel, see
+ * \c dxf_read_group.
  * 
  */
 DxfFile *
@@ -93,9 +532,25 @@ dxf_read_init (const char *filename)
                 return (NULL);
         }
         dxf_file = malloc (sizeof(DxfFile));
+        if (!dxf_file)
+        {
+                fprintf (stderr, "Error: could not allocate memory for a DxfFile struct.\n");
+                fclose (fp);
+                return (NULL);
+        }
+        memset (dxf_file, 0, sizeof (DxfFile));
         dxf_file->fp = fp;
         dxf_file->filename = strdup(filename);
         dxf_file->line_number = 0;
+        dxf_read_map (dxf_file);
+        if (dxf_read_detect_compression (dxf_file) != EXIT_SUCCESS)
+        {
+                fprintf (stderr, "Error: could not read the compressed file: %s.\n",
+                        filename);
+                dxf_read_close (dxf_file);
+                return (NULL);
+        }
+        dxf_read_detect (dxf_file);
         /*! \todo FIXME: dxf header and blocks need initialized ?
         dxf_header_init (dxf_file->dxf_header);
         dxf_block_init (dxf_file->dxf_block);
@@ -104,13 +559,158 @@ dxf_read_init (const char *filename)
 }
 
 
+
+/*!
+ * \brief Opens a DxfFile on the contents of a DXF file which are in
+ * memory already.
+ *
+ * The lines are read from \c data without copying them. With \c owned
+ * \c data must have been allocated with \c malloc and is freed by
+ * \c dxf_read_close, otherwise \c data must stay valid until the
+ * DxfFile is closed.\n
+ * Binary DXF data is read like a binary DXF file, gzip or zstd
+ * compressed data is decompressed into a buffer of its own (after which
+ * \c data is no longer needed).
+ *
+ * \return \c NULL when no memory was allocated or the compressed data
+ * could not be read, a pointer to the DxfFile when succesful.
+ */
+DxfFile *
+dxf_read_memory
+(
+        const char *data,
+                /*!< the contents of the DXF file. */
+        size_t length,
+                /*!< number of bytes in \c data. */
+        int owned
+                /*!< \c TRUE when the DxfFile takes \c data over,
+                 * \c FALSE when \c data is borrowed. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_read_memory () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfFile *dxf_file;
+        int ret = EXIT_SUCCESS;
+
+        if (!data && (length > 0))
+        {
+                fprintf (stderr, "Error in dxf_read_memory () data is not initialised (NULL pointer).\n");
+                return (NULL);
+        }
+        dxf_file = malloc (sizeof (DxfFile));
+        if (!dxf_file)
+        {
+                fprintf (stderr, "Error: could not allocate memory for a DxfFile struct.\n");
+                if (owned)
+                        free ((char *) data);
+                return (NULL);
+        }
+        memset (dxf_file, 0, sizeof (DxfFile));
+        dxf_file->filename = strdup ("(memory)");
+        if (dxf_stream_detect (data, length) == DXF_COMPRESSION_NONE)
+        {
+                dxf_file->buffer = (char *) data;
+                dxf_file->buffer_size = length;
+                dxf_file->buffer_length = length;
+                dxf_file->borrowed = !owned;
+                dxf_file->memory = TRUE;
+        }
+        else
+        {
+                /* Decompress everything now through a file handle on
+                 * data, the buffer is complete afterwards. */
+                dxf_file->fp = fmemopen ((char *) data, length, "r");
+                if (!dxf_file->fp
+                        || (dxf_read_detect_compression (dxf_file) != EXIT_SUCCESS)
+                        || (dxf_read_load (dxf_file) != EXIT_SUCCESS))
+                {
+                        fprintf (stderr, "Error in dxf_read_memory () could not read the compressed data.\n");
+                        ret = EXIT_FAILURE;
+                }
+                if (owned)
+                        free ((char *) data);
+                dxf_file->memory = TRUE;
+        }
+        if (ret != EXIT_SUCCESS)
+        {
+                dxf_read_close (dxf_file);
+                return (NULL);
+        }
+        dxf_read_detect (dxf_file);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_read_memory () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_file);
+}
+
+
+/*!
+ * \brief Opens a DxfFile on a part of the buffer of another DxfFile.
+ *
+ * The lines from offset \c start up to offset \c end of the buffer of
+ * \c fp are read, without copying them. \c start has to be the start of
+ * a line.\n
+ * The line numbers start at 0, the view is valid as long as \c fp is
+ * open and must be closed with \c dxf_read_close.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * DxfFile when succesful.
+ */
+DxfFile *
+dxf_read_view
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        size_t start,
+                /*!< offset of the first line in the buffer of \c fp. */
+        size_t end
+                /*!< offset after the last line in the buffer of \c fp. */
+)
+{
+        DxfFile *dxf_file;
+
+        dxf_file = malloc (sizeof (DxfFile));
+        if (!dxf_file)
+        {
+                fprintf (stderr, "Error: could not allocate memory for a DxfFile struct.\n");
+                return (NULL);
+        }
+        memset (dxf_file, 0, sizeof (DxfFile));
+        dxf_file->filename = strdup (fp->filename);
+        dxf_file->buffer = fp->buffer + start;
+        dxf_file->buffer_size = end - start;
+        dxf_file->buffer_length = end - start;
+        dxf_file->borrowed = TRUE;
+        dxf_file->binary = fp->binary;
+        return (dxf_file);
+}
+
 void
 dxf_read_close (DxfFile *dxf_file)
 {
-        /*! \todo FIXME: how to free other sub structures */
+        /*! \todo FIXME: how to free other sub structures, entities read
+         * into the arena of the file are freed with the arena (see
+         * \c dxf_arena_free). */
         if (dxf_file != NULL)
         {
-                fclose (dxf_file->fp);
+                if (dxf_file->borrowed)
+                        ;
+#if HAVE_MMAP
+                else if (dxf_file->mapped)
+                        munmap (dxf_file->buffer, dxf_file->buffer_size);
+#endif
+                else
+                        free (dxf_file->buffer);
+                free (dxf_file->lines);
+                free (dxf_file->sections);
+                dxf_read_free_strings (dxf_file);
+                dxf_intern_free (dxf_file->names);
+                dxf_stream_close (dxf_file->stream);
+                if (dxf_file->fp)
+                        fclose (dxf_file->fp);
                 free (dxf_file->filename);
                 free (dxf_file);
                 dxf_file = NULL;
@@ -119,66 +719,1133 @@ dxf_read_close (DxfFile *dxf_file)
 
 
 /*!
- * \brief Reads a line from a file.
- * 
- * Reads the next line from \c fp file and stores it into the temp_string.
- * 
+ * \brief Reads the remainder of a DxfFile which is not memory mapped into
+ * its buffer.
+ *
+ * Afterwards the buffer holds the file from the last group read onwards
+ * and is never refilled, so offsets in the buffer stay valid (see
+ * \c dxf_read_seek).\n
+ * Memory mapped files and views are complete already.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
  */
 int
-dxf_read_line (char * temp_string, DxfFile *fp)
+dxf_read_load
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
 {
-        int ret;
+        size_t mark;
 
-        ret = fscanf (fp->fp, "%[^\n]\n", temp_string);
-        if (ferror (fp->fp))
+        if (fp->mapped || !fp->fp)
+                return (EXIT_SUCCESS);
+        /* Drop what was read before the last group once, then only let
+         * the buffer grow. */
+        if (fp->buffer_mark > 0)
+                dxf_read_fill (fp);
+        mark = fp->buffer_mark;
+        fp->buffer_mark = 0;
+        while (dxf_read_fill (fp))
+                ;
+        fp->buffer_mark = mark;
+        if (fp->stream ? !dxf_stream_eof (fp->stream) : !feof (fp->fp))
+                return (EXIT_FAILURE);
+        dxf_stream_close (fp->stream);
+        fp->stream = NULL;
+        fclose (fp->fp);
+        fp->fp = NULL;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Moves the position of a DxfFile to \c offset in its buffer.
+ *
+ * The next line read starts at \c offset, \c line_number is the number
+ * of the line before it.\n
+ * Only a complete buffer can be seeked, see \c dxf_read_load.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the buffer
+ * is refilled from the file or \c offset is outside of the buffer.
+ */
+int
+dxf_read_seek
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        size_t offset,
+                /*!< offset of the start of a line in the buffer. */
+        int line_number
+                /*!< line number of the line before \c offset. */
+)
+{
+        if ((!fp->mapped && fp->fp) || (offset > fp->buffer_length))
         {
-                fprintf (stderr, "Error: while reading from: %s in line: %d.\n",
-                        fp->filename, fp->line_number);
+                fprintf (stderr, "Error in dxf_read_seek () can not seek in: %s.\n",
+                        fp->filename);
+                return (EXIT_FAILURE);
+        }
+        fp->buffer_position = offset;
+        fp->line_number = line_number;
+        dxf_read_mark (fp);
+        fp->line_count = 0;
+        fp->line_index = 0;
+        fp->lines_start = offset;
+        fp->lines_scanned = offset;
+        fp->binary_value = FALSE;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Appends bytes which were received to the buffer of a DxfFile
+ * without a file handle (see \c dxf_push_parser_feed).
+ *
+ * The bytes before the last group read are dropped first, as when the
+ * buffer is refilled from a file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * was allocated.
+ */
+int
+dxf_read_append
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        const char *data,
+                /*!< the bytes. */
+        size_t length
+                /*!< number of bytes in \c data. */
+)
+{
+        if (fp->mapped || fp->borrowed || fp->memory || fp->fp)
+        {
+                fprintf (stderr, "Error in dxf_read_append () can not append to: %s.\n",
+                        fp->filename);
+                return (EXIT_FAILURE);
+        }
+        if (length == 0)
+                return (EXIT_SUCCESS);
+        if (!dxf_read_make_room (fp, length))
                 return (EXIT_FAILURE);
+        memcpy (fp->buffer + fp->buffer_length, data, length);
+        fp->buffer_length += length;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Returns the size of the group at \c offset in the buffer of a
+ * DxfFile, when the buffer holds the complete group.
+ *
+ * The buffer is not refilled.
+ *
+ * \return the number of bytes of the group (both lines of a group of an
+ * ASCII DXF file), or 0 when the group is incomplete.
+ */
+size_t
+dxf_read_group_size
+(
+        const DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        size_t offset
+                /*!< offset of a group in the buffer. */
+)
+{
+        const char *start;
+        const char *end;
+        const unsigned char *p;
+        size_t available;
+        size_t n;
+        size_t size;
+        int code;
+
+        if (offset >= fp->buffer_length)
+                return (0);
+        start = fp->buffer + offset;
+        available = fp->buffer_length - offset;
+        if (!fp->binary)
+        {
+                end = memchr (start, '\n', available);
+                if (end)
+                        end = memchr (end + 1, '\n', available - (size_t) (end + 1 - start));
+                return (end ? (size_t) (end + 1 - start) : 0);
         }
-        if (ret)
+        p = (const unsigned char *) start;
+        n = fp->binary;
+        if (available < n)
+                return (0);
+        if (n == 2)
+                code = (short) (p[0] | (p[1] << 8));
+        else if (p[0] != 255)
+                code = p[0];
+        else
         {
-                fp->line_number++;
+                n = 3;
+                if (available < n)
+                        return (0);
+                code = (short) (p[1] | (p[2] << 8));
         }
-        return ret;
+        switch (dxf_binary_type (code))
+        {
+                case DXF_BINARY_TEXT:
+                        end = memchr (start + n, '\0', available - n);
+                        return (end ? (size_t) (end + 1 - start) : 0);
+                case DXF_BINARY_DOUBLE:
+                case DXF_BINARY_INT64:
+                        size = 8;
+                        break;
+                case DXF_BINARY_INT32:
+                        size = 4;
+                        break;
+                case DXF_BINARY_INT16:
+                        size = 2;
+                        break;
+                case DXF_BINARY_INT8:
+                        size = 1;
+                        break;
+                case DXF_BINARY_CHUNK:
+                default:
+                        if (available < n + 1)
+                                return (0);
+                        size = (size_t) p[n] + 1;
+                        break;
+        }
+        return ((available >= n + size) ? n + size : 0);
+}
+
+
+/*!
+ * \brief Tests for the end of a DxfFile.
+ *
+ * \return \c TRUE when all lines have been read, \c FALSE otherwise.
+ */
+int
+dxf_read_eof (DxfFile *fp)
+{
+        if (fp->binary_value)
+                return (FALSE);
+        if (fp->buffer_position < fp->buffer_length)
+                return (FALSE);
+        return (!dxf_read_fill (fp));
+}
+
+
+/*!
+ * \brief Locates the next line ends in the buffer of a DxfFile.
+ *
+ * Up to \c DXF_READ_LINES line ends from the current position onwards
+ * are stored in \c lines, see \c dxf_scan_lines.
+ *
+ * \return \c TRUE when a line end was found, \c FALSE when the buffer
+ * contains no more line ends (or no memory was allocated).
+ */
+static int
+dxf_read_scan
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+        if (!fp->lines)
+        {
+                fp->lines = malloc (DXF_READ_LINES * sizeof (size_t));
+                if (!fp->lines)
+                {
+                        fprintf (stderr, "Error: could not allocate memory for the line ends of: %s.\n",
+                                fp->filename);
+                        return (FALSE);
+                }
+        }
+        if (fp->lines_scanned < fp->buffer_position)
+                fp->lines_scanned = fp->buffer_position;
+        fp->lines_start = fp->buffer_position;
+        fp->line_index = 0;
+        fp->line_count = dxf_scan_lines (fp->buffer, fp->lines_scanned,
+                fp->buffer_length, fp->lines, DXF_READ_LINES,
+                &fp->lines_scanned);
+        return (fp->line_count > 0);
+}
+
+
+static long long dxf_binary_get_integer (const DxfGroup *group);
+
+
+/*!
+ * \brief Decodes the raw little-endian floating point value of a group
+ * of a binary DXF file.
+ *
+ * \return the value, integers are converted.
+ */
+static double
+dxf_binary_get_double
+(
+        const DxfGroup *group
+                /*!< group read with \c dxf_read_group. */
+)
+{
+        const unsigned char *p = (const unsigned char *) group->value;
+        unsigned long long bits = 0;
+        double value;
+        int i;
+
+        if (group->binary != DXF_BINARY_DOUBLE)
+                return ((double) dxf_binary_get_integer (group));
+        for (i = 7; i >= 0; i--)
+                bits = (bits << 8) | p[i];
+        memcpy (&value, &bits, sizeof (value));
+        return (value);
+}
+
+
+/*!
+ * \brief Decodes the raw little-endian integer value of a group of a
+ * binary DXF file.
+ *
+ * \return the value, floating point numbers are truncated.
+ */
+static long long
+dxf_binary_get_integer
+(
+        const DxfGroup *group
+                /*!< group read with \c dxf_read_group. */
+)
+{
+        const unsigned char *p = (const unsigned char *) group->value;
+        unsigned long long value = 0;
+        size_t i;
+
+        if (group->binary == DXF_BINARY_DOUBLE)
+                return ((long long) dxf_binary_get_double (group));
+        for (i = group->length; i > 0; i--)
+                value = (value << 8) | p[i - 1];
+        switch (group->binary)
+        {
+                case DXF_BINARY_INT16:
+                        return ((short) value);
+                case DXF_BINARY_INT32:
+                        return ((int) value);
+                case DXF_BINARY_INT8:
+                case DXF_BINARY_INT64:
+                        return ((long long) value);
+                default:
+                        return (0);
+        }
+}
+
+
+/*!
+ * \brief Formats the raw value of a group of a binary DXF file like the
+ * value line of an ASCII DXF file.
+ *
+ * Binary data is formatted as hexadecimal digits.
+ *
+ * \return the number of characters in \c text.
+ */
+static size_t
+dxf_group_format
+(
+        const DxfGroup *group,
+                /*!< group read with \c dxf_read_group. */
+        char *text,
+                /*!< buffer of \c DXF_BINARY_LINE_LENGTH characters. */
+        size_t size
+                /*!< size of \c text. */
+)
+{
+        static const char digits[] = "0123456789ABCDEF";
+        const unsigned char *p = (const unsigned char *) group->value;
+        size_t i;
+        int n;
+
+        switch (group->binary)
+        {
+                case DXF_BINARY_TEXT:
+                        n = snprintf (text, size, "%.*s", (int) group->length, group->value);
+                        break;
+                case DXF_BINARY_DOUBLE:
+                        n = snprintf (text, size, "%.17g", dxf_binary_get_double (group));
+                        break;
+                case DXF_BINARY_CHUNK:
+                        for (i = 0; (i < group->length) && (2 * i + 2 < size); i++)
+                        {
+                                text[2 * i] = digits[p[i] >> 4];
+                                text[2 * i + 1] = digits[p[i] & 0x0f];
+                        }
+                        text[2 * i] = '\0';
+                        n = (int) (2 * i);
+                        break;
+                default:
+                        n = snprintf (text, size, "%lld", dxf_binary_get_integer (group));
+                        break;
+        }
+        if (n < 0)
+                n = 0;
+        return (((size_t) n < size) ? (size_t) n : size - 1);
+}
+
+
+/*!
+ * \brief Returns a group with the raw value of \c group formatted as
+ * text.
+ *
+ * \return \c group when its value is text already, \c text otherwise.
+ */
+static const DxfGroup *
+dxf_group_text
+(
+        const DxfGroup *group,
+                /*!< group read with \c dxf_read_group. */
+        DxfGroup *text,
+                /*!< group to store the formatted value in. */
+        char *line
+                /*!< buffer of \c DXF_BINARY_LINE_LENGTH characters. */
+)
+{
+        if (group->binary == DXF_BINARY_TEXT)
+                return (group);
+        text->code = group->code;
+        text->value = line;
+        text->length = dxf_group_format (group, line, DXF_BINARY_LINE_LENGTH);
+        text->binary = DXF_BINARY_TEXT;
+        return (text);
+}
+
+
+/*!
+ * \brief Reads the next line from a binary DXF file.
+ *
+ * Every group is read as a group code line ("  0") and a value line
+ * formatted with \c dxf_group_format, text values are not copied.
+ *
+ * \return \c TRUE when a line was read, \c FALSE at the end of the file
+ * or when an error occurred.
+ */
+static int
+dxf_read_binary_line
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        const char **line,
+                /*!< first character of the line read. */
+        size_t *length
+                /*!< number of characters in the line read. */
+)
+{
+        int n;
+
+        if (!fp->binary_value)
+        {
+                if (!dxf_read_binary_group (fp, &fp->binary_group))
+                        return (FALSE);
+                fp->line_number--;
+                n = snprintf (fp->binary_line, DXF_BINARY_LINE_LENGTH, "%3d",
+                        fp->binary_group.code);
+                *line = fp->binary_line;
+                *length = (size_t) n;
+                fp->binary_value = TRUE;
+                return (TRUE);
+        }
+        fp->binary_value = FALSE;
+        fp->line_number++;
+        if (fp->binary_group.binary == DXF_BINARY_TEXT)
+        {
+                *line = fp->binary_group.value;
+                *length = fp->binary_group.length;
+        }
+        else
+        {
+                *line = fp->binary_line;
+                *length = dxf_group_format (&fp->binary_group, fp->binary_line,
+                        DXF_BINARY_LINE_LENGTH);
+        }
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Reads the next line from a DxfFile without copying it.
+ *
+ * \c line points into the buffer of the DxfFile, the line ends are
+ * located in bulk by \c dxf_read_scan.\n
+ * A trailing carriage return (CRLF files) is not part of the line, nor
+ * are trailing spaces and tabs.\n
+ * The groups of a binary DXF file are handed out as two lines, see
+ * \c dxf_read_binary_line.\n
+ * The line number counter is incremented for every line read.
+ *
+ * \return \c TRUE when a line was read, \c FALSE at the end of the file
+ * or when an error occurred.
+ */
+int
+dxf_read_next_line
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        const char **line,
+                /*!< first character of the line read. */
+        size_t *length
+                /*!< number of characters in the line read. */
+)
+{
+        const char *start;
+        size_t len;
+
+        if (fp->binary)
+                return (dxf_read_binary_line (fp, line, length));
+        while (fp->line_index >= fp->line_count)
+        {
+                if ((fp->lines_scanned < fp->buffer_length)
+                        && dxf_read_scan (fp))
+                        break;
+                if (!dxf_read_fill (fp))
+                        break;
+        }
+        start = fp->buffer + fp->buffer_position;
+        if (fp->line_index < fp->line_count)
+        {
+                len = fp->lines[fp->line_index++] - fp->buffer_position;
+                fp->buffer_position += len + 1;
+        }
+        else
+        {
+                if (fp->buffer_position >= fp->buffer_length)
+                        return (FALSE);
+                /* Last line without a line terminator. */
+                len = fp->buffer_length - fp->buffer_position;
+                fp->buffer_position = fp->buffer_length;
+        }
+        while ((len > 0) && ((start[len - 1] == '\r')
+                || (start[len - 1] == ' ') || (start[len - 1] == '\t')))
+                len--;
+        fp->line_number++;
+        *line = start;
+        *length = len;
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Reads the next group (a group code and its value) from a
+ * DxfFile.
+ *
+ * The group code line may be padded with spaces ("  0", " 10").\n
+ * The value of \c group is a slice which is only valid until the next
+ * line is read from \c fp.\n
+ * The values of a binary DXF file are raw, see \c dxf_binary_type, the
+ * \c dxf_group_get_ functions accept both.
+ *
+ * \return \c TRUE when a group was read, \c FALSE at the end of the file
+ * or when the group code is not a number.
+ */
+int
+dxf_read_group
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        DxfGroup *group
+                /*!< group to store the group code and value in. */
+)
+{
+        const char *line;
+        size_t length;
+        size_t i;
+        int code;
+        int negative;
+        int digits;
+
+        dxf_read_mark (fp);
+        if (fp->binary)
+        {
+                fp->binary_value = FALSE;
+                return (dxf_read_binary_group (fp, group));
+        }
+        if (!dxf_read_next_line (fp, &line, &length))
+                return (FALSE);
+        i = 0;
+        while ((i < length) && isspace ((unsigned char) line[i]))
+                i++;
+        negative = FALSE;
+        if ((i < length) && (line[i] == '-'))
+        {
+                negative = TRUE;
+                i++;
+        }
+        code = 0;
+        digits = 0;
+        while ((i < length) && (line[i] >= '0') && (line[i] <= '9'))
+        {
+                code = (code * 10) + (line[i] - '0');
+                digits++;
+                i++;
+        }
+        while ((i < length) && isspace ((unsigned char) line[i]))
+                i++;
+        if ((digits == 0) || (i != length))
+        {
+                fprintf (stderr, "Error: invalid group code while reading from: %s in line: %d.\n",
+                        fp->filename, fp->line_number);
+                return (FALSE);
+        }
+        group->code = negative ? -code : code;
+        group->binary = DXF_BINARY_TEXT;
+        if (!dxf_read_next_line (fp, &group->value, &group->length))
+        {
+                fprintf (stderr, "Error: missing value for group code %d while reading from: %s in line: %d.\n",
+                        group->code, fp->filename, fp->line_number);
+                return (FALSE);
+        }
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Pushes the last group read back into a DxfFile.
+ *
+ * The next call to \c dxf_read_group returns the same group again.\n
+ * This is used by readers which stop at the group code 0 announcing the
+ * next entity, so the caller can read the name of that entity.
+ */
+void
+dxf_read_unread_group
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+        fp->buffer_position = fp->buffer_mark;
+        fp->line_number = fp->mark_line_number;
+        fp->binary_value = FALSE;
+        /* Step back over the line ends of the group in \c lines, or
+         * start a new scan when the group was read before it. */
+        if (fp->buffer_position < fp->lines_start)
+        {
+                fp->line_count = 0;
+                fp->line_index = 0;
+                fp->lines_scanned = fp->buffer_position;
+        }
+        while ((fp->line_index > 0)
+                && (fp->lines[fp->line_index - 1] >= fp->buffer_position))
+                fp->line_index--;
+}
+
+
+/*!
+ * \brief Parses the value of a group as a decimal integer.
+ *
+ * \return the value, or 0 when the value does not start with a number.
+ */
+int
+dxf_group_get_int
+(
+        const DxfGroup *group
+                /*!< group read with \c dxf_read_group. */
+)
+{
+        const char *p = group->value;
+        const char *end = group->value + group->length;
+        int value = 0;
+        int negative = FALSE;
+
+        if (group->binary != DXF_BINARY_TEXT)
+                return ((int) dxf_binary_get_integer (group));
+        while ((p < end) && isspace ((unsigned char) *p))
+                p++;
+        if ((p < end) && ((*p == '-') || (*p == '+')))
+        {
+                negative = (*p == '-');
+                p++;
+        }
+        while ((p < end) && (*p >= '0') && (*p <= '9'))
+        {
+                value = (value * 10) + (*p - '0');
+                p++;
+        }
+        return (negative ? -value : value);
+}
+
+
+/*!
+ * \brief Parses the value of a group as a hexadecimal number of up to 64
+ * bits (handles).
+ *
+ * \return the value, or 0 when the value does not start with a
+ * hexadecimal digit.
+ */
+uint64_t
+dxf_group_get_handle
+(
+        const DxfGroup *group
+                /*!< group read with \c dxf_read_group. */
+)
+{
+        const char *p = group->value;
+        const char *end = group->value + group->length;
+        uint64_t value = 0;
+        int digit;
+
+        if (group->binary != DXF_BINARY_TEXT)
+                return ((uint64_t) dxf_binary_get_integer (group));
+        while ((p < end) && isspace ((unsigned char) *p))
+                p++;
+        while (p < end)
+        {
+                if ((*p >= '0') && (*p <= '9'))
+                        digit = *p - '0';
+                else if ((*p >= 'a') && (*p <= 'f'))
+                        digit = *p - 'a' + 10;
+                else if ((*p >= 'A') && (*p <= 'F'))
+                        digit = *p - 'A' + 10;
+                else
+                        break;
+                value = (value << 4) | (uint64_t) digit;
+                p++;
+        }
+        return (value);
+}
+
+
+/*!
+ * \brief Parses the value of a group as a hexadecimal number (handles).
+ *
+ * Only the lower 32 bits of the handle are returned, for the \c int
+ * id-codes of the entities, see \c dxf_group_get_handle for all of it.
+ *
+ * \return the value, or 0 when the value does not start with a
+ * hexadecimal digit.
+ */
+int
+dxf_group_get_hex
+(
+        const DxfGroup *group
+                /*!< group read with \c dxf_read_group. */
+)
+{
+        return ((int) (uint32_t) dxf_group_get_handle (group));
+}
+
+
+/*!
+ * \brief Parses the value of a group as a floating point number.
+ *
+ * The decimal point is always a '.', see \c dxf_strtod.
+ *
+ * \return the value, or 0.0 when the value is not a number.
+ */
+double
+dxf_group_get_double
+(
+        const DxfGroup *group
+                /*!< group read with \c dxf_read_group. */
+)
+{
+        double value;
+
+        if (group->binary != DXF_BINARY_TEXT)
+                return (dxf_binary_get_double (group));
+        dxf_strtod (group->value, group->length, &value);
+        return (value);
+}
+
+
+/*!
+ * \brief Hands out \c size bytes from the blocks of borrowed strings of
+ * \c fp, starting at a multiple of \c alignment.
+ *
+ * \return a pointer to the bytes, or \c NULL when no memory was
+ * allocated.
+ */
+static void *
+dxf_read_block
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        size_t size,
+                /*!< number of bytes. */
+        size_t alignment
+                /*!< 1 for strings, a power of 2. */
+)
+{
+        DxfStringBlock *block;
+        size_t block_size;
+        size_t start;
+        void *value;
+
+        block = fp->strings;
+        start = block ? (block->length + alignment - 1) & ~(alignment - 1) : 0;
+        if (!block || (start > block->size) || (block->size - start < size))
+        {
+                block_size = block ? 2 * block->size : DXF_READ_STRINGS_SIZE;
+                while (block_size < size)
+                        block_size *= 2;
+                block = malloc (sizeof (DxfStringBlock) + block_size);
+                if (!block)
+                {
+                        fprintf (stderr, "Error in dxf_read_block () could not allocate memory for a string.\n");
+                        return (NULL);
+                }
+                block->next = fp->strings;
+                block->size = block_size;
+                block->length = 0;
+                block->data = (char *) (block + 1);
+                fp->strings = block;
+                start = 0;
+        }
+        value = block->data + start;
+        block->length = start + size;
+        return (value);
+}
+
+
+/*!
+ * \brief Borrows \c size bytes for the entity being read, like a string
+ * stored by \c dxf_read_string when \c borrow_strings is set for \c fp.
+ *
+ * The bytes are aligned for any number and are valid until the next
+ * call of \c dxf_read_reset_strings.
+ *
+ * \return a pointer to the bytes, or \c NULL when no memory was
+ * allocated.
+ */
+void *
+dxf_read_borrow
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        size_t size
+                /*!< number of bytes. */
+)
+{
+        return (dxf_read_block (fp, size, sizeof (uint64_t)));
+}
+
+
+/*!
+ * \brief Gives the table of names the entities read from \c fp are
+ * numbered in.
+ *
+ * This is the table of the arena of \c fp, the names shared by the
+ * entities without an arena (see \c dxf_intern_shared) when the
+ * entities keep their strings, or when \c borrow_strings is set for
+ * \c fp a table of its own which is freed by \c dxf_read_close, as the
+ * entities do not outlive the file then.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the table
+ * when succesful.
+ */
+DxfIntern *
+dxf_read_names
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+        if (fp->arena)
+                return (dxf_arena_names (fp->arena));
+        if (!fp->borrow_strings)
+                return (dxf_intern_shared ());
+        if (!fp->names)
+                fp->names = dxf_intern_new ();
+        return (fp->names);
+}
+
+
+/*!
+ * \brief Copies the value of a group into a string.
+ *
+ * When \c borrow_strings is set for \c fp the string is stored in the
+ * blocks of borrowed strings of \c fp, it is valid until the next call
+ * of \c dxf_read_reset_strings and must not be freed.\n
+ * When \c fp has an arena the string is stored in the arena, it is freed
+ * with the arena.\n
+ * Otherwise the string is allocated with \c dxf_group_get_string.
+ *
+ * \return a pointer to the string, or \c NULL when no memory was
+ * allocated.
+ */
+char *
+dxf_read_string
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        const DxfGroup *group
+                /*!< group read with \c dxf_read_group. */
+)
+{
+        DxfGroup text;
+        char line[DXF_BINARY_LINE_LENGTH];
+        char *value;
+
+        if (fp->arena)
+        {
+                group = dxf_group_text (group, &text, line);
+                return (dxf_arena_strndup (fp->arena, group->value, group->length));
+        }
+        if (!fp->borrow_strings)
+                return (dxf_group_get_string (group));
+        group = dxf_group_text (group, &text, line);
+        value = dxf_read_block (fp, group->length + 1, 1);
+        if (!value)
+                return (NULL);
+        memcpy (value, group->value, group->length);
+        value[group->length] = '\0';
+        return (value);
+}
+
+
+/*!
+ * \brief Copies the value of a group into the name of a layer, linetype,
+ * text style or block.
+ *
+ * When \c fp has an arena the name is interned in the arena (see
+ * \c dxf_arena_internn), so all entities with the same name share one
+ * string. When \c borrow_strings is set for \c fp the name is copied by
+ * \c dxf_read_string, otherwise it is interned in the names shared by
+ * the entities without an arena. An interned name must not be freed.
+ *
+ * \return a pointer to the string, or \c NULL when no memory was
+ * allocated.
+ */
+char *
+dxf_read_name
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        const DxfGroup *group
+                /*!< group read with \c dxf_read_group. */
+)
+{
+        DxfGroup text;
+        char line[DXF_BINARY_LINE_LENGTH];
+
+        if (!fp->arena && fp->borrow_strings)
+                return (dxf_read_string (fp, group));
+        group = dxf_group_text (group, &text, line);
+        return (dxf_arena_internn (fp->arena, group->value, group->length));
+}
+
+
+/*!
+ * \brief Releases all borrowed strings of a DxfFile (see
+ * \c dxf_read_string).
+ *
+ * The largest block is kept for the strings of the next entity, so no
+ * memory is allocated once it is large enough.
+ */
+void
+dxf_read_reset_strings
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+        DxfStringBlock *block;
+
+        if (!fp->strings)
+                return;
+        block = fp->strings;
+        fp->strings = block->next;
+        dxf_read_free_strings (fp);
+        block->next = NULL;
+        block->length = 0;
+        fp->strings = block;
+}
+
+
+/*!
+ * \brief Tests a group for a group code and a value.
+ *
+ * \return \c TRUE when \c group has the group code \c code and the value
+ * \c value, \c FALSE otherwise.
+ */
+int
+dxf_group_is
+(
+        const DxfGroup *group,
+                /*!< group read with \c dxf_read_group. */
+        int code,
+                /*!< the group code. */
+        const char *value
+                /*!< the value. */
+)
+{
+        size_t length;
+
+        if (group->code != code)
+                return (FALSE);
+        length = strlen (value);
+        return ((group->length == length)
+                && (memcmp (group->value, value, length) == 0));
+}
+
+
+/*!
+ * \brief Tests if a line, without padding and carriage return, equals
+ * \c string.
+ *
+ * \return \c TRUE when the line equals \c string, \c FALSE otherwise.
+ */
+int
+dxf_line_is
+(
+        const char *line,
+                /*!< first character of the line. */
+        size_t length,
+                /*!< number of characters in the line. */
+        const char *string
+                /*!< the string. */
+)
+{
+        size_t n = strlen (string);
+
+        while ((length > 0) && ((*line == ' ') || (*line == '\t')))
+        {
+                line++;
+                length--;
+        }
+        while ((length > 0) && isspace ((unsigned char) line[length - 1]))
+                length--;
+        return ((length == n) && (memcmp (line, string, n) == 0));
+}
+
+
+/*!
+ * \brief Copies the value of a group into a newly allocated string.
+ *
+ * \return a pointer to the string, or \c NULL when no memory was
+ * allocated.
+ */
+char *
+dxf_group_get_string
+(
+        const DxfGroup *group
+                /*!< group read with \c dxf_read_group. */
+)
+{
+        DxfGroup text;
+        char line[DXF_BINARY_LINE_LENGTH];
+        char *value;
+
+        group = dxf_group_text (group, &text, line);
+        value = malloc (group->length + 1);
+        if (!value)
+        {
+                fprintf (stderr, "Error in dxf_group_get_string () could not allocate memory for a string.\n");
+                return (NULL);
+        }
+        memcpy (value, group->value, group->length);
+        value[group->length] = '\0';
+        return (value);
+}
+
+
+/*!
+ * \brief Reads a line from a file.
+ * 
+ * Reads the next line from \c fp file and stores it into the temp_string.\n
+ * Leading white space is skipped, the line is truncated to
+ * \c DXF_MAX_STRING_LENGTH characters (including the terminating
+ * null character).
+ *
+ * \return \c 1 when a line was read, \c EOF at the end of the file.
+ */
+int
+dxf_read_line (char * temp_string, DxfFile *fp)
+{
+        const char *line;
+        size_t length;
+
+        dxf_read_mark (fp);
+        if (!dxf_read_next_line (fp, &line, &length))
+                return (EOF);
+        while ((length > 0) && isspace ((unsigned char) *line))
+        {
+                line++;
+                length--;
+        }
+        if (length > DXF_MAX_STRING_LENGTH - 1)
+                length = DXF_MAX_STRING_LENGTH - 1;
+        memcpy (temp_string, line, length);
+        temp_string[length] = '\0';
+        return (1);
 }
 
 /*!
  * \brief Uses of fscanf with other features.
  * 
- * Uses fscanf for file parsing, but also tracks the lines it reads;
+ * Scans as many lines as there are newline characters in \c template
+ * from \c fp, and parses these lines with \c vsscanf; so the line
+ * number counter tracks the lines read.
  * 
  */
 int
 dxf_read_scanf (DxfFile *fp, const char *template, ...)
 {
         int ret;
-        char * search_result;
+        int lines;
+        const char *search_result;
+        const char *line;
+        size_t length;
+        char stack_buffer[4 * (DXF_MAX_STRING_LENGTH + 1)];
+        char *buffer;
+        char *temp;
+        size_t size;
+        size_t used;
         va_list lst;
-        va_start (lst, template);
-        ret = vfscanf (fp->fp, template, lst);
-        if (ferror (fp->fp))
+
+        /*
+         * we have to find each \n from the template to know how many lines will we read;
+         */
+        lines = 0;
+        search_result = template;
+        while ((search_result = strchr (search_result, '\n')) != NULL)
         {
-                fprintf (stderr, "Error: while reading from: %s in line: %d.\n",
-                        fp->filename, fp->line_number);
-                return (EXIT_FAILURE);
+                lines++;
+                search_result++;
         }
-        va_end (lst);
-        if (ret)
+        if (lines == 0)
+                lines = 1;
+        buffer = stack_buffer;
+        size = sizeof (stack_buffer);
+        used = 0;
+        dxf_read_mark (fp);
+        while (lines-- > 0)
         {
-                /*
-                 * we have to find each \n from the template to know how many lines will we read;
-                 */
-                search_result = (char *) template;
-                while (TRUE)
+                if (!dxf_read_next_line (fp, &line, &length))
+                        break;
+                if (used + length + 2 > size)
                 {
-                        search_result = strstr (search_result, "\n");
-                        if (search_result == NULL)
-                                break;
-                        fp->line_number++;
-                        *++search_result;
+                        size = 2 * (used + length + 2);
+                        if (buffer == stack_buffer)
+                        {
+                                temp = malloc (size);
+                                if (temp)
+                                        memcpy (temp, buffer, used);
+                        }
+                        else
+                                temp = realloc (buffer, size);
+                        if (!temp)
+                        {
+                                if (buffer != stack_buffer)
+                                        free (buffer);
+                                return (EOF);
+                        }
+                        buffer = temp;
                 }
+                memcpy (buffer + used, line, length);
+                used += length;
+                buffer[used++] = '\n';
         }
+        if (used == 0)
+                return (EOF);
+        buffer[used] = '\0';
+        va_start (lst, template);
+        ret = vsscanf (buffer, template, lst);
+        va_end (lst);
+        if (buffer != stack_buffer)
+                free (buffer);
         return ret;
 }
 
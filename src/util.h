@@ -58,9 +58,33 @@ enum return_state { FAIL = 0, SUCCESS, FOUND };
 int dxf_read_is_double (int type);
 int dxf_read_is_int (int type);
 int dxf_read_is_string (int type);
+int dxf_read_eof (DxfFile *fp);
+DxfBinaryType dxf_binary_type (int code);
+int dxf_read_next_line (DxfFile *fp, const char **line, size_t *length);
+int dxf_read_group (DxfFile *fp, DxfGroup *group);
+void dxf_read_unread_group (DxfFile *fp);
+int dxf_group_get_int (const DxfGroup *group);
+int dxf_group_get_hex (const DxfGroup *group);
+uint64_t dxf_group_get_handle (const DxfGroup *group);
+double dxf_group_get_double (const DxfGroup *group);
+char *dxf_group_get_string (const DxfGroup *group);
+int dxf_group_is (const DxfGroup *group, int code, const char *value);
+int dxf_line_is (const char *line, size_t length, const char *string);
+void *dxf_read_borrow (DxfFile *fp, size_t size);
+DxfIntern *dxf_read_names (DxfFile *fp);
+char *dxf_read_string (DxfFile *fp, const DxfGroup *group);
+char *dxf_read_name (DxfFile *fp, const DxfGroup *group);
+void dxf_read_reset_strings (DxfFile *fp);
 int dxf_read_line (char * temp_string, DxfFile *fp);
 int dxf_read_scanf (DxfFile *fp, const char *template, ...);
 DxfFile *dxf_read_init (const char *filename);
+DxfFile *dxf_read_memory (const char *data, size_t length, int owned);
+DxfFile *dxf_read_view (DxfFile *fp, size_t start, size_t end);
+int dxf_read_load (DxfFile *fp);
+int dxf_read_append (DxfFile *fp, const char *data, size_t length);
+size_t dxf_read_group_size (const DxfFile *fp, size_t offset);
+void dxf_read_detect (DxfFile *fp);
+int dxf_read_seek (DxfFile *fp, size_t offset, int line_number);
 void dxf_read_close (DxfFile *dxf_file);
 
 
@@ -31,12 +31,25 @@
 
 
 #include "vertex.h"
+#include "arena.h"
+#include "pool.h"
+#include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_vertex_new are handed out by.
+ */
+static DxfPool dxf_vertex_pool = DXF_POOL_INITIALIZER (sizeof (DxfVertex));
 
 
 /*!
  * \brief Allocate memory for a \c DxfVertex.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_vertex_free.
  */
 DxfVertex *
 dxf_vertex_new ()
@@ -46,31 +59,91 @@ dxf_vertex_new ()
                 __FILE__, __LINE__);
 #endif
         DxfVertex *dxf_vertex = NULL;
-        size_t size;
 
-        size = sizeof (DxfVertex);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_vertex = malloc (size)) == NULL)
+        if ((dxf_vertex = dxf_pool_alloc (&dxf_vertex_pool)) == NULL)
         {
                 fprintf (stderr, "ERROR in dxf_vertex_new () could not allocate memory for a DxfVertex struct.\n");
-                dxf_vertex = NULL;
         }
-        else
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_vertex_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_vertex);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfVertex from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_vertex_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfVertex *
+dxf_vertex_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_vertex_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfVertex *dxf_vertex = NULL;
+
+        if (arena == NULL)
+        {
+                dxf_vertex = dxf_vertex_new ();
+        }
+        else if ((dxf_vertex = dxf_arena_alloc (arena, sizeof (DxfVertex))) == NULL)
         {
-                memset (dxf_vertex, 0, size);
+                fprintf (stderr, "ERROR in dxf_vertex_new_arena () could not allocate memory for a DxfVertex struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_vertex_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_vertex_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_vertex);
 }
 
 
+/*!
+ * \brief Release a \c DxfVertex allocated by \c dxf_vertex_new to its pool.
+ *
+ * The struct has no strings of its own, the layer and linetype are
+ * interned (see \c dxf_arena_intern).\n
+ * Not for a \c DxfVertex allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_vertex_free
+(
+        DxfVertex *dxf_vertex
+                /*!< DXF vertex entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_vertex_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        dxf_pool_release (&dxf_vertex_pool, dxf_vertex);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_vertex_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in a \c VERTEX entity.
  * 
+ * The layer and linetype are interned in the names shared by the
+ * entities without an arena (see \c dxf_intern_shared), they stay
+ * valid until \c dxf_intern_shared_free.
+ *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
  */
@@ -85,15 +158,45 @@ dxf_vertex_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_vertex_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        dxf_vertex = dxf_vertex_new ();
+        dxf_vertex = dxf_vertex_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_vertex_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_vertex);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in a \c VERTEX entity.
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_vertex_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfVertex *
+dxf_vertex_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_vertex_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfVertex *dxf_vertex = NULL;
+        dxf_vertex = dxf_vertex_new_arena (arena);
         if (dxf_vertex == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_vertex_init () could not allocate memory for a DxfVertex struct.\n");
+              fprintf (stderr, "ERROR in dxf_vertex_init_arena () could not allocate memory for a DxfVertex struct.\n");
               return (NULL);
         }
         dxf_vertex->common.id_code = 0;
-        dxf_vertex->common.linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dxf_vertex->common.layer = strdup (DXF_DEFAULT_LAYER);
+        dxf_vertex->common.linetype = dxf_arena_intern (arena, DXF_DEFAULT_LINETYPE);
+        dxf_vertex->common.layer = dxf_arena_intern (arena, DXF_DEFAULT_LAYER);
         dxf_vertex->x0 = 0.0;
         dxf_vertex->y0 = 0.0;
         dxf_vertex->z0 = 0.0;
@@ -107,13 +210,29 @@ dxf_vertex_init
         dxf_vertex->flag = 0;
         dxf_vertex->common.acad_version_number = 0;
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_vertex_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_vertex_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_vertex);
 }
 
 
+/*!
+ * \brief Schema of the \c VERTEX entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_vertex_schema[DXF_SCHEMA_SIZE] =
+{
+        DXF_SCHEMA_ENTITY_COMMON (DxfVertex),
+        [10] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfVertex, x0),
+        [20] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfVertex, y0),
+        [30] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfVertex, z0),
+        [38] = DXF_SCHEMA_FIELD (DXF_FIELD_ELEVATION, DxfVertex, z0),
+        [40] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfVertex, start_width),
+        [41] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfVertex, end_width),
+        [42] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfVertex, bulge)
+};
+
+
 /*!
  * \brief Read data from a DXF file into an \c VERTEX entity.
  *
@@ -121,7 +240,8 @@ dxf_vertex_init
  * Now follows some data for the \c VERTEX, to be terminated with a "  0"
  * string announcing the following entity, or the end of the \c ENTITY
  * section marker \c ENDSEC. \n
- * While parsing the DXF file store data in \c dxf_vertex. \n
+ * While parsing the DXF file store data in \c dxf_vertex, the group
+ * codes are decoded through \c dxf_vertex_schema. \n
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -129,12 +249,8 @@ dxf_vertex_init
 int
 dxf_vertex_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         DxfVertex *dxf_vertex,
                 /*!< DXF vertex entity. */
         int acad_version_number
@@ -145,147 +261,19 @@ dxf_vertex_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_arc_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
         if (!dxf_vertex)
         {
                 dxf_vertex = dxf_vertex_new ();
         }
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_vertex_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (EXIT_FAILURE);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (*line_number)++;
-                        fscanf (fp, "%x\n", &dxf_vertex->common.id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_vertex->common.linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_vertex->common.layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_vertex->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_vertex->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_vertex->z0);
-                }
-                else if ((acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (dxf_vertex->z0 = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_vertex->z0);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_vertex->common.thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * start width. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_vertex->start_width);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * end width. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_vertex->end_width);
-                }
-                else if (strcmp (temp_string, "42") == 0)
-                {
-                        /* Now follows a string containing the
-                         * bulge. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_vertex->bulge);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_vertex->common.color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_vertex->common.paperspace);
-                }
-                else if ((acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr, "Warning: in dxf_vertex_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_vertex_schema, dxf_vertex, NULL,
+                "VERTEX", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_vertex_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -295,8 +283,8 @@ dxf_vertex_read
 int
 dxf_vertex_write_lowlevel
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< group code = 5. */
         char *linetype,
@@ -368,48 +356,48 @@ dxf_vertex_write_lowlevel
                 layer = strdup (DXF_DEFAULT_LAYER);
         }
 
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
         if (start_width != 0.0)
         {
-                fprintf (fp, " 40\n%f\n", start_width);
+                dxf_write_group_double (fp, 40, start_width);
         }
         if (end_width != 0.0)
         {
-                fprintf (fp, " 41\n%f\n", end_width);
+                dxf_write_group_double (fp, 41, end_width);
         }
         if (bulge != 0.0)
         {
-                fprintf (fp, " 42\n%f\n", bulge);
+                dxf_write_group_double (fp, 42, bulge);
         }
         if (curve_fit_tangent_direction != 0.0)
         {
-                fprintf (fp, " 50\n%f\n", curve_fit_tangent_direction);
+                dxf_write_group_double (fp, 50, curve_fit_tangent_direction);
         }
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
         if (paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp, " 70\n%d\n", flag);
+        dxf_write_group_int (fp, 70, flag);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_vertex_write_lowlevel () function.\n",
                 __FILE__, __LINE__);
@@ -424,8 +412,8 @@ dxf_vertex_write_lowlevel
 int
 dxf_vertex_write
 (
-        FILE *fp,
-                /*!< file pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         DxfVertex dxf_vertex
                 /*!< DXF vertex entity. */
 )
@@ -445,48 +433,48 @@ dxf_vertex_write
                 dxf_vertex.common.layer = strdup (DXF_DEFAULT_LAYER);
         }
 
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (dxf_vertex.common.id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", dxf_vertex.common.id_code);
+                dxf_write_group_hex (fp, 5, dxf_vertex.common.id_code);
         }
         if (strcmp (dxf_vertex.common.linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", dxf_vertex.common.linetype);
+                dxf_write_group_string (fp, 6, dxf_vertex.common.linetype);
         }
-        fprintf (fp, "  8\n%s\n", dxf_vertex.common.layer);
-        fprintf (fp, " 10\n%f\n", dxf_vertex.x0);
-        fprintf (fp, " 20\n%f\n", dxf_vertex.y0);
-        fprintf (fp, " 30\n%f\n", dxf_vertex.z0);
+        dxf_write_group_string (fp, 8, dxf_vertex.common.layer);
+        dxf_write_group_double (fp, 10, dxf_vertex.x0);
+        dxf_write_group_double (fp, 20, dxf_vertex.y0);
+        dxf_write_group_double (fp, 30, dxf_vertex.z0);
         if (dxf_vertex.common.thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", dxf_vertex.common.thickness);
+                dxf_write_group_double (fp, 39, dxf_vertex.common.thickness);
         }
         if (dxf_vertex.start_width != 0.0)
         {
-                fprintf (fp, " 40\n%f\n", dxf_vertex.start_width);
+                dxf_write_group_double (fp, 40, dxf_vertex.start_width);
         }
         if (dxf_vertex.end_width != 0.0)
         {
-                fprintf (fp, " 41\n%f\n", dxf_vertex.end_width);
+                dxf_write_group_double (fp, 41, dxf_vertex.end_width);
         }
         if (dxf_vertex.bulge != 0.0)
         {
-                fprintf (fp, " 42\n%f\n", dxf_vertex.bulge);
+                dxf_write_group_double (fp, 42, dxf_vertex.bulge);
         }
         if (dxf_vertex.curve_fit_tangent_direction != 0.0)
         {
-                fprintf (fp, " 50\n%f\n", dxf_vertex.curve_fit_tangent_direction);
+                dxf_write_group_double (fp, 50, dxf_vertex.curve_fit_tangent_direction);
         }
         if (dxf_vertex.common.color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", dxf_vertex.common.color);
+                dxf_write_group_int (fp, 62, dxf_vertex.common.color);
         }
         if (dxf_vertex.common.paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp, " 70\n%d\n", dxf_vertex.flag);
+        dxf_write_group_int (fp, 70, dxf_vertex.flag);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_vertex_write () function.\n",
                 __FILE__, __LINE__);
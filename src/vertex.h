@@ -109,23 +109,36 @@ dxf_vertex
 DxfVertex *
 dxf_vertex_new ();
 DxfVertex *
+dxf_vertex_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_vertex_free
+(
+        DxfVertex *dxf_vertex
+);
+DxfVertex *
 dxf_vertex_init
 (
         DxfVertex *dxf_vertex
 );
+DxfVertex *
+dxf_vertex_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_vertex_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfVertex *dxf_vertex,
         int acad_version_number
 );
 int
 dxf_vertex_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *linetype,
         char *layer,
@@ -144,7 +157,7 @@ dxf_vertex_write_lowlevel
 int
 dxf_vertex_write
 (
-        FILE *fp,
+        DxfWriter *fp,
         DxfVertex dxf_vertex
 );
 
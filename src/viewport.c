@@ -31,12 +31,26 @@
 
 
 #include "viewport.h"
+#include "arena.h"
+#include "pool.h"
+#include "intern.h"
+#include "util.h"
+#include "schema.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Pool the structs of \c dxf_viewport_new are handed out by.
+ */
+static DxfPool dxf_viewport_pool = DXF_POOL_INITIALIZER (sizeof (DxfViewport));
 
 
 /*!
  * \brief Allocate memory for a \c DxfViewport.
  *
  * Fill the memory contents with zeros.
+ * The struct is handed out by a pool (see \c dxf_pool_alloc), it is
+ * released with \c dxf_viewport_free.
  */
 DxfViewport *
 dxf_viewport_new ()
@@ -46,32 +60,104 @@ dxf_viewport_new ()
                 __FILE__, __LINE__);
 #endif
         DxfViewport *dxf_viewport = NULL;
-        size_t size;
 
-        size = sizeof (DxfViewport);
-        /* avoid malloc of 0 bytes */
-        if (size == 0) size = 1;
-        if ((dxf_viewport = malloc (size)) == NULL)
+        if ((dxf_viewport = dxf_pool_alloc (&dxf_viewport_pool)) == NULL)
         {
                 fprintf (stderr, "ERROR in dxf_viewport_new () could not allocate memory for a DxfViewport struct.\n");
-                dxf_viewport = NULL;
         }
-        else
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_viewport_new () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_viewport);
+}
+
+
+/*!
+ * \brief Allocate memory for a \c DxfViewport from an arena.
+ *
+ * Fill the memory contents with zeros, without an arena this is the same
+ * as \c dxf_viewport_new.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfViewport *
+dxf_viewport_new_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_viewport_new_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfViewport *dxf_viewport = NULL;
+
+        if (arena == NULL)
+        {
+                dxf_viewport = dxf_viewport_new ();
+        }
+        else if ((dxf_viewport = dxf_arena_alloc (arena, sizeof (DxfViewport))) == NULL)
         {
-                memset (dxf_viewport, 0, size);
+                fprintf (stderr, "ERROR in dxf_viewport_new_arena () could not allocate memory for a DxfViewport struct.\n");
         }
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_viewport_new () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_viewport_new_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_viewport);
 }
 
 
+/*!
+ * \brief Release a \c DxfViewport allocated by \c dxf_viewport_new to its pool.
+ *
+ * The strings of the extended entity data and the bitset of the frozen
+ * layers are freed, the names of the layer and linetype and the names the
+ * frozen layers are numbered in are shared and are not (see
+ * \c dxf_viewport_freeze_layer).\n
+ * Not for a \c DxfViewport allocated from an arena, which is freed with
+ * the arena: its memory would be handed out again by the pool.
+ */
+void
+dxf_viewport_free
+(
+        DxfViewport *dxf_viewport
+                /*!< DXF viewport entity, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_viewport_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+        if (dxf_viewport)
+        {
+                free (dxf_viewport->app_name);
+                free (dxf_viewport->viewport_data);
+                free (dxf_viewport->window_descriptor_begin);
+                free (dxf_viewport->frozen_layer_list_begin);
+                free (dxf_viewport->frozen_layer_list_end);
+                free (dxf_viewport->window_descriptor_end);
+                free (dxf_viewport->frozen_layers);
+        }
+        dxf_pool_release (&dxf_viewport_pool, dxf_viewport);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_viewport_free () function.\n",
+                __FILE__, __LINE__);
+#endif
+}
+
+
 /*!
  * \brief Allocate memory and initialize data fields in a \c VIEWPORT
  * entity.
  * 
+ * The layer and linetype are interned in the names shared by the
+ * entities without an arena (see \c dxf_intern_shared), they stay
+ * valid until \c dxf_intern_shared_free.
+ *
  * \return \c NULL when no memory was allocated, a pointer to the
  * allocated memory when succesful.
  */
@@ -86,16 +172,45 @@ dxf_viewport_init
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_viewport_init () function.\n",
                 __FILE__, __LINE__);
 #endif
-        int i;
-        dxf_viewport = dxf_viewport_new ();
+        dxf_viewport = dxf_viewport_init_arena (NULL);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_viewport_init () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (dxf_viewport);
+}
+
+
+/*!
+ * \brief Allocate memory from an arena and initialize data fields in a \c VIEWPORT
+ *
+ * The strings are copied into the arena as well, without an arena this
+ * is the same as \c dxf_viewport_init.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfViewport *
+dxf_viewport_init_arena
+(
+        DxfArena *arena
+                /*!< arena, or \c NULL. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_viewport_init_arena () function.\n",
+                __FILE__, __LINE__);
+#endif
+        DxfViewport *dxf_viewport = NULL;
+        dxf_viewport = dxf_viewport_new_arena (arena);
         if (dxf_viewport == NULL)
         {
-              fprintf (stderr, "ERROR in dxf_viewport_init () could not allocate memory for a DxfViewport struct.\n");
+              fprintf (stderr, "ERROR in dxf_viewport_init_arena () could not allocate memory for a DxfViewport struct.\n");
               return (NULL);
         }
         dxf_viewport->common.id_code = 0;
-        dxf_viewport->common.linetype = strdup (DXF_DEFAULT_LINETYPE);
-        dxf_viewport->common.layer = strdup (DXF_DEFAULT_LAYER);
+        dxf_viewport->common.linetype = dxf_arena_intern (arena, DXF_DEFAULT_LINETYPE);
+        dxf_viewport->common.layer = dxf_arena_intern (arena, DXF_DEFAULT_LAYER);
         dxf_viewport->x0 = 0.0;
         dxf_viewport->y0 = 0.0;
         dxf_viewport->z0 = 0.0;
@@ -106,9 +221,9 @@ dxf_viewport_init
         dxf_viewport->id = 1; /* Always 1. */
         dxf_viewport->common.color = DXF_COLOR_BYLAYER;
         dxf_viewport->common.paperspace = DXF_PAPERSPACE; /* Always on PAPERSPACE. */
-        dxf_viewport->app_name = strdup ("ACAD"); /* Always "ACAD". */
-        dxf_viewport->viewport_data = strdup ("MVIEW"); /* Always "MVIEW". */
-        dxf_viewport->window_descriptor_begin = strdup ("{"); /* Always "{". */
+        dxf_viewport->app_name = dxf_arena_strdup (arena, "ACAD"); /* Always "ACAD". */
+        dxf_viewport->viewport_data = dxf_arena_strdup (arena, "MVIEW"); /* Always "MVIEW". */
+        dxf_viewport->window_descriptor_begin = dxf_arena_strdup (arena, "{"); /* Always "{". */
         dxf_viewport->extended_entity_data_version = 16;
         dxf_viewport->x_target = 0.0;
         dxf_viewport->y_target = 0.0;
@@ -139,29 +254,276 @@ dxf_viewport_init
         dxf_viewport->x_grid_spacing = 0.0;
         dxf_viewport->y_grid_spacing = 0.0;
         dxf_viewport->plot_flag = 0;
-        dxf_viewport->frozen_layer_list_begin = strdup ("{"); /* Always "{". */
-        /*! \todo Implement the number of layers in a more efficient way.
-         * A lot of memory is consumed by reserving for DXF_MAX_LAYERS
-         * instead of the actual existing number of layers.
-         * Maybe this can be solved by dynamically allocating a
-         * reasonable number of layers during compile time, and
-         * (re-allocating) shrinking when the actual number of layers is
-         * known during run time. */
-        for (i = 0; i == DXF_MAX_LAYERS; i++)
-        {
-                dxf_viewport->frozen_layers[i] = strdup ("");
-        }
-        dxf_viewport->frozen_layer_list_end = strdup ("}"); /* Always "}". */
-        dxf_viewport->window_descriptor_end = strdup ("}"); /* Always "}". */
+        dxf_viewport->frozen_layer_list_begin = dxf_arena_strdup (arena, "{"); /* Always "{". */
+        /* The frozen layers are numbered in the names of the document. */
+        dxf_viewport->layer_names = arena ? dxf_arena_names (arena) : NULL;
+        dxf_viewport->frozen_layers = NULL;
+        dxf_viewport->frozen_layers_size = 0;
+        dxf_viewport->frozen_layer_list_end = dxf_arena_strdup (arena, "}"); /* Always "}". */
+        dxf_viewport->window_descriptor_end = dxf_arena_strdup (arena, "}"); /* Always "}". */
         dxf_viewport->common.acad_version_number = AutoCAD_12; /* Minimum required version is AutoCAD R12*/
 #if DEBUG
-        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_viewport_init () function.\n",
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_viewport_init_arena () function.\n",
                 __FILE__, __LINE__);
 #endif
         return (dxf_viewport);
 }
 
 
+/*!
+ * \brief DXF definition of an entry in the ordered sequence of extended
+ * entity data groups of a \c VIEWPORT entity.
+ */
+typedef struct
+dxf_viewport_extended_data_field
+{
+        int code;
+                /*!< expected group code. */
+        DxfSchemaField field;
+                /*!< member of \c DxfViewport the value is stored in. */
+} DxfViewportExtendedDataField;
+
+
+/*!
+ * \brief Ordered sequence of the extended entity data groups of a
+ * \c VIEWPORT entity, following the "1001" application name up to and
+ * including the begin of the frozen layer list.
+ */
+static const DxfViewportExtendedDataField dxf_viewport_extended_data[] =
+{
+        {1000, DXF_SCHEMA_FIELD (DXF_FIELD_STRING, DxfViewport, viewport_data)},
+        {1002, DXF_SCHEMA_FIELD (DXF_FIELD_STRING, DxfViewport, window_descriptor_begin)},
+        {1070, DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfViewport, extended_entity_data_version)},
+        {1010, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, x_target)},
+        {1020, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, y_target)},
+        {1030, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, z_target)},
+        {1010, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, x_direction)},
+        {1020, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, y_direction)},
+        {1030, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, z_direction)},
+        {1040, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, view_twist_angle)},
+        {1040, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, view_height)},
+        {1040, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, x_center)},
+        {1040, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, y_center)},
+        {1040, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, perspective_lens_length)},
+        {1040, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, front_plane_offset)},
+        {1040, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, back_plane_offset)},
+        {1070, DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfViewport, view_mode)},
+        {1070, DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfViewport, circle_zoom_percent)},
+        {1070, DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfViewport, fast_zoom_setting)},
+        {1070, DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfViewport, UCSICON_setting)},
+        {1070, DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfViewport, snap_on)},
+        {1070, DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfViewport, grid_on)},
+        {1070, DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfViewport, snap_style)},
+        {1070, DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfViewport, snap_isopair)},
+        {1040, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, snap_rotation_angle)},
+        {1040, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, x_snap_base)},
+        {1040, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, y_snap_base)},
+        {1040, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, x_snap_spacing)},
+        {1040, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, y_snap_spacing)},
+        {1040, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, x_grid_spacing)},
+        {1040, DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, y_grid_spacing)},
+        {1070, DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfViewport, plot_flag)},
+        {1002, DXF_SCHEMA_FIELD (DXF_FIELD_STRING, DxfViewport, frozen_layer_list_begin)}
+};
+
+
+/*!
+ * \brief Freezes a layer in a viewport, with the bitset allocated from
+ * \c arena, borrowed from \c fp or allocated with realloc.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * was allocated.
+ */
+static int
+dxf_viewport_freeze
+(
+        DxfFile *fp,
+                /*!< DXF file handle the viewport is read from, or
+                 * \c NULL. */
+        DxfArena *arena,
+                /*!< arena the viewport was allocated from, or \c NULL. */
+        DxfViewport *dxf_viewport,
+                /*!< DXF viewport entity. */
+        const char *layer
+                /*!< name of the layer. */
+)
+{
+        uint32_t *frozen_layers;
+        long number;
+        size_t size;
+
+        if (!dxf_viewport->layer_names)
+        {
+                dxf_viewport->layer_names = arena ? dxf_arena_names (arena)
+                        : (fp ? dxf_read_names (fp) : dxf_intern_shared ());
+                if (!dxf_viewport->layer_names)
+                        return (EXIT_FAILURE);
+        }
+        number = dxf_intern_index (dxf_viewport->layer_names, layer, strlen (layer));
+        if (number < 0)
+                return (EXIT_FAILURE);
+        if ((size_t) number / 32 >= dxf_viewport->frozen_layers_size)
+        {
+                /* Make room for all names known so far. */
+                size = (dxf_viewport->layer_names->count + 31) / 32;
+                if (size < 2 * dxf_viewport->frozen_layers_size)
+                        size = 2 * dxf_viewport->frozen_layers_size;
+                if (arena || (fp && fp->borrow_strings))
+                {
+                        frozen_layers = arena
+                                ? dxf_arena_alloc (arena, size * sizeof (uint32_t))
+                                : dxf_read_borrow (fp, size * sizeof (uint32_t));
+                        if (frozen_layers)
+                        {
+                                memset (frozen_layers, 0, size * sizeof (uint32_t));
+                                if (dxf_viewport->frozen_layers)
+                                        memcpy (frozen_layers, dxf_viewport->frozen_layers,
+                                                dxf_viewport->frozen_layers_size * sizeof (uint32_t));
+                        }
+                }
+                else
+                {
+                        frozen_layers = realloc (dxf_viewport->frozen_layers,
+                                size * sizeof (uint32_t));
+                        if (frozen_layers)
+                                memset (frozen_layers + dxf_viewport->frozen_layers_size, 0,
+                                        (size - dxf_viewport->frozen_layers_size) * sizeof (uint32_t));
+                }
+                if (!frozen_layers)
+                {
+                        fprintf (stderr, "Error in dxf_viewport_freeze_layer () could not allocate memory for the frozen layers.\n");
+                        return (EXIT_FAILURE);
+                }
+                dxf_viewport->frozen_layers = frozen_layers;
+                dxf_viewport->frozen_layers_size = size;
+        }
+        dxf_viewport->frozen_layers[number / 32] |= (uint32_t) 1 << (number % 32);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read the extended entity data of a \c VIEWPORT entity.
+ *
+ * Hook of \c dxf_viewport_schema for group code 1001, \c group contains
+ * the application name (always "ACAD").\n
+ * In contrast to normal entity data the same group code can appear
+ * multiple times, so the groups are decoded in the order of
+ * \c dxf_viewport_extended_data, followed by the frozen layer list and
+ * the end of the window descriptor.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_viewport_read_extended_data
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        DxfGroup *group,
+                /*!< group containing the application name. */
+        void *entity,
+                /*!< DXF viewport entity. */
+        int acad_version_number
+                /*!< AutoCAD version number. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_viewport_read_extended_data () function.\n",
+                __FILE__, __LINE__);
+#endif
+        static const DxfSchemaField app_name =
+                DXF_SCHEMA_FIELD (DXF_FIELD_STRING, DxfViewport, app_name);
+        static const DxfSchemaField frozen_layer_list_end =
+                DXF_SCHEMA_FIELD (DXF_FIELD_STRING, DxfViewport, frozen_layer_list_end);
+        static const DxfSchemaField window_descriptor_end =
+                DXF_SCHEMA_FIELD (DXF_FIELD_STRING, DxfViewport, window_descriptor_end);
+        DxfViewport *dxf_viewport = entity;
+        char *layer;
+        size_t i;
+
+        dxf_schema_store (fp, &app_name, group, dxf_viewport, acad_version_number);
+        if (strcmp (dxf_viewport->app_name, DXF_VIEWPORT_APP_NAME) != 0)
+        {
+                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
+                        fp->filename, fp->line_number);
+                fprintf (stderr, "    unexpected content in string followed after group code 1001.\n");
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < sizeof (dxf_viewport_extended_data) / sizeof (dxf_viewport_extended_data[0]); i++)
+        {
+                if (!dxf_read_group (fp, group)
+                        || (group->code != dxf_viewport_extended_data[i].code))
+                {
+                        fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
+                                fp->filename, fp->line_number);
+                        fprintf (stderr, "    unexpected content in string sequence found.\n");
+                        return (EXIT_FAILURE);
+                }
+                if (dxf_schema_store (fp, &dxf_viewport_extended_data[i].field,
+                        group, dxf_viewport, acad_version_number) != EXIT_SUCCESS)
+                {
+                        return (EXIT_FAILURE);
+                }
+        }
+        /* Now follow any number of frozen layer names, bail out when a
+         * group code with a value of "1002" is encountered. */
+        while (dxf_read_group (fp, group) && (group->code == 1003))
+        {
+                layer = dxf_group_get_string (group);
+                if (!layer
+                        || (dxf_viewport_freeze (fp, fp->arena, dxf_viewport,
+                                layer) != EXIT_SUCCESS))
+                {
+                        free (layer);
+                        return (EXIT_FAILURE);
+                }
+                free (layer);
+        }
+        /* Now we are expecting the end of the frozen layer list and the
+         * end of the window descriptor. */
+        if (group->code != 1002)
+        {
+                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
+                        fp->filename, fp->line_number);
+                fprintf (stderr, "    unexpected end of frozen layer list found.\n");
+                return (EXIT_FAILURE);
+        }
+        dxf_schema_store (fp, &frozen_layer_list_end, group, dxf_viewport, acad_version_number);
+        if (!dxf_read_group (fp, group) || (group->code != 1002))
+        {
+                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
+                        fp->filename, fp->line_number);
+                fprintf (stderr, "    unexpected content in string sequence found.\n");
+                return (EXIT_FAILURE);
+        }
+        dxf_schema_store (fp, &window_descriptor_end, group, dxf_viewport, acad_version_number);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_viewport_read_extended_data () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Schema of the \c VIEWPORT entity, see \c dxf_schema_read.
+ */
+static const DxfSchemaField dxf_viewport_schema[DXF_SCHEMA_SIZE] =
+{
+        DXF_SCHEMA_ENTITY_COMMON (DxfViewport),
+        [10] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, x0),
+        [20] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, y0),
+        [30] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, z0),
+        [38] = DXF_SCHEMA_FIELD (DXF_FIELD_ELEVATION, DxfViewport, z0),
+        [40] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, width),
+        [41] = DXF_SCHEMA_FIELD (DXF_FIELD_DOUBLE, DxfViewport, height),
+        [68] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfViewport, status),
+        [69] = DXF_SCHEMA_FIELD (DXF_FIELD_INT, DxfViewport, id),
+        [1001] = DXF_SCHEMA_TYPE (DXF_FIELD_CUSTOM)
+};
+
+
 /*!
  * \brief Read data from a DXF file into an \c VIEWPORT entity.
  *
@@ -169,7 +531,8 @@ dxf_viewport_init
  * Now follows some data for the \c VIEWPORT, to be terminated with a
  * "  0" string announcing the following entity, or the end of the
  * \c ENTITY section marker \c ENDSEC. \n
- * While parsing the DXF file store data in \c dxf_viewport. \n
+ * While parsing the DXF file store data in \c dxf_viewport, the group
+ * codes are decoded through \c dxf_viewport_schema. \n
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -177,12 +540,8 @@ dxf_viewport_init
 int
 dxf_viewport_read
 (
-        char *filename,
-                /*!< filename of input file (or device). */
-        FILE *fp,
-                /*!< filepointer to the input file (or device). */
-        int *line_number,
-                /*!< current line number in the input file (or device). */
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
         DxfViewport *dxf_viewport,
                 /*!< DXF viewport entity. */
         int acad_version_number
@@ -193,673 +552,19 @@ dxf_viewport_read
         fprintf (stderr, "[File: %s: line: %d] Entering dxf_viewport_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        char *temp_string = NULL;
+        int ret;
 
         if (!dxf_viewport)
         {
                 dxf_viewport = dxf_viewport_new ();
         }
-        (*line_number)++;
-        fscanf (fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp))
-                {
-                        fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                        fclose (fp);
-                        return (EXIT_FAILURE);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (*line_number)++;
-                        fscanf (fp, "%x\n", &dxf_viewport->common.id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_viewport->common.linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_viewport->common.layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->z0);
-                }
-                else if ((acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (dxf_viewport->z0 = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->z0);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->common.thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * width. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->width);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * height. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->height);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_viewport->common.color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_viewport->common.paperspace);
-                }
-                else if (strcmp (temp_string, "68") == 0)
-                {
-                        /* Now follows a string containing the
-                         * status value. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_viewport->status);
-                }
-                else if (strcmp (temp_string, "69") == 0)
-                {
-                        /* Now follows a string containing the
-                         * id. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_viewport->id);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "1001") == 0)
-                {
-                        /* Now follows a sequence of ordered data fields. */
-                        /* Now follows a string containing the appname,
-                         * always "ACAD". */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_viewport->app_name);
-                        if (strcmp (dxf_viewport->app_name, "ACAD") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string followed after group code 1001.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1000") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the viewport
-                         * data, always "MVIEW". */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_viewport->viewport_data);
-                        if (strcmp (dxf_viewport->viewport_data, "MVIEW") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string.\n");
-                        }
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1002") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the window
-                         * begin descriptor, always "{". */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_viewport->window_descriptor_begin);
-                        if (strcmp (dxf_viewport->window_descriptor_begin, "{") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string.\n");
-                        }
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the extended
-                         * entity data version number. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_viewport->extended_entity_data_version);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1010") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the X-target. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->x_target);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1020") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the Y-target. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->y_target);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1030") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the Z-target. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->z_target);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1010") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the X-direction. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->x_direction);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1020") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the Y-direction. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->y_direction);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1030") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the Z-direction. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->z_direction);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the view
-                         * twist angle. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->view_twist_angle);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the view
-                         * height. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->view_height);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the
-                         * X-coordinate of the view center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->x_center);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the
-                         * Y-coordinate of the view center point. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->y_center);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the
-                         * perspective lens length. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->perspective_lens_length);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the front
-                         * clipping plane offset. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->front_plane_offset);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the back
-                         * clipping plane offset. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->back_plane_offset);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the view mode. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_viewport->view_mode);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the circle
-                         * zoom percent. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_viewport->circle_zoom_percent);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the fast zoom
-                         * setting. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_viewport->fast_zoom_setting);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the ICS ICON
-                         * setting. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_viewport->UCSICON_setting);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the snap on
-                         * setting. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_viewport->snap_on);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the grid on
-                         * setting. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_viewport->grid_on);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the snap
-                         * style setting. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_viewport->snap_style);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the snap
-                         * isopair setting. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_viewport->snap_isopair);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the snap
-                         * rotation angle. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->snap_rotation_angle);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the X snap
-                         * base. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->x_snap_base);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the Y snap
-                         * base. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->y_snap_base);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the X snap
-                         * spacing. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->x_snap_spacing);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the Y snap
-                         * spacing. */
-                        (*line_number)++;
-                        fscanf (fp, "%lf\n", &dxf_viewport->y_snap_spacing);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the plot flag. */
-                        (*line_number)++;
-                        fscanf (fp, "%d\n", &dxf_viewport->plot_flag);
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1002") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the frozen
-                         * layer list begin descriptor, always "{". */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_viewport->frozen_layer_list_begin);
-                        if (strcmp (dxf_viewport->frozen_layer_list_begin, "{") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string.\n");
-                        }
-                        /* Now follows a string containing a group code
-                         * value of "1003". */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1003") == 0)
-                        {
-                                /* Start a loop reading all frozen layer
-                                 * names and bail out when a group code
-                                 * with a value of "1002" is encountered
-                                 * or DXF_MAX_LAYERS is reached.*/
-                                int j = 0;
-                                do
-                                {
-                                        (*line_number)++;
-                                        fscanf (fp, "%s\n", dxf_viewport->frozen_layers[j]);
-                                        j++;
-                                        /* Now follows a string containing a group code. */
-                                        (*line_number)++;
-                                        fscanf (fp, "%s\n", temp_string);
-                                }
-                                while ((strcmp (temp_string, "1003") == 0)
-                                        || (j < DXF_MAX_LAYERS));
-                        }
-                        else
-                        {
-                                /* Either we found an empty list or we
-                                 * have found an exception. */
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected end of frozen layer list found.\n");
-                        }
-                        /* Now we are expecting temp_string to contain a
-                         * group code value of "1002". */
-                        if (strcmp (temp_string, "1002") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the frozen
-                         * layer list end descriptor, always "}". */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_viewport->frozen_layer_list_end);
-                        if (strcmp (dxf_viewport->frozen_layer_list_end, "}") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string.\n");
-                        }
-                        /* Now follows a string containing a group code. */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1002") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string sequence found.\n");
-                                return (EXIT_FAILURE);
-                        }
-                        /* Now follows a string containing the window
-                         * end descriptor, always "}". */
-                        (*line_number)++;
-                        fscanf (fp, "%s\n", dxf_viewport->window_descriptor_end);
-                        if (strcmp (dxf_viewport->window_descriptor_end, "}") == 1)
-                        {
-                                fprintf (stderr, "Error in dxf_viewport_read () while reading from: %s in line: %d.\n",
-                                        filename, *line_number);
-                                fprintf (stderr, "    unexpected content in string.\n");
-                        }
-                }
-                /* End of sequential ordered data fields. */
-                else 
-                {
-                        fprintf (stderr, "Warning: in dxf_viewport_read () unknown string tag found while reading from: %s in line: %d.\n",
-                                filename, *line_number);
-                }
-        }
+        ret = dxf_schema_read (fp, dxf_viewport_schema, dxf_viewport,
+                dxf_viewport_read_extended_data, "VIEWPORT", acad_version_number);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_viewport_read () function.\n",
                 __FILE__, __LINE__);
 #endif
-        return (EXIT_SUCCESS);
+        return (ret);
 }
 
 
@@ -872,8 +577,8 @@ dxf_viewport_read
 int
 dxf_viewport_write_lowlevel
 (
-        FILE *fp,
-                /*!< File pointer to output file (or device). */
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
         int id_code,
                 /*!< Identification number for the entity.\n
                  * this is to be an unique (sequential) number in the DXF
@@ -1017,20 +722,15 @@ dxf_viewport_write_lowlevel
         int plot_flag,
                 /*!< Hidden in plot flag.\n
                  * Group code = 1070. */
-        char *frozen_layers[DXF_MAX_LAYERS],
-                /*!< The names of layers frozen in this viewport.\n
-                 * This list may include Xref-dependent layers.\n
-                 * Any number of 1003 groups may appear here.\n
-                 * Group code = 1003.\n
-                 * \todo Implement the number of layers in a more
-                 * efficient way.\n
-                 * A lot of memory is consumed by reserving for
-                 * DXF_MAX_LAYERS instead of the actual existing number
-                 * of layers.\n
-                 * Maybe this can be solved by dynamically allocating a
-                 * reasonable number of layers during compile time, and
-                 * (re-allocating) shrinking when the actual number of
-                 * layers is known during run time. */
+        DxfIntern *layer_names,
+                /*!< names the frozen layers are numbered in, \c NULL
+                 * without frozen layers. */
+        const uint32_t *frozen_layers,
+                /*!< bitset of the numbers of the layers frozen in this
+                 * viewport.\n
+                 * Group code = 1003. */
+        size_t frozen_layers_size,
+                /*!< number of words in \c frozen_layers. */
         int acad_version_number
                 /*!< AutoCAD version number. */
 )
@@ -1040,6 +740,8 @@ dxf_viewport_write_lowlevel
                 __FILE__, __LINE__);
 #endif
         char *dxf_entity_name = strdup ("VIEWPORT");
+        size_t i;
+        int j;
 
         if (strcmp (layer, "") == 0)
         {
@@ -1049,77 +751,79 @@ dxf_viewport_write_lowlevel
                         dxf_entity_name);
                 layer = strdup (DXF_DEFAULT_LAYER);
         }
-        fprintf (fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_group_string (fp, 0, dxf_entity_name);
         if (id_code != -1)
         {
-                fprintf (fp, "  5\n%x\n", id_code);
+                dxf_write_group_hex (fp, 5, id_code);
         }
         if (strcmp (linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp, "  6\n%s\n", linetype);
+                dxf_write_group_string (fp, 6, linetype);
         }
-        fprintf (fp, "  8\n%s\n", layer);
-        fprintf (fp, " 10\n%f\n", x0);
-        fprintf (fp, " 20\n%f\n", y0);
-        fprintf (fp, " 30\n%f\n", z0);
+        dxf_write_group_string (fp, 8, layer);
+        dxf_write_group_double (fp, 10, x0);
+        dxf_write_group_double (fp, 20, y0);
+        dxf_write_group_double (fp, 30, z0);
         if (thickness != 0.0)
         {
-                fprintf (fp, " 39\n%f\n", thickness);
+                dxf_write_group_double (fp, 39, thickness);
         }
-        fprintf (fp, " 40\n%f\n", width);
-        fprintf (fp, " 41\n%f\n", height);
+        dxf_write_group_double (fp, 40, width);
+        dxf_write_group_double (fp, 41, height);
         if (color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp, " 62\n%d\n", color);
+                dxf_write_group_int (fp, 62, color);
         }
-        fprintf (fp, " 67\n%d\n", DXF_PAPERSPACE);
-        fprintf (fp, " 68\n%d\n", status);
-        fprintf (fp, " 69\n%d\n", id);
-        fprintf (fp, "1001\n%s\n", DXF_VIEWPORT_APP_NAME);
-        fprintf (fp, "1000\n%s\n", DXF_VIEWPORT_DATA);
-        fprintf (fp, "1002\n%s\n", DXF_VIEWPORT_WINDOW_BEGIN);
-        fprintf (fp, "1070\n%d\n", extended_entity_data_version);
-        fprintf (fp, "1010\n%f\n", x_target);
-        fprintf (fp, "1020\n%f\n", y_target);
-        fprintf (fp, "1030\n%f\n", z_target);
-        fprintf (fp, "1010\n%f\n", x_direction);
-        fprintf (fp, "1020\n%f\n", y_direction);
-        fprintf (fp, "1030\n%f\n", z_direction);
-        fprintf (fp, "1040\n%f\n", view_twist_angle);
-        fprintf (fp, "1040\n%f\n", view_height);
-        fprintf (fp, "1040\n%f\n", x_center);
-        fprintf (fp, "1040\n%f\n", y_center);
-        fprintf (fp, "1040\n%f\n", perspective_lens_length);
-        fprintf (fp, "1040\n%f\n", front_plane_offset);
-        fprintf (fp, "1040\n%f\n", back_plane_offset);
-        fprintf (fp, "1070\n%d\n", view_mode);
-        fprintf (fp, "1070\n%d\n", circle_zoom_percent);
-        fprintf (fp, "1070\n%d\n", fast_zoom_setting);
-        fprintf (fp, "1070\n%d\n", UCSICON_setting);
-        fprintf (fp, "1070\n%d\n", snap_on);
-        fprintf (fp, "1070\n%d\n", grid_on);
-        fprintf (fp, "1070\n%d\n", snap_style);
-        fprintf (fp, "1070\n%d\n", snap_isopair);
-        fprintf (fp, "1040\n%f\n", snap_rotation_angle);
-        fprintf (fp, "1040\n%f\n", x_snap_base);
-        fprintf (fp, "1040\n%f\n", y_snap_base);
-        fprintf (fp, "1040\n%f\n", x_snap_spacing);
-        fprintf (fp, "1040\n%f\n", y_snap_spacing);
-        fprintf (fp, "1040\n%f\n", x_grid_spacing);
-        fprintf (fp, "1040\n%f\n", y_grid_spacing);
-        fprintf (fp, "1070\n%d\n", plot_flag);
-        fprintf (fp, "1002\n%s\n", DXF_VIEWPORT_FROZEN_LAYER_LIST_BEGIN);
-        /* Start a loop writing all frozen layer names*/
-        int j = 0;
-        while ((!frozen_layers[j]) /* Do not allow NULL pointers. */
-                || (strcmp (frozen_layers[j], "") == 1) /* Do not allow empty strings. */
-                || (j < DXF_MAX_LAYERS)) /* Do not overrun the array size. */
+        dxf_write_group_int (fp, 67, DXF_PAPERSPACE);
+        dxf_write_group_int (fp, 68, status);
+        dxf_write_group_int (fp, 69, id);
+        dxf_write_group_string (fp, 1001, DXF_VIEWPORT_APP_NAME);
+        dxf_write_group_string (fp, 1000, DXF_VIEWPORT_DATA);
+        dxf_write_group_string (fp, 1002, DXF_VIEWPORT_WINDOW_BEGIN);
+        dxf_write_group_int (fp, 1070, extended_entity_data_version);
+        dxf_write_group_double (fp, 1010, x_target);
+        dxf_write_group_double (fp, 1020, y_target);
+        dxf_write_group_double (fp, 1030, z_target);
+        dxf_write_group_double (fp, 1010, x_direction);
+        dxf_write_group_double (fp, 1020, y_direction);
+        dxf_write_group_double (fp, 1030, z_direction);
+        dxf_write_group_double (fp, 1040, view_twist_angle);
+        dxf_write_group_double (fp, 1040, view_height);
+        dxf_write_group_double (fp, 1040, x_center);
+        dxf_write_group_double (fp, 1040, y_center);
+        dxf_write_group_double (fp, 1040, perspective_lens_length);
+        dxf_write_group_double (fp, 1040, front_plane_offset);
+        dxf_write_group_double (fp, 1040, back_plane_offset);
+        dxf_write_group_int (fp, 1070, view_mode);
+        dxf_write_group_int (fp, 1070, circle_zoom_percent);
+        dxf_write_group_int (fp, 1070, fast_zoom_setting);
+        dxf_write_group_int (fp, 1070, UCSICON_setting);
+        dxf_write_group_int (fp, 1070, snap_on);
+        dxf_write_group_int (fp, 1070, grid_on);
+        dxf_write_group_int (fp, 1070, snap_style);
+        dxf_write_group_int (fp, 1070, snap_isopair);
+        dxf_write_group_double (fp, 1040, snap_rotation_angle);
+        dxf_write_group_double (fp, 1040, x_snap_base);
+        dxf_write_group_double (fp, 1040, y_snap_base);
+        dxf_write_group_double (fp, 1040, x_snap_spacing);
+        dxf_write_group_double (fp, 1040, y_snap_spacing);
+        dxf_write_group_double (fp, 1040, x_grid_spacing);
+        dxf_write_group_double (fp, 1040, y_grid_spacing);
+        dxf_write_group_int (fp, 1070, plot_flag);
+        dxf_write_group_string (fp, 1002, DXF_VIEWPORT_FROZEN_LAYER_LIST_BEGIN);
+        /* Write the names of the frozen layers, skipping the words
+         * without a bit set. */
+        for (i = 0; layer_names && (i < frozen_layers_size); i++)
         {
-                fprintf (fp, "1003\n%s\n", frozen_layers[j]);
-                j++;
+                for (j = 0; frozen_layers[i] >> j; j++)
+                {
+                        if (frozen_layers[i] & ((uint32_t) 1 << j))
+                                dxf_write_group_string (fp, 1003,
+                                        dxf_intern_name (layer_names, 32 * i + j));
+                }
         }
-        fprintf (fp, "1002\n%s\n", DXF_VIEWPORT_FROZEN_LAYER_LIST_END);
-        fprintf (fp, "1002\n%s\n", DXF_VIEWPORT_WINDOW_END);
+        dxf_write_group_string (fp, 1002, DXF_VIEWPORT_FROZEN_LAYER_LIST_END);
+        dxf_write_group_string (fp, 1002, DXF_VIEWPORT_WINDOW_END);
 #if DEBUG
         fprintf (stderr, "[File: %s: line: %d] Leaving dxf_viewport_write_lowlevel () function.\n",
                 __FILE__, __LINE__);
@@ -1128,4 +832,163 @@ dxf_viewport_write_lowlevel
 }
 
 
+/*!
+ * \brief Write DXF output to fp for a viewport entity.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_viewport_write
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        DxfViewport dxf_viewport
+                /*!< DXF viewport entity. */
+)
+{
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Entering dxf_viewport_write () function.\n",
+                __FILE__, __LINE__);
+#endif
+        int ret;
+
+        ret = dxf_viewport_write_lowlevel (fp,
+                dxf_viewport.common.id_code,
+                dxf_viewport.common.linetype,
+                dxf_viewport.common.layer,
+                dxf_viewport.x0,
+                dxf_viewport.y0,
+                dxf_viewport.z0,
+                dxf_viewport.common.thickness,
+                dxf_viewport.width,
+                dxf_viewport.height,
+                dxf_viewport.common.color,
+                dxf_viewport.common.paperspace,
+                dxf_viewport.status,
+                dxf_viewport.id,
+                dxf_viewport.extended_entity_data_version,
+                dxf_viewport.x_target,
+                dxf_viewport.y_target,
+                dxf_viewport.z_target,
+                dxf_viewport.x_direction,
+                dxf_viewport.y_direction,
+                dxf_viewport.z_direction,
+                dxf_viewport.view_twist_angle,
+                dxf_viewport.view_height,
+                dxf_viewport.x_center,
+                dxf_viewport.y_center,
+                dxf_viewport.perspective_lens_length,
+                dxf_viewport.front_plane_offset,
+                dxf_viewport.back_plane_offset,
+                dxf_viewport.view_mode,
+                dxf_viewport.circle_zoom_percent,
+                dxf_viewport.fast_zoom_setting,
+                dxf_viewport.UCSICON_setting,
+                dxf_viewport.snap_on,
+                dxf_viewport.grid_on,
+                dxf_viewport.snap_style,
+                dxf_viewport.snap_isopair,
+                dxf_viewport.snap_rotation_angle,
+                dxf_viewport.x_snap_base,
+                dxf_viewport.y_snap_base,
+                dxf_viewport.x_snap_spacing,
+                dxf_viewport.y_snap_spacing,
+                dxf_viewport.x_grid_spacing,
+                dxf_viewport.y_grid_spacing,
+                dxf_viewport.plot_flag,
+                dxf_viewport.layer_names,
+                dxf_viewport.frozen_layers,
+                dxf_viewport.frozen_layers_size,
+                dxf_viewport.common.acad_version_number);
+#if DEBUG
+        fprintf (stderr, "[File: %s: line: %d] Leaving dxf_viewport_write () function.\n",
+                __FILE__, __LINE__);
+#endif
+        return (ret);
+}
+
+
+/*!
+ * \brief Freezes a layer in a viewport.
+ *
+ * The name of the layer is numbered in the names of the viewport (see
+ * \c dxf_intern_index) and the bit with that number is set. A viewport
+ * without names gets the names of \c arena, or without an arena the
+ * names shared by all viewports (see \c dxf_intern_shared).\n
+ * The bitset grows to the number of names, so a viewport takes one bit
+ * per name of the document instead of a string per frozen layer.
+ * Without \c arena the bitset is allocated with realloc and freed by
+ * \c dxf_viewport_free.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * was allocated.
+ */
+int
+dxf_viewport_freeze_layer
+(
+        DxfArena *arena,
+                /*!< arena the viewport was allocated from, or \c NULL. */
+        DxfViewport *dxf_viewport,
+                /*!< DXF viewport entity. */
+        const char *layer
+                /*!< name of the layer. */
+)
+{
+        return (dxf_viewport_freeze (NULL, arena, dxf_viewport, layer));
+}
+
+
+/*!
+ * \brief Tests whether the layer with number \c layer in the names of a
+ * viewport is frozen in the viewport.
+ *
+ * \c layer is for example the \c layer of a \c DxfEntityHeader which
+ * shares the names of the viewport.
+ *
+ * \return \c TRUE when the layer is frozen, \c FALSE otherwise.
+ */
+int
+dxf_viewport_layer_number_is_frozen
+(
+        const DxfViewport *dxf_viewport,
+                /*!< DXF viewport entity. */
+        size_t layer
+                /*!< number of the name of the layer. */
+)
+{
+        if (layer / 32 >= dxf_viewport->frozen_layers_size)
+                return (FALSE);
+        return ((dxf_viewport->frozen_layers[layer / 32] >> (layer % 32)) & 1);
+}
+
+
+/*!
+ * \brief Tests whether a layer is frozen in a viewport.
+ *
+ * The name is only looked up (see \c dxf_intern_find), a name not
+ * numbered yet is not frozen.
+ *
+ * \return \c TRUE when the layer is frozen, \c FALSE otherwise.
+ */
+int
+dxf_viewport_layer_is_frozen
+(
+        const DxfViewport *dxf_viewport,
+                /*!< DXF viewport entity. */
+        const char *layer
+                /*!< name of the layer. */
+)
+{
+        long number;
+
+        if (!dxf_viewport->layer_names)
+                return (FALSE);
+        number = dxf_intern_find (dxf_viewport->layer_names, layer, strlen (layer));
+        if (number < 0)
+                return (FALSE);
+        return (dxf_viewport_layer_number_is_frozen (dxf_viewport, (size_t) number));
+}
+
+
 /* EOF */
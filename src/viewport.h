@@ -183,20 +183,23 @@ dxf_viewport
                 /*!< Begin frozen layer list (possibly empty).\n
                  * This field will always be the string "{".\n
                  * Group code = 1002. */
-        char *frozen_layers[DXF_MAX_LAYERS];
-                /*!< The names of layers frozen in this viewport.\n
+        DxfIntern *layer_names;
+                /*!< Names the frozen layers are numbered in, the names of
+                 * the document for a viewport in an arena (see
+                 * \c dxf_arena_names) or read with borrowed strings (see
+                 * \c dxf_read_names), the names shared by the entities
+                 * without an arena otherwise (see \c dxf_intern_shared).
+                 * \c NULL until a layer is frozen. */
+        uint32_t *frozen_layers;
+                /*!< The layers frozen in this viewport, as a bitset over
+                 * the numbers of the names in \c layer_names: the layer
+                 * with number n is frozen when bit n % 32 of
+                 * \c frozen_layers[n / 32] is set.\n
                  * This list may include Xref-dependent layers.\n
                  * Any number of 1003 groups may appear here.\n
-                 * Group code = 1003.\n
-                 * \todo Implement the number of layers in a more
-                 * efficient way.\n
-                 * A lot of memory is consumed by reserving for
-                 * DXF_MAX_LAYERS instead of the actual existing number
-                 * of layers.\n
-                 * Maybe this can be solved by dynamically allocating a
-                 * reasonable number of layers during compile time, and
-                 * (re-allocating) shrinking when the actual number of
-                 * layers is known during run time. */
+                 * Group code = 1003. */
+        size_t frozen_layers_size;
+                /*!< Number of words in \c frozen_layers. */
         char *frozen_layer_list_end;
                 /*!< End frozen layer list.\n
                  * This field will always be the string "}".\n
@@ -211,23 +214,36 @@ dxf_viewport
 DxfViewport *
 dxf_viewport_new ();
 DxfViewport *
+dxf_viewport_new_arena
+(
+        DxfArena *arena
+);
+void
+dxf_viewport_free
+(
+        DxfViewport *dxf_viewport
+);
+DxfViewport *
 dxf_viewport_init
 (
         DxfViewport *dxf_viewport
 );
+DxfViewport *
+dxf_viewport_init_arena
+(
+        DxfArena *arena
+);
 int
 dxf_viewport_read
 (
-        char *filename,
-        FILE *fp,
-        int *line_number,
+        DxfFile *fp,
         DxfViewport *dxf_viewport,
         int acad_version_number
 );
 int
 dxf_viewport_write_lowlevel
 (
-        FILE *fp,
+        DxfWriter *fp,
         int id_code,
         char *linetype,
         char *layer,
@@ -271,9 +287,36 @@ dxf_viewport_write_lowlevel
         double x_grid_spacing,
         double y_grid_spacing,
         int plot_flag,
-        char *frozen_layers[DXF_MAX_LAYERS],
+        DxfIntern *layer_names,
+        const uint32_t *frozen_layers,
+        size_t frozen_layers_size,
         int acad_version_number
 );
+int
+dxf_viewport_write
+(
+        DxfWriter *fp,
+        DxfViewport dxf_viewport
+);
+int
+dxf_viewport_freeze_layer
+(
+        DxfArena *arena,
+        DxfViewport *dxf_viewport,
+        const char *layer
+);
+int
+dxf_viewport_layer_number_is_frozen
+(
+        const DxfViewport *dxf_viewport,
+        size_t layer
+);
+int
+dxf_viewport_layer_is_frozen
+(
+        const DxfViewport *dxf_viewport,
+        const char *layer
+);
 
 
 #endif /* _VIEWPORT_H */
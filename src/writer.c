@@ -0,0 +1,1069 @@
+/*!
+ * \file writer.c
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Functions writing groups to a DXF file.
+ *
+ * Every group written by the entity writers passes through the
+ * \c dxf_write_group_ functions, which write it as ASCII DXF or as
+ * binary DXF, depending on the DxfWriter.\n
+ * In a binary DXF file the group codes and numbers are written
+ * without formatting them as text, see \c dxf_binary_type.\n
+ * The groups are formatted into the buffer of the DxfWriter without
+ * \c printf (floating point values as the shortest number which reads
+ * back exactly, see \c dxf_write_set_precision), which is written in blocks (compressed for a ".gz" or
+ * ".zst" file) when it is full.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#include "writer.h"
+#include "util.h"
+#include "strtod.h"
+#include "stream.h"
+
+
+/*!
+ * \brief Highest group code in \c dxf_write_prefixes.
+ */
+#define DXF_WRITE_MAX_PREFIX 1071
+
+
+/*!
+ * \brief DXF definition of the prefix written before the value of a
+ * group, for one group code.
+ */
+typedef struct
+dxf_write_prefix
+{
+        char text[8];
+                /*!< the group code of an ASCII DXF file, right aligned
+                 * in 3 columns and followed by a line end. */
+        unsigned char text_length;
+                /*!< number of characters in \c text. */
+        unsigned char r12[3];
+                /*!< the group code of a binary DXF file with 1 byte
+                 * group codes (255 and 2 bytes for codes which do not
+                 * fit). */
+        unsigned char r12_length;
+                /*!< number of bytes in \c r12. */
+        unsigned char r13[2];
+                /*!< the group code of a binary DXF file with 2 byte
+                 * group codes. */
+} DxfWritePrefix;
+
+
+/*!
+ * \brief Character \c i of the text prefix of group code \c n.
+ */
+#define DXF_WRITE_PREFIX_CHAR(n, i) \
+        ((n) < 1000 \
+        ? ((i) == 0 ? ((n) >= 100 ? '0' + (n) / 100 : ' ') \
+        : (i) == 1 ? ((n) >= 10 ? '0' + (n) / 10 % 10 : ' ') \
+        : (i) == 2 ? '0' + (n) % 10 \
+        : (i) == 3 ? '\n' : '\0') \
+        : ((i) == 0 ? '0' + (n) / 1000 \
+        : (i) == 1 ? '0' + (n) / 100 % 10 \
+        : (i) == 2 ? '0' + (n) / 10 % 10 \
+        : (i) == 3 ? '0' + (n) % 10 \
+        : (i) == 4 ? '\n' : '\0'))
+
+/*!
+ * \brief Entry of \c dxf_write_prefixes for group code \c n.
+ */
+#define DXF_WRITE_PREFIX(n) \
+        { \
+                { \
+                        DXF_WRITE_PREFIX_CHAR (n, 0), DXF_WRITE_PREFIX_CHAR (n, 1), \
+                        DXF_WRITE_PREFIX_CHAR (n, 2), DXF_WRITE_PREFIX_CHAR (n, 3), \
+                        DXF_WRITE_PREFIX_CHAR (n, 4), '\0', '\0', '\0' \
+                }, \
+                (n) < 1000 ? 4 : 5, \
+                { \
+                        (n) < 255 ? (n) : 255, \
+                        (n) < 255 ? 0 : (n) & 0xff, \
+                        (n) < 255 ? 0 : (n) >> 8 \
+                }, \
+                (n) < 255 ? 1 : 3, \
+                { (n) & 0xff, (n) >> 8 } \
+        }
+#define DXF_WRITE_PREFIX_4(n) \
+        DXF_WRITE_PREFIX (n), DXF_WRITE_PREFIX ((n) + 1), \
+        DXF_WRITE_PREFIX ((n) + 2), DXF_WRITE_PREFIX ((n) + 3)
+#define DXF_WRITE_PREFIX_16(n) \
+        DXF_WRITE_PREFIX_4 (n), DXF_WRITE_PREFIX_4 ((n) + 4), \
+        DXF_WRITE_PREFIX_4 ((n) + 8), DXF_WRITE_PREFIX_4 ((n) + 12)
+#define DXF_WRITE_PREFIX_64(n) \
+        DXF_WRITE_PREFIX_16 (n), DXF_WRITE_PREFIX_16 ((n) + 16), \
+        DXF_WRITE_PREFIX_16 ((n) + 32), DXF_WRITE_PREFIX_16 ((n) + 48)
+#define DXF_WRITE_PREFIX_256(n) \
+        DXF_WRITE_PREFIX_64 (n), DXF_WRITE_PREFIX_64 ((n) + 64), \
+        DXF_WRITE_PREFIX_64 ((n) + 128), DXF_WRITE_PREFIX_64 ((n) + 192)
+
+
+/*!
+ * \brief Prefixes of the group codes 0 up to and including
+ * \c DXF_WRITE_MAX_PREFIX, computed at compile time.
+ *
+ * Used by the ASCII writer (\c dxf_write_format_code) and by the binary
+ * writer (\c dxf_write_binary_code).
+ */
+static const DxfWritePrefix dxf_write_prefixes[DXF_WRITE_MAX_PREFIX + 1] =
+{
+        DXF_WRITE_PREFIX_256 (0), DXF_WRITE_PREFIX_256 (256),
+        DXF_WRITE_PREFIX_256 (512), DXF_WRITE_PREFIX_256 (768),
+        DXF_WRITE_PREFIX_16 (1024), DXF_WRITE_PREFIX_16 (1040),
+        DXF_WRITE_PREFIX_16 (1056)
+};
+
+
+/*!
+ * \brief Writes the buffer of a DxfWriter to its file, compressed when
+ * the DxfWriter has a compressed stream.
+ *
+ * The groups of a DxfWriter opened with \c dxf_write_init_memory stay
+ * in the buffer.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred (now or before).
+ */
+int
+dxf_write_flush
+(
+        DxfWriter *fp
+                /*!< DXF file handle of output file (or device). */
+)
+{
+        if (fp->memory)
+                return (fp->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+        if ((fp->buffer_length > 0) && !fp->failed)
+        {
+                if (fp->stream)
+                        fp->failed = (dxf_stream_write (fp->stream, fp->fp,
+                                fp->buffer, fp->buffer_length) != EXIT_SUCCESS);
+                else
+                        fp->failed = (fwrite (fp->buffer, 1, fp->buffer_length,
+                                fp->fp) != fp->buffer_length);
+                if (fp->failed)
+                        fprintf (stderr, "Error: while writing to: %s.\n",
+                                fp->filename);
+        }
+        fp->offset += (long) fp->buffer_length;
+        fp->buffer_length = 0;
+        return (fp->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Enlarges the buffer of a DxfWriter opened with
+ * \c dxf_write_init_memory, so \c size more bytes fit.
+ *
+ * When no memory could be allocated the groups in the buffer are
+ * dropped and the DxfWriter fails.
+ */
+static void
+dxf_write_grow
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        size_t size
+                /*!< number of bytes. */
+)
+{
+        size_t buffer_size = fp->buffer_size;
+        char *buffer;
+
+        while (buffer_size - fp->buffer_length < size)
+                buffer_size *= 2;
+        buffer = realloc (fp->buffer, buffer_size);
+        if (!buffer)
+        {
+                if (!fp->failed)
+                        fprintf (stderr, "Error: could not allocate memory for the groups of: %s.\n",
+                                fp->filename);
+                fp->failed = TRUE;
+                fp->buffer_length = 0;
+                return;
+        }
+        fp->buffer = buffer;
+        fp->buffer_size = buffer_size;
+}
+
+
+/*!
+ * \brief Makes room for \c size bytes in the buffer of a DxfWriter,
+ * \c size is at most \c DXF_WRITE_BUFFER_SIZE.
+ *
+ * \return the end of the bytes in the buffer, where at least \c size
+ * bytes can be written.
+ */
+static char *
+dxf_write_reserve
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        size_t size
+                /*!< number of bytes. */
+)
+{
+        if ((fp->buffer_size - fp->buffer_length < size) && fp->memory)
+                dxf_write_grow (fp, size);
+        else if (fp->buffer_size - fp->buffer_length < size)
+                dxf_write_flush (fp);
+        return (fp->buffer + fp->buffer_length);
+}
+
+
+/*!
+ * \brief Writes bytes to a DxfWriter.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_write_bytes
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        const void *data,
+                /*!< the bytes. */
+        size_t length
+                /*!< number of bytes in \c data. */
+)
+{
+        const char *p = data;
+        size_t n;
+
+        while (length > 0)
+        {
+                n = fp->buffer_size - fp->buffer_length;
+                if ((n == 0) && fp->memory)
+                {
+                        dxf_write_grow (fp, length);
+                        n = fp->buffer_size - fp->buffer_length;
+                }
+                else if (n == 0)
+                {
+                        dxf_write_flush (fp);
+                        n = fp->buffer_size;
+                }
+                if (n > length)
+                        n = length;
+                memcpy (fp->buffer + fp->buffer_length, p, n);
+                fp->buffer_length += n;
+                p += n;
+                length -= n;
+        }
+        return (fp->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Formats an integer in decimal.
+ *
+ * \return the number of characters, at most 20.
+ */
+static size_t
+dxf_write_format_int
+(
+        char *p,
+                /*!< destination of the characters. */
+        long long value
+                /*!< the value. */
+)
+{
+        char digits[20];
+        unsigned long long magnitude;
+        size_t n = 0;
+        size_t length = 0;
+
+        magnitude = (value < 0) ? 0 - (unsigned long long) value
+                : (unsigned long long) value;
+        do
+        {
+                digits[n++] = (char) ('0' + (magnitude % 10));
+                magnitude /= 10;
+        }
+        while (magnitude > 0);
+        if (value < 0)
+                p[length++] = '-';
+        while (n > 0)
+                p[length++] = digits[--n];
+        return (length);
+}
+
+
+/*!
+ * \brief Formats an integer in hexadecimal like "%x".
+ *
+ * \return the number of characters, at most 8.
+ */
+static size_t
+dxf_write_format_hex
+(
+        char *p,
+                /*!< destination of the characters. */
+        unsigned int value
+                /*!< the value. */
+)
+{
+        static const char hex[] = "0123456789abcdef";
+        size_t length = 1;
+        size_t i;
+
+        while ((length < 8) && (value >> (4 * length)))
+                length++;
+        for (i = length; i > 0; i--)
+        {
+                p[i - 1] = hex[value & 0xf];
+                value >>= 4;
+        }
+        return (length);
+}
+
+
+/*!
+ * \brief Formats a group code of an ASCII DXF file like "%3d\n".
+ *
+ * \c p must have room for 8 characters at least.
+ *
+ * \return the number of characters, at most 21.
+ */
+static size_t
+dxf_write_format_code
+(
+        char *p,
+                /*!< destination of the characters. */
+        int code
+                /*!< the group code. */
+)
+{
+        size_t length;
+
+        if ((code >= 0) && (code <= DXF_WRITE_MAX_PREFIX))
+        {
+                /* All 8 bytes are copied, which is a single move. */
+                memcpy (p, dxf_write_prefixes[code].text, 8);
+                return (dxf_write_prefixes[code].text_length);
+        }
+        length = dxf_write_format_int (p, code);
+        if (length < 3)
+        {
+                memmove (p + 3 - length, p, length);
+                memset (p, ' ', 3 - length);
+                length = 3;
+        }
+        p[length++] = '\n';
+        return (length);
+}
+
+
+/*!
+ * \brief Allocates a DxfWriter for an opened file.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * DxfWriter when succesful.
+ */
+static DxfWriter *
+dxf_write_new
+(
+        FILE *fp,
+                /*!< file handle of output file (or device). */
+        const char *filename,
+                /*!< filename of output file (or device). */
+        int binary,
+                /*!< size of the group codes (1 or 2 bytes) of a binary
+                 * DXF file, 0 for an ASCII DXF file. */
+        int compression
+                /*!< \c DXF_COMPRESSION_NONE, \c DXF_COMPRESSION_GZIP
+                 * or \c DXF_COMPRESSION_ZSTD. */
+)
+{
+        DxfWriter *dxf_writer;
+
+        if ((binary != 0) && (binary != 1) && (binary != 2))
+        {
+                fprintf (stderr, "Error in dxf_write_init () invalid size of the group codes: %d.\n",
+                        binary);
+                return (NULL);
+        }
+        dxf_writer = malloc (sizeof (DxfWriter));
+        if (!dxf_writer)
+        {
+                fprintf (stderr, "Error: could not allocate memory for a DxfWriter struct.\n");
+                return (NULL);
+        }
+        memset (dxf_writer, 0, sizeof (DxfWriter));
+        dxf_writer->fp = fp;
+        dxf_writer->filename = strdup (filename);
+        dxf_writer->binary = binary;
+        dxf_writer->buffer = malloc (DXF_WRITE_BUFFER_SIZE);
+        if (!dxf_writer->buffer)
+        {
+                fprintf (stderr, "Error: could not allocate memory for the write buffer of: %s.\n",
+                        filename);
+                free (dxf_writer->filename);
+                free (dxf_writer);
+                return (NULL);
+        }
+        dxf_writer->buffer_size = DXF_WRITE_BUFFER_SIZE;
+        dxf_writer->precision = -1;
+        if (compression != DXF_COMPRESSION_NONE)
+        {
+                dxf_writer->stream = dxf_stream_write_open (compression);
+                if (!dxf_writer->stream)
+                {
+                        free (dxf_writer->buffer);
+                        free (dxf_writer->filename);
+                        free (dxf_writer);
+                        return (NULL);
+                }
+        }
+        return (dxf_writer);
+}
+
+
+/*!
+ * \brief Opens a DxfWriter, does error checking.
+ *
+ * With \c binary 2 a binary DXF file for AutoCAD R13 and later is
+ * written, with \c binary 1 a binary DXF file for AutoCAD R12 and
+ * before (1 byte group codes).\n
+ * A file with the extension ".gz" is compressed with gzip, a file with
+ * the extension ".zst" with zstd.
+ *
+ * \return \c NULL when the file could not be opened or its compression
+ * is not supported, a pointer to the
+ * DxfWriter when succesful.
+ */
+DxfWriter *
+dxf_write_init
+(
+        const char *filename,
+                /*!< filename of output file (or device). */
+        int binary
+                /*!< size of the group codes (1 or 2 bytes) of a binary
+                 * DXF file, 0 for an ASCII DXF file. */
+)
+{
+        DxfWriter *dxf_writer;
+        FILE *fp;
+        int compression;
+
+        if (!filename)
+        {
+                fprintf (stderr, "Error: filename is not initialised (NULL pointer).\n");
+                return (NULL);
+        }
+        if (strcmp (filename, "") == 0)
+        {
+                fprintf (stderr, "Error: filename contains an empty string.\n");
+                return (NULL);
+        }
+        compression = dxf_stream_by_name (filename);
+        fp = fopen (filename, (binary || compression) ? "wb" : "w");
+        if (!fp)
+        {
+                fprintf (stderr, "Error: could not open file: %s for writing (NULL pointer).\n",
+                        filename);
+                return (NULL);
+        }
+        dxf_writer = dxf_write_new (fp, filename, binary, compression);
+        if (!dxf_writer)
+                fclose (fp);
+        else if (binary)
+                dxf_write_bytes (dxf_writer, DXF_BINARY_SENTINEL,
+                        DXF_BINARY_SENTINEL_LENGTH);
+        return (dxf_writer);
+}
+
+
+/*!
+ * \brief Opens a DxfWriter on a file handle which is already open, for
+ * example \c stdout.
+ *
+ * The file handle is not closed by \c dxf_write_close.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * DxfWriter when succesful.
+ */
+DxfWriter *
+dxf_write_init_stream
+(
+        FILE *fp,
+                /*!< file handle of output file (or device). */
+        int binary
+                /*!< size of the group codes (1 or 2 bytes) of a binary
+                 * DXF file, 0 for an ASCII DXF file. */
+)
+{
+        DxfWriter *dxf_writer;
+
+        if (!fp)
+        {
+                fprintf (stderr, "Error in dxf_write_init_stream () file handle is not initialised (NULL pointer).\n");
+                return (NULL);
+        }
+        dxf_writer = dxf_write_new (fp, "(stream)", binary,
+                DXF_COMPRESSION_NONE);
+        if (dxf_writer)
+                dxf_writer->borrowed = TRUE;
+        if (dxf_writer && binary)
+                dxf_write_bytes (dxf_writer, DXF_BINARY_SENTINEL,
+                        DXF_BINARY_SENTINEL_LENGTH);
+        return (dxf_writer);
+}
+
+
+/*!
+ * \brief Opens a DxfWriter which keeps the groups in memory.
+ *
+ * The buffer grows as groups are written, the groups are found in
+ * \c buffer (\c buffer_length bytes) and can be written to another
+ * DxfWriter with \c dxf_write_data.\n
+ * No binary DXF sentinel is written, so the groups of a binary
+ * DxfWriter can be appended to a binary DXF file.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * DxfWriter when succesful.
+ */
+DxfWriter *
+dxf_write_init_memory
+(
+        int binary
+                /*!< size of the group codes (1 or 2 bytes) of a binary
+                 * DXF file, 0 for an ASCII DXF file. */
+)
+{
+        DxfWriter *dxf_writer;
+
+        dxf_writer = dxf_write_new (NULL, "(memory)", binary,
+                DXF_COMPRESSION_NONE);
+        if (dxf_writer)
+        {
+                dxf_writer->borrowed = TRUE;
+                dxf_writer->memory = TRUE;
+        }
+        return (dxf_writer);
+}
+
+/*!
+ * \brief Closes a DxfWriter.
+ *
+ * \return \c EXIT_SUCCESS when all groups were written, or
+ * \c EXIT_FAILURE when an error occurred.
+ */
+int
+dxf_write_close
+(
+        DxfWriter *fp
+                /*!< DXF file handle of output file (or device). */
+)
+{
+        int ret = EXIT_SUCCESS;
+
+        if (!fp)
+                return (EXIT_FAILURE);
+        if (dxf_write_flush (fp) != EXIT_SUCCESS)
+                ret = EXIT_FAILURE;
+        if (fp->stream)
+        {
+                if (dxf_stream_finish (fp->stream, fp->fp) != EXIT_SUCCESS)
+                        ret = EXIT_FAILURE;
+                dxf_stream_close (fp->stream);
+        }
+        if (fp->fp && (fflush (fp->fp) != 0 || ferror (fp->fp)))
+        {
+                fprintf (stderr, "Error: while writing to: %s.\n",
+                        fp->filename);
+                ret = EXIT_FAILURE;
+        }
+        if (!fp->borrowed && (fclose (fp->fp) != 0))
+                ret = EXIT_FAILURE;
+        free (fp->buffer);
+        free (fp->filename);
+        free (fp);
+        return (ret);
+}
+
+
+/*!
+ * \brief Writes formatted groups, for example the buffer of a DxfWriter
+ * opened with \c dxf_write_init_memory, to a DxfWriter.
+ *
+ * The groups already in the buffer are written first, a large block of
+ * groups is then written to the file without copying it into the
+ * buffer.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred (now or before).
+ */
+int
+dxf_write_data
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        const char *data,
+                /*!< the formatted groups. */
+        size_t length
+                /*!< number of bytes in \c data. */
+)
+{
+        if (fp->memory || (length < fp->buffer_size - fp->buffer_length))
+                return (dxf_write_bytes (fp, data, length));
+        if ((dxf_write_flush (fp) != EXIT_SUCCESS) || (length == 0))
+                return (fp->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+        if (fp->stream)
+                fp->failed = (dxf_stream_write (fp->stream, fp->fp, data,
+                        length) != EXIT_SUCCESS);
+        else
+                fp->failed = (fwrite (data, 1, length, fp->fp) != length);
+        if (fp->failed)
+                fprintf (stderr, "Error: while writing to: %s.\n",
+                        fp->filename);
+        fp->offset += (long) length;
+        return (fp->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Tells the offset of the next byte written to a DxfWriter.
+ *
+ * The offset counts the bytes before compression, from the moment the
+ * DxfWriter was opened.
+ *
+ * \return the offset.
+ */
+long
+dxf_write_tell
+(
+        DxfWriter *fp
+                /*!< DXF file handle of output file (or device). */
+)
+{
+        return (fp->offset + (long) fp->buffer_length);
+}
+
+
+/*!
+ * \brief Overwrites bytes which were written before, at \c offset (see
+ * \c dxf_write_tell).
+ *
+ * Bytes which are still in the buffer are overwritten in the buffer,
+ * bytes in the file are overwritten by seeking back in the file, which
+ * is not possible for a compressed file or a file which can not seek
+ * (a pipe).
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the bytes
+ * could not be overwritten.
+ */
+int
+dxf_write_patch
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        long offset,
+                /*!< offset of the first byte. */
+        const char *data,
+                /*!< the new bytes. */
+        size_t length
+                /*!< number of bytes in \c data. */
+)
+{
+        size_t n;
+
+        if ((offset < 0) || (offset + (long) length > dxf_write_tell (fp)))
+                return (EXIT_FAILURE);
+        if (offset + (long) length > fp->offset)
+        {
+                /* The part in the buffer. */
+                n = (offset >= fp->offset) ? 0 : (size_t) (fp->offset - offset);
+                memcpy (fp->buffer + (offset + (long) n - fp->offset), data + n,
+                        length - n);
+                length = n;
+        }
+        if (length == 0)
+                return (EXIT_SUCCESS);
+        if (fp->memory || fp->stream || fp->failed || (fflush (fp->fp) != 0))
+                return (EXIT_FAILURE);
+        /* The file is at fp->offset, seek back and return. */
+        if (fseek (fp->fp, offset - fp->offset, SEEK_CUR) != 0)
+                return (EXIT_FAILURE);
+        if (fwrite (data, 1, length, fp->fp) != length)
+                fp->failed = TRUE;
+        if (fseek (fp->fp, fp->offset - offset - (long) length, SEEK_CUR) != 0)
+                fp->failed = TRUE;
+        if (fp->failed)
+                fprintf (stderr, "Error: while writing to: %s.\n",
+                        fp->filename);
+        return (fp->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Sets the number of decimals of the floating point values written
+ * to an ASCII DXF file.
+ *
+ * By default (\c precision -1) the shortest decimal number which reads
+ * back as exactly the same double is written, see
+ * \c dxf_dtoa_shortest.\n
+ * With a \c precision from 0 up to and including
+ * \c DXF_DTOA_MAX_PRECISION that many decimals are written, like with
+ * "%.*f" (6 gives the output of former versions of libDXF).
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when
+ * \c precision is out of range.
+ */
+int
+dxf_write_set_precision
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        int precision
+                /*!< number of decimals, -1 for the shortest number. */
+)
+{
+        if ((precision < -1) || (precision > DXF_DTOA_MAX_PRECISION))
+        {
+                fprintf (stderr, "Error in dxf_write_set_precision () invalid number of decimals: %d.\n",
+                        precision);
+                return (EXIT_FAILURE);
+        }
+        fp->precision = precision;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Writes a group code to a binary DXF file.
+ *
+ * A 1 byte group code of 255 is followed by a 2 byte group code for
+ * group codes which do not fit.
+ */
+static void
+dxf_write_binary_code
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        int code
+                /*!< the group code. */
+)
+{
+        unsigned char bytes[3];
+
+        if ((code >= 0) && (code <= DXF_WRITE_MAX_PREFIX))
+        {
+                if (fp->binary == 2)
+                        dxf_write_bytes (fp, dxf_write_prefixes[code].r13, 2);
+                else
+                        dxf_write_bytes (fp, dxf_write_prefixes[code].r12,
+                                dxf_write_prefixes[code].r12_length);
+        }
+        else if (fp->binary == 2)
+        {
+                bytes[0] = (unsigned char) code;
+                bytes[1] = (unsigned char) (code >> 8);
+                dxf_write_bytes (fp, bytes, 2);
+        }
+        else if ((code >= 0) && (code < 255))
+        {
+                bytes[0] = (unsigned char) code;
+                dxf_write_bytes (fp, bytes, 1);
+        }
+        else
+        {
+                bytes[0] = 255;
+                bytes[1] = (unsigned char) code;
+                bytes[2] = (unsigned char) (code >> 8);
+                dxf_write_bytes (fp, bytes, 3);
+        }
+}
+
+
+/*!
+ * \brief Writes a group with a number to a binary DXF file, in the type
+ * which follows from the group code.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_write_binary_number
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        int code,
+                /*!< the group code. */
+        long long integer,
+                /*!< the value, for integer group codes. */
+        double real
+                /*!< the value, for floating point group codes. */
+)
+{
+        unsigned char bytes[8];
+        unsigned long long bits;
+        size_t size;
+        size_t i;
+
+        switch (dxf_binary_type (code))
+        {
+                case DXF_BINARY_DOUBLE:
+                        memcpy (&bits, &real, sizeof (bits));
+                        size = 8;
+                        break;
+                case DXF_BINARY_INT64:
+                        bits = (unsigned long long) integer;
+                        size = 8;
+                        break;
+                case DXF_BINARY_INT32:
+                        bits = (unsigned long long) integer;
+                        size = 4;
+                        break;
+                case DXF_BINARY_INT16:
+                        bits = (unsigned long long) integer;
+                        size = 2;
+                        break;
+                case DXF_BINARY_INT8:
+                        bits = (unsigned long long) integer;
+                        size = 1;
+                        break;
+                default:
+                        return (EXIT_FAILURE);
+        }
+        for (i = 0; i < size; i++)
+                bytes[i] = (unsigned char) (bits >> (8 * i));
+        dxf_write_binary_code (fp, code);
+        return (dxf_write_bytes (fp, bytes, size));
+}
+
+
+/*!
+ * \brief Writes a group with text to a binary DXF file.
+ *
+ * Binary data (group codes 310 - 319, 1004) is given as hexadecimal
+ * digits, like in an ASCII DXF file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_write_binary_text
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        int code,
+                /*!< the group code. */
+        const char *value
+                /*!< the value. */
+)
+{
+        unsigned char bytes[256];
+        size_t length = strlen (value);
+        size_t i;
+        unsigned int byte;
+
+        dxf_write_binary_code (fp, code);
+        if (dxf_binary_type (code) != DXF_BINARY_CHUNK)
+                return (dxf_write_bytes (fp, value, length + 1));
+        for (i = 0; (i < 255) && (2 * i + 1 < length); i++)
+        {
+                if (sscanf (value + 2 * i, "%2x", &byte) != 1)
+                        break;
+                bytes[i + 1] = (unsigned char) byte;
+        }
+        bytes[0] = (unsigned char) i;
+        return (dxf_write_bytes (fp, bytes, i + 1));
+}
+
+
+/*!
+ * \brief Writes a group with a string value.
+ *
+ * In a binary DXF file a value for a group code with a numeric type is
+ * converted to that type.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_write_group_string
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        int code,
+                /*!< the group code. */
+        const char *value
+                /*!< the value. */
+)
+{
+        double real;
+        char *p;
+
+        if (!value)
+                value = "";
+        if (!fp->binary)
+        {
+                p = dxf_write_reserve (fp, 24);
+                fp->buffer_length += dxf_write_format_code (p, code);
+                dxf_write_bytes (fp, value, strlen (value));
+                return (dxf_write_bytes (fp, "\n", 1));
+        }
+        switch (dxf_binary_type (code))
+        {
+                case DXF_BINARY_TEXT:
+                case DXF_BINARY_CHUNK:
+                        return (dxf_write_binary_text (fp, code, value));
+                default:
+                        dxf_strtod (value, strlen (value), &real);
+                        return (dxf_write_binary_number (fp, code,
+                                strtoll (value, NULL, 10), real));
+        }
+}
+
+
+/*!
+ * \brief Writes a group with an integer value.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_write_group_int
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        int code,
+                /*!< the group code. */
+        int value
+                /*!< the value. */
+)
+{
+        char text[16];
+        char *p;
+        size_t n;
+
+        if (!fp->binary)
+        {
+                p = dxf_write_reserve (fp, 48);
+                n = dxf_write_format_code (p, code);
+                n += dxf_write_format_int (p + n, value);
+                p[n++] = '\n';
+                fp->buffer_length += n;
+                return (fp->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+        }
+        if (dxf_binary_type (code) == DXF_BINARY_TEXT)
+        {
+                snprintf (text, sizeof (text), "%d", value);
+                return (dxf_write_binary_text (fp, code, text));
+        }
+        return (dxf_write_binary_number (fp, code, value, (double) value));
+}
+
+
+/*!
+ * \brief Writes a group with an integer value as a hexadecimal number
+ * (handles).
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_write_group_hex
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        int code,
+                /*!< the group code. */
+        int value
+                /*!< the value. */
+)
+{
+        char text[16];
+        char *p;
+        size_t n;
+
+        if (!fp->binary)
+        {
+                p = dxf_write_reserve (fp, 48);
+                n = dxf_write_format_code (p, code);
+                n += dxf_write_format_hex (p + n, (unsigned int) value);
+                p[n++] = '\n';
+                fp->buffer_length += n;
+                return (fp->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+        }
+        if (dxf_binary_type (code) == DXF_BINARY_TEXT)
+        {
+                snprintf (text, sizeof (text), "%x", value);
+                return (dxf_write_binary_text (fp, code, text));
+        }
+        return (dxf_write_binary_number (fp, code, value, (double) value));
+}
+
+
+/*!
+ * \brief Writes a group with a floating point value.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_write_group_double
+(
+        DxfWriter *fp,
+                /*!< DXF file handle of output file (or device). */
+        int code,
+                /*!< the group code. */
+        double value
+                /*!< the value. */
+)
+{
+        char text[DXF_DTOA_LENGTH];
+        char *p;
+        size_t n;
+
+        if (!fp->binary)
+        {
+                p = dxf_write_reserve (fp, 24 + DXF_DTOA_LENGTH);
+                n = dxf_write_format_code (p, code);
+                n += (fp->precision < 0) ? dxf_dtoa_shortest (p + n, value)
+                        : dxf_dtoa_fixed (p + n, value, fp->precision);
+                p[n++] = '\n';
+                fp->buffer_length += n;
+                return (fp->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+        }
+        if (dxf_binary_type (code) == DXF_BINARY_TEXT)
+        {
+                if (fp->precision < 0)
+                        dxf_dtoa_shortest (text, value);
+                else
+                        dxf_dtoa_fixed (text, value, fp->precision);
+                return (dxf_write_binary_text (fp, code, text));
+        }
+        return (dxf_write_binary_number (fp, code, (long long) value, value));
+}
+
+
+/* EOF */
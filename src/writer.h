@@ -0,0 +1,58 @@
+/*!
+ * \file writer.h
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Definition of the functions writing groups to a DXF file.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#ifndef WRITER_H
+#define WRITER_H
+
+
+#include "global.h"
+
+
+DxfWriter *dxf_write_init (const char *filename, int binary);
+DxfWriter *dxf_write_init_stream (FILE *fp, int binary);
+DxfWriter *dxf_write_init_memory (int binary);
+int dxf_write_close (DxfWriter *fp);
+int dxf_write_flush (DxfWriter *fp);
+int dxf_write_data (DxfWriter *fp, const char *data, size_t length);
+long dxf_write_tell (DxfWriter *fp);
+int dxf_write_patch (DxfWriter *fp, long offset, const char *data, size_t length);
+int dxf_write_set_precision (DxfWriter *fp, int precision);
+int dxf_write_group_string (DxfWriter *fp, int code, const char *value);
+int dxf_write_group_int (DxfWriter *fp, int code, int value);
+int dxf_write_group_hex (DxfWriter *fp, int code, int value);
+int dxf_write_group_double (DxfWriter *fp, int code, double value);
+
+
+#endif /* WRITER_H */
+
+
+/* EOF */
@@ -0,0 +1,878 @@
+/*!
+ * \file bench.c
+ * \author Copyright (C) 2011 by Bert Timmerman <bert.timmerman@xs4all.nl>.
+ * \brief Benchmarks for libdxf.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com .
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../src/strtod.h"
+#include "../src/scan.h"
+#include "../src/parallel.h"
+#include "../src/arena.h"
+#include "../src/entity.h"
+#include "../src/object.h"
+#include "../src/line.h"
+#include "../src/pool.h"
+#include "../src/vertex.h"
+#include "../src/writer.h"
+
+
+/*!
+ * \brief Number of coordinates converted in each benchmark.
+ */
+#define BENCH_COUNT 1000000
+
+
+/*!
+ * \brief Wall clock time in seconds.
+ */
+static double
+bench_now (void)
+{
+        struct timespec now;
+
+        clock_gettime (CLOCK_MONOTONIC, &now);
+        return (now.tv_sec + now.tv_nsec / 1e9);
+}
+
+
+/*!
+ * \brief Prints the time and the throughput of a benchmark.
+ */
+static void
+bench_report
+(
+        const char *name,
+                /*!< name of the benchmark. */
+        double start,
+                /*!< \c bench_now at the start of the benchmark. */
+        size_t bytes,
+                /*!< number of bytes processed. */
+        double checksum
+                /*!< result, printed to keep the work from being
+                 * optimized away. */
+)
+{
+        double seconds = bench_now () - start;
+
+        fprintf (stdout, "BENCH: %-24s %8.3f s %8.1f MB/s (checksum %g)\n",
+                name, seconds, seconds > 0.0 ? bytes / seconds / 1e6 : 0.0,
+                checksum);
+}
+
+
+/*!
+ * \brief Prints the memory per entity of a drawing read into an arena,
+ * and the size of the common properties per entity as \c DxfEntity and
+ * as \c DxfEntityHeader.
+ */
+static void
+bench_memory
+(
+        const char *filename
+                /*!< the drawing. */
+)
+{
+        DxfArena *arena;
+        DxfArenaChunk *chunk;
+        DxfEntityHeaders *headers;
+        DxfEntityRecord *records;
+        size_t count;
+        size_t used = 0;
+        size_t compact;
+        size_t i;
+
+        arena = dxf_arena_new (0);
+        if (!arena
+                || (dxf_read_entities_arena (filename, 1, arena, &records, &count, NULL) != EXIT_SUCCESS)
+                || (count == 0))
+        {
+                dxf_arena_free (arena);
+                return;
+        }
+        for (chunk = arena->chunks; chunk; chunk = chunk->next)
+                used += chunk->used;
+        headers = dxf_entity_headers_new (arena->names);
+        for (i = 0; headers && (i < count); i++)
+        {
+                /* All entities but APPID start with a DxfEntity. */
+                if (records[i].type != APPID)
+                        dxf_entity_headers_add (headers, records[i].entity);
+        }
+        if (headers && (headers->count > 0))
+        {
+                compact = headers->count * sizeof (DxfEntityHeader)
+                        + headers->thickness_count * sizeof (double);
+                fprintf (stdout, "BENCH: memory %-22s %8.1f bytes/entity, common %d -> %.1f bytes/entity\n",
+                        strrchr (filename, '/') ? strrchr (filename, '/') + 1 : filename,
+                        (double) used / count, (int) sizeof (DxfEntity),
+                        (double) compact / headers->count);
+        }
+        dxf_entity_headers_free (headers);
+        dxf_arena_free (arena);
+}
+
+
+/*!
+ * \brief Returns the resident memory of the process in bytes, 0 when it
+ * is not known.
+ */
+static size_t
+bench_resident (void)
+{
+        unsigned long size = 0;
+        unsigned long pages = 0;
+        FILE *fp;
+
+        fp = fopen ("/proc/self/statm", "r");
+        if (!fp)
+                return (0);
+        if (fscanf (fp, "%lu %lu", &size, &pages) != 2)
+                pages = 0;
+        fclose (fp);
+        return ((size_t) pages * (size_t) sysconf (_SC_PAGESIZE));
+}
+
+
+/*!
+ * \brief Number of vertices alive at once in the churn benchmarks.
+ */
+#define BENCH_WINDOW 4096
+
+
+/*!
+ * \brief Allocates and frees vertices with \c malloc and with a
+ * \c DxfPool: all at once as for a POLYLINE, and with a window of
+ * vertices alive of which one is replaced in each step.
+ */
+static void
+bench_pool (void)
+{
+        DxfVertex **vertices;
+        DxfPool *pool;
+        double start;
+        double checksum;
+        size_t i;
+        size_t j;
+        int round;
+
+        vertices = malloc (BENCH_COUNT * sizeof (DxfVertex *));
+        if (!vertices)
+                return;
+        for (round = 0; round < 2; round++)
+        {
+                pool = (round == 0) ? NULL : dxf_pool_new (NULL, sizeof (DxfVertex));
+                if ((round == 1) && !pool)
+                        break;
+                start = bench_now ();
+                checksum = 0.0;
+                for (i = 0; i < BENCH_COUNT; i++)
+                {
+                        if (pool)
+                                vertices[i] = dxf_pool_alloc (pool);
+                        else
+                        {
+                                vertices[i] = malloc (sizeof (DxfVertex));
+                                memset (vertices[i], 0, sizeof (DxfVertex));
+                        }
+                        vertices[i]->x0 = (double) i;
+                }
+                for (i = 0; i < BENCH_COUNT; i++)
+                {
+                        checksum += vertices[i]->x0;
+                        if (pool)
+                                dxf_pool_release (pool, vertices[i]);
+                        else
+                                free (vertices[i]);
+                }
+                bench_report (pool ? "vertices, pool" : "vertices, malloc",
+                        start, BENCH_COUNT * sizeof (DxfVertex), checksum);
+                start = bench_now ();
+                checksum = 0.0;
+                for (i = 0; i < 4 * (size_t) BENCH_COUNT; i++)
+                {
+                        j = (i * 7919) % BENCH_WINDOW;
+                        if (i >= BENCH_WINDOW)
+                        {
+                                checksum += vertices[j]->x0;
+                                if (pool)
+                                        dxf_pool_release (pool, vertices[j]);
+                                else
+                                        free (vertices[j]);
+                        }
+                        if (pool)
+                                vertices[j] = dxf_pool_alloc (pool);
+                        else
+                        {
+                                vertices[j] = malloc (sizeof (DxfVertex));
+                                memset (vertices[j], 0, sizeof (DxfVertex));
+                        }
+                        vertices[j]->x0 = (double) i;
+                }
+                for (j = 0; j < BENCH_WINDOW; j++)
+                {
+                        if (pool)
+                                dxf_pool_release (pool, vertices[j]);
+                        else
+                                free (vertices[j]);
+                }
+                bench_report (pool ? "vertex churn, pool" : "vertex churn, malloc",
+                        start, 4 * (size_t) BENCH_COUNT * sizeof (DxfVertex), checksum);
+                dxf_pool_free (pool);
+        }
+        free (vertices);
+}
+
+
+/*!
+ * \brief Reads the OBJECTS section of a drawing with many dictionaries
+ * into an arena, and prints the resident memory used per object.
+ */
+static void
+bench_objects (void)
+{
+        const char *filename = "bench.dxf";
+        DxfArena *arena;
+        DxfObject *objects;
+        size_t count;
+        size_t bytes;
+        size_t resident;
+        size_t used = 0;
+        DxfArenaChunk *chunk;
+        FILE *fp;
+        double start;
+        int i;
+
+        fp = fopen (filename, "w");
+        if (!fp)
+                return;
+        fprintf (fp, "  0\nSECTION\n  2\nOBJECTS\n");
+        for (i = 0; i < BENCH_COUNT / 10; i++)
+                fprintf (fp, "  0\nDICTIONARY\n  5\n%X\n330\nC\n100\nAcDbDictionary\n281\n1\n"
+                        "  3\nENTRY%d\n350\n%X\n 40\n%f\n",
+                        i + 16, i, i + 17, i / 1000.0);
+        fprintf (fp, "  0\nENDSEC\n  0\nEOF\n");
+        bytes = (size_t) ftell (fp);
+        fclose (fp);
+        resident = bench_resident ();
+        arena = dxf_arena_new (0);
+        start = bench_now ();
+        dxf_read_objects (filename, arena, &objects, &count);
+        bench_report ("objects, arena", start, bytes, (double) count);
+        resident = bench_resident () - resident;
+        for (chunk = arena ? arena->chunks : NULL; chunk; chunk = chunk->next)
+                used += chunk->used;
+        if (count > 0)
+                fprintf (stdout, "BENCH: memory %-22s %8.1f bytes/object (%.1f resident), %d as DxfParam\n",
+                        "objects", (double) used / count, (double) resident / count,
+                        (int) (DXF_MAX_PARAM * sizeof (DxfParam)));
+        dxf_arena_free (arena);
+        remove (filename);
+}
+
+
+/*!
+ * \brief Compares \c dxf_strtod with \c strtod and \c sscanf on
+ * coordinates as written to DXF files.
+ */
+static void
+bench_strtod (void)
+{
+        char *strings;
+        size_t *lengths;
+        size_t bytes = 0;
+        double value;
+        double sum;
+        double start;
+        int i;
+
+        strings = malloc ((size_t) BENCH_COUNT * 32);
+        lengths = malloc ((size_t) BENCH_COUNT * sizeof (size_t));
+        if (!strings || !lengths)
+        {
+                free (strings);
+                free (lengths);
+                return;
+        }
+        srand (1);
+        for (i = 0; i < BENCH_COUNT; i++)
+        {
+                value = (rand () - RAND_MAX / 2) / 1000.0;
+                if (i % 2)
+                        lengths[i] = (size_t) sprintf (strings + 32 * i, "%f", value);
+                else
+                        lengths[i] = (size_t) sprintf (strings + 32 * i, "%.17g", value);
+                bytes += lengths[i];
+        }
+        sum = 0.0;
+        start = bench_now ();
+        for (i = 0; i < BENCH_COUNT; i++)
+                sum += strtod (strings + 32 * i, NULL);
+        bench_report ("strtod", start, bytes, sum);
+        sum = 0.0;
+        start = bench_now ();
+        for (i = 0; i < BENCH_COUNT; i++)
+        {
+                sscanf (strings + 32 * i, "%lf", &value);
+                sum += value;
+        }
+        bench_report ("sscanf", start, bytes, sum);
+        sum = 0.0;
+        start = bench_now ();
+        for (i = 0; i < BENCH_COUNT; i++)
+        {
+                dxf_strtod (strings + 32 * i, lengths[i], &value);
+                sum += value;
+        }
+        bench_report ("dxf_strtod", start, bytes, sum);
+        free (strings);
+        free (lengths);
+}
+
+
+/*!
+ * \brief Compares \c dxf_scan_lines with a \c memchr loop on the lines
+ * of a DXF file.
+ */
+static void
+bench_scan (void)
+{
+        char *buffer;
+        size_t lines[DXF_READ_LINES];
+        size_t length = 0;
+        size_t position;
+        size_t count;
+        size_t total;
+        const char *p;
+        double start;
+        int i;
+
+        buffer = malloc ((size_t) BENCH_COUNT * 32);
+        if (!buffer)
+                return;
+        for (i = 0; i < BENCH_COUNT; i++)
+        {
+                if (i % 2)
+                        length += (size_t) sprintf (buffer + length, "%f\r\n",
+                                (i - BENCH_COUNT / 2) / 1000.0);
+                else
+                        length += (size_t) sprintf (buffer + length, " %d\r\n",
+                                10 + 10 * (i % 3));
+        }
+        total = 0;
+        start = bench_now ();
+        for (p = buffer; (p = memchr (p, '\n', length - (size_t) (p - buffer))); p++)
+                total++;
+        bench_report ("memchr", start, length, (double) total);
+        total = 0;
+        position = 0;
+        start = bench_now ();
+        while (position < length)
+        {
+                count = dxf_scan_lines (buffer, position, length, lines,
+                        DXF_READ_LINES, &position);
+                total += count;
+        }
+        bench_report ("dxf_scan_lines", start, length, (double) total);
+        fprintf (stdout, "BENCH: dxf_scan_lines uses %s\n", dxf_scan_name ());
+        free (buffer);
+}
+
+
+/*!
+ * \brief Compares reading the \c ENTITIES section with one thread and
+ * with a thread per processor.
+ */
+static void
+bench_parallel (void)
+{
+        const char *filename = "bench.dxf";
+        DxfArena *arena;
+        DxfEntityRecord *records;
+        size_t count;
+        size_t bytes;
+        FILE *fp;
+        double start;
+        int i;
+
+        fp = fopen (filename, "w");
+        if (!fp)
+                return;
+        fprintf (fp, "  0\nSECTION\n  2\nENTITIES\n");
+        for (i = 0; i < BENCH_COUNT / 4; i++)
+                fprintf (fp, "  0\nLINE\n  5\n%X\n  8\n0\n 10\n%f\n 20\n%f\n 11\n%f\n 21\n%f\n",
+                        i + 16, i / 1000.0, -i / 1000.0, i / 500.0, -i / 500.0);
+        fprintf (fp, "  0\nENDSEC\n  0\nEOF\n");
+        bytes = (size_t) ftell (fp);
+        fclose (fp);
+        start = bench_now ();
+        dxf_read_entities_parallel (filename, 1, &records, &count);
+        bench_report ("entities, 1 thread", start, bytes, (double) count);
+        dxf_entity_records_free (records, count);
+        start = bench_now ();
+        dxf_read_entities_parallel (filename, 0, &records, &count);
+        bench_report ("entities, all threads", start, bytes, (double) count);
+        dxf_entity_records_free (records, count);
+        arena = dxf_arena_new (0);
+        start = bench_now ();
+        dxf_read_entities_arena (filename, 0, arena, &records, &count, NULL);
+        bench_report ("entities, arena", start, bytes, (double) count);
+        start = bench_now ();
+        dxf_arena_free (arena);
+        bench_report ("entities, arena free", start, bytes, (double) count);
+        bench_memory (filename);
+        remove (filename);
+}
+
+
+/*!
+ * \brief Writes a group with a text value to a binary DXF file.
+ */
+static void
+bench_put_string
+(
+        FILE *fp,
+                /*!< file to write to. */
+        int code,
+                /*!< the group code. */
+        const char *value
+                /*!< the value. */
+)
+{
+        fputc (code & 0xff, fp);
+        fputc ((code >> 8) & 0xff, fp);
+        fwrite (value, 1, strlen (value) + 1, fp);
+}
+
+
+/*!
+ * \brief Writes a group with a floating point value to a binary DXF
+ * file.
+ */
+static void
+bench_put_double
+(
+        FILE *fp,
+                /*!< file to write to. */
+        int code,
+                /*!< the group code. */
+        double value
+                /*!< the value. */
+)
+{
+        unsigned char bytes[8];
+        unsigned long long bits;
+        int i;
+
+        memcpy (&bits, &value, sizeof (bits));
+        for (i = 0; i < 8; i++)
+                bytes[i] = (unsigned char) (bits >> (8 * i));
+        fputc (code & 0xff, fp);
+        fputc ((code >> 8) & 0xff, fp);
+        fwrite (bytes, 1, sizeof (bytes), fp);
+}
+
+
+/*!
+ * \brief Reads the entities of a file with one thread and reports the
+ * sum of the start points of the lines.
+ */
+static void
+bench_entities
+(
+        const char *name,
+                /*!< name of the benchmark. */
+        const char *filename,
+                /*!< the file. */
+        size_t bytes
+                /*!< size of the file. */
+)
+{
+        DxfEntityRecord *records;
+        DxfLine *line;
+        size_t count;
+        size_t i;
+        double sum = 0.0;
+        double start;
+
+        start = bench_now ();
+        dxf_read_entities_parallel (filename, 1, &records, &count);
+        for (i = 0; i < count; i++)
+        {
+                line = records[i].entity;
+                sum += line->x0 - line->y0;
+        }
+        bench_report (name, start, bytes, sum);
+        dxf_entity_records_free (records, count);
+}
+
+
+/*!
+ * \brief Compares reading the same drawing from an ASCII DXF file and
+ * from a binary DXF file.
+ */
+static void
+bench_binary (void)
+{
+        const char *ascii = "bench.dxf";
+        const char *binary = "bench-binary.dxf";
+        size_t ascii_bytes;
+        size_t binary_bytes;
+        char handle[16];
+        FILE *fp;
+        FILE *fb;
+        int i;
+
+        fp = fopen (ascii, "w");
+        fb = fopen (binary, "wb");
+        if (!fp || !fb)
+        {
+                if (fp)
+                        fclose (fp);
+                if (fb)
+                        fclose (fb);
+                return;
+        }
+        fprintf (fp, "  0\nSECTION\n  2\nENTITIES\n");
+        fwrite (DXF_BINARY_SENTINEL, 1, DXF_BINARY_SENTINEL_LENGTH, fb);
+        bench_put_string (fb, 0, "SECTION");
+        bench_put_string (fb, 2, "ENTITIES");
+        for (i = 0; i < BENCH_COUNT / 4; i++)
+        {
+                fprintf (fp, "  0\nLINE\n  5\n%X\n  8\n0\n 10\n%.17g\n 20\n%.17g\n 11\n%.17g\n 21\n%.17g\n",
+                        i + 16, i / 1000.0, -i / 1000.0, i / 500.0, -i / 500.0);
+                sprintf (handle, "%X", i + 16);
+                bench_put_string (fb, 0, "LINE");
+                bench_put_string (fb, 5, handle);
+                bench_put_string (fb, 8, "0");
+                bench_put_double (fb, 10, i / 1000.0);
+                bench_put_double (fb, 20, -i / 1000.0);
+                bench_put_double (fb, 11, i / 500.0);
+                bench_put_double (fb, 21, -i / 500.0);
+        }
+        fprintf (fp, "  0\nENDSEC\n  0\nEOF\n");
+        bench_put_string (fb, 0, "ENDSEC");
+        bench_put_string (fb, 0, "EOF");
+        ascii_bytes = (size_t) ftell (fp);
+        binary_bytes = (size_t) ftell (fb);
+        fclose (fp);
+        fclose (fb);
+        bench_entities ("entities, ASCII", ascii, ascii_bytes);
+        bench_entities ("entities, binary", binary, binary_bytes);
+        remove (ascii);
+        remove (binary);
+}
+
+
+/*!
+ * \brief Compares \c dxf_dtoa_shortest with \c snprintf "%.17g" on
+ * coordinates with few decimals, on computed coordinates which need up
+ * to 17 digits and on tiny values which are written with an exponent
+ * (like the rest of a sine near zero).
+ */
+static void
+bench_dtoa (void)
+{
+        char string[DXF_DTOA_LENGTH];
+        double start;
+        size_t bytes;
+        int i;
+        int j;
+        const char *names[6] =
+        {
+                "dtoa, snprintf %.17g",
+                "dtoa, shortest",
+                "dtoa 17 digits, snprintf",
+                "dtoa 17 digits, shortest",
+                "dtoa exponent, snprintf",
+                "dtoa exponent, shortest"
+        };
+
+        for (j = 0; j < 6; j++)
+        {
+                start = bench_now ();
+                bytes = 0;
+                for (i = 1; i <= BENCH_COUNT; i++)
+                {
+                        double value = (j < 2) ? i / 1000.0
+                                : (j < 4) ? i / 3.0 : i * 6.123233995736766e-20;
+
+                        if (j % 2 == 0)
+                                bytes += (size_t) snprintf (string, sizeof (string), "%.17g", value);
+                        else
+                                bytes += dxf_dtoa_shortest (string, value);
+                }
+                bench_report (names[j], start, bytes, (double) bytes);
+        }
+}
+
+
+/*!
+ * \brief Writes lines with \c dxf_line_write_lowlevel to a file.
+ */
+static void
+bench_write_lines
+(
+        const char *name,
+                /*!< name of the benchmark. */
+        const char *filename,
+                /*!< the file. */
+        int binary
+                /*!< size of the group codes of a binary DXF file, 0 for
+                 * an ASCII DXF file. */
+)
+{
+        DxfWriter *writer;
+        double start;
+        long bytes;
+        int i;
+
+        start = bench_now ();
+        writer = dxf_write_init (filename, binary);
+        if (!writer)
+                return;
+        /* Lines of zero length are refused, so start at 1. */
+        for (i = 1; i <= BENCH_COUNT / 4; i++)
+                dxf_line_write_lowlevel (writer, i + 16, DXF_DEFAULT_LINETYPE,
+                        "0", i / 1000.0, -i / 1000.0, 0.0, i / 500.0,
+                        -i / 500.0, 0.0, 0.0, DXF_COLOR_BYLAYER, DXF_MODELSPACE);
+        dxf_write_flush (writer);
+        bytes = ftell (writer->fp);
+        dxf_write_close (writer);
+        bench_report (name, start, (size_t) bytes, (double) bytes);
+        remove (filename);
+}
+
+
+/*!
+ * \brief Writes the same lines as \c bench_write_lines with
+ * \c dxf_line_write_batch, from arrays of coordinates.
+ */
+static void
+bench_write_batch (void)
+{
+        DxfWriter *writer;
+        double *coordinates;
+        double start;
+        long bytes;
+        int handle = 17;
+        int i;
+
+        coordinates = malloc ((size_t) BENCH_COUNT * sizeof (double));
+        if (!coordinates)
+                return;
+        for (i = 0; i < BENCH_COUNT / 4; i++)
+        {
+                coordinates[i] = (i + 1) / 1000.0;
+                coordinates[i + BENCH_COUNT / 4] = -(i + 1) / 1000.0;
+                coordinates[i + BENCH_COUNT / 2] = (i + 1) / 500.0;
+                coordinates[i + 3 * (BENCH_COUNT / 4)] = -(i + 1) / 500.0;
+        }
+        start = bench_now ();
+        writer = dxf_write_init ("bench.dxf", 0);
+        if (writer)
+        {
+                dxf_line_write_batch (writer, BENCH_COUNT / 4, coordinates,
+                        coordinates + BENCH_COUNT / 4, NULL,
+                        coordinates + BENCH_COUNT / 2,
+                        coordinates + 3 * (BENCH_COUNT / 4), NULL, "0",
+                        DXF_COLOR_BYLAYER, &handle);
+                dxf_write_flush (writer);
+                bytes = ftell (writer->fp);
+                dxf_write_close (writer);
+                bench_report ("write lines, batch", start, (size_t) bytes, (double) bytes);
+        }
+        free (coordinates);
+        remove ("bench.dxf");
+}
+
+
+/*!
+ * \brief Writes the groups of lines with one \c fprintf per group, as
+ * the entity writers did before the DxfWriter buffer.
+ */
+static void
+bench_write_fprintf (void)
+{
+        FILE *fp;
+        double start;
+        long bytes;
+        int i;
+
+        start = bench_now ();
+        fp = fopen ("bench.dxf", "w");
+        if (!fp)
+                return;
+        for (i = 1; i <= BENCH_COUNT / 4; i++)
+        {
+                fprintf (fp, "%3d\n%s\n", 0, "LINE");
+                fprintf (fp, "%3d\n%x\n", 5, i + 16);
+                fprintf (fp, "%3d\n%s\n", 8, "0");
+                fprintf (fp, "%3d\n%f\n", 10, i / 1000.0);
+                fprintf (fp, "%3d\n%f\n", 20, -i / 1000.0);
+                fprintf (fp, "%3d\n%f\n", 30, 0.0);
+                fprintf (fp, "%3d\n%f\n", 11, i / 500.0);
+                fprintf (fp, "%3d\n%f\n", 21, -i / 500.0);
+                fprintf (fp, "%3d\n%f\n", 31, 0.0);
+        }
+        bytes = ftell (fp);
+        fclose (fp);
+        bench_report ("write groups, fprintf", start, (size_t) bytes, (double) bytes);
+        remove ("bench.dxf");
+}
+
+
+/*!
+ * \brief Writes the same groups through the buffer of a DxfWriter.
+ */
+static void
+bench_write_groups (void)
+{
+        DxfWriter *writer;
+        double start;
+        long bytes;
+        int i;
+
+        start = bench_now ();
+        writer = dxf_write_init ("bench.dxf", 0);
+        if (!writer)
+                return;
+        for (i = 1; i <= BENCH_COUNT / 4; i++)
+        {
+                dxf_write_group_string (writer, 0, "LINE");
+                dxf_write_group_hex (writer, 5, i + 16);
+                dxf_write_group_string (writer, 8, "0");
+                dxf_write_group_double (writer, 10, i / 1000.0);
+                dxf_write_group_double (writer, 20, -i / 1000.0);
+                dxf_write_group_double (writer, 30, 0.0);
+                dxf_write_group_double (writer, 11, i / 500.0);
+                dxf_write_group_double (writer, 21, -i / 500.0);
+                dxf_write_group_double (writer, 31, 0.0);
+        }
+        dxf_write_flush (writer);
+        bytes = ftell (writer->fp);
+        dxf_write_close (writer);
+        bench_report ("write groups, DxfWriter", start, (size_t) bytes, (double) bytes);
+        remove ("bench.dxf");
+}
+
+
+/*!
+ * \brief Compares writing lines with \c dxf_write_entities_parallel with
+ * one thread and with a thread per processor.
+ */
+static void
+bench_write_parallel (void)
+{
+        DxfEntityRecord *records;
+        DxfWriter *writer;
+        DxfLine *line;
+        double start;
+        long bytes;
+        size_t count;
+        int threads;
+        int i;
+
+        records = malloc ((size_t) (BENCH_COUNT / 4) * sizeof (DxfEntityRecord));
+        if (!records)
+                return;
+        for (count = 0; count < BENCH_COUNT / 4; count++)
+        {
+                line = dxf_line_init (NULL);
+                if (!line)
+                        break;
+                line->common.id_code = (int) count + 16;
+                line->x0 = count / 1000.0;
+                line->y0 = -(count / 1000.0);
+                line->x1 = (count + 1) / 500.0;
+                line->y1 = -((count + 1) / 500.0);
+                records[count].type = LINE;
+                records[count].entity = line;
+                records[count].line_number = 0;
+        }
+        for (i = 0; i < 2; i++)
+        {
+                threads = (i == 0) ? 1 : 0;
+                start = bench_now ();
+                writer = dxf_write_init ("bench.dxf", 0);
+                if (!writer)
+                        break;
+                dxf_write_entities_parallel (writer, records, count,
+                        AutoCAD_2000, threads, NULL);
+                dxf_write_flush (writer);
+                bytes = ftell (writer->fp);
+                dxf_write_close (writer);
+                bench_report ((i == 0) ? "write entities, 1 thread"
+                        : "write entities, all threads", start, (size_t) bytes,
+                        (double) bytes);
+        }
+        dxf_entity_records_free (records, count);
+        remove ("bench.dxf");
+}
+
+
+/*!
+ * \brief Compares writing the groups of lines with \c fprintf and with
+ * a DxfWriter, writing the same lines to an ASCII DXF file and to a
+ * binary DXF file, from arrays, and with a pool of threads.
+ */
+static void
+bench_write (void)
+{
+        bench_dtoa ();
+        bench_write_fprintf ();
+        bench_write_groups ();
+        bench_write_lines ("write lines, ASCII", "bench.dxf", 0);
+        bench_write_lines ("write lines, binary", "bench-binary.dxf", 2);
+        bench_write_batch ();
+        bench_write_parallel ();
+}
+
+
+int main (void)
+{
+        /* First, so the memory freed by the other benchmarks does not
+         * hide the growth of the resident memory. */
+        bench_objects ();
+        bench_pool ();
+        bench_strtod ();
+        bench_scan ();
+        bench_parallel ();
+        bench_memory ("../examples/qcad-example_R12.dxf");
+        bench_memory ("../examples/qcad-example_R2000.dxf");
+        bench_binary ();
+        bench_write ();
+        return 0;
+}
+
+
+/* EOF */
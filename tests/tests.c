@@ -31,6 +31,156 @@
 
 #include <string.h>
 #include "../src/file.h"
+#include "../src/reader.h"
+#include "../src/callback.h"
+#include "../src/line.h"
+#include "../src/section.h"
+#include "../src/util.h"
+#include "../src/writer.h"
+#include "../src/eof.h"
+#include "../src/push.h"
+#include "../src/parallel.h"
+#include "../src/session.h"
+#include "../src/arena.h"
+#include "../src/object.h"
+#include "../src/intern.h"
+#include "../src/vertex.h"
+#include "../src/viewport.h"
+#include "../src/point.h"
+#include "../src/circle.h"
+#include "../src/arc.h"
+#include "../src/3dface.h"
+#include "../src/lwpolyline.h"
+
+/*
+ * Counts the LINE entities of a file.
+ */
+static int count_lines (DxfEntityType type, void *entity, void *user_data)
+{
+    DxfLine *line = entity;
+    int *lines = user_data;
+    if ((type != LINE) || !line->common.layer)
+        return (EXIT_FAILURE);
+    (*lines)++;
+    return (EXIT_SUCCESS);
+}
+
+/*
+ * Counts the VIEWPORT entities with the layer WALLS frozen.
+ */
+static int count_frozen (DxfEntityType type, void *entity, void *user_data)
+{
+    DxfViewport *viewport = entity;
+    int *viewports = user_data;
+    if ((type != VIEWPORT)
+        || !dxf_viewport_layer_is_frozen (viewport, "WALLS")
+        || dxf_viewport_layer_is_frozen (viewport, "0"))
+        return (EXIT_FAILURE);
+    (*viewports)++;
+    return (EXIT_SUCCESS);
+}
+
+/*
+ * Compares the start point of a LINE with the one given.
+ */
+static int compare_start (DxfEntityType type, void *entity, void *user_data)
+{
+    DxfLine *line = entity;
+    double *start = user_data;
+    if ((type != LINE) || (line->x0 != start[0]) || (line->y0 != start[1]))
+        return (EXIT_FAILURE);
+    start[2] += 1.0;
+    return (EXIT_SUCCESS);
+}
+
+/*
+ * Coordinates written by the batch writers: the points, the centers of
+ * the circles and arcs, and the vertices of the polylines, of which the
+ * first has three vertices and the second one.
+ */
+static const double batch_xs[4] = { 1.5, -2.25, 3.0, 0.125 };
+static const double batch_ys[4] = { 4.0, 0.5, -6.75, 2.0 };
+static const double batch_radii[2] = { 1.0, 2.5 };
+static const double batch_start_angles[2] = { 30.0, 270.0 };
+static const double batch_end_angles[2] = { 270.0, 30.0 };
+static const size_t batch_first[3] = { 0, 3, 4 };
+
+/*
+ * The three corners of two triangles, X, Y and Z of the first triangle
+ * followed by those of the second.
+ */
+static const double batch_corners[3][6] =
+{
+    { 0.0, 0.0, 0.0, 10.0, 0.0, 1.0 },
+    { 1.0, 0.0, 0.0, 11.0, 0.0, 1.0 },
+    { 0.0, 1.0, 0.0, 10.0, 1.0, 1.0 }
+};
+
+/*
+ * Compares the entities written by the batch writers with the arrays
+ * they were written from, counting the entities of each type.
+ */
+static int check_batch (DxfEntityType type, void *entity, void *user_data)
+{
+    int *counts = user_data;
+    int i = counts[type];
+    int same = 0;
+    if (type == POINT)
+    {
+        DxfPoint *point = entity;
+        same = (i < 2) && (point->x0 == batch_xs[i]) && (point->y0 == batch_ys[i]);
+    }
+    else if (type == CIRCLE)
+    {
+        DxfCircle *circle = entity;
+        same = (i < 2) && (circle->x0 == batch_xs[i]) && (circle->y0 == batch_ys[i])
+            && (circle->radius == batch_radii[i]);
+    }
+    else if (type == ARC)
+    {
+        DxfArc *arc = entity;
+        same = (i < 2) && (arc->x0 == batch_xs[i]) && (arc->y0 == batch_ys[i])
+            && (arc->radius == batch_radii[i])
+            && (arc->start_angle == batch_start_angles[i])
+            && (arc->end_angle == batch_end_angles[i]);
+    }
+    else if (type == FACE3D)
+    {
+        /* A triangle repeats its third corner as the fourth. */
+        Dxf3dface *face = entity;
+        const double *corner = batch_corners[2] + 3 * i;
+        same = (i < 2) && (face->x0 == batch_corners[0][3 * i])
+            && (face->y1 == batch_corners[1][3 * i + 1])
+            && (face->x2 == corner[0]) && (face->z2 == corner[2])
+            && (face->x3 == corner[0]) && (face->y3 == corner[1])
+            && (face->z3 == corner[2]);
+    }
+    else if (type == LWPOLYLINE)
+    {
+        /* The last vertex read is kept. */
+        DxfLWPolyline *polyline = entity;
+        size_t last = (i < 2) ? batch_first[i + 1] - 1 : 0;
+        same = (i < 2)
+            && (polyline->number_vertices == (int) (batch_first[i + 1] - batch_first[i]))
+            && (polyline->flag == 1)
+            && (polyline->x0 == batch_xs[last]) && (polyline->y0 == batch_ys[last]);
+    }
+    if (!same)
+        return (EXIT_FAILURE);
+    counts[type]++;
+    return (EXIT_SUCCESS);
+}
+
+/*
+ * Counts the sections reported by a push parser.
+ */
+static int count_sections (const DxfReaderEvent *event, void *user_data)
+{
+    int *sections = user_data;
+    if (event->type == DXF_EVENT_SECTION_BEGIN)
+        (*sections)++;
+    return (EXIT_SUCCESS);
+}
 
 int main (void)
 {
@@ -42,6 +192,576 @@ int main (void)
         fprintf (stdout, "TESTS: R2000 exited with error\n");
     else
         fprintf (stdout, "TESTS: R2000 exited with no error\n");
-    
+
+    /*
+     * Pulls all events from the same file, every entity has to end.
+     */
+    DxfReader *reader;
+    DxfReaderEvent event;
+    int sections = 0;
+    int entities = 0;
+    reader = dxf_reader_open ("../examples/qcad-example_R2000.dxf");
+    while (reader && dxf_reader_next (reader, &event) > DXF_EVENT_EOF)
+    {
+        if (event.type == DXF_EVENT_SECTION_BEGIN)
+            sections++;
+        else if (event.type == DXF_EVENT_ENTITY_BEGIN)
+            entities++;
+        else if (event.type == DXF_EVENT_ENTITY_END)
+            entities--;
+    }
+    /* A fresh event after the end gets the end again. */
+    DxfReaderEvent fresh;
+    memset (&fresh, 0xff, sizeof (fresh));
+    if (!reader || (event.type != DXF_EVENT_EOF) || (entities != 0)
+        || (dxf_reader_next (reader, &fresh) != DXF_EVENT_EOF)
+        || (fresh.type != DXF_EVENT_EOF))
+        fprintf (stdout, "TESTS: R2000 pull reader exited with error\n");
+    else
+        fprintf (stdout, "TESTS: R2000 pull reader read %d sections with no error\n", sections);
+    dxf_reader_close (reader);
+
+    /*
+     * Calls a handler for the LINE entities of the same file.
+     */
+    DxfCallbackReader *callback_reader;
+    int lines = 0;
+    callback_reader = dxf_callback_reader_open ("../examples/qcad-example_R2000.dxf");
+    if (!callback_reader
+        || dxf_callback_reader_register (callback_reader, LINE, count_lines, &lines)
+        || dxf_callback_reader_run (callback_reader))
+        fprintf (stdout, "TESTS: R2000 callback reader exited with error\n");
+    else
+        fprintf (stdout, "TESTS: R2000 callback reader read %d lines with no error\n", lines);
+    dxf_callback_reader_close (callback_reader);
+
+    /*
+     * Calls the same handler on the file read into memory first.
+     */
+    FILE *in;
+    char *data = NULL;
+    long size = 0;
+    int memory_lines = 0;
+    in = fopen ("../examples/qcad-example_R2000.dxf", "r");
+    if (in && (fseek (in, 0, SEEK_END) == 0) && ((size = ftell (in)) > 0))
+    {
+        data = malloc ((size_t) size);
+        rewind (in);
+        if (data && (fread (data, 1, (size_t) size, in) != (size_t) size))
+            size = 0;
+    }
+    if (in)
+        fclose (in);
+    callback_reader = data ? dxf_callback_reader_open_file (dxf_read_memory (data, (size_t) size, FALSE)) : NULL;
+    if (!callback_reader
+        || dxf_callback_reader_register (callback_reader, LINE, count_lines, &memory_lines)
+        || dxf_callback_reader_run (callback_reader)
+        || (memory_lines != lines))
+        fprintf (stdout, "TESTS: R2000 memory reader exited with error\n");
+    else
+        fprintf (stdout, "TESTS: R2000 memory reader read %d lines with no error\n", memory_lines);
+    dxf_callback_reader_close (callback_reader);
+
+    /*
+     * Reads a LINE from CRLF lines with trailing spaces and tabs and with
+     * padded group codes.
+     */
+    static const char crlf_data[] =
+        "  0 \r\nSECTION  \r\n  2\r\nENTITIES\t\r\n  0\r\nLINE \r\n"
+        "  8 \r\n0  \r\n 10\t\r\n1.5 \r\n 20\r\n2.5\t \r\n"
+        "  0\r\nENDSEC \r\n  0\r\nEOF  \r\n";
+    double crlf_start[3] = { 1.5, 2.5, 0.0 };
+    callback_reader = dxf_callback_reader_open_file (dxf_read_memory (crlf_data,
+        sizeof (crlf_data) - 1, FALSE));
+    if (!callback_reader
+        || dxf_callback_reader_register (callback_reader, LINE, compare_start, crlf_start)
+        || dxf_callback_reader_run (callback_reader)
+        || (crlf_start[2] != 1.0))
+        fprintf (stdout, "TESTS: CRLF reader exited with error\n");
+    else
+        fprintf (stdout, "TESTS: CRLF reader read %g line with no error\n", crlf_start[2]);
+    dxf_callback_reader_close (callback_reader);
+
+    /*
+     * Feeds the same file to a push parser in chunks of 7 bytes.
+     */
+    DxfPushParser *push_parser;
+    int push_sections = 0;
+    long i;
+    int ret = EXIT_FAILURE;
+    push_parser = dxf_push_parser_new (count_sections, &push_sections);
+    if (push_parser && data)
+    {
+        ret = EXIT_SUCCESS;
+        for (i = 0; (i < size) && (ret == EXIT_SUCCESS); i += 7)
+            ret = dxf_push_parser_feed (push_parser, data + i, (size - i < 7) ? (size_t) (size - i) : 7);
+        if (ret == EXIT_SUCCESS)
+            ret = dxf_push_parser_finish (push_parser);
+    }
+    if ((ret != EXIT_SUCCESS) || (push_sections != sections))
+        fprintf (stdout, "TESTS: R2000 push parser exited with error\n");
+    else
+        fprintf (stdout, "TESTS: R2000 push parser read %d sections with no error\n", push_sections);
+    dxf_push_parser_free (push_parser);
+    free (data);
+
+    /*
+     * Indexes the sections of the same file and jumps to the ENTITIES.
+     */
+    DxfFile *fp;
+    const DxfSectionRange *section = NULL;
+    DxfGroup group;
+    fp = dxf_read_init ("../examples/qcad-example_R2000.dxf");
+    if (fp && (dxf_section_index (fp) == EXIT_SUCCESS))
+        section = dxf_section_find (fp, "ENTITIES");
+    if (!section
+        || dxf_section_seek (fp, section)
+        || !dxf_read_group (fp, &group)
+        || (group.code != 0)
+        || (section->start >= section->body)
+        || (section->body > section->end))
+        fprintf (stdout, "TESTS: R2000 section index exited with error\n");
+    else
+        fprintf (stdout, "TESTS: R2000 section index found %d sections with no error\n", fp->section_count);
+    dxf_read_close (fp);
+
+    /*
+     * Writes a LINE to a binary DXF file and reads it back.
+     */
+    DxfWriter *writer;
+    int binary_lines = 0;
+    writer = dxf_write_init ("binary.dxf", 2);
+    if (writer)
+    {
+        dxf_section_write (writer, "ENTITIES");
+        dxf_line_write_lowlevel (writer, 0x2f, DXF_DEFAULT_LINETYPE, "0",
+            1.0, 2.0, 0.0, 3.0, 4.0, 0.0, 0.0, 1, DXF_MODELSPACE);
+        dxf_section_write_endsection (writer);
+        dxf_write_eof (writer);
+    }
+    callback_reader = NULL;
+    if (writer && (dxf_write_close (writer) == EXIT_SUCCESS))
+        callback_reader = dxf_callback_reader_open ("binary.dxf");
+    if (!callback_reader
+        || !callback_reader->reader->fp->binary
+        || dxf_callback_reader_register (callback_reader, LINE, count_lines, &binary_lines)
+        || dxf_callback_reader_run (callback_reader)
+        || (binary_lines != 1))
+        fprintf (stdout, "TESTS: binary writer exited with error\n");
+    else
+        fprintf (stdout, "TESTS: binary writer wrote %d line with no error\n", binary_lines);
+    dxf_callback_reader_close (callback_reader);
+    remove ("binary.dxf");
+
+    /*
+     * Writes a LINE to a gzip compressed DXF file and reads it back.
+     */
+    int gzip_lines = 0;
+    writer = dxf_write_init ("compressed.dxf.gz", 0);
+    if (writer)
+    {
+        dxf_section_write (writer, "ENTITIES");
+        dxf_line_write_lowlevel (writer, 0x2f, DXF_DEFAULT_LINETYPE, "0",
+            1.0, 2.0, 0.0, 3.0, 4.0, 0.0, 0.0, 1, DXF_MODELSPACE);
+        dxf_section_write_endsection (writer);
+        dxf_write_eof (writer);
+    }
+    callback_reader = NULL;
+    if (writer && (dxf_write_close (writer) == EXIT_SUCCESS))
+        callback_reader = dxf_callback_reader_open ("compressed.dxf.gz");
+    if (!callback_reader
+        || !callback_reader->reader->fp->stream
+        || dxf_callback_reader_register (callback_reader, LINE, count_lines, &gzip_lines)
+        || dxf_callback_reader_run (callback_reader)
+        || (gzip_lines != 1))
+        fprintf (stdout, "TESTS: gzip writer exited with error\n");
+    else
+        fprintf (stdout, "TESTS: gzip writer wrote %d line with no error\n", gzip_lines);
+    dxf_callback_reader_close (callback_reader);
+    remove ("compressed.dxf.gz");
+
+    /*
+     * Writes coordinates which need 17 digits and reads them back.
+     */
+    double start[3] = { 0.1 + 0.2, 1.0 / 3.0e6, 0.0 };
+    writer = dxf_write_init ("precision.dxf", 0);
+    if (writer)
+    {
+        dxf_section_write (writer, "ENTITIES");
+        dxf_line_write_lowlevel (writer, 0x30, DXF_DEFAULT_LINETYPE, "0",
+            start[0], start[1], 0.0, 3.0, 4.0, 0.0, 0.0, 1, DXF_MODELSPACE);
+        dxf_section_write_endsection (writer);
+        dxf_write_eof (writer);
+    }
+    callback_reader = NULL;
+    if (writer && (dxf_write_close (writer) == EXIT_SUCCESS))
+        callback_reader = dxf_callback_reader_open ("precision.dxf");
+    if (!callback_reader
+        || dxf_callback_reader_register (callback_reader, LINE, compare_start, start)
+        || dxf_callback_reader_run (callback_reader)
+        || (start[2] != 1.0))
+        fprintf (stdout, "TESTS: shortest round trip exited with error\n");
+    else
+        fprintf (stdout, "TESTS: shortest round trip read %g line with no error\n", start[2]);
+    dxf_callback_reader_close (callback_reader);
+    remove ("precision.dxf");
+
+    /*
+     * Writes lines with 4 threads and with 1 thread, the files and the
+     * handles have to be the same.
+     */
+    DxfEntityRecord *records = malloc (40000 * sizeof (DxfEntityRecord));
+    size_t record_count = 0;
+    int handle = 0x100;
+    int parallel_ret = EXIT_FAILURE;
+    int serial_ret = EXIT_FAILURE;
+    int differences = 0;
+    while (records && (record_count < 40000))
+    {
+        DxfLine *line = dxf_line_init (NULL);
+        if (!line)
+            break;
+        line->x1 = (double) record_count + 1.0;
+        records[record_count].type = LINE;
+        records[record_count].entity = line;
+        records[record_count++].line_number = 0;
+    }
+    writer = dxf_write_init ("parallel.dxf", 0);
+    if (writer && (record_count == 40000))
+        parallel_ret = dxf_write_entities_parallel (writer, records,
+            record_count, AutoCAD_2000, 4, &handle);
+    if (writer && dxf_write_close (writer))
+        parallel_ret = EXIT_FAILURE;
+    size_t record;
+    for (record = 0; record < record_count; record++)
+        ((DxfLine *) records[record].entity)->common.id_code = 0;
+    handle = 0x100;
+    writer = dxf_write_init ("serial.dxf", 0);
+    if (writer && (record_count == 40000))
+        serial_ret = dxf_write_entities_parallel (writer, records,
+            record_count, AutoCAD_2000, 1, &handle);
+    if (writer && dxf_write_close (writer))
+        serial_ret = EXIT_FAILURE;
+    FILE *parallel_file = fopen ("parallel.dxf", "r");
+    FILE *serial_file = fopen ("serial.dxf", "r");
+    while (parallel_file && serial_file)
+    {
+        int c = fgetc (parallel_file);
+        if (c != fgetc (serial_file))
+            differences++;
+        if (c == EOF)
+            break;
+    }
+    if ((parallel_ret != EXIT_SUCCESS)
+        || (serial_ret != EXIT_SUCCESS)
+        || !parallel_file
+        || !serial_file
+        || differences
+        || (handle != 0x100 + 40000))
+        fprintf (stdout, "TESTS: parallel writer exited with error\n");
+    else
+        fprintf (stdout, "TESTS: parallel writer wrote %d lines with no error\n", (int) record_count);
+    if (parallel_file)
+        fclose (parallel_file);
+    if (serial_file)
+        fclose (serial_file);
+    dxf_entity_records_free (records, record_count);
+    remove ("parallel.dxf");
+    remove ("serial.dxf");
+
+    /*
+     * Streams lines through a writer session, the header has to get the
+     * next handle and the extents of the lines.
+     */
+    DxfWriteSession *session = NULL;
+    DxfLine *session_line = dxf_line_init (NULL);
+    int session_lines = 0;
+    int session_ret = EXIT_FAILURE;
+    writer = dxf_write_init ("session.dxf", 0);
+    if (writer && session_line)
+        session = dxf_write_session_begin (writer, AutoCAD_2000, 0x100);
+    if (session && !dxf_write_session_begin_entities (session))
+    {
+        for (i = 0; i < 3; i++)
+        {
+            session_line->common.id_code = 0;
+            session_line->x0 = -1.0 * i;
+            session_line->x1 = 2.0 * i + 1.0;
+            session_line->y1 = 4.0;
+            dxf_write_session_add (session, LINE, session_line);
+        }
+        session_ret = dxf_write_session_finish (session);
+    }
+    if (writer && dxf_write_close (writer))
+        session_ret = EXIT_FAILURE;
+    char session_text[512] = "";
+    FILE *session_file = fopen ("session.dxf", "r");
+    if (session_file)
+    {
+        session_text[fread (session_text, 1, sizeof (session_text) - 1, session_file)] = '\0';
+        fclose (session_file);
+    }
+    char *extmax = strstr (session_text, "$EXTMAX\n 10\n");
+    callback_reader = NULL;
+    if (session_ret == EXIT_SUCCESS)
+        callback_reader = dxf_callback_reader_open ("session.dxf");
+    if (!callback_reader
+        || dxf_callback_reader_register (callback_reader, LINE, count_lines, &session_lines)
+        || dxf_callback_reader_run (callback_reader)
+        || (session_lines != 3)
+        || !strstr (session_text, "$HANDSEED\n  5\n0000000000000103\n")
+        || !extmax
+        || (strtod (extmax + 13, NULL) != 5.0))
+        fprintf (stdout, "TESTS: writer session exited with error\n");
+    else
+        fprintf (stdout, "TESTS: writer session wrote %d lines with no error\n", session_lines);
+    dxf_callback_reader_close (callback_reader);
+    dxf_line_free (session_line);
+    remove ("session.dxf");
+
+    /*
+     * Writes lines from arrays, the line of zero length is skipped, and
+     * two entities of each other type with a batch writer.
+     */
+    double batch_x[3] = { 0.0, 1.0, 2.0 };
+    double batch_y[3] = { 0.0, 1.0, 5.0 };
+    double batch_end[3] = { 1.0, 1.0, 3.0 };
+    int batch_counts[DXF_MAX_ENTITY_TYPES] = { 0 };
+    int batch_handle = 0x200;
+    int batch_ret = EXIT_SUCCESS;
+    int batch_others = EXIT_SUCCESS;
+    int batch_lines = 0;
+    writer = dxf_write_init ("batch.dxf", 0);
+    if (writer)
+    {
+        dxf_section_write (writer, "ENTITIES");
+        batch_ret = dxf_line_write_batch (writer, 3, batch_x, batch_y, NULL,
+            batch_end, batch_end, NULL, "0", DXF_COLOR_BYLAYER, &batch_handle);
+        if (dxf_point_write_batch (writer, 2, batch_xs, batch_ys, NULL,
+                "0", DXF_COLOR_BYLAYER, &batch_handle)
+            || dxf_circle_write_batch (writer, 2, batch_xs, batch_ys, NULL,
+                batch_radii, "0", DXF_COLOR_BYLAYER, &batch_handle)
+            || dxf_arc_write_batch (writer, 2, batch_xs, batch_ys, NULL,
+                batch_radii, batch_start_angles, batch_end_angles, "0",
+                DXF_COLOR_BYLAYER, &batch_handle)
+            || dxf_3dface_write_batch (writer, 2, batch_corners[0], batch_corners[1],
+                batch_corners[2], NULL, "0", DXF_COLOR_BYLAYER, &batch_handle)
+            || dxf_lwpolyline_write_batch (writer, 2, batch_first, batch_xs, batch_ys,
+                1, "0", DXF_COLOR_BYLAYER, &batch_handle))
+            batch_others = EXIT_FAILURE;
+        dxf_section_write_endsection (writer);
+        dxf_write_eof (writer);
+    }
+    callback_reader = NULL;
+    if (writer && (dxf_write_close (writer) == EXIT_SUCCESS))
+        callback_reader = dxf_callback_reader_open ("batch.dxf");
+    if (!callback_reader
+        || (batch_ret != EXIT_FAILURE)
+        || (batch_others != EXIT_SUCCESS)
+        || dxf_callback_reader_register (callback_reader, LINE, count_lines, &batch_lines)
+        || dxf_callback_reader_register (callback_reader, POINT, check_batch, batch_counts)
+        || dxf_callback_reader_register (callback_reader, CIRCLE, check_batch, batch_counts)
+        || dxf_callback_reader_register (callback_reader, ARC, check_batch, batch_counts)
+        || dxf_callback_reader_register (callback_reader, FACE3D, check_batch, batch_counts)
+        || dxf_callback_reader_register (callback_reader, LWPOLYLINE, check_batch, batch_counts)
+        || dxf_callback_reader_run (callback_reader)
+        || (batch_lines != 2)
+        || (batch_counts[POINT] != 2)
+        || (batch_counts[CIRCLE] != 2)
+        || (batch_counts[ARC] != 2)
+        || (batch_counts[FACE3D] != 2)
+        || (batch_counts[LWPOLYLINE] != 2)
+        || (batch_handle != 0x20C))
+        fprintf (stdout, "TESTS: batch writer exited with error\n");
+    else
+        fprintf (stdout, "TESTS: batch writer wrote %d lines and 2 of each other entity with no error\n", batch_lines);
+    dxf_callback_reader_close (callback_reader);
+    remove ("batch.dxf");
+
+    /*
+     * Reads the entities of the R2000 example into an arena, the same
+     * lines have to be found as by the callback reader, with interned
+     * layer names.
+     */
+    DxfArena *arena = dxf_arena_new (0);
+    DxfEntityHeaders *headers = dxf_entity_headers_new (arena ? dxf_arena_names (arena) : NULL);
+    DxfEntityRecord *arena_records = NULL;
+    size_t arena_count = 0;
+    size_t arena_index;
+    int arena_lines = 0;
+    if (!arena || !headers
+        || dxf_read_entities_arena ("../examples/qcad-example_R2000.dxf", 2,
+            arena, &arena_records, &arena_count, headers))
+        arena_lines = -1;
+    for (arena_index = 0; arena_index < arena_count; arena_index++)
+    {
+        DxfLine *arena_line = arena_records[arena_index].entity;
+        /* Names are interned, the same name is the same pointer. */
+        if ((arena_records[arena_index].type == LINE)
+            && (dxf_arena_intern (arena, arena_line->common.layer) == arena_line->common.layer))
+            arena_lines++;
+    }
+    /* An arena with names of its own is adopted only by an arena without
+     * names, which takes over its table. */
+    DxfArena *own = dxf_arena_new (0);
+    DxfArena *taker = dxf_arena_new (0);
+    char *own_layer = own ? dxf_arena_intern (own, "WALLS") : NULL;
+    if (!own_layer || !taker
+        || (dxf_arena_adopt (arena, own) != EXIT_FAILURE)
+        || (dxf_arena_adopt (taker, own) != EXIT_SUCCESS)
+        || (dxf_arena_intern (taker, "WALLS") != own_layer))
+        arena_lines = -1;
+    dxf_arena_free (taker);
+    if (arena_lines != lines)
+        fprintf (stdout, "TESTS: arena reader exited with error\n");
+    else
+        fprintf (stdout, "TESTS: arena reader read %d lines with no error\n", arena_lines);
+
+    /*
+     * The reader stored the common properties of the entities as compact
+     * headers, with their handles, and a line added afterwards has to
+     * read back the same.  Handles are parsed in 64 bits.
+     */
+    DxfLine compact_line;
+    DxfGroup handle_group;
+    int compact_lines = 0;
+    long compact_index;
+    for (arena_index = 0; headers && (arena_index < arena_count); arena_index++)
+    {
+        DxfLine *arena_line = arena_records[arena_index].entity;
+        if ((arena_index < headers->count)
+            && (arena_records[arena_index].handle != 0)
+            && (headers->headers[arena_index].handle == arena_records[arena_index].handle)
+            && ((int) headers->headers[arena_index].handle == arena_line->common.id_code))
+            compact_lines++;
+    }
+    if (!headers || (headers->count != arena_count) || (compact_lines != (int) arena_count))
+        compact_lines = -1;
+    compact_line.common.thickness = 0.0;
+    if (headers && (arena_count > 0))
+        compact_line.common = ((DxfLine *) arena_records[0].entity)->common;
+    compact_line.common.color = -3;
+    compact_line.common.thickness = 2.5;
+    compact_line.common.paperspace = DXF_PAPERSPACE;
+    compact_index = headers ? dxf_entity_headers_add (headers, &compact_line.common) : -1;
+    if ((compact_index == (long) arena_count) && (compact_lines >= 0))
+    {
+        DxfEntity common;
+        if ((dxf_entity_headers_get (headers, (size_t) compact_index, &common) == EXIT_SUCCESS)
+            && (common.layer == compact_line.common.layer)
+            && (common.color == -3)
+            && (common.thickness == 2.5)
+            && (common.paperspace == DXF_PAPERSPACE)
+            && (common.id_code == compact_line.common.id_code))
+            compact_lines++;
+    }
+    memset (&handle_group, 0, sizeof (handle_group));
+    handle_group.code = 5;
+    handle_group.value = "1234567890AB";
+    handle_group.length = strlen (handle_group.value);
+    handle_group.binary = DXF_BINARY_TEXT;
+    if ((compact_lines != (int) arena_count + 1)
+        || (sizeof (DxfEntityHeader) >= sizeof (DxfEntity))
+        || (dxf_group_get_handle (&handle_group) != 0x1234567890ABULL)
+        || (dxf_group_get_hex (&handle_group) != 0x567890AB))
+        fprintf (stdout, "TESTS: compact header exited with error\n");
+    else
+        fprintf (stdout, "TESTS: compact header stored %d entities in %d bytes each with no error\n",
+            compact_lines, (int) sizeof (DxfEntityHeader));
+    dxf_entity_headers_free (headers);
+    dxf_arena_free (arena);
+
+    /*
+     * Reads the OBJECTS section of the R2000 example, the first object
+     * is the root dictionary with handle C.
+     */
+    DxfObject *objects = NULL;
+    size_t object_count = 0;
+    int objects_ret = dxf_read_objects ("../examples/qcad-example_R2000.dxf",
+        NULL, &objects, &object_count);
+    if ((objects_ret != EXIT_SUCCESS)
+        || (object_count == 0)
+        || (strcmp (objects[0].name, "DICTIONARY") != 0)
+        || (objects[0].count == 0)
+        || (objects[0].values[0].code != 5)
+        || (strcmp (objects[0].values[0].value.S, "C") != 0))
+        fprintf (stdout, "TESTS: objects reader exited with error\n");
+    else
+        fprintf (stdout, "TESTS: objects reader read %d objects with no error\n", (int) object_count);
+    dxf_objects_free (objects, object_count);
+
+    /*
+     * Freezes a layer in a VIEWPORT, writes it and reads it back.
+     */
+    int frozen_viewports = 0;
+    DxfViewport *viewport;
+    arena = dxf_arena_new (0);
+    viewport = dxf_viewport_init_arena (arena);
+    writer = NULL;
+    if (viewport
+        && (dxf_viewport_freeze_layer (arena, viewport, "WALLS") == EXIT_SUCCESS)
+        && dxf_viewport_layer_is_frozen (viewport, "WALLS")
+        && dxf_viewport_layer_number_is_frozen (viewport,
+            (size_t) dxf_intern_find (arena->names, "WALLS", 5))
+        && !dxf_viewport_layer_is_frozen (viewport, "DOORS")
+        && (dxf_intern_find (arena->names, "DOORS", 5) < 0))
+        writer = dxf_write_init ("viewport.dxf", 0);
+    if (writer)
+    {
+        dxf_section_write (writer, "ENTITIES");
+        dxf_viewport_write (writer, *viewport);
+        dxf_section_write_endsection (writer);
+        dxf_write_eof (writer);
+    }
+    callback_reader = NULL;
+    if (writer && (dxf_write_close (writer) == EXIT_SUCCESS))
+        callback_reader = dxf_callback_reader_open ("viewport.dxf");
+    if (!callback_reader
+        || dxf_callback_reader_register (callback_reader, VIEWPORT, count_frozen, &frozen_viewports)
+        || dxf_callback_reader_run (callback_reader)
+        || (frozen_viewports != 1)
+        || (dxf_intern_find (dxf_intern_shared (), "WALLS", 5) >= 0))
+        fprintf (stdout, "TESTS: viewport frozen layers exited with error\n");
+    else
+        fprintf (stdout, "TESTS: viewport frozen layers read %d viewport with no error\n", frozen_viewports);
+    dxf_callback_reader_close (callback_reader);
+    dxf_arena_free (arena);
+    remove ("viewport.dxf");
+
+    /*
+     * A name interned without an arena is gone after the shared names
+     * are freed.
+     */
+    char *anonymous = dxf_arena_intern (NULL, "*U123");
+    int shared_names = (anonymous
+        && (dxf_intern_find (dxf_intern_shared (), "*U123", 5) >= 0));
+    DxfLine *fresh_line;
+    dxf_intern_shared_free ();
+    fresh_line = dxf_line_init (NULL);
+    if (!shared_names || !fresh_line
+        || (dxf_intern_find (dxf_intern_shared (), "*U123", 5) >= 0)
+        || (strcmp (fresh_line->common.layer, DXF_DEFAULT_LAYER) != 0))
+        fprintf (stdout, "TESTS: shared names exited with error\n");
+    else
+        fprintf (stdout, "TESTS: shared names freed with no error\n");
+    dxf_line_free (fresh_line);
+
+    /*
+     * Releases a VERTEX to its pool, the next one reuses it zeroed.
+     */
+    DxfVertex *vertex = dxf_vertex_new ();
+    DxfVertex *reused = NULL;
+    if (vertex)
+    {
+        vertex->x0 = 1.0;
+        dxf_vertex_free (vertex);
+        reused = dxf_vertex_new ();
+    }
+    if (!reused || (reused != vertex) || (reused->x0 != 0.0))
+        fprintf (stdout, "TESTS: vertex pool exited with error\n");
+    else
+        fprintf (stdout, "TESTS: vertex pool reused 1 vertex with no error\n");
+    dxf_vertex_free (reused);
+
     return 1;
 }
\ No newline at end of file